@@ -15,6 +15,7 @@
 #include "includes/kratos_flags.h"
 #include "utilities/math_utils.h"
 #include "isogeometric_application/custom_utilities/isogeometric_math_utils.h"
+#include "isogeometric_application/custom_utilities/isogeometric_profiler.h"
 #include "isogeometric_application/isogeometric_application.h"
 
 namespace Kratos
@@ -72,9 +73,7 @@ void DummyIsogeometricCondition::Initialize()
     Set(ACTIVE, false);
 
     ////////////////////Initialize geometry_data/////////////////////////////
-    #ifdef ENABLE_PROFILING
-    double start_compute = OpenMPUtils::GetCurrentTime();
-    #endif
+    IsogeometricProfiler::ScopedTimer timer("DummyIsogeometricCondition::Initialize");
 
     // try to read the extraction operator from the elemental data
     Matrix ExtractionOperator;
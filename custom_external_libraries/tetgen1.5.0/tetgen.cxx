@@ -15,6 +15,8 @@
 
 #include "tetgen.h"
 
+#include <mutex>
+
 //// io_cxx ///////////////////////////////////////////////////////////////////
 ////                                                                       ////
 ////                                                                       ////
@@ -3614,6 +3616,11 @@ int tetgenmesh::sapexpivot[6] = {5, 5, 3, 3, 4, 4};
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
 
+// The look-up tables are static, hence they are initialized only once. Therefore
+//   several meshes can be tetrahedralized concurrently (isogeometric application).
+
+static std::once_flag inittables_flag;
+
 void tetgenmesh::inittables()
 {
   int i, j;
@@ -4540,7 +4547,7 @@ void tetgenmesh::initializepools()
     printf("  tetrahedron per block: %d.\n", b->tetrahedraperblock);
   }
 
-  inittables();
+  std::call_once(inittables_flag, &tetgenmesh::inittables);
 
   // There are three input point lists available, which are in, addin,
   //   and bgm->in. These point lists may have different number of 
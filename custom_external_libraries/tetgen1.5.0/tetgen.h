@@ -1371,7 +1371,7 @@ public:
   static int sorgpivot [6], sdestpivot[6], sapexpivot[6];
   static int snextpivot[6];
 
-  void inittables();
+  static void inittables();
 
   // Primitives for tetrahedra.
   inline tetrahedron encode(triface& t);
@@ -60,6 +60,7 @@
 #include "integration/quadrature.h"
 #include "integration/line_gauss_legendre_integration_points.h"
 #include "custom_utilities/bezier_utils.h"
+#include "custom_utilities/bezier_kernel.h"
 #include "custom_utilities/isogeometric_math_utils.h"
 
 namespace Kratos
@@ -202,13 +203,13 @@ public:
      * Life Cycle
      */
 
-    Geo1dBezier(): BaseType( PointsArrayType() )
+    Geo1dBezier(): BaseType( PointsArrayType() ), mpKernel( NULL )
     {}
 
     Geo1dBezier(
             const PointsArrayType& ThisPoints
     )
-    : BaseType( ThisPoints )
+    : BaseType( ThisPoints ), mpKernel( NULL )
     {
     }
 
@@ -222,7 +223,7 @@ public:
      * source geometry's points too.
      */
     Geo1dBezier( Geo1dBezier const& rOther )
-    : BaseType( rOther )
+    : BaseType( rOther ), mpKernel( NULL )
     {
     }
 
@@ -238,7 +239,7 @@ public:
      * source geometry's points too.
      */
     template<class TOtherPointType> Geo1dBezier( Geo1dBezier<TOtherPointType> const& rOther )
-    : BaseType( rOther )
+    : BaseType( rOther ), mpKernel( NULL )
     {
     }
 
@@ -803,6 +804,12 @@ public:
     virtual VectorType& ShapeFunctionValues( VectorType& rResults,
             const CoordinatesArrayType& rPoint ) const
     {
+        if (mpKernel != NULL)
+        {
+            mpKernel->ShapeFunctionsValues(rResults, &rPoint[0], mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return rResults;
+        }
+
         //compute all Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values(mOrder + 1);
         BezierUtils::bernstein(bezier_functions_values, mOrder, rPoint[0]);
@@ -827,6 +834,14 @@ public:
     virtual MatrixType& ShapeFunctionsLocalGradients( MatrixType& rResult,
             const CoordinatesArrayType& rPoint ) const
     {
+        if (mpKernel != NULL)
+        {
+            VectorType shape_functions_values;
+            mpKernel->ShapeFunctionsValuesAndLocalGradients(shape_functions_values, rResult, &rPoint[0],
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return rResult;
+        }
+
         //compute all Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values(mOrder + 1);
         VectorType bezier_functions_derivatives(mOrder + 1);
@@ -859,6 +874,13 @@ public:
     void ShapeFunctionsValuesAndLocalGradients( VectorType& shape_functions_values,
             MatrixType& shape_functions_local_gradients, const CoordinatesArrayType& rPoint ) const
     {
+        if (mpKernel != NULL)
+        {
+            mpKernel->ShapeFunctionsValuesAndLocalGradients(shape_functions_values, shape_functions_local_gradients, &rPoint[0],
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return;
+        }
+
         //compute all Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values(mOrder + 1);
         VectorType bezier_functions_derivatives(mOrder + 1);
@@ -978,6 +1000,11 @@ public:
         if(mExtractionOperator.size2() != (mOrder + 1))
             KRATOS_THROW_ERROR(std::logic_error, "The number of column of extraction operator must be equal to (p_u+1)", __FUNCTION__)
 
+        // use the kernel of fixed degree if there is one for this p_u
+        mpKernel = BezierKernel<1>::Get(mOrder, 0, 0);
+        if(mpKernel != NULL)
+            mBezierWeights = prod(trans(mExtractionOperator), mCtrlWeights);
+
         // find the existing integration rule or create new one if not existed
         BezierUtils::RegisterIntegrationRule<2, 2, 2>(NumberOfIntegrationMethod, Degree1);
 
@@ -1008,6 +1035,10 @@ private:
 
     int mNumber;//number of shape functions define the curve
 
+    const BezierKernel<1>* mpKernel;//kernel of fixed degree, NULL if the shape functions are evaluated by the generic code
+
+    ValuesContainerType mBezierWeights;//weights of the Bezier functions, only computed when the kernel is used
+
     ///@}
     ///@name Serialization
     ///@{
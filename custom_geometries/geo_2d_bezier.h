@@ -28,13 +28,13 @@ see isogeometric_application/LICENSE.txt
 #include "integration/quadrature.h"
 #include "custom_utilities/bspline_utils.h"
 #include "custom_utilities/bezier_utils.h"
+#include "custom_utilities/bezier_kernel.h"
 //#include "integration/quadrature.h"
 //#include "integration/line_gauss_legendre_integration_points.h"
 
 //#define DEBUG_LEVEL1
 //#define DEBUG_LEVEL2
 // #define DEBUG_LEVEL3
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -188,12 +188,12 @@ public:
 
     Geo2dBezier()
 //    : BaseType( PointsArrayType(), &msGeometryData )
-    : BaseType( PointsArrayType() )
+    : BaseType( PointsArrayType() ), mpKernel( NULL )
     {}
 
     Geo2dBezier( const PointsArrayType& ThisPoints )
 //    : BaseType( ThisPoints, &msGeometryData )
-    : BaseType( ThisPoints )
+    : BaseType( ThisPoints ), mpKernel( NULL )
     {}
 
 //    Geo2dBezier( const PointsArrayType& ThisPoints, const GeometryData* pGeometryData )
@@ -210,7 +210,7 @@ public:
      * source geometry's points too.
      */
     Geo2dBezier( Geo2dBezier const& rOther )
-    : BaseType( rOther )
+    : BaseType( rOther ), mpKernel( NULL )
     {}
 
     /**
@@ -225,7 +225,7 @@ public:
      * source geometry's points too.
      */
     template<class TOtherPointType> Geo2dBezier( Geo2dBezier<TOtherPointType> const& rOther )
-    : BaseType( rOther )
+    : BaseType( rOther ), mpKernel( NULL )
     {
     }
 
@@ -331,6 +331,15 @@ public:
         std::cout << typeid(*this).name() << "::" << __FUNCTION__ << std::endl;
         #endif
 
+        if (mpKernel != NULL)
+        {
+            mpKernel->IntegrationPointsValuesAndLocalGradients(shape_functions_values, shape_functions_local_gradients,
+                mpBezierGeometryData->ShapeFunctionsValues( ThisMethod ),
+                mpBezierGeometryData->ShapeFunctionsLocalGradients( ThisMethod ),
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return;
+        }
+
         IndexType NumberOfIntegrationPoints = this->IntegrationPointsNumber(ThisMethod);
 
         shape_functions_values.resize(NumberOfIntegrationPoints, this->PointsNumber(), false);
@@ -603,6 +612,12 @@ public:
      */
     virtual Vector& ShapeFunctionsValues( Vector& rResults, const CoordinatesArrayType& rCoordinates ) const
     {
+        if (mpKernel != NULL)
+        {
+            mpKernel->ShapeFunctionsValues(rResults, &rCoordinates[0], mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return rResults;
+        }
+
         //compute all univariate Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values1(mNumber1);
         VectorType bezier_functions_values2(mNumber2);
@@ -647,6 +662,14 @@ public:
         std::cout << typeid(*this).name() << "::" << __FUNCTION__ << std::endl;
         #endif
 
+        if (mpKernel != NULL)
+        {
+            VectorType shape_functions_values;
+            mpKernel->ShapeFunctionsValuesAndLocalGradients(shape_functions_values, rResults, &rCoordinates[0],
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return rResults;
+        }
+
         //compute all univariate Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values1(mNumber1);
         VectorType bezier_functions_values2(mNumber2);
@@ -926,6 +949,11 @@ public:
         if(mExtractionOperator.size2() != (mOrder1 + 1) * (mOrder2 + 1))
             KRATOS_THROW_ERROR(std::logic_error, "The number of column of extraction operator must be equal to (p_u+1) * (p_v+1), mExtractionOperator.size2() =", mExtractionOperator.size2())
 
+        // use the kernel of fixed degrees if there is one for this (p_u, p_v)
+        mpKernel = BezierKernel<2>::Get(mOrder1, mOrder2, 0);
+        if(mpKernel != NULL)
+            mBezierWeights = prod(trans(mExtractionOperator), mCtrlWeights);
+
         if(NumberOfIntegrationMethod > 0)
         {
             // find the existing integration rule or create new one if not existed
@@ -953,6 +981,9 @@ protected:
     int mNumber1; //number of bezier shape functions define the surface on parametric direction 1
     int mNumber2; //number of bezier shape functions define the surface on parametric direction 2
 
+    const BezierKernel<2>* mpKernel; //kernel of fixed degrees, NULL if the shape functions are evaluated by the generic code
+    ValuesContainerType mBezierWeights; //weights of the Bezier functions, only computed when the kernel is used
+
 private:
 
     /**
@@ -992,6 +1023,13 @@ private:
         std::cout << typeid(*this).name() << "::" << __FUNCTION__ << std::endl;
         #endif
 
+        if (mpKernel != NULL)
+        {
+            mpKernel->ShapeFunctionsValuesAndLocalGradients(shape_functions_values, shape_functions_local_gradients, &rPoint[0],
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return;
+        }
+
         //compute all univariate Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values1(mNumber1);
         VectorType bezier_functions_values2(mNumber2);
@@ -1120,7 +1158,6 @@ template<class TPointType> inline std::ostream& operator <<(
 #undef DEBUG_LEVEL6
 #undef DEBUG_LEVEL7
 #undef DEBUG_LEVEL8
-#undef ENABLE_PROFILING
 
 #endif
 
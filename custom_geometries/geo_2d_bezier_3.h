@@ -35,7 +35,6 @@ see isogeometric_application/LICENSE.txt
 //#define DEBUG_LEVEL1
 //#define DEBUG_LEVEL2
 // #define DEBUG_LEVEL3
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -630,6 +629,11 @@ public:
             KRATOS_THROW_ERROR(std::logic_error, "The parametric parameters is not compatible.", __FUNCTION__)
         }
 
+        // use the kernel of fixed degrees if there is one for this (p_u, p_v)
+        BaseType::mpKernel = BezierKernel<2>::Get(BaseType::mOrder1, BaseType::mOrder2, 0);
+        if(BaseType::mpKernel != NULL)
+            BaseType::mBezierWeights = prod(trans(BaseType::mExtractionOperator), BaseType::mCtrlWeights);
+
         // find the existing integration rule or create new one if not existed
         BezierUtils::RegisterIntegrationRule<2, 3, 2>(NumberOfIntegrationMethod, Degree1, Degree2);
 
@@ -731,7 +735,6 @@ template<class TPointType> inline std::ostream& operator <<(
 #undef DEBUG_LEVEL6
 #undef DEBUG_LEVEL7
 #undef DEBUG_LEVEL8
-#undef ENABLE_PROFILING
 
 #endif
 
@@ -60,13 +60,13 @@
 #include "custom_geometries/isogeometric_geometry.h"
 #include "integration/quadrature.h"
 #include "custom_utilities/bspline_utils.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "integration/quadrature.h"
 #include "integration/line_gauss_legendre_integration_points.h"
 
 //#define DEBUG_LEVEL1
 //#define DEBUG_LEVEL2
 //#define DEBUG_LEVEL3
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -1366,9 +1366,7 @@ public:
             KRATOS_THROW_ERROR(std::logic_error, "The parametric parameters is not compatible, knots.length != n+p+1.", __FUNCTION__)
         }
 
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("Geo2dNURBS::GenerateGeometryData");
 
         //generate all integration points
         IntegrationPointsContainerType all_integration_points = AllIntegrationPoints(NumberOfIntegrationMethod);
@@ -1380,11 +1378,7 @@ public:
 //            KRATOS_WATCH(all_integration_points[i])
         #endif
         
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Generate integration points: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-        #endif
+        timer.Lap("Geo2dNURBS::GenerateGeometryData::IntegrationPoints");
         
         //generate all shape function values and derivatives
         ShapeFunctionsValuesContainerType shape_functions_values;
@@ -1400,11 +1394,7 @@ public:
             );
         }
         
-        #ifdef ENABLE_PROFILING
-        end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Generate shape function values and derivatives: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-        #endif
+        timer.Lap("Geo2dNURBS::GenerateGeometryData::ShapeFunctions");
 
         #ifdef DEBUG_LEVEL3
         std::cout << "Generate shape functions and local gradients completed." << std::endl;
@@ -1426,23 +1416,7 @@ public:
                 )
         );
         
-        #ifdef ENABLE_PROFILING
-        end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Initialize pNewGeometryData: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-
-//        for ( unsigned int i = 0 ; i < GeometryData::NumberOfIntegrationMethods ; i++ )
-//        {
-//            boost::numeric::ublas::vector<Matrix> temp( all_integration_points[i].size() );
-
-//            for ( unsigned int j = 0 ; j < all_integration_points[i].size() ; j++ )
-//                temp[j] = outer_prod( row( shape_functions_values[i], j ), row( shape_functions_values[i], j ) );
-//        }
-//        
-//        end_compute = OpenMPUtils::GetCurrentTime();
-//        std::cout << "Dummy calculation: " << end_compute - start_compute << " s" << std::endl;
-//        start_compute = end_compute;
-        #endif
+        timer.Lap("Geo2dNURBS::GenerateGeometryData::InitializeGeometryData");
 
 
         //generate an empty GeometryData
@@ -1802,7 +1776,6 @@ template<class TPointType> inline std::ostream& operator <<(
 #undef DEBUG_LEVEL6
 #undef DEBUG_LEVEL7
 #undef DEBUG_LEVEL8
-#undef ENABLE_PROFILING
 
 #endif
 
@@ -63,7 +63,6 @@
 //#define DEBUG_LEVEL1
 //#define DEBUG_LEVEL2
 //#define DEBUG_LEVEL3
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -660,7 +659,6 @@ template<class TPointType> inline std::ostream& operator <<(
 #undef DEBUG_LEVEL6
 #undef DEBUG_LEVEL7
 #undef DEBUG_LEVEL8
-#undef ENABLE_PROFILING
 
 #endif
 
@@ -27,13 +27,13 @@ see isogeometric_application/LICENSE.txt
 #include "custom_geometries/isogeometric_geometry.h"
 #include "integration/quadrature.h"
 #include "custom_utilities/bspline_utils.h"
+#include "custom_utilities/bezier_kernel.h"
 //#include "integration/quadrature.h"
 //#include "integration/line_gauss_legendre_integration_points.h"
 
 //#define DEBUG_LEVEL1
 //#define DEBUG_LEVEL2
 // #define DEBUG_LEVEL3
-#define ENABLE_PROFILING
 #define ENABLE_CHECK_SIZE
 
 namespace Kratos
@@ -186,12 +186,12 @@ public:
 
     Geo3dBezier()
 //    : BaseType( PointsArrayType(), &msGeometryData )
-    : BaseType( PointsArrayType() )
+    : BaseType( PointsArrayType() ), mpKernel( NULL )
     {}
 
     Geo3dBezier( const PointsArrayType& ThisPoints )
 //    : BaseType( ThisPoints, &msGeometryData )
-    : BaseType( ThisPoints )
+    : BaseType( ThisPoints ), mpKernel( NULL )
     {
     }
 
@@ -205,7 +205,7 @@ public:
      * source geometry's points too.
      */
     Geo3dBezier( Geo3dBezier const& rOther )
-    : BaseType( rOther )
+    : BaseType( rOther ), mpKernel( NULL )
     {
     }
 
@@ -221,7 +221,7 @@ public:
      * source geometry's points too.
      */
     template<class TOtherPointType> Geo3dBezier( Geo3dBezier<TOtherPointType> const& rOther )
-    : BaseType( rOther )
+    : BaseType( rOther ), mpKernel( NULL )
     {
     }
 
@@ -344,6 +344,15 @@ public:
         std::cout << typeid(*this).name() << "::" << __FUNCTION__ << std::endl;
         #endif
 
+        if (mpKernel != NULL)
+        {
+            mpKernel->IntegrationPointsValuesAndLocalGradients(shape_functions_values, shape_functions_local_gradients,
+                mpBezierGeometryData->ShapeFunctionsValues( ThisMethod ),
+                mpBezierGeometryData->ShapeFunctionsLocalGradients( ThisMethod ),
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return;
+        }
+
 //        SizeType NumberOfIntegrationPoints = this->IntegrationPointsNumber(ThisMethod);
         SizeType NumberOfIntegrationPoints = mpBezierGeometryData->IntegrationPoints(ThisMethod).size();
 
@@ -791,6 +800,12 @@ public:
      */
     virtual Vector& ShapeFunctionsValues( Vector& rResults, const CoordinatesArrayType& rCoordinates ) const
     {
+        if (mpKernel != NULL)
+        {
+            mpKernel->ShapeFunctionsValues(rResults, &rCoordinates[0], mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return rResults;
+        }
+
         //compute all univariate Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values1(mNumber1);
         VectorType bezier_functions_values2(mNumber2);
@@ -842,6 +857,14 @@ public:
         std::cout << typeid(*this).name() << "::" << __FUNCTION__ << std::endl;
         #endif
 
+        if (mpKernel != NULL)
+        {
+            VectorType shape_functions_values;
+            mpKernel->ShapeFunctionsValuesAndLocalGradients(shape_functions_values, rResults, &rCoordinates[0],
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return rResults;
+        }
+
         //compute all univariate Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values1(mNumber1);
         VectorType bezier_functions_values2(mNumber2);
@@ -1064,6 +1087,11 @@ public:
             KRATOS_THROW_ERROR(std::logic_error, "The number of column of extraction operator must be equal to (p_u+1) * (p_v+1) * (p_w+1), error at", __FUNCTION__)
         }
 
+        // use the kernel of fixed degrees if there is one for this (p_u, p_v, p_w)
+        mpKernel = BezierKernel<3>::Get(mOrder1, mOrder2, mOrder3);
+        if(mpKernel != NULL)
+            mBezierWeights = prod(trans(mExtractionOperator), mCtrlWeights);
+
         if(NumberOfIntegrationMethod > 0)
         {
             // find the existing integration rule or create new one if not existed
@@ -1130,6 +1158,9 @@ protected:
     int mNumber2; //number of bezier shape functions define the surface on parametric direction 2
     int mNumber3; //number of bezier shape functions define the surface on parametric direction 3
 
+    const BezierKernel<3>* mpKernel; //kernel of fixed degrees, NULL if the shape functions are evaluated by the generic code
+    ValuesContainerType mBezierWeights; //weights of the Bezier functions, only computed when the kernel is used
+
 private:
 
     /**
@@ -1170,6 +1201,13 @@ private:
         std::cout << typeid(*this).name() << "::" << __FUNCTION__ << std::endl;
         #endif
 
+        if (mpKernel != NULL)
+        {
+            mpKernel->ShapeFunctionsValuesAndLocalGradients(shape_functions_values, shape_functions_local_gradients, &rPoint[0],
+                mExtractionOperator, mCtrlWeights, mBezierWeights);
+            return;
+        }
+
         //compute all univariate Bezier shape functions & derivatives at rPoint
         VectorType bezier_functions_values1(mNumber1);
         VectorType bezier_functions_values2(mNumber2);
@@ -1320,7 +1358,6 @@ template<class TPointType> inline std::ostream& operator <<(
 #undef DEBUG_LEVEL6
 #undef DEBUG_LEVEL7
 #undef DEBUG_LEVEL8
-#undef ENABLE_PROFILING
 #undef ENABLE_PRECOMPUTE
 
 #endif
@@ -54,6 +54,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string>
 #include <fstream>
 #include <set>
+#include <algorithm>
 
 
 // External includes
@@ -118,13 +119,25 @@ public:
 
     typedef std::size_t SizeType;
 
+    /// A range of elements or conditions in compressed form. The node ids of the i-th entity are
+    /// Connectivities[Offsets[i]], ..., Connectivities[Offsets[i+1]-1].
+    struct EntitiesChunk
+    {
+        std::vector<std::string> Names;     // the distinct entity names in the range
+        std::vector<int> NameIndices;       // the index of the entity name in Names
+        std::vector<SizeType> Ids;
+        std::vector<SizeType> PropertiesIds;
+        std::vector<SizeType> Offsets;
+        std::vector<SizeType> Connectivities;
+    };
+
     ///@}
     ///@name Life Cycle
     ///@{
 
     /// Constructor with  filenames.
     IsogeometricModelPartIO(std::string const& Filename)
-        : mNumberOfLines(1)
+        : mNumberOfLines(1), mReadLocalEntitiesOnly(false)
         , mInputBaseName(Filename), mOutputBaseName(Filename)
         , mInputFilename(Filename + ".mdpa"), mOutputFilename(Filename + "_out.mdpa")
         , mInput(mInputFilename.c_str()),  mOutput(mOutputFilename.c_str())
@@ -140,7 +153,7 @@ public:
 
     /// Constructor with input and output filenames.
     IsogeometricModelPartIO(std::string const& InputFilename, std::string const& OutputFilename)
-        : mNumberOfLines(1)
+        : mNumberOfLines(1), mReadLocalEntitiesOnly(false)
         , mInputBaseName(InputFilename), mOutputBaseName(OutputFilename)
         , mInputFilename(InputFilename + ".mdpa"), mOutputFilename(OutputFilename + ".mdpa")
         , mInput(mInputFilename.c_str()), mOutput(mOutputFilename.c_str())
@@ -526,6 +539,194 @@ public:
         return num_nodes;
     }
 
+    /// Count the nodes, elements and conditions in all blocks of the input, in a single pass.
+    /// The entity lines are skipped without parsing.
+    void ReadEntitiesNumbers(SizeType& rNumberOfNodes, SizeType& rNumberOfElements, SizeType& rNumberOfConditions)
+    {
+        KRATOS_TRY
+        rNumberOfNodes = 0;
+        rNumberOfElements = 0;
+        rNumberOfConditions = 0;
+        ResetInput();
+        std::string word;
+        std::string block_name;
+        while(true)
+        {
+            ReadWord(word);
+            if(mInput.eof())
+                break;
+            ReadBlockName(word);
+            SizeType* p_number_of_entities;
+            if(word == "Nodes")
+                p_number_of_entities = &rNumberOfNodes;
+            else if(word == "Elements")
+                p_number_of_entities = &rNumberOfElements;
+            else if(word == "Conditions")
+                p_number_of_entities = &rNumberOfConditions;
+            else
+            {
+                SkipBlock(word);
+                continue;
+            }
+
+            block_name = word;
+            if(block_name != "Nodes")
+                ReadWord(word); // the entity name
+            while(!mInput.eof())
+            {
+                ReadWord(word);
+                if(CheckEndBlock(block_name, word))
+                    break;
+                SkipLine();
+                ++(*p_number_of_entities);
+            }
+        }
+        KRATOS_CATCH("")
+    }
+
+    /// Read the nodes in the range [Start, End) of their order of appearance in the input.
+    /// Only the nodes in the range are parsed and the reading stops after the range.
+    /// The coordinates are stored as (x, y, z) per node.
+    SizeType ReadNodesChunk(SizeType Start, SizeType End, std::vector<SizeType>& rIds, std::vector<double>& rCoordinates)
+    {
+        KRATOS_TRY
+        rIds.clear();
+        rCoordinates.clear();
+        rIds.reserve(End - Start);
+        rCoordinates.reserve(3*(End - Start));
+
+        SizeType count = 0, id;
+        double x;
+        ResetInput();
+        std::string word;
+        while(count < End)
+        {
+            ReadWord(word);
+            if(mInput.eof())
+                break;
+            ReadBlockName(word);
+            if(word == "Nodes")
+            {
+                while(!mInput.eof())
+                {
+                    ReadWord(word);
+                    if(CheckEndBlock("Nodes", word))
+                        break;
+                    if((count < Start) || (count >= End))
+                        SkipLine();
+                    else
+                    {
+                        ExtractValue(word, id);
+                        rIds.push_back(id);
+                        for(int i = 0; i < 3; ++i)
+                        {
+                            ReadWord(word);
+                            rCoordinates.push_back(ExtractValue(word, x));
+                        }
+                    }
+                    ++count;
+                }
+            }
+            else
+                SkipBlock(word);
+        }
+        return rIds.size();
+        KRATOS_CATCH("")
+    }
+
+    /// Read the elements (BlockName = "Elements") or conditions (BlockName = "Conditions") in the range [Start, End)
+    /// of their order of appearance in the input. Only the entities in the range are parsed and the reading stops after the range.
+    SizeType ReadEntitiesChunk(std::string const& BlockName, SizeType Start, SizeType End, EntitiesChunk& rChunk)
+    {
+        KRATOS_TRY
+        rChunk.Names.clear();
+        rChunk.NameIndices.clear();
+        rChunk.Ids.clear();
+        rChunk.PropertiesIds.clear();
+        rChunk.Offsets.clear();
+        rChunk.Connectivities.clear();
+        rChunk.Offsets.push_back(0);
+
+        SizeType count = 0, id, properties_id, node_id;
+        ResetInput();
+        std::string word;
+        std::string entity_name;
+        while(count < End)
+        {
+            ReadWord(word);
+            if(mInput.eof())
+                break;
+            ReadBlockName(word);
+            if(word == BlockName)
+            {
+                ReadWord(entity_name);
+                int name_index = -1;
+                while(!mInput.eof())
+                {
+                    ReadWord(word); // Reading the entity id or End
+                    if(CheckEndBlock(BlockName, word))
+                        break;
+
+                    if((count < Start) || (count >= End))
+                    {
+                        SkipLine();
+                        ++count;
+                        continue;
+                    }
+
+                    if(name_index == -1)
+                    {
+                        name_index = std::find(rChunk.Names.begin(), rChunk.Names.end(), entity_name) - rChunk.Names.begin();
+                        if(name_index == static_cast<int>(rChunk.Names.size()))
+                            rChunk.Names.push_back(entity_name);
+                    }
+
+                    ExtractValue(word, id);
+                    ReadWord(word); // Reading the properties id
+                    ExtractValue(word, properties_id);
+
+                    int CurrentNumberOfLine = mNumberOfLines;
+                    while(mNumberOfLines == CurrentNumberOfLine)
+                    {
+                        ReadWord2(word); // Reading the node id
+                        if(!word.empty())
+                        {
+                            ExtractValue(word, node_id);
+                            rChunk.Connectivities.push_back(node_id);
+                        }
+                    }
+
+                    rChunk.NameIndices.push_back(name_index);
+                    rChunk.Ids.push_back(id);
+                    rChunk.PropertiesIds.push_back(properties_id);
+                    rChunk.Offsets.push_back(rChunk.Connectivities.size());
+                    ++count;
+                }
+            }
+            else
+                SkipBlock(word);
+        }
+        return rChunk.Ids.size();
+        KRATOS_CATCH("")
+    }
+
+    /// Read the initial values of the entities existing in the given containers, i.e. the entities of the current
+    /// partition. The values of the entities which are not in the containers are skipped.
+    void ReadLocalInitialValues(NodesContainerType& rThisNodes, ElementsContainerType& rThisElements, ConditionsContainerType& rThisConditions)
+    {
+        mReadLocalEntitiesOnly = true;
+        try
+        {
+            ReadInitialValues(rThisNodes, rThisElements, rThisConditions);
+        }
+        catch(...)
+        {
+            mReadLocalEntitiesOnly = false;
+            throw;
+        }
+        mReadLocalEntitiesOnly = false;
+    }
+
     virtual void DivideInputToPartitions(SizeType NumberOfPartitions, GraphType const& DomainsColoredGraph,
                                          PartitionIndicesType const& NodesPartitions,
                                          PartitionIndicesType const& ElementsPartitions,
@@ -678,6 +879,7 @@ private:
     ///@{
 
     SizeType mNumberOfLines;
+    bool mReadLocalEntitiesOnly;
     std::string mInputBaseName;
     std::string mOutputBaseName;
     std::string mInputFilename;
@@ -730,6 +932,14 @@ private:
         KRATOS_CATCH("")
     }
 
+    /// Skip the rest of the current line
+    void SkipLine()
+    {
+        char c = GetCharacter();
+        while(!mInput.eof() && (c != '\n'))
+            c = GetCharacter();
+    }
+
     bool CheckEndBlock(std::string const& BlockName, std::string& rWord)
     {
         if(rWord == "End")
@@ -1529,18 +1739,22 @@ private:
                 break;
 
             ExtractValue(value, id);
-            typename NodesContainerType::iterator i_node = FindKey(rThisNodes, id, "Node");
+            typename NodesContainerType::iterator i_node = FindLocalKey(rThisNodes, id, "Node");
 
             // readidng is_fixed
             ReadWord(value);
             ExtractValue(value, is_fixed);
-            if(is_fixed)
-                i_node->Fix(rVariable);
 
             // readidng nodal_value
             ReadWord(value);
             ExtractValue(value, nodal_value);
 
+            if(i_node == rThisNodes.end())
+                continue;
+
+            if(is_fixed)
+                i_node->Fix(rVariable);
+
             i_node->GetSolutionStepValue(rVariable, 0) =  nodal_value;
         }
 
@@ -1565,7 +1779,9 @@ private:
 
             ExtractValue(value, id);
 
-            FindKey(rThisNodes, id, "Node")->Set(rFlags);
+            typename NodesContainerType::iterator i_node = FindLocalKey(rThisNodes, id, "Node");
+            if(i_node != rThisNodes.end())
+                i_node->Set(rFlags);
         }
 
         KRATOS_CATCH("")
@@ -1607,7 +1823,9 @@ private:
             ReadWord(value);
             ExtractValue(value, nodal_value);
 
-            FindKey(rThisNodes, id, "Node")->GetSolutionStepValue(rVariable, 0) =  nodal_value;
+            typename NodesContainerType::iterator i_node = FindLocalKey(rThisNodes, id, "Node");
+            if(i_node != rThisNodes.end())
+                i_node->GetSolutionStepValue(rVariable, 0) =  nodal_value;
         }
 
         KRATOS_CATCH("")
@@ -1650,7 +1868,9 @@ private:
             // readidng nodal_value
             ReadVectorialValue(nodal_value);
 
-            FindKey(rThisNodes, id, "Node")->GetSolutionStepValue(rVariable, 0) =  nodal_value;
+            typename NodesContainerType::iterator i_node = FindLocalKey(rThisNodes, id, "Node");
+            if(i_node != rThisNodes.end())
+                i_node->GetSolutionStepValue(rVariable, 0) =  nodal_value;
         }
 
         KRATOS_CATCH("")
@@ -3471,6 +3691,15 @@ private:
         return i_result;
     }
 
+    /// Same as FindKey, but returns the end of the container if the key is not found when only the local entities are read
+    template<class TContainerType, class TKeyType>
+    typename TContainerType::iterator FindLocalKey(TContainerType& ThisContainer , TKeyType ThisKey, std::string ComponentName)
+    {
+        if(mReadLocalEntitiesOnly)
+            return ThisContainer.find(ThisKey);
+        return FindKey(ThisContainer, ThisKey, ComponentName);
+    }
+
 
 
 
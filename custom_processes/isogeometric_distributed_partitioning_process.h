@@ -0,0 +1,746 @@
+/*
+LICENSE: see isogeometric_application/LICENSE.txt
+*/
+
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+
+#if !defined(KRATOS_ISOGEOMETRIC_DISTRIBUTED_PARTITIONING_PROCESS_INCLUDED )
+#define  KRATOS_ISOGEOMETRIC_DISTRIBUTED_PARTITIONING_PROCESS_INCLUDED
+
+
+
+// System includes
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+
+// External includes
+#include <mpi.h>
+#include <parmetis.h>
+
+
+// Project includes
+#include "includes/define.h"
+#include "processes/process.h"
+#include "processes/graph_coloring_process.h"
+#include "includes/node.h"
+#include "includes/element.h"
+#include "includes/condition.h"
+#include "includes/model_part.h"
+#include "includes/kratos_components.h"
+#include "includes/mpi_communicator.h"
+#include "custom_io/isogeometric_model_part_io.h"
+
+
+namespace Kratos
+{
+
+///@name Kratos Classes
+///@{
+
+/// Partition the input with the distributed interface of ParMETIS and assign each rank its own entities.
+/** Each rank reads only a contiguous chunk of the elements, conditions and nodes from the input and the mesh
+ * is partitioned by ParMETIS_V3_PartMeshKway. The elements, conditions and the required nodes are then
+ * exchanged directly between the ranks, i.e. no rank holds the full mesh and no intermediate partition
+ * files are written. The number of partitions is the number of processes.
+ * A node is owned by the lowest partition among the partitions of the elements containing it. As in
+ * IsogeometricPartitioningProcess, the node ids are assumed to be consecutive in the input, starting from 1.
+ */
+class IsogeometricDistributedPartitioningProcess : public Process
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Pointer definition of IsogeometricDistributedPartitioningProcess
+    KRATOS_CLASS_POINTER_DEFINITION(IsogeometricDistributedPartitioningProcess);
+
+    typedef std::size_t size_type;
+    typedef unsigned long index_type; // transferred as MPI_UNSIGNED_LONG
+    typedef boost::numeric::ublas::matrix<int> graph_type;
+    typedef IsogeometricModelPartIO::EntitiesChunk EntitiesChunk;
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor.
+    IsogeometricDistributedPartitioningProcess(ModelPart& rModelPart, IsogeometricModelPartIO& rIO)
+        : mrModelPart(rModelPart), mrIO(rIO), mNumberOfCommonNodes(4), mImbalanceTolerance(1.05)
+    {
+    }
+
+    /// Constructor with the number of common nodes defining the adjacency of two elements in the dual graph
+    IsogeometricDistributedPartitioningProcess(ModelPart& rModelPart, IsogeometricModelPartIO& rIO, int NumberOfCommonNodes)
+        : mrModelPart(rModelPart), mrIO(rIO), mNumberOfCommonNodes(NumberOfCommonNodes), mImbalanceTolerance(1.05)
+    {
+    }
+
+    /// Destructor.
+    virtual ~IsogeometricDistributedPartitioningProcess()
+    {
+    }
+
+
+    ///@}
+    ///@name Operators
+    ///@{
+
+    void operator()()
+    {
+        Execute();
+    }
+
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Set the allowed load imbalance of the partitions, e.g. 1.05
+    void SetImbalanceTolerance(const double& Tolerance) {mImbalanceTolerance = Tolerance;}
+
+    virtual void Execute()
+    {
+        KRATOS_TRY;
+
+        int rank, number_of_processes;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+        if (number_of_processes < 2) // There is no need to partition it and just reading the input
+        {
+            mrIO.ReadModelPart(mrModelPart);
+            return;
+        }
+
+        double start = MPI_Wtime();
+
+        // Set MPICommunicator as modelpart's communicator
+        VariablesList* mVariables_List = &mrModelPart.GetNodalSolutionStepVariablesList();
+        mrModelPart.SetCommunicator(Communicator::Pointer(new MPICommunicator(mVariables_List)));
+
+        // Count the entities and distribute them evenly over the ranks
+        index_type numbers[3];
+        if (rank == 0)
+        {
+            size_type number_of_nodes, number_of_elements, number_of_conditions;
+            mrIO.ReadEntitiesNumbers(number_of_nodes, number_of_elements, number_of_conditions);
+            numbers[0] = number_of_nodes;
+            numbers[1] = number_of_elements;
+            numbers[2] = number_of_conditions;
+        }
+        MPI_Bcast(numbers, 3, MPI_UNSIGNED_LONG, 0, MPI_COMM_WORLD);
+
+        if (numbers[1] < static_cast<index_type>(number_of_processes))
+            KRATOS_THROW_ERROR(std::logic_error, "The number of elements is less than the number of processes:", numbers[1])
+
+        std::vector<index_type> node_dist, element_dist, condition_dist;
+        ComputeDistribution(numbers[0], number_of_processes, node_dist);
+        ComputeDistribution(numbers[1], number_of_processes, element_dist);
+        ComputeDistribution(numbers[2], number_of_processes, condition_dist);
+
+        // Read the rank-local chunks
+        std::vector<size_type> chunk_node_ids;
+        std::vector<double> chunk_node_coordinates;
+        mrIO.ReadNodesChunk(node_dist[rank], node_dist[rank+1], chunk_node_ids, chunk_node_coordinates);
+        for (size_type i = 0; i < chunk_node_ids.size(); ++i)
+            if (chunk_node_ids[i] != node_dist[rank] + i + 1)
+                KRATOS_THROW_ERROR(std::logic_error, "The distributed partitioning requires consecutive node ids starting from 1. Wrong node id", chunk_node_ids[i])
+
+        EntitiesChunk chunk_elements;
+        mrIO.ReadEntitiesChunk("Elements", element_dist[rank], element_dist[rank+1], chunk_elements);
+
+        EntitiesChunk chunk_conditions;
+        mrIO.ReadEntitiesChunk("Conditions", condition_dist[rank], condition_dist[rank+1], chunk_conditions);
+
+        // Partition the elements
+        std::vector<idx_t> element_partitions;
+        CallingParMetis(element_dist, chunk_elements, element_partitions);
+
+        // Collect the partitions of the home nodes, i.e. the nodes in the local chunk
+        std::vector<std::vector<int> > node_partitions;
+        ComputeNodePartitions(node_dist, chunk_elements, element_partitions, node_partitions);
+
+        // Send the elements to their partitions
+        EntitiesChunk local_elements;
+        RedistributeEntities(chunk_elements, element_partitions, local_elements);
+        chunk_elements = EntitiesChunk();
+
+        // Send each condition to the lowest partition containing all of its nodes
+        std::vector<idx_t> condition_partitions;
+        ComputeConditionPartitions(node_dist, node_partitions, chunk_conditions, condition_partitions);
+        EntitiesChunk local_conditions;
+        RedistributeEntities(chunk_conditions, condition_partitions, local_conditions);
+        chunk_conditions = EntitiesChunk();
+
+        // Collect the nodes required by the local entities, and the nodes which are not connected to any element
+        std::vector<index_type> local_node_ids(local_elements.Connectivities.begin(), local_elements.Connectivities.end());
+        local_node_ids.insert(local_node_ids.end(), local_conditions.Connectivities.begin(), local_conditions.Connectivities.end());
+        for (size_type i = 0; i < node_partitions.size(); ++i)
+            if (node_partitions[i].size() == 1 && node_partitions[i][0] == -1)
+            {
+                node_partitions[i][0] = rank;
+                local_node_ids.push_back(node_dist[rank] + i + 1);
+            }
+        std::sort(local_node_ids.begin(), local_node_ids.end());
+        local_node_ids.erase(std::unique(local_node_ids.begin(), local_node_ids.end()), local_node_ids.end());
+
+        std::vector<double> local_node_coordinates;
+        std::vector<std::vector<int> > local_node_partitions;
+        QueryNodes(node_dist, chunk_node_coordinates, node_partitions, local_node_ids, local_node_coordinates, local_node_partitions, true);
+        chunk_node_coordinates = std::vector<double>();
+        node_partitions = std::vector<std::vector<int> >();
+
+        // Create the nodes and set up the communicator
+        AddingNodes(local_node_ids, local_node_coordinates, local_node_partitions);
+
+        // Adding properties to modelpart
+        mrIO.ReadProperties(mrModelPart.rProperties());
+
+        // Adding elements and conditions to the partition
+        AddingElements(local_elements);
+        AddingConditions(local_conditions);
+
+        mrIO.ReadLocalInitialValues(mrModelPart.Nodes(), mrModelPart.Elements(), mrModelPart.Conditions());
+
+        double end = MPI_Wtime();
+        std::cout << rank << ": " << mrModelPart.NumberOfNodes() << " nodes (" << mrModelPart.GetCommunicator().LocalMesh().NumberOfNodes() << " local), "
+                  << mrModelPart.NumberOfElements() << " elements, " << mrModelPart.NumberOfConditions() << " conditions"
+                  << ", distributed partitioning completed in " << (end - start) << " s" << std::endl;
+
+        KRATOS_CATCH("")
+    }
+
+    ///@}
+    ///@name Access
+    ///@{
+
+
+    ///@}
+    ///@name Inquiry
+    ///@{
+
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+
+    virtual std::string Info() const
+    {
+        return "IsogeometricDistributedPartitioningProcess";
+    }
+
+    /// Print information about this object.
+
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "IsogeometricDistributedPartitioningProcess";
+    }
+
+    /// Print object's data.
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+
+    ///@}
+
+protected:
+    ///@name Protected member Variables
+    ///@{
+
+    ModelPart& mrModelPart;
+
+    IsogeometricModelPartIO& mrIO;
+
+    int mNumberOfCommonNodes;
+
+    double mImbalanceTolerance;
+
+    ///@}
+    ///@name Protected Operations
+    ///@{
+
+    /// Compute the block distribution [dist[r], dist[r+1]) of n items over the ranks
+    static void ComputeDistribution(index_type n, int number_of_processes, std::vector<index_type>& dist)
+    {
+        dist.resize(number_of_processes + 1);
+        for (int r = 0; r <= number_of_processes; ++r)
+            dist[r] = (n * r) / number_of_processes;
+    }
+
+    /// Get the rank holding the index (0-based) in the block distribution
+    static int HomeRank(const std::vector<index_type>& dist, index_type index)
+    {
+        return static_cast<int>(std::upper_bound(dist.begin(), dist.end(), index) - dist.begin()) - 1;
+    }
+
+    static MPI_Datatype DataType(const int& Dummy) {return MPI_INT;}
+    static MPI_Datatype DataType(const index_type& Dummy) {return MPI_UNSIGNED_LONG;}
+    static MPI_Datatype DataType(const double& Dummy) {return MPI_DOUBLE;}
+
+    /// Personalised all-to-all exchange. The received data from rank r are in rRecv[rRecvDispls[r], rRecvDispls[r+1]).
+    template<typename TDataType>
+    static void AllToAll(const std::vector<std::vector<TDataType> >& rSend, std::vector<TDataType>& rRecv, std::vector<int>& rRecvDispls)
+    {
+        int number_of_processes = rSend.size();
+        std::vector<int> send_counts(number_of_processes), send_displs(number_of_processes + 1);
+        std::vector<int> recv_counts(number_of_processes);
+        rRecvDispls.resize(number_of_processes + 1);
+
+        send_displs[0] = 0;
+        for (int r = 0; r < number_of_processes; ++r)
+        {
+            send_counts[r] = rSend[r].size();
+            send_displs[r+1] = send_displs[r] + send_counts[r];
+        }
+
+        MPI_Alltoall(&send_counts[0], 1, MPI_INT, &recv_counts[0], 1, MPI_INT, MPI_COMM_WORLD);
+
+        rRecvDispls[0] = 0;
+        for (int r = 0; r < number_of_processes; ++r)
+            rRecvDispls[r+1] = rRecvDispls[r] + recv_counts[r];
+
+        std::vector<TDataType> send_buffer(send_displs[number_of_processes]);
+        for (int r = 0; r < number_of_processes; ++r)
+            std::copy(rSend[r].begin(), rSend[r].end(), send_buffer.begin() + send_displs[r]);
+
+        rRecv.resize(rRecvDispls[number_of_processes]);
+        MPI_Alltoallv(send_buffer.data(), &send_counts[0], &send_displs[0], DataType(TDataType()),
+                      rRecv.data(), &recv_counts[0], &rRecvDispls[0], DataType(TDataType()), MPI_COMM_WORLD);
+    }
+
+    /// Make the list of entity names identical on all ranks
+    static void SynchronizeNames(const std::vector<std::string>& rLocalNames, std::vector<std::string>& rGlobalNames)
+    {
+        int number_of_processes;
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+        std::string local;
+        for (size_type i = 0; i < rLocalNames.size(); ++i)
+            local += rLocalNames[i] + "\n";
+
+        int local_size = local.size();
+        std::vector<int> sizes(number_of_processes), displs(number_of_processes + 1);
+        MPI_Allgather(&local_size, 1, MPI_INT, &sizes[0], 1, MPI_INT, MPI_COMM_WORLD);
+        displs[0] = 0;
+        for (int r = 0; r < number_of_processes; ++r)
+            displs[r+1] = displs[r] + sizes[r];
+
+        std::vector<char> global(displs[number_of_processes] + 1, '\0');
+        MPI_Allgatherv(const_cast<char*>(local.c_str()), local_size, MPI_CHAR, &global[0], &sizes[0], &displs[0], MPI_CHAR, MPI_COMM_WORLD);
+
+        rGlobalNames.clear();
+        std::stringstream ss;
+        ss << &global[0];
+        std::string name;
+        while (std::getline(ss, name))
+            if (!name.empty())
+                rGlobalNames.push_back(name);
+        std::sort(rGlobalNames.begin(), rGlobalNames.end());
+        rGlobalNames.erase(std::unique(rGlobalNames.begin(), rGlobalNames.end()), rGlobalNames.end());
+    }
+
+    void CallingParMetis(const std::vector<index_type>& rElementDist, const EntitiesChunk& rElements, std::vector<idx_t>& rPartitions)
+    {
+        int number_of_processes;
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+        std::vector<idx_t> elmdist(rElementDist.begin(), rElementDist.end());
+        std::vector<idx_t> eptr(rElements.Offsets.begin(), rElements.Offsets.end());
+        std::vector<idx_t> eind(rElements.Connectivities.size());
+        for (size_type i = 0; i < eind.size(); ++i)
+            eind[i] = rElements.Connectivities[i] - 1; //transform to zero-based indexing
+
+        idx_t wgtflag = 0;
+        idx_t numflag = 0;
+        idx_t ncon = 1;
+        idx_t ncommonnodes = mNumberOfCommonNodes;
+        idx_t nparts = number_of_processes;
+        std::vector<real_t> tpwgts(nparts, 1.0 / nparts);
+        real_t ubvec = mImbalanceTolerance;
+        idx_t options[3] = {0, 0, 0};
+        idx_t edgecut;
+        MPI_Comm comm = MPI_COMM_WORLD;
+
+        rPartitions.resize(rElements.Ids.size());
+        int status = ParMETIS_V3_PartMeshKway(&elmdist[0], &eptr[0], eind.data(), NULL, &wgtflag, &numflag,
+                                              &ncon, &ncommonnodes, &nparts, &tpwgts[0], &ubvec, options,
+                                              &edgecut, rPartitions.data(), &comm);
+        if (status != METIS_OK)
+            KRATOS_THROW_ERROR(std::runtime_error, "ParMETIS_V3_PartMeshKway failed with status", status)
+
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        if (rank == 0)
+            std::cout << "ParMETIS_V3_PartMeshKway completed, edgecut = " << edgecut << std::endl;
+    }
+
+    /// Compute the partitions of the elements containing each node in the local node chunk. The node without any element is marked by -1.
+    void ComputeNodePartitions(const std::vector<index_type>& rNodeDist, const EntitiesChunk& rElements,
+            const std::vector<idx_t>& rElementPartitions, std::vector<std::vector<int> >& rNodePartitions)
+    {
+        int rank, number_of_processes;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+        // send pairs of (node id, partition) to the home rank of the node
+        std::vector<std::vector<index_type> > send(number_of_processes);
+        for (size_type i = 0; i < rElements.Ids.size(); ++i)
+            for (size_type j = rElements.Offsets[i]; j < rElements.Offsets[i+1]; ++j)
+            {
+                index_type node_id = rElements.Connectivities[j];
+                int home = HomeRank(rNodeDist, node_id - 1);
+                send[home].push_back(node_id);
+                send[home].push_back(rElementPartitions[i]);
+            }
+
+        std::vector<index_type> recv;
+        std::vector<int> recv_displs;
+        AllToAll(send, recv, recv_displs);
+
+        rNodePartitions.clear();
+        rNodePartitions.resize(rNodeDist[rank+1] - rNodeDist[rank]);
+        for (size_type i = 0; i < recv.size(); i += 2)
+            rNodePartitions[recv[i] - 1 - rNodeDist[rank]].push_back(recv[i+1]);
+
+        for (size_type i = 0; i < rNodePartitions.size(); ++i)
+        {
+            std::vector<int>& parts = rNodePartitions[i];
+            std::sort(parts.begin(), parts.end());
+            parts.erase(std::unique(parts.begin(), parts.end()), parts.end());
+            if (parts.size() == 0)
+                parts.push_back(-1);
+        }
+    }
+
+    /// Query the partitions (and coordinates) of the given nodes from their home ranks
+    void QueryNodes(const std::vector<index_type>& rNodeDist, const std::vector<double>& rHomeCoordinates,
+            const std::vector<std::vector<int> >& rHomePartitions, const std::vector<index_type>& rNodeIds,
+            std::vector<double>& rCoordinates, std::vector<std::vector<int> >& rPartitions, bool with_coordinates)
+    {
+        int rank, number_of_processes;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+        // send the requests
+        std::vector<std::vector<index_type> > requests(number_of_processes);
+        for (size_type i = 0; i < rNodeIds.size(); ++i)
+            requests[HomeRank(rNodeDist, rNodeIds[i] - 1)].push_back(rNodeIds[i]);
+
+        std::vector<index_type> recv_requests;
+        std::vector<int> recv_displs;
+        AllToAll(requests, recv_requests, recv_displs);
+
+        // answer the requests, in the same order
+        std::vector<std::vector<index_type> > partitions(number_of_processes);
+        std::vector<std::vector<double> > coordinates(number_of_processes);
+        for (int r = 0; r < number_of_processes; ++r)
+            for (int i = recv_displs[r]; i < recv_displs[r+1]; ++i)
+            {
+                index_type local_index = recv_requests[i] - 1 - rNodeDist[rank];
+                const std::vector<int>& parts = rHomePartitions[local_index];
+                partitions[r].push_back(parts.size());
+                for (size_type j = 0; j < parts.size(); ++j)
+                    partitions[r].push_back(parts[j]);
+                if (with_coordinates)
+                    for (int k = 0; k < 3; ++k)
+                        coordinates[r].push_back(rHomeCoordinates[3*local_index + k]);
+            }
+
+        std::vector<index_type> recv_partitions;
+        std::vector<int> partition_displs;
+        AllToAll(partitions, recv_partitions, partition_displs);
+
+        std::vector<double> recv_coordinates;
+        std::vector<int> coordinate_displs;
+        if (with_coordinates)
+            AllToAll(coordinates, recv_coordinates, coordinate_displs);
+
+        // map the answers back to the requested nodes; the answers from each rank come in the order of the requests
+        std::vector<size_type> partition_position(partition_displs.begin(), partition_displs.end() - 1);
+        std::vector<size_type> coordinate_position;
+        if (with_coordinates)
+            coordinate_position.assign(coordinate_displs.begin(), coordinate_displs.end() - 1);
+
+        rPartitions.resize(rNodeIds.size());
+        if (with_coordinates)
+            rCoordinates.resize(3*rNodeIds.size());
+        for (size_type i = 0; i < rNodeIds.size(); ++i)
+        {
+            int home = HomeRank(rNodeDist, rNodeIds[i] - 1);
+            size_type& pos = partition_position[home];
+            size_type nparts = recv_partitions[pos++];
+            rPartitions[i].assign(recv_partitions.begin() + pos, recv_partitions.begin() + pos + nparts);
+            pos += nparts;
+            if (with_coordinates)
+            {
+                for (int k = 0; k < 3; ++k)
+                    rCoordinates[3*i + k] = recv_coordinates[coordinate_position[home] + k];
+                coordinate_position[home] += 3;
+            }
+        }
+    }
+
+    /// The condition is assigned to the lowest partition containing all of its nodes, or to the owner of its first node
+    void ComputeConditionPartitions(const std::vector<index_type>& rNodeDist, const std::vector<std::vector<int> >& rHomePartitions,
+            const EntitiesChunk& rConditions, std::vector<idx_t>& rPartitions)
+    {
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+        std::vector<index_type> node_ids(rConditions.Connectivities.begin(), rConditions.Connectivities.end());
+        std::sort(node_ids.begin(), node_ids.end());
+        node_ids.erase(std::unique(node_ids.begin(), node_ids.end()), node_ids.end());
+
+        std::vector<double> dummy;
+        std::vector<std::vector<int> > node_partitions;
+        QueryNodes(rNodeDist, dummy, rHomePartitions, node_ids, dummy, node_partitions, false);
+
+        rPartitions.resize(rConditions.Ids.size());
+        std::vector<int> common, tmp;
+        for (size_type i = 0; i < rConditions.Ids.size(); ++i)
+        {
+            size_type first = std::lower_bound(node_ids.begin(), node_ids.end(), rConditions.Connectivities[rConditions.Offsets[i]]) - node_ids.begin();
+            common = node_partitions[first];
+            for (size_type j = rConditions.Offsets[i] + 1; j < rConditions.Offsets[i+1]; ++j)
+            {
+                size_type k = std::lower_bound(node_ids.begin(), node_ids.end(), rConditions.Connectivities[j]) - node_ids.begin();
+                tmp.clear();
+                std::set_intersection(common.begin(), common.end(), node_partitions[k].begin(), node_partitions[k].end(), std::back_inserter(tmp));
+                common.swap(tmp);
+            }
+
+            if (common.size() != 0 && common[0] != -1)
+                rPartitions[i] = common[0];
+            else if (node_partitions[first][0] != -1)
+                rPartitions[i] = node_partitions[first][0];
+            else
+                rPartitions[i] = HomeRank(rNodeDist, rConditions.Connectivities[rConditions.Offsets[i]] - 1);
+        }
+    }
+
+    /// Send the entities to their partitions
+    void RedistributeEntities(const EntitiesChunk& rEntities, const std::vector<idx_t>& rPartitions, EntitiesChunk& rLocalEntities)
+    {
+        int number_of_processes;
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+        std::vector<std::string> names;
+        SynchronizeNames(rEntities.Names, names);
+        std::vector<index_type> name_map(rEntities.Names.size());
+        for (size_type i = 0; i < rEntities.Names.size(); ++i)
+            name_map[i] = std::find(names.begin(), names.end(), rEntities.Names[i]) - names.begin();
+
+        // pack as [id, properties id, name index, number of nodes, node ids...]
+        std::vector<std::vector<index_type> > send(number_of_processes);
+        for (size_type i = 0; i < rEntities.Ids.size(); ++i)
+        {
+            std::vector<index_type>& buffer = send[rPartitions[i]];
+            buffer.push_back(rEntities.Ids[i]);
+            buffer.push_back(rEntities.PropertiesIds[i]);
+            buffer.push_back(name_map[rEntities.NameIndices[i]]);
+            buffer.push_back(rEntities.Offsets[i+1] - rEntities.Offsets[i]);
+            buffer.insert(buffer.end(), rEntities.Connectivities.begin() + rEntities.Offsets[i], rEntities.Connectivities.begin() + rEntities.Offsets[i+1]);
+        }
+
+        std::vector<index_type> recv;
+        std::vector<int> recv_displs;
+        AllToAll(send, recv, recv_displs);
+
+        rLocalEntities = EntitiesChunk();
+        rLocalEntities.Names = names;
+        rLocalEntities.Offsets.push_back(0);
+        size_type pos = 0;
+        while (pos < recv.size())
+        {
+            rLocalEntities.Ids.push_back(recv[pos++]);
+            rLocalEntities.PropertiesIds.push_back(recv[pos++]);
+            rLocalEntities.NameIndices.push_back(recv[pos++]);
+            size_type number_of_nodes = recv[pos++];
+            rLocalEntities.Connectivities.insert(rLocalEntities.Connectivities.end(), recv.begin() + pos, recv.begin() + pos + number_of_nodes);
+            rLocalEntities.Offsets.push_back(rLocalEntities.Connectivities.size());
+            pos += number_of_nodes;
+        }
+    }
+
+    /// Create the local and ghost nodes and fill the communicator meshes
+    void AddingNodes(const std::vector<index_type>& rNodeIds, const std::vector<double>& rCoordinates,
+            const std::vector<std::vector<int> >& rPartitions)
+    {
+        int rank, number_of_processes;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+        MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+        Communicator& r_communicator = mrModelPart.GetCommunicator();
+
+        // The owner is the lowest partition of the node
+        // Build the domains graph: an edge connects the owner and each other partition sharing the node
+        graph_type domains_graph = boost::numeric::ublas::zero_matrix<int>(number_of_processes, number_of_processes);
+        for (size_type i = 0; i < rNodeIds.size(); ++i)
+        {
+            int owner = rPartitions[i][0];
+            if (owner != rank)
+                domains_graph(rank, owner) = domains_graph(owner, rank) = 1;
+            else
+                for (size_type j = 1; j < rPartitions[i].size(); ++j)
+                    domains_graph(rank, rPartitions[i][j]) = domains_graph(rPartitions[i][j], rank) = 1;
+        }
+        MPI_Allreduce(MPI_IN_PLACE, &(domains_graph.data()[0]), number_of_processes*number_of_processes, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+        // All ranks color the same graph
+        graph_type domains_colored_graph;
+        int colors_number;
+        GraphColoringProcess(number_of_processes, domains_graph, domains_colored_graph, colors_number).Execute();
+
+        // Adding interface meshes
+        mrModelPart.GetMeshes().push_back(ModelPart::MeshType());
+
+        Communicator::NeighbourIndicesContainerType& neighbours_indices = r_communicator.NeighbourIndices();
+        if(neighbours_indices.size() != static_cast<unsigned int>(colors_number))
+            neighbours_indices.resize(colors_number, false);
+        for (int i = 0; i < colors_number; ++i)
+            neighbours_indices[i] = domains_colored_graph(rank, i);
+        r_communicator.SetNumberOfColors(colors_number);
+
+        // Adding local, ghost and interface meshes to ModelPart if is necessary
+        int number_of_meshes = ModelPart::Kratos_Ownership_Size + colors_number; // (all + local + ghost) + (colors_number for interfaces)
+        if (mrModelPart.GetMeshes().size() < static_cast<unsigned int>(number_of_meshes))
+            for (int i = mrModelPart.GetMeshes().size(); i < number_of_meshes; ++i)
+                mrModelPart.GetMeshes().push_back(ModelPart::MeshType());
+
+        std::vector<int> interface_indices(number_of_processes, -1);
+        for (size_type i = 0; i < neighbours_indices.size(); i++)
+            if ((neighbours_indices[i] >= 0) && (neighbours_indices[i] < number_of_processes))
+                interface_indices[neighbours_indices[i]] = i;
+
+        for (size_type i = 0; i < rNodeIds.size(); ++i)
+        {
+            ModelPart::NodeType::Pointer p_node = mrModelPart.CreateNewNode(rNodeIds[i], rCoordinates[3*i], rCoordinates[3*i+1], rCoordinates[3*i+2]);
+
+            int owner = rPartitions[i][0];
+            p_node->GetSolutionStepValue(PARTITION_INDEX) = owner;
+
+            if (owner == rank)
+            {
+                r_communicator.LocalMesh().Nodes().push_back(p_node);
+                for (size_type j = 1; j < rPartitions[i].size(); ++j)
+                {
+                    int mesh_index = interface_indices[rPartitions[i][j]];
+                    if (mesh_index < 0)
+                        KRATOS_THROW_ERROR(std::logic_error, "Cannot find the neighbour domain : ", rPartitions[i][j])
+                    r_communicator.LocalMesh(mesh_index).Nodes().push_back(p_node);
+                    r_communicator.InterfaceMesh(mesh_index).Nodes().push_back(p_node);
+                    r_communicator.InterfaceMesh().Nodes().push_back(p_node);
+                }
+            }
+            else
+            {
+                int mesh_index = interface_indices[owner];
+                if (mesh_index < 0)
+                    KRATOS_THROW_ERROR(std::logic_error, "Cannot find the neighbour domain : ", owner)
+                r_communicator.GhostMesh().Nodes().push_back(p_node);
+                r_communicator.GhostMesh(mesh_index).Nodes().push_back(p_node);
+                r_communicator.InterfaceMesh(mesh_index).Nodes().push_back(p_node);
+                r_communicator.InterfaceMesh().Nodes().push_back(p_node);
+            }
+        }
+
+        // After making push_back to the nodes list now we need to make unique and sort for all meshes in communicator
+        mrModelPart.Nodes().Unique();
+        r_communicator.LocalMesh().Nodes().Unique();
+        r_communicator.GhostMesh().Nodes().Unique();
+        r_communicator.InterfaceMesh().Nodes().Unique();
+        for (size_type i = 0; i < r_communicator.LocalMeshes().size(); i++)
+            r_communicator.LocalMesh(i).Nodes().Unique();
+        for (size_type i = 0; i < r_communicator.GhostMeshes().size(); i++)
+            r_communicator.GhostMesh(i).Nodes().Unique();
+        for (size_type i = 0; i < r_communicator.InterfaceMeshes().size(); i++)
+            r_communicator.InterfaceMesh(i).Nodes().Unique();
+    }
+
+    void AddingElements(const EntitiesChunk& rElements)
+    {
+        Element::NodesArrayType temp_element_nodes;
+        for (size_type i = 0; i < rElements.Ids.size(); ++i)
+        {
+            const std::string& element_name = rElements.Names[rElements.NameIndices[i]];
+            if(!KratosComponents<Element>::Has(element_name))
+                KRATOS_THROW_ERROR(std::invalid_argument, "Element is not registered in Kratos:", element_name)
+            Element const& r_clone_element = KratosComponents<Element>::Get(element_name);
+
+            temp_element_nodes.clear();
+            for (size_type j = rElements.Offsets[i]; j < rElements.Offsets[i+1]; ++j)
+                temp_element_nodes.push_back(mrModelPart.pGetNode(rElements.Connectivities[j]));
+
+            Element::Pointer p_element = r_clone_element.Create(rElements.Ids[i], temp_element_nodes, mrModelPart.pGetProperties(rElements.PropertiesIds[i]));
+            mrModelPart.AddElement(p_element);
+            mrModelPart.GetCommunicator().LocalMesh().AddElement(p_element);
+        }
+    }
+
+    void AddingConditions(const EntitiesChunk& rConditions)
+    {
+        Condition::NodesArrayType temp_condition_nodes;
+        for (size_type i = 0; i < rConditions.Ids.size(); ++i)
+        {
+            const std::string& condition_name = rConditions.Names[rConditions.NameIndices[i]];
+            if(!KratosComponents<Condition>::Has(condition_name))
+                KRATOS_THROW_ERROR(std::invalid_argument, "Condition is not registered in Kratos:", condition_name)
+            Condition const& r_clone_condition = KratosComponents<Condition>::Get(condition_name);
+
+            temp_condition_nodes.clear();
+            for (size_type j = rConditions.Offsets[i]; j < rConditions.Offsets[i+1]; ++j)
+                temp_condition_nodes.push_back(mrModelPart.pGetNode(rConditions.Connectivities[j]));
+
+            Condition::Pointer p_condition = r_clone_condition.Create(rConditions.Ids[i], temp_condition_nodes, mrModelPart.pGetProperties(rConditions.PropertiesIds[i]));
+            mrModelPart.AddCondition(p_condition);
+            mrModelPart.GetCommunicator().LocalMesh().AddCondition(p_condition);
+        }
+    }
+
+    ///@}
+
+private:
+
+    /// Assignment operator.
+    IsogeometricDistributedPartitioningProcess & operator=(IsogeometricDistributedPartitioningProcess const& rOther);
+
+    /// Copy constructor.
+    IsogeometricDistributedPartitioningProcess(IsogeometricDistributedPartitioningProcess const& rOther);
+
+}; // Class IsogeometricDistributedPartitioningProcess
+
+///@}
+
+///@name Input and output
+///@{
+
+/// output stream function
+inline std::ostream & operator <<(std::ostream& rOStream,
+                                  const IsogeometricDistributedPartitioningProcess& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+
+    return rOStream;
+}
+///@}
+
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_DISTRIBUTED_PARTITIONING_PROCESS_INCLUDED defined
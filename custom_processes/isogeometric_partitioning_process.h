@@ -142,6 +142,7 @@ public:
     /// Copy constructor.
     IsogeometricPartitioningProcess(IsogeometricPartitioningProcess const& rOther)
         : mrModelPart(rOther.mrModelPart), mrIO(rOther.mrIO), mNumberOfPartitions(rOther.mNumberOfPartitions)
+        , mElementWeights(rOther.mElementWeights), mElementPartitions(rOther.mElementPartitions)
     {
         KRATOS_TRY
         int rank;
@@ -173,6 +174,20 @@ public:
     ///@name Operations
     ///@{
 
+    /// Set the weights of the elements, in the order of the elements in the input. They are given to METIS as the vertex weights.
+    /// For a multipatch, the weights are provided by MultiPatchPartitioner::GetElementWeights.
+    void SetElementWeights(const std::vector<int>& rWeights)
+    {
+        mElementWeights.assign(rWeights.begin(), rWeights.end());
+    }
+
+    /// Set the partitions of the elements, in the order of the elements in the input. METIS is then not called.
+    /// For a multipatch, the partitions are provided by MultiPatchPartitioner::GetElementPartitions.
+    void SetElementPartitions(const std::vector<int>& rPartitions)
+    {
+        mElementPartitions.assign(rPartitions.begin(), rPartitions.end());
+    }
+
     virtual void Execute()
     {
         KRATOS_TRY;
@@ -223,7 +238,10 @@ public:
         int colors_number;
         if (rank == 0)
         {
-            CallingMetis(number_of_nodes, number_of_elements, elements_connectivities, npart, epart);
+            if (mElementPartitions.size() != 0)
+                AssignPartitions(number_of_nodes, number_of_elements, elements_connectivities, npart, epart);
+            else
+                CallingMetis(number_of_nodes, number_of_elements, elements_connectivities, npart, epart);
             CalculateDomainsGraph(domains_graph, number_of_elements, elements_connectivities, npart, epart);
             GraphColoringProcess(mNumberOfPartitions, domains_graph, domains_colored_graph, colors_number).Execute();
             KRATOS_WATCH(colors_number);
@@ -381,6 +399,10 @@ protected:
 
     size_type mNumberOfPartitions;
 
+    std::vector<idx_t> mElementWeights;
+
+    std::vector<idx_t> mElementPartitions;
+
     std::ofstream mLogFile;
 
     size_type mDimension;
@@ -446,8 +468,15 @@ protected:
         idx_t edgecut;
         idx_t ncommon = 4;
         idx_t nparts = mNumberOfPartitions;
+        idx_t* vwgt = NULL;
+        if (mElementWeights.size() != 0)
+        {
+            if (mElementWeights.size() != static_cast<size_type>(ne))
+                KRATOS_THROW_ERROR(std::logic_error, "The number of element weights is not equal to the number of elements:", mElementWeights.size())
+            vwgt = &mElementWeights[0];
+        }
         status = METIS_PartMeshDual(&ne, &nn, eptr, eind, 
-                                    NULL, NULL, &ncommon, &nparts, 
+                                    vwgt, NULL, &ncommon, &nparts, 
                                     NULL, NULL, &edgecut, EPart, NPart);
 
         // release memory
@@ -455,6 +484,39 @@ protected:
         delete [] eind;
     }
 
+    /// Use the given element partitions; each node is assigned to the lowest partition of the elements containing it
+    void AssignPartitions(size_type NumberOfNodes, size_type NumberOfElements, IO::ConnectivitiesContainerType& ElementsConnectivities, idx_t* NPart, idx_t* EPart)
+    {
+        int rank;
+        MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+        mLogFile << rank << ": Assigning the given element partitions" << std::endl;
+
+        if (mElementPartitions.size() != NumberOfElements)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of element partitions is not equal to the number of elements:", mElementPartitions.size())
+
+        for (size_type i = 0; i < NumberOfNodes; ++i)
+            NPart[i] = -1;
+
+        for (size_type i = 0; i < NumberOfElements; ++i)
+        {
+            if (mElementPartitions[i] < 0 || mElementPartitions[i] >= static_cast<idx_t>(mNumberOfPartitions))
+                KRATOS_THROW_ERROR(std::logic_error, "Invalid partition of element", i + 1)
+
+            EPart[i] = mElementPartitions[i];
+            for (unsigned int j = 0; j < ElementsConnectivities[i].size(); ++j)
+            {
+                idx_t& node_part = NPart[ElementsConnectivities[i][j] - 1];
+                if (node_part == -1 || EPart[i] < node_part)
+                    node_part = EPart[i];
+            }
+        }
+
+        for (size_type i = 0; i < NumberOfNodes; ++i)
+            if (NPart[i] == -1)
+                NPart[i] = 0;
+    }
+
     void AddingNodes(ModelPart::NodesContainerType& AllNodes, size_type NumberOfElements, IO::ConnectivitiesContainerType& ElementsConnectivities, idx_t* NPart, idx_t* EPart)
     {
         int rank;
@@ -27,6 +27,7 @@ LICENSE: see isogeometric_application/LICENSE.txt
 
 #ifdef ISOGEOMETRIC_USE_PARMETIS
 #include "custom_processes/isogeometric_partitioning_process.h"
+#include "custom_processes/isogeometric_distributed_partitioning_process.h"
 #endif
 
 namespace Kratos
@@ -35,6 +36,26 @@ namespace Kratos
 namespace Python
 {
 
+#ifdef ISOGEOMETRIC_USE_PARMETIS
+template<class TProcessType>
+void IsogeometricPartitioningProcess_SetElementWeights(TProcessType& rDummy, boost::python::list& rWeights)
+{
+    std::vector<int> weights;
+    for (std::size_t i = 0; i < boost::python::len(rWeights); ++i)
+        weights.push_back(boost::python::extract<int>(rWeights[i]));
+    rDummy.SetElementWeights(weights);
+}
+
+template<class TProcessType>
+void IsogeometricPartitioningProcess_SetElementPartitions(TProcessType& rDummy, boost::python::list& rPartitions)
+{
+    std::vector<int> partitions;
+    for (std::size_t i = 0; i < boost::python::len(rPartitions); ++i)
+        partitions.push_back(boost::python::extract<int>(rPartitions[i]));
+    rDummy.SetElementPartitions(partitions);
+}
+#endif
+
 void IsogeometricApplication_AddProcessesToPython()
 {
     using namespace boost::python;
@@ -42,6 +63,14 @@ void IsogeometricApplication_AddProcessesToPython()
     #ifdef ISOGEOMETRIC_USE_PARMETIS
     class_<IsogeometricPartitioningProcess, bases<Process> >
     ("IsogeometricPartitioningProcess", init<ModelPart&, IO&, unsigned int>())
+    .def("SetElementWeights", &IsogeometricPartitioningProcess_SetElementWeights<IsogeometricPartitioningProcess>)
+    .def("SetElementPartitions", &IsogeometricPartitioningProcess_SetElementPartitions<IsogeometricPartitioningProcess>)
+    ;
+
+    class_<IsogeometricDistributedPartitioningProcess, bases<Process>, boost::noncopyable>
+    ("IsogeometricDistributedPartitioningProcess", init<ModelPart&, IsogeometricModelPartIO&>())
+    .def(init<ModelPart&, IsogeometricModelPartIO&, int>())
+    .def("SetImbalanceTolerance", &IsogeometricDistributedPartitioningProcess::SetImbalanceTolerance)
     ;
     #endif
 }
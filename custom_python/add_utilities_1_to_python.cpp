@@ -27,9 +27,11 @@ LICENSE: see isogeometric_application/LICENSE.txt
 #include "custom_utilities/nurbs_test_utils.h"
 #include "custom_utilities/bezier_test_utils.h"
 #include "custom_utilities/isogeometric_merge_utility.h"
+#include "custom_utilities/isogeometric_profiler.h"
 
 #ifdef ISOGEOMETRIC_USE_HDF5
 #include "custom_utilities/hdf5_post_utility.h"
+#include "custom_utilities/hdf5_time_series_post_utility.h"
 #endif
 
 #ifdef ISOGEOMETRIC_USE_GISMO
@@ -216,6 +218,21 @@ void BezierClassicalPostUtility_GenerateModelPart2(BezierClassicalPostUtility& d
     dummy.GenerateModelPart2(pModelPartPost, generate_for_condition);
 }
 
+void IsogeometricProfiler_PrintSummary()
+{
+    IsogeometricProfiler::PrintSummary(std::cout);
+}
+
+void IsogeometricProfiler_AddTime(const std::string& Name, const double& Time)
+{
+    IsogeometricProfiler::AddTime(IsogeometricProfiler::Intern(Name), Time);
+}
+
+void IsogeometricProfiler_AddCount(const std::string& Name, const long& Increment)
+{
+    IsogeometricProfiler::AddCount(IsogeometricProfiler::Intern(Name), Increment);
+}
+
 void IsogeometricApplication_AddCustomUtilities1ToPython()
 {
     enum_<PostElementType>("PostElementType")
@@ -225,6 +242,19 @@ void IsogeometricApplication_AddCustomUtilities1ToPython()
     .value("Hexahedra", _HEXAHEDRA_)
     ;
 
+    class_<IsogeometricProfiler, boost::noncopyable>("IsogeometricProfiler", no_init)
+    .def("Enable", &IsogeometricProfiler::Enable).staticmethod("Enable")
+    .def("Disable", &IsogeometricProfiler::Disable).staticmethod("Disable")
+    .def("IsEnabled", &IsogeometricProfiler::IsEnabled).staticmethod("IsEnabled")
+    .def("SetEcho", &IsogeometricProfiler::SetEcho).staticmethod("SetEcho")
+    .def("Reset", &IsogeometricProfiler::Reset).staticmethod("Reset")
+    .def("AddTime", &IsogeometricProfiler_AddTime).staticmethod("AddTime")
+    .def("AddCount", &IsogeometricProfiler_AddCount).staticmethod("AddCount")
+    .def("PrintSummary", &IsogeometricProfiler_PrintSummary).staticmethod("PrintSummary")
+    .def("WriteJSON", &IsogeometricProfiler::WriteJSON).staticmethod("WriteJSON")
+    .def("WriteCSV", &IsogeometricProfiler::WriteCSV).staticmethod("WriteCSV")
+    ;
+
     class_<BSplineUtils, BSplineUtils::Pointer, boost::noncopyable>("BSplineUtils", init<>())
     .def("FindSpan", BSplineUtils_FindSpan)
     .def("BasisFuns", BSplineUtils_BasisFuns)
@@ -283,6 +313,23 @@ void IsogeometricApplication_AddCustomUtilities1ToPython()
     .def("ReadNodalResults", &HDF5PostUtility::ReadNodalResults<Vector>)
     .def("ReadElementalData", &HDF5PostUtility::ReadElementalData<bool>)
     ;
+
+    class_<HDF5TimeSeriesPostUtility, HDF5TimeSeriesPostUtility::Pointer, boost::noncopyable>("HDF5TimeSeriesPostUtility", init<const std::string>())
+    .def(init<const std::string, const std::string>())
+    .def("SetChunkSize", &HDF5TimeSeriesPostUtility::SetChunkSize)
+    .def("SetCompressionLevel", &HDF5TimeSeriesPostUtility::SetCompressionLevel)
+    .def("SetShuffle", &HDF5TimeSeriesPostUtility::SetShuffle)
+    .def("WriteMesh", &HDF5TimeSeriesPostUtility::WriteMesh)
+    .def("BeginStep", &HDF5TimeSeriesPostUtility::BeginStep)
+    .def("NumberOfSteps", &HDF5TimeSeriesPostUtility::NumberOfSteps)
+    .def("WriteNodalResults", &HDF5TimeSeriesPostUtility::WriteNodalResults<Variable<double> >)
+    .def("WriteNodalResults", &HDF5TimeSeriesPostUtility::WriteNodalResults<Variable<array_1d<double, 3> > >)
+    .def("WriteNodalResults", &HDF5TimeSeriesPostUtility::WriteNodalResults<Variable<Vector> >)
+    .def("ReadNodalResults", &HDF5TimeSeriesPostUtility::ReadNodalResults<Variable<double> >)
+    .def("ReadNodalResults", &HDF5TimeSeriesPostUtility::ReadNodalResults<Variable<array_1d<double, 3> > >)
+    .def("ReadNodalResults", &HDF5TimeSeriesPostUtility::ReadNodalResults<Variable<Vector> >)
+    .def(self_ns::str(self))
+    ;
     #endif
 
     class_<NURBSTestUtils, NURBSTestUtils::Pointer, boost::noncopyable>("NURBSTestUtils", init<>())
@@ -303,6 +350,8 @@ void IsogeometricApplication_AddCustomUtilities1ToPython()
     class_<IsogeometricMergeUtility, IsogeometricMergeUtility::Pointer, boost::noncopyable>(
         "IsogeometricMergeUtility", init<>())
     .def("Add", &IsogeometricMergeUtility::Add)
+    .def("SetTolerance", &IsogeometricMergeUtility::SetTolerance)
+    .def("GetTolerance", &IsogeometricMergeUtility::GetTolerance)
     .def("Export", &IsogeometricMergeUtility::Export)
     .def("DumpNodalVariablesList", &IsogeometricMergeUtility::DumpNodalVariablesList)
     ;
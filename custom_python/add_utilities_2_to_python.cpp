@@ -19,6 +19,7 @@ LICENSE: see isogeometric_application/LICENSE.txt
 #include <boost/python.hpp>
 #include <boost/python/stl_iterator.hpp>
 #include <boost/python/operators.hpp>
+#include <omp.h>
 
 // Project includes
 #include "includes/define.h"
@@ -26,11 +27,13 @@ LICENSE: see isogeometric_application/LICENSE.txt
 #include "includes/variables.h"
 #include "python/pointer_vector_set_python_interface.h"
 #include "custom_python/add_utilities_to_python.h"
+#include "custom_python/python_buffer_view.h"
 #include "custom_utilities/nurbs/domain_manager.h"
 #include "custom_utilities/nurbs/domain_manager_2d.h"
 #include "custom_utilities/trans/transformation.h"
 #include "custom_utilities/trans/translation.h"
 #include "custom_utilities/trans/rotation.h"
+#include "custom_utilities/trans/batched_transformation.h"
 #include "custom_utilities/control_point.h"
 #include "custom_utilities/control_grid.h"
 #include "custom_utilities/unstructured_control_grid.h"
@@ -48,6 +51,8 @@ LICENSE: see isogeometric_application/LICENSE.txt
 #include "custom_utilities/import_export/multi_nurbs_patch_geo_importer.h"
 #include "custom_utilities/import_export/multi_nurbs_patch_matlab_exporter.h"
 #include "custom_utilities/import_export/multi_nurbs_patch_glvis_exporter.h"
+#include "custom_utilities/import_export/multi_nurbs_patch_control_value_io.h"
+#include "custom_utilities/import_export/multi_nurbs_patch_snapshot_io.h"
 
 
 namespace Kratos
@@ -119,6 +124,112 @@ void ControlGrid_SetItem(ControlGrid<TDataType>& rDummy, int index, const TDataT
     rDummy.SetData(index, value);
 }
 
+/// Memory layout of the control values, used for the buffer views of the control grid
+template<typename TDataType>
+struct ControlValueLayout_Helper
+{
+};
+
+template<>
+struct ControlValueLayout_Helper<double>
+{
+    static std::size_t NumberOfComponents() {return 1;}
+    static double* Begin(double& rValue) {return &rValue;}
+};
+
+template<>
+struct ControlValueLayout_Helper<array_1d<double, 3> >
+{
+    static std::size_t NumberOfComponents() {return 3;}
+    static double* Begin(array_1d<double, 3>& rValue) {return &rValue[0];}
+};
+
+template<>
+struct ControlValueLayout_Helper<ControlPoint<double> >
+{
+    static std::size_t NumberOfComponents() {return 4;}
+    static double* Begin(ControlPoint<double>& rValue) {return &rValue.WX();}
+};
+
+/// Get the pointer to the contiguous storage of the control grid
+template<typename TDataType>
+TDataType* ControlGrid_pData(ControlGrid<TDataType>& rDummy)
+{
+    if (BaseStructuredControlGrid<TDataType>* pGrid = dynamic_cast<BaseStructuredControlGrid<TDataType>*>(&rDummy))
+        return (pGrid->size() == 0) ? NULL : &(pGrid->Data()[0]);
+
+    if (UnstructuredControlGrid<TDataType>* pGrid = dynamic_cast<UnstructuredControlGrid<TDataType>*>(&rDummy))
+        return (pGrid->size() == 0) ? NULL : &((*pGrid)[0]);
+
+    KRATOS_THROW_ERROR(std::logic_error, "The control values are not stored contiguously in", rDummy.Name())
+    return NULL;
+}
+
+/// Zero-copy view of the control values, of size n (double) or n x ncomp (array_1d: x, y, z; control point: wx, wy, wz, w)
+/// The view is not valid anymore after the control grid is resized.
+template<typename TDataType>
+PythonBufferView::Pointer ControlGrid_Buffer(typename ControlGrid<TDataType>::Pointer pDummy)
+{
+    typedef ControlValueLayout_Helper<TDataType> LayoutType;
+    std::size_t ncomp = (LayoutType::NumberOfComponents() == 1) ? 0 : LayoutType::NumberOfComponents();
+
+    TDataType* pData = ControlGrid_pData(*pDummy);
+    if (pData == NULL)
+        return PythonBufferView::Create(0, ncomp);
+
+    return PythonBufferView::Pointer(new PythonBufferView(pDummy, LayoutType::Begin(pData[0]), pDummy->size(), ncomp, sizeof(TDataType), false));
+}
+
+/// Zero-copy view of the weights of the control points. Note that the control points are stored in homogeneous coordinates,
+/// hence changing the weights only also changes the physical coordinates.
+PythonBufferView::Pointer ControlPointGrid_WeightBuffer(ControlGrid<ControlPoint<double> >::Pointer pDummy)
+{
+    ControlPoint<double>* pData = ControlGrid_pData(*pDummy);
+    if (pData == NULL)
+        return PythonBufferView::Create(0, 0);
+
+    return PythonBufferView::Pointer(new PythonBufferView(pDummy, &(pData[0].W()), pDummy->size(), 0, sizeof(ControlPoint<double>), false));
+}
+
+/// Get the physical coordinates of the control points as an array of size n x 3
+PythonBufferView::Pointer ControlPointGrid_GetCoordinates(ControlGrid<ControlPoint<double> >& rDummy)
+{
+    PythonBufferView::Pointer pValues = PythonBufferView::Create(rDummy.size(), 3);
+    PythonBufferView& rValues = *pValues;
+    for (std::size_t i = 0; i < rDummy.size(); ++i)
+    {
+        const ControlPoint<double>& rPoint = rDummy.GetData(i);
+        rValues(i, 0) = rPoint.X();
+        rValues(i, 1) = rPoint.Y();
+        rValues(i, 2) = rPoint.Z();
+    }
+    return pValues;
+}
+
+/// Set the physical coordinates of the control points from an array of size n x 3. The weights are kept.
+void ControlPointGrid_SetCoordinates(ControlGrid<ControlPoint<double> >& rDummy, boost::python::object values)
+{
+    Py_buffer view;
+    PythonBufferView::GetInputBuffer(values.ptr(), &view, 3);
+    const double* v = static_cast<const double*>(view.buf);
+    std::size_t n = static_cast<std::size_t>(view.len / view.itemsize) / 3;
+
+    if (n != rDummy.size())
+    {
+        PyBuffer_Release(&view);
+        KRATOS_THROW_ERROR(std::invalid_argument, "The number of coordinates is not the same as the size of the control grid", "")
+    }
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        ControlPoint<double> point = rDummy.GetData(i);
+        point.SetCoordinates(v[3*i], v[3*i+1], v[3*i+2], point.W());
+        rDummy.SetData(i, point);
+    }
+
+    PyBuffer_Release(&view);
+}
+
 template<typename TDataType>
 struct ControlValue_Helper
 {
@@ -574,6 +685,94 @@ TDataType GridFunction_GetValue(GridFunction<TDim, TDataType>& rDummy, const boo
     return rDummy.GetValue(xi_vec);
 }
 
+/// Helper to store the value of the grid function in a row of the output array
+template<typename TDataType>
+struct GridFunctionValue_Helper
+{
+};
+
+template<>
+struct GridFunctionValue_Helper<double>
+{
+    static std::size_t NumberOfComponents() {return 1;}
+    static void Assign(const double& rValue, PythonBufferView& rValues, const std::size_t& i)
+    {
+        rValues(i, 0) = rValue;
+    }
+};
+
+template<>
+struct GridFunctionValue_Helper<array_1d<double, 3> >
+{
+    static std::size_t NumberOfComponents() {return 3;}
+    static void Assign(const array_1d<double, 3>& rValue, PythonBufferView& rValues, const std::size_t& i)
+    {
+        rValues(i, 0) = rValue[0];
+        rValues(i, 1) = rValue[1];
+        rValues(i, 2) = rValue[2];
+    }
+};
+
+template<>
+struct GridFunctionValue_Helper<ControlPoint<double> >
+{
+    static std::size_t NumberOfComponents() {return 3;}
+    static void Assign(const ControlPoint<double>& rValue, PythonBufferView& rValues, const std::size_t& i)
+    {
+        rValues(i, 0) = rValue.X();
+        rValues(i, 1) = rValue.Y();
+        rValues(i, 2) = rValue.Z();
+    }
+};
+
+/// Evaluate the grid function at an array of local coordinates of size npoints x TDim.
+/// The result is of size npoints (double) or npoints x 3 (array_1d, and physical coordinates for control points).
+template<int TDim, typename TDataType>
+PythonBufferView::Pointer GridFunction_GetValues(GridFunction<TDim, TDataType>& rDummy, boost::python::object xi)
+{
+    typedef GridFunctionValue_Helper<TDataType> HelperType;
+
+    Py_buffer view;
+    PythonBufferView::GetInputBuffer(xi.ptr(), &view, TDim);
+    const double* pxi = static_cast<const double*>(view.buf);
+    int npoints = static_cast<int>(view.len / view.itemsize) / TDim;
+
+    std::size_t ncomp = (HelperType::NumberOfComponents() == 1) ? 0 : HelperType::NumberOfComponents();
+    PythonBufferView::Pointer pValues = PythonBufferView::Create(npoints, ncomp);
+    PythonBufferView& rValues = *pValues;
+
+    bool error = false;
+    std::string error_message;
+
+    // the evaluation is read-only after the search maps are created
+    rDummy.pFESpace()->UpdateSearchMaps();
+
+    #pragma omp parallel for
+    for (int i = 0; i < npoints; ++i)
+    {
+        std::vector<double> xi_vec(pxi + i*TDim, pxi + (i+1)*TDim);
+        try
+        {
+            HelperType::Assign(rDummy.GetValue(xi_vec), rValues, i);
+        }
+        catch (std::exception& e)
+        {
+            #pragma omp critical
+            {
+                error = true;
+                error_message = e.what();
+            }
+        }
+    }
+
+    PyBuffer_Release(&view);
+
+    if (error)
+        KRATOS_THROW_ERROR(std::runtime_error, "Error evaluating the grid function:", error_message)
+
+    return pValues;
+}
+
 ////////////////////////////////////////
 
 
@@ -613,6 +812,20 @@ typename GridFunction<TDim, typename TVariableType::Type>::Pointer Patch_GridFun
     return rDummy.template pGetGridFunction<TVariableType>(rVariable);
 }
 
+/// Transformation of the control points of the patch or multipatch
+template<class TPatchType, class TTransformationType>
+void Patch_ApplyTransformation(TPatchType& rDummy, const TTransformationType& trans)
+{
+    rDummy.ApplyTransformation(BatchedTransformation<double>(trans));
+}
+
+/// Transformation of the array_1d or Vector grid function of the patch or multipatch
+template<class TPatchType, class TTransformationType, class TVariableType>
+void Patch_ApplyTransformationToGridFunction(TPatchType& rDummy, const TTransformationType& trans, const TVariableType& rVariable)
+{
+    rDummy.ApplyTransformation(BatchedTransformation<double>(trans), rVariable);
+}
+
 template<class TMultiPatchType>
 typename TMultiPatchType::PatchContainerType MultiPatch_GetPatches(TMultiPatchType& rDummy)
 {
@@ -747,6 +960,78 @@ void MultiPatchExporter_Export(TExporter& rDummy,
     rDummy.template Export<TDim>(pPatch, filename);
 }
 
+template<int TDim>
+void MultiNURBSPatchControlValueWriter_Export(MultiNURBSPatchControlValueWriter<TDim>& rDummy,
+        typename MultiPatch<TDim>::Pointer pMultiPatch, const std::string& filename)
+{
+    rDummy.Export(pMultiPatch, filename);
+}
+
+template<int TDim, class TPatchType>
+void MultiNURBSPatchSnapshotWriter_Export(MultiNURBSPatchSnapshotWriter<TDim>& rDummy,
+        typename TPatchType::Pointer pPatch, const std::string& filename)
+{
+    rDummy.Export(pPatch, filename);
+}
+
+template<int TDim, class TVariableType>
+void MultiNURBSPatchControlValueWriter_AddVariable(MultiNURBSPatchControlValueWriter<TDim>& rDummy,
+        const TVariableType& rVariable)
+{
+    rDummy.AddVariable(rVariable);
+}
+
+template<int TDim>
+boost::python::list MultiNURBSPatchControlValueReader_Times(MultiNURBSPatchControlValueReader<TDim>& rDummy,
+        const std::string& filename)
+{
+    std::vector<double> times = rDummy.Times(filename);
+    boost::python::list output;
+    for (std::size_t i = 0; i < times.size(); ++i)
+        output.append(times[i]);
+    return output;
+}
+
+template<int TDim>
+std::vector<std::size_t> MultiNURBSPatchControlValueReader_ExtractDivisions(boost::python::list divisions)
+{
+    std::vector<std::size_t> divs;
+    typedef boost::python::stl_input_iterator<int> iterator_value_type;
+    BOOST_FOREACH(const iterator_value_type::value_type& v,
+                std::make_pair(iterator_value_type(divisions), // begin
+                iterator_value_type() ) ) // end
+    {
+        divs.push_back(static_cast<std::size_t>(v));
+    }
+    if (divs.size() < TDim)
+        KRATOS_THROW_ERROR(std::logic_error, "The number of divisions must be given for each dimension", "")
+    return divs;
+}
+
+template<int TDim>
+boost::python::list MultiNURBSPatchControlValueReader_SampleCoordinates(MultiNURBSPatchControlValueReader<TDim>& rDummy,
+        typename Patch<TDim>::Pointer pPatch, boost::python::list divisions)
+{
+    std::vector<array_1d<double, 3> > points;
+    MultiNURBSPatchControlValueReader<TDim>::SampleCoordinates(pPatch, MultiNURBSPatchControlValueReader_ExtractDivisions<TDim>(divisions), points);
+    boost::python::list output;
+    for (std::size_t i = 0; i < points.size(); ++i)
+        output.append(points[i]);
+    return output;
+}
+
+template<int TDim, class TVariableType>
+boost::python::list MultiNURBSPatchControlValueReader_Sample(MultiNURBSPatchControlValueReader<TDim>& rDummy,
+        typename Patch<TDim>::Pointer pPatch, const TVariableType& rVariable, boost::python::list divisions)
+{
+    std::vector<typename TVariableType::Type> values;
+    MultiNURBSPatchControlValueReader<TDim>::Sample(pPatch, rVariable, MultiNURBSPatchControlValueReader_ExtractDivisions<TDim>(divisions), values);
+    boost::python::list output;
+    for (std::size_t i = 0; i < values.size(); ++i)
+        output.append(values[i]);
+    return output;
+}
+
 //////////////////////////////////////////////////
 
 template<int TDim>
@@ -802,6 +1087,13 @@ void IsogeometricApplication_AddTransformation()
     ("RotationZ", init<const double&>())
     .def(self_ns::str(self))
     ;
+
+    class_<BatchedTransformation<double>, BatchedTransformation<double>::Pointer>
+    ("BatchedTransformation", init<>())
+    .def(init<const Transformation<double>&>())
+    .def("Append", &BatchedTransformation<double>::Append)
+    .def(self_ns::str(self))
+    ;
 }
 
 void IsogeometricApplication_AddControlPoint()
@@ -823,6 +1115,8 @@ void IsogeometricApplication_AddControlPoint()
 
 void IsogeometricApplication_AddControlGrids()
 {
+    PythonBufferView::AddToPython("PythonBufferView");
+
     /////////////////////////////////////////////////////////////////////////////////////////////////
 
     class_<ControlGrid<ControlPoint<double> >, ControlGrid<ControlPoint<double> >::Pointer, boost::noncopyable>
@@ -831,6 +1125,10 @@ void IsogeometricApplication_AddControlGrids()
     .def("size", &ControlGrid<ControlPoint<double> >::Size)
     .def("__setitem__", &ControlGrid_SetItem<ControlPoint<double> >)
     .def("__getitem__", &ControlGrid_GetItem<ControlPoint<double> >)
+    .def("Buffer", &ControlGrid_Buffer<ControlPoint<double> >)
+    .def("WeightBuffer", &ControlPointGrid_WeightBuffer)
+    .def("GetCoordinates", &ControlPointGrid_GetCoordinates)
+    .def("SetCoordinates", &ControlPointGrid_SetCoordinates)
     .def(self_ns::str(self))
     ;
 
@@ -840,6 +1138,7 @@ void IsogeometricApplication_AddControlGrids()
     .def("size", &ControlGrid<double>::Size)
     .def("__setitem__", &ControlGrid_SetItem<double>)
     .def("__getitem__", &ControlGrid_GetItem<double>)
+    .def("Buffer", &ControlGrid_Buffer<double>)
     .def(self_ns::str(self))
     ;
 
@@ -849,6 +1148,7 @@ void IsogeometricApplication_AddControlGrids()
     .def("size", &ControlGrid<array_1d<double, 3> >::Size)
     .def("__setitem__", &ControlGrid_SetItem<array_1d<double, 3> >)
     .def("__getitem__", &ControlGrid_GetItem<array_1d<double, 3> >)
+    .def("Buffer", &ControlGrid_Buffer<array_1d<double, 3> >)
     .def(self_ns::str(self))
     ;
 
@@ -1034,6 +1334,7 @@ void IsogeometricApplication_AddGridFunctionsToPython()
     .add_property("FESpace", GridFunction_GetFESpace<TDim, ControlPoint<double> >, GridFunction_SetFESpace<TDim, ControlPoint<double> >)
     .add_property("ControlGrid", GridFunction_GetControlGrid<TDim, ControlPoint<double> >, GridFunction_SetControlGrid<TDim, ControlPoint<double> >)
     .def("GetValue", &GridFunction_GetValue<TDim, ControlPoint<double> >)
+    .def("GetValues", &GridFunction_GetValues<TDim, ControlPoint<double> >)
     .def(self_ns::str(self))
     ;
 
@@ -1044,6 +1345,7 @@ void IsogeometricApplication_AddGridFunctionsToPython()
     .add_property("FESpace", GridFunction_GetFESpace<TDim, double>, GridFunction_SetFESpace<TDim, double>)
     .add_property("ControlGrid", GridFunction_GetControlGrid<TDim, double>, GridFunction_SetControlGrid<TDim, double>)
     .def("GetValue", &GridFunction_GetValue<TDim, double>)
+    .def("GetValues", &GridFunction_GetValues<TDim, double>)
     .def(self_ns::str(self))
     ;
 
@@ -1054,6 +1356,7 @@ void IsogeometricApplication_AddGridFunctionsToPython()
     .add_property("FESpace", GridFunction_GetFESpace<TDim, array_1d<double, 3> >, GridFunction_SetFESpace<TDim, array_1d<double, 3> >)
     .add_property("ControlGrid", GridFunction_GetControlGrid<TDim, array_1d<double, 3> >, GridFunction_SetControlGrid<TDim, array_1d<double, 3> >)
     .def("GetValue", &GridFunction_GetValue<TDim, array_1d<double, 3> >)
+    .def("GetValues", &GridFunction_GetValues<TDim, array_1d<double, 3> >)
     .def(self_ns::str(self))
     ;
 
@@ -1088,7 +1391,12 @@ void IsogeometricApplication_AddPatchesToPython()
     .def("GridFunction", &Patch_GridFunction<TDim, Variable<double> >)
     .def("GridFunction", &Patch_GridFunction<TDim, Variable<array_1d<double, 3> > >)
     .def("GridFunction", &Patch_GridFunction<TDim, Variable<Vector> >)
-    .def("ApplyTransformation", &Patch<TDim>::ApplyTransformation)
+    .def("ApplyTransformation", &Patch_ApplyTransformation<Patch<TDim>, Transformation<double> >)
+    .def("ApplyTransformation", &Patch_ApplyTransformation<Patch<TDim>, BatchedTransformation<double> >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<Patch<TDim>, Transformation<double>, Variable<array_1d<double, 3> > >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<Patch<TDim>, BatchedTransformation<double>, Variable<array_1d<double, 3> > >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<Patch<TDim>, Transformation<double>, Variable<Vector> >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<Patch<TDim>, BatchedTransformation<double>, Variable<Vector> >)
     .def("Order", &Patch<TDim>::Order)
     .def("TotalNumber", &Patch<TDim>::TotalNumber)
     .def("Neighbor", &Patch_pGetNeighbor<Patch<TDim> >)
@@ -1123,6 +1431,12 @@ void IsogeometricApplication_AddPatchesToPython()
     .def("Enumerate", &MultiPatch_Enumerate1<TDim>)
     .def("Enumerate", &MultiPatch_Enumerate2<TDim>)
     .def("PrintAddress", &MultiPatch<TDim>::PrintAddress)
+    .def("ApplyTransformation", &Patch_ApplyTransformation<MultiPatch<TDim>, Transformation<double> >)
+    .def("ApplyTransformation", &Patch_ApplyTransformation<MultiPatch<TDim>, BatchedTransformation<double> >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<MultiPatch<TDim>, Transformation<double>, Variable<array_1d<double, 3> > >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<MultiPatch<TDim>, BatchedTransformation<double>, Variable<array_1d<double, 3> > >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<MultiPatch<TDim>, Transformation<double>, Variable<Vector> >)
+    .def("ApplyTransformation", &Patch_ApplyTransformationToGridFunction<MultiPatch<TDim>, BatchedTransformation<double>, Variable<Vector> >)
     .def(self_ns::str(self))
     ;
 }
@@ -1178,6 +1492,53 @@ void IsogeometricApplication_AddImportToPython()
     .def(self_ns::str(self))
     ;
 
+    ss.str(std::string());
+    ss << "MultiNURBSPatchControlValueWriter" << TDim << "D";
+    class_<MultiNURBSPatchControlValueWriter<TDim>, typename MultiNURBSPatchControlValueWriter<TDim>::Pointer, boost::noncopyable>
+    (ss.str().c_str(), init<>())
+    .def("AddVariable", &MultiNURBSPatchControlValueWriter_AddVariable<TDim, Variable<double> >)
+    .def("AddVariable", &MultiNURBSPatchControlValueWriter_AddVariable<TDim, Variable<array_1d<double, 3> > >)
+    .def("AddVariable", &MultiNURBSPatchControlValueWriter_AddVariable<TDim, Variable<Vector> >)
+    .def("Export", &MultiNURBSPatchControlValueWriter_Export<TDim>)
+    .def("WriteStep", &MultiNURBSPatchControlValueWriter<TDim>::WriteStep)
+    .def(self_ns::str(self))
+    ;
+
+    ss.str(std::string());
+    ss << "MultiNURBSPatchControlValueReader" << TDim << "D";
+    class_<MultiNURBSPatchControlValueReader<TDim>, typename MultiNURBSPatchControlValueReader<TDim>::Pointer, boost::noncopyable>
+    (ss.str().c_str(), init<>())
+    .def("Import", &MultiNURBSPatchControlValueReader<TDim>::Import)
+    .def("NumberOfSteps", &MultiNURBSPatchControlValueReader<TDim>::NumberOfSteps)
+    .def("Times", &MultiNURBSPatchControlValueReader_Times<TDim>)
+    .def("ReadStep", &MultiNURBSPatchControlValueReader<TDim>::ReadStep)
+    .def("SampleCoordinates", &MultiNURBSPatchControlValueReader_SampleCoordinates<TDim>)
+    .def("Sample", &MultiNURBSPatchControlValueReader_Sample<TDim, Variable<double> >)
+    .def("Sample", &MultiNURBSPatchControlValueReader_Sample<TDim, Variable<array_1d<double, 3> > >)
+    .def("Sample", &MultiNURBSPatchControlValueReader_Sample<TDim, Variable<Vector> >)
+    .def(self_ns::str(self))
+    ;
+
+    ss.str(std::string());
+    ss << "MultiNURBSPatchSnapshotWriter" << TDim << "D";
+    class_<MultiNURBSPatchSnapshotWriter<TDim>, typename MultiNURBSPatchSnapshotWriter<TDim>::Pointer, boost::noncopyable>
+    (ss.str().c_str(), init<>())
+    .def("SetCompressionLevel", &MultiNURBSPatchSnapshotWriter<TDim>::SetCompressionLevel)
+    .def("SetShuffle", &MultiNURBSPatchSnapshotWriter<TDim>::SetShuffle)
+    .def("Export", &MultiNURBSPatchSnapshotWriter_Export<TDim, Patch<TDim> >)
+    .def("Export", &MultiNURBSPatchSnapshotWriter_Export<TDim, MultiPatch<TDim> >)
+    .def(self_ns::str(self))
+    ;
+
+    ss.str(std::string());
+    ss << "MultiNURBSPatchSnapshotReader" << TDim << "D";
+    class_<MultiNURBSPatchSnapshotReader<TDim>, typename MultiNURBSPatchSnapshotReader<TDim>::Pointer, boost::noncopyable>
+    (ss.str().c_str(), init<>())
+    .def("ImportSingle", &MultiNURBSPatchSnapshotReader<TDim>::ImportSingle)
+    .def("Import", &MultiNURBSPatchSnapshotReader<TDim>::Import)
+    .def(self_ns::str(self))
+    ;
+
 }
 
 void IsogeometricApplication_AddCustomUtilities2ToPython()
@@ -60,6 +60,19 @@ void HBSplinesRefinementUtility_Refine(HBSplinesRefinementUtility& rDummy,
     rDummy.Refine<TDim>(pPatch, Id, EchoLevel);
 }
 
+template<int TDim>
+void HBSplinesRefinementUtility_RefineFunctions(HBSplinesRefinementUtility& rDummy,
+        typename Patch<TDim>::Pointer pPatch, boost::python::list& Ids, const int& EchoLevel)
+{
+    std::vector<std::size_t> Ids_vector;
+    typedef boost::python::stl_input_iterator<std::size_t> iterator_value_type;
+    BOOST_FOREACH(const iterator_value_type::value_type& v, std::make_pair(iterator_value_type(Ids), iterator_value_type() ) )
+    {
+        Ids_vector.push_back(v);
+    }
+    rDummy.RefineFunctions<TDim>(pPatch, Ids_vector, EchoLevel);
+}
+
 template<int TDim>
 void HBSplinesRefinementUtility_RefineWindow(HBSplinesRefinementUtility& rDummy,
         typename Patch<TDim>::Pointer pPatch, boost::python::list& window, const int& EchoLevel)
@@ -149,6 +162,7 @@ void IsogeometricApplication_AddHBSplinesToPython()
     .def("ExportMDPA2", &DeprecatedHBMesh<TDim>::ExportMDPA2)
     .def("ExportPostMDPA", &DeprecatedHBMesh<TDim>::ExportPostMDPA)
     .def("ExportCellGeologyAsPostMDPA", &DeprecatedHBMesh<TDim>::ExportCellGeologyAsPostMDPA)
+    .def("ExportCellGeologyAsBinary", &DeprecatedHBMesh<TDim>::ExportCellGeologyAsBinary)
     /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
     .def("PrintKnotVectors", &DeprecatedHBMesh<TDim>::PrintKnotVectors)
     .def("PrintCells", &DeprecatedHBMesh<TDim>::PrintCells)
@@ -221,6 +235,8 @@ void IsogeometricApplication_AddCustomUtilities3ToPython()
     ("HBSplinesRefinementUtility", init<>())
     .def("Refine", &HBSplinesRefinementUtility_Refine<2>)
     .def("Refine", &HBSplinesRefinementUtility_Refine<3>)
+    .def("RefineFunctions", &HBSplinesRefinementUtility_RefineFunctions<2>)
+    .def("RefineFunctions", &HBSplinesRefinementUtility_RefineFunctions<3>)
     .def("RefineWindow", &HBSplinesRefinementUtility_RefineWindow<2>)
     .def("RefineWindow", &HBSplinesRefinementUtility_RefineWindow<3>)
     .def("LinearDependencyRefine", &HBSplinesRefinementUtility_LinearDependencyRefine<2>)
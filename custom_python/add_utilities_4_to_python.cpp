@@ -28,6 +28,7 @@ LICENSE: see isogeometric_application/LICENSE.txt
 #include "custom_utilities/nonconforming_variable_multipatch_lagrange_mesh.h"
 #include "custom_utilities/multipatch_model_part.h"
 #include "custom_utilities/multi_multipatch_model_part.h"
+#include "custom_utilities/multipatch_partitioner.h"
 
 
 namespace Kratos
@@ -94,6 +95,7 @@ void IsogeometricApplication_AddMeshToPython()
     .def("SetDivision", &NonConformingMultipatchLagrangeMesh<TDim>::SetDivision)
     .def("SetUniformDivision", &NonConformingMultipatchLagrangeMesh<TDim>::SetUniformDivision)
     .def("WriteModelPart", &NonConformingMultipatchLagrangeMesh<TDim>::WriteModelPart)
+    .def("WriteModelPartBulk", &NonConformingMultipatchLagrangeMesh<TDim>::WriteModelPartBulk)
     .def(self_ns::str(self))
     ;
 
@@ -115,6 +117,52 @@ void IsogeometricApplication_AddMeshToPython()
     ;
 }
 
+template<class T>
+boost::python::list MultiPatchPartitioner_GetPartitions(T& rDummy, const std::size_t& patch_id)
+{
+    boost::python::list output;
+    std::vector<int> partitions = rDummy.GetPartitions(patch_id);
+    for (std::size_t i = 0; i < partitions.size(); ++i)
+        output.append(partitions[i]);
+    return output;
+}
+
+template<class T>
+boost::python::list MultiPatchPartitioner_GetElementPartitions(T& rDummy)
+{
+    boost::python::list output;
+    const std::vector<int>& partitions = rDummy.GetElementPartitions();
+    for (std::size_t i = 0; i < partitions.size(); ++i)
+        output.append(partitions[i]);
+    return output;
+}
+
+template<class T>
+boost::python::list MultiPatchPartitioner_GetElementWeights(T& rDummy)
+{
+    boost::python::list output;
+    const std::vector<int>& weights = rDummy.GetElementWeights();
+    for (std::size_t i = 0; i < weights.size(); ++i)
+        output.append(weights[i]);
+    return output;
+}
+
+template<class T>
+boost::python::list MultiPatchPartitioner_PartitionLoads(T& rDummy)
+{
+    boost::python::list output;
+    const std::vector<double>& loads = rDummy.PartitionLoads();
+    for (std::size_t i = 0; i < loads.size(); ++i)
+        output.append(loads[i]);
+    return output;
+}
+
+template<class T>
+void MultiPatchPartitioner_Report(T& rDummy)
+{
+    rDummy.Report(std::cout);
+}
+
 template<int TDim>
 void IsogeometricApplication_AddModelPartToPython()
 {
@@ -141,6 +189,27 @@ void IsogeometricApplication_AddModelPartToPython()
     .def(self_ns::str(self))
     ;
 
+    typedef MultiPatchPartitioner<TDim> MultiPatchPartitionerType;
+    ss.str(std::string());
+    ss << "MultiPatchPartitioner" << TDim << "D";
+    class_<MultiPatchPartitionerType, typename MultiPatchPartitionerType::Pointer, boost::noncopyable>
+    (ss.str().c_str(), init<typename MultiPatch<TDim>::Pointer>())
+    .def("SetIntegrationMethod", &MultiPatchPartitionerType::SetIntegrationMethod)
+    .def("SetIntraPatchFactor", &MultiPatchPartitionerType::SetIntraPatchFactor)
+    .def("SetImbalanceTolerance", &MultiPatchPartitionerType::SetImbalanceTolerance)
+    .def("Partition", &MultiPatchPartitionerType::Partition)
+    .def("GetPartitions", &MultiPatchPartitioner_GetPartitions<MultiPatchPartitionerType>)
+    .def("GetElementPartitions", &MultiPatchPartitioner_GetElementPartitions<MultiPatchPartitionerType>)
+    .def("GetElementWeights", &MultiPatchPartitioner_GetElementWeights<MultiPatchPartitionerType>)
+    .def("PartitionLoads", &MultiPatchPartitioner_PartitionLoads<MultiPatchPartitionerType>)
+    .def("EstimatedImbalance", &MultiPatchPartitionerType::EstimatedImbalance)
+    .def("HaloSize", &MultiPatchPartitionerType::HaloSize, return_value_policy<copy_const_reference>())
+    .def("NumberOfInterfaceControlPoints", &MultiPatchPartitionerType::NumberOfInterfaceControlPoints, return_value_policy<copy_const_reference>())
+    .def("NumberOfCutPatches", &MultiPatchPartitionerType::NumberOfCutPatches, return_value_policy<copy_const_reference>())
+    .def("Report", &MultiPatchPartitioner_Report<MultiPatchPartitionerType>)
+    .def(self_ns::str(self))
+    ;
+
     typedef MultiMultiPatchModelPart<TDim> MultiMultiPatchModelPartType;
     ss.str(std::string());
     ss << "MultiMultiPatchModelPart" << TDim << "D";
@@ -0,0 +1,211 @@
+/*
+LICENSE: see isogeometric_application/LICENSE.txt
+*/
+
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_PYTHON_BUFFER_VIEW_H_INCLUDED )
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_PYTHON_BUFFER_VIEW_H_INCLUDED
+
+
+
+// System includes
+#include <cstring>
+#include <vector>
+
+// External includes
+#include <boost/python.hpp>
+#include <boost/shared_ptr.hpp>
+
+
+// Project includes
+#include "includes/define.h"
+
+
+namespace Kratos
+{
+
+namespace Python
+{
+
+/**
+ * A one- or two-dimensional strided view of double values owned by a C++ object, exported to Python by the buffer protocol.
+ * numpy.asarray(view) (or memoryview(view)) gives an array sharing the memory with the C++ object, hence no copy is made.
+ * The view keeps the owner alive, but it becomes invalid if the owner reallocates its storage (e.g. the control grid is resized).
+ */
+class PythonBufferView
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(PythonBufferView);
+
+    /// Constructor of a view of size n x ncomp; the rows are separated by RowStride bytes and the components are contiguous.
+    /// If ncomp is zero, the view is one-dimensional of size n.
+    PythonBufferView(boost::shared_ptr<const void> pOwner, double* pData, const std::size_t& n, const std::size_t& ncomp,
+            const std::size_t& RowStride, const bool& ReadOnly)
+    : mpOwner(pOwner), mpData(pData), mReadOnly(ReadOnly)
+    {
+        mNdim = (ncomp == 0) ? 1 : 2;
+        mShape[0] = static_cast<Py_ssize_t>(n);
+        mShape[1] = static_cast<Py_ssize_t>((ncomp == 0) ? 1 : ncomp);
+        mStrides[0] = static_cast<Py_ssize_t>(RowStride);
+        mStrides[1] = static_cast<Py_ssize_t>(sizeof(double));
+    }
+
+    /// Destructor
+    virtual ~PythonBufferView() {}
+
+    /// Create a view owning a new contiguous array of size n x ncomp (one-dimensional if ncomp is zero)
+    static PythonBufferView::Pointer Create(const std::size_t& n, const std::size_t& ncomp)
+    {
+        std::size_t nc = (ncomp == 0) ? 1 : ncomp;
+        boost::shared_ptr<std::vector<double> > pValues(new std::vector<double>(n*nc + 1)); // one more to have a valid pointer when n == 0
+        return PythonBufferView::Pointer(new PythonBufferView(pValues, &(*pValues)[0], n, ncomp, nc*sizeof(double), false));
+    }
+
+    /// Number of rows
+    std::size_t Size1() const {return static_cast<std::size_t>(mShape[0]);}
+
+    /// Number of components of each row
+    std::size_t Size2() const {return static_cast<std::size_t>(mShape[1]);}
+
+    /// Access the value
+    double& operator() (const std::size_t& i, const std::size_t& j)
+    {
+        return *reinterpret_cast<double*>(reinterpret_cast<char*>(mpData) + i*mStrides[0] + j*mStrides[1]);
+    }
+
+    /// Access the value
+    const double& operator() (const std::size_t& i, const std::size_t& j) const
+    {
+        return *reinterpret_cast<const double*>(reinterpret_cast<const char*>(mpData) + i*mStrides[0] + j*mStrides[1]);
+    }
+
+    /// Shape of the view as a Python tuple
+    boost::python::tuple Shape() const
+    {
+        if (mNdim == 1)
+            return boost::python::make_tuple(mShape[0]);
+        return boost::python::make_tuple(mShape[0], mShape[1]);
+    }
+
+    /// Fill the Py_buffer for the exporter object, following the request flags
+    int GetBuffer(PyObject* pExporter, Py_buffer* pView, int flags)
+    {
+        if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && mReadOnly)
+        {
+            PyErr_SetString(PyExc_BufferError, "The view is read-only");
+            return -1;
+        }
+
+        bool c_contiguous = (mStrides[1] == static_cast<Py_ssize_t>(sizeof(double))) && (mNdim == 1 ? mStrides[0] == static_cast<Py_ssize_t>(sizeof(double)) : mStrides[0] == mShape[1]*mStrides[1]);
+        if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES && !c_contiguous)
+        {
+            PyErr_SetString(PyExc_BufferError, "The view is not contiguous, the strides must be requested");
+            return -1;
+        }
+
+        if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS && (mNdim == 2 && mShape[1] > 1))
+        {
+            PyErr_SetString(PyExc_BufferError, "The view is not Fortran contiguous");
+            return -1;
+        }
+
+        if (((flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS || (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS) && !c_contiguous)
+        {
+            PyErr_SetString(PyExc_BufferError, "The view is not contiguous");
+            return -1;
+        }
+
+        pView->buf = mpData;
+        pView->obj = pExporter;
+        Py_INCREF(pExporter);
+        pView->len = mShape[0]*mShape[1]*static_cast<Py_ssize_t>(sizeof(double));
+        pView->readonly = mReadOnly ? 1 : 0;
+        pView->itemsize = sizeof(double);
+        pView->format = ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) ? const_cast<char*>("d") : NULL;
+        pView->ndim = mNdim;
+        pView->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? mShape : NULL;
+        pView->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? mStrides : NULL;
+        pView->suboffsets = NULL;
+        pView->internal = NULL;
+        return 0;
+    }
+
+    /// Export the class to Python, with the buffer protocol
+    static void AddToPython(const char* Name)
+    {
+        using namespace boost::python;
+
+        class_<PythonBufferView, PythonBufferView::Pointer, boost::noncopyable> cls(Name, no_init);
+        cls.add_property("shape", &PythonBufferView::Shape);
+        cls.def("__len__", &PythonBufferView::Size1);
+
+        static PyBufferProcs buffer_procs;
+        std::memset(&buffer_procs, 0, sizeof(PyBufferProcs));
+        buffer_procs.bf_getbuffer = &PythonBufferView::GetBufferCallback;
+        buffer_procs.bf_releasebuffer = NULL;
+
+        PyTypeObject* type = reinterpret_cast<PyTypeObject*>(cls.ptr());
+        type->tp_as_buffer = &buffer_procs;
+        #if PY_MAJOR_VERSION < 3
+        type->tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+        #endif
+    }
+
+    /// Obtain a read-only C-contiguous buffer of double values from a Python object (e.g. a numpy array of float64)
+    /// The buffer must be released by PyBuffer_Release after use.
+    static void GetInputBuffer(PyObject* pObject, Py_buffer* pView, const std::size_t& ncomp)
+    {
+        if (PyObject_GetBuffer(pObject, pView, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+        {
+            PyErr_Clear();
+            KRATOS_THROW_ERROR(std::invalid_argument, "The input must be a C-contiguous array of float64, e.g. numpy.ascontiguousarray(a, dtype=float)", "")
+        }
+
+        if (pView->itemsize != sizeof(double) || (pView->format != NULL && std::strcmp(pView->format, "d") != 0))
+        {
+            PyBuffer_Release(pView);
+            KRATOS_THROW_ERROR(std::invalid_argument, "The input array must be of type float64", "")
+        }
+
+        if ((pView->len / pView->itemsize) % ncomp != 0 || (pView->ndim > 1 && pView->shape[pView->ndim-1] != static_cast<Py_ssize_t>(ncomp)))
+        {
+            PyBuffer_Release(pView);
+            KRATOS_THROW_ERROR(std::invalid_argument, "The last dimension of the input array must be", ncomp)
+        }
+    }
+
+private:
+
+    boost::shared_ptr<const void> mpOwner;
+    double* mpData;
+    bool mReadOnly;
+    int mNdim;
+    Py_ssize_t mShape[2];
+    Py_ssize_t mStrides[2];
+
+    static int GetBufferCallback(PyObject* pExporter, Py_buffer* pView, int flags)
+    {
+        boost::python::extract<PythonBufferView&> x(pExporter);
+        if (!x.check())
+        {
+            PyErr_SetString(PyExc_BufferError, "The object is not a buffer view");
+            return -1;
+        }
+        return x().GetBuffer(pExporter, pView, flags);
+    }
+};
+
+} // namespace Python.
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_PYTHON_BUFFER_VIEW_H_INCLUDED  defined
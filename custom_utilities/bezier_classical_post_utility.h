@@ -36,13 +36,13 @@
 #include "utilities/openmp_utils.h"
 #include "utilities/auto_collapse_spatial_binning.h"
 #include "custom_geometries/isogeometric_geometry.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "isogeometric_application.h"
 
 //#define DEBUG_LEVEL1
 //#define DEBUG_LEVEL2
 //#define DEBUG_MULTISOLVE
 //#define DEBUG_GENERATE_MESH
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -165,9 +165,7 @@ public:
     /// Deprecated
     void GenerateModelPart(ModelPart::Pointer pModelPartPost, PostElementType postElementType)
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::GenerateModelPart");
 
         #ifdef DEBUG_LEVEL1
         std::cout << typeid(*this).name() << "::GenerateModelPart" << std::endl;
@@ -458,12 +456,7 @@ public:
             ++show_progress;
         }
         
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "GeneratePostModelPart completed: " << (end_compute - start_compute) << " s" << std::endl;
-        #else
         std::cout << "GeneratePostModelPart completed" << std::endl;
-        #endif
         std::cout << NodeCounter << " nodes and " << ElementCounter << " elements are created" << std::endl;
     }
     
@@ -472,9 +465,7 @@ public:
     /// which uses template function to generate post Elements for both Element and Condition
     void GenerateModelPart2(ModelPart::Pointer pModelPartPost, const bool& generate_for_condition)
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::GenerateModelPart2");
         
         #ifdef DEBUG_LEVEL1
         std::cout << typeid(*this).name() << "::GenerateModelPart" << std::endl;
@@ -628,12 +619,7 @@ public:
             KRATOS_WATCH(ConditionCounter)
         }
 
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "GeneratePostModelPart2 completed: " << (end_compute - start_compute) << " s" << std::endl;
-        #else
         std::cout << "GeneratePostModelPart2 completed" << std::endl;
-        #endif
         std::cout << NodeCounter << " nodes and " << ElementCounter << " elements";
         if (generate_for_condition)
             std::cout << ", " << ConditionCounter << " conditions";
@@ -647,9 +633,7 @@ public:
     void GenerateModelPart2AutoCollapse(ModelPart::Pointer pModelPartPost,
                                         double dx, double dy, double dz, double tol)
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::GenerateModelPart2AutoCollapse");
         
         #ifdef DEBUG_LEVEL1
         std::cout << typeid(*this).name() << "::GenerateModelPart" << std::endl;
@@ -787,12 +771,7 @@ public:
             ++show_progress2;
         }
         
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Generate PostModelPart completed: " << (end_compute - start_compute) << " s" << std::endl;
-        #else
         std::cout << "Generate PostModelPart completed" << std::endl;
-        #endif
         std::cout << NodeCounter << " nodes and " << ElementCounter << " elements" << ", " << ConditionCounter << " conditions are created" << std::endl;
     }
     
@@ -1383,9 +1362,7 @@ public:
         const ModelPart::Pointer pModelPartPost
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::TransferNodalResults");
 
         NodesArrayType& pTargetNodes = pModelPartPost->Nodes();
         
@@ -1411,11 +1388,6 @@ public:
                 }
             }
         }
-        
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Transfer nodal point results for " << rThisVariable.Name() << " completed: " << end_compute - start_compute << " s" << std::endl;
-        #endif
     }
     
     // Synchronize post model_part with the reference model_part
@@ -1426,12 +1398,7 @@ public:
         LinearSolverType::Pointer pSolver
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "########################################" << std::endl;
-        std::cout << "Transfer integration point results for "
-                  << rThisVariable.Name() << " starts" << std::endl;
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::TransferIntegrationPointResults");
 
         // firstly transfer rThisVariable from integration points of reference model_part to its nodes
         TransferVariablesToNodes(pSolver, mpModelPart, rThisVariable);
@@ -1439,13 +1406,6 @@ public:
         // secondly transfer new nodal variables results to the post model_part
         TransferNodalResults(rThisVariable, pModelPartPost);
 
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Transfer integration point results for "
-                  << rThisVariable.Name() << " completed: "
-                  << end_compute - start_compute << "s" << std::endl;
-        std::cout << "########################################" << std::endl;
-        #endif
     }
 
     // Transfer the variable to nodes for model_part
@@ -1456,22 +1416,10 @@ public:
         LinearSolverType::Pointer pSolver
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "########################################" << std::endl;
-        std::cout << "Transfer integration point results to nodes for "
-                  << rThisVariable.Name() << " starts" << std::endl;
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::TransferVariablesToNodes");
         
         TransferVariablesToNodes(pSolver, pModelPart, rThisVariable);
         
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Transfer integration point results to nodes for "
-                  << rThisVariable.Name() << " completed: "
-                  << end_compute - start_compute << "s" << std::endl;
-        std::cout << "########################################" << std::endl;
-        #endif
     }
 
     /**
@@ -1876,11 +1824,7 @@ private:
         else
             KRATOS_THROW_ERROR(std::logic_error, rThisVariable.Name(), " is not a supported variable for TransferVariablesToNodes routine.")
 
-        #ifdef ENABLE_PROFILING
-        //profiling variables
-        double start_compute, end_compute;
-        start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierClassicalPostUtility::TransferVariablesToNodes<Vector>");
 
         //Initialize system of equations
         unsigned int NumberOfNodes = pModelPart->NumberOfNodes();
@@ -1890,11 +1834,7 @@ private:
         // create the structure for M a priori
         ConstructMatrixStructure(M, ElementsArray, pModelPart->GetProcessInfo());
 
-        #ifdef ENABLE_PROFILING
-        end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "ConstructMatrixStructure completed: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-        #endif
+        timer.Lap("BezierClassicalPostUtility::TransferVariablesToNodes<Vector>::ConstructMatrixStructure");
 
         SerialDenseSpaceType::MatrixType g(NumberOfNodes, VariableSize);
         noalias(g)= ZeroMatrix(NumberOfNodes, VariableSize);
@@ -2006,11 +1946,7 @@ private:
         for(unsigned int i = 0; i < NumberOfNodes; ++i)
             omp_destroy_lock(&lock_array[i]);
 
-        #ifdef ENABLE_PROFILING
-        end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Assemble the matrix completed: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-        #endif
+        timer.Lap("BezierClassicalPostUtility::TransferVariablesToNodes<Vector>::Assemble");
 
         #ifdef DEBUG_MULTISOLVE
         KRATOS_WATCH(M)
@@ -2237,6 +2173,5 @@ inline std::ostream& operator <<(std::ostream& rOStream,
 #undef DEBUG_LEVEL2
 #undef DEBUG_MULTISOLVE
 #undef DEBUG_GENERATE_MESH
-#undef ENABLE_PROFILING
 
 #endif
@@ -0,0 +1,521 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_BEZIER_KERNEL_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_BEZIER_KERNEL_H_INCLUDED
+
+// System includes
+#include <cstddef>
+#include <iostream>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/ublas_interface.h"
+#include "geometries/geometry_data.h"
+
+namespace Kratos
+{
+///@addtogroup IsogeometricApplication
+///@{
+
+///@name Kratos Classes
+///@{
+
+/**
+ * Bernstein basis functions of degree TOrder and their first derivatives on [0, 1], written out for the degrees up to 4.
+ * The results are the same as BezierUtils::bernstein.
+ */
+template<int TOrder>
+struct BernsteinBasis;
+
+template<>
+struct BernsteinBasis<0>
+{
+    static inline void Values(double* B, const double& x)
+    {
+        B[0] = 1.0;
+    }
+
+    static inline void ValuesAndDerivatives(double* B, double* D, const double& x)
+    {
+        B[0] = 1.0;
+        D[0] = 0.0;
+    }
+};
+
+template<>
+struct BernsteinBasis<1>
+{
+    static inline void Values(double* B, const double& x)
+    {
+        B[0] = 1.0 - x;
+        B[1] = x;
+    }
+
+    static inline void ValuesAndDerivatives(double* B, double* D, const double& x)
+    {
+        Values(B, x);
+        D[0] = -1.0;
+        D[1] = 1.0;
+    }
+};
+
+template<>
+struct BernsteinBasis<2>
+{
+    static inline void Values(double* B, const double& x)
+    {
+        const double a = x, b = 1.0 - x;
+        B[0] = b*b;
+        B[1] = 2.0*a*b;
+        B[2] = a*a;
+    }
+
+    static inline void ValuesAndDerivatives(double* B, double* D, const double& x)
+    {
+        const double a = x, b = 1.0 - x;
+        B[0] = b*b;
+        B[1] = 2.0*a*b;
+        B[2] = a*a;
+        D[0] = -2.0*b;
+        D[1] = 2.0*(b - a);
+        D[2] = 2.0*a;
+    }
+};
+
+template<>
+struct BernsteinBasis<3>
+{
+    static inline void Values(double* B, const double& x)
+    {
+        const double a = x, b = 1.0 - x;
+        B[0] = b*b*b;
+        B[1] = 3.0*a*b*b;
+        B[2] = 3.0*a*a*b;
+        B[3] = a*a*a;
+    }
+
+    static inline void ValuesAndDerivatives(double* B, double* D, const double& x)
+    {
+        const double a = x, b = 1.0 - x;
+        const double aa = a*a, bb = b*b;
+        B[0] = bb*b;
+        B[1] = 3.0*a*bb;
+        B[2] = 3.0*aa*b;
+        B[3] = aa*a;
+        D[0] = -3.0*bb;
+        D[1] = 3.0*b*(b - 2.0*a);
+        D[2] = 3.0*a*(2.0*b - a);
+        D[3] = 3.0*aa;
+    }
+};
+
+template<>
+struct BernsteinBasis<4>
+{
+    static inline void Values(double* B, const double& x)
+    {
+        const double a = x, b = 1.0 - x;
+        const double aa = a*a, bb = b*b;
+        B[0] = bb*bb;
+        B[1] = 4.0*a*bb*b;
+        B[2] = 6.0*aa*bb;
+        B[3] = 4.0*aa*a*b;
+        B[4] = aa*aa;
+    }
+
+    static inline void ValuesAndDerivatives(double* B, double* D, const double& x)
+    {
+        const double a = x, b = 1.0 - x;
+        const double aa = a*a, bb = b*b;
+        B[0] = bb*bb;
+        B[1] = 4.0*a*bb*b;
+        B[2] = 6.0*aa*bb;
+        B[3] = 4.0*aa*a*b;
+        B[4] = aa*aa;
+        D[0] = -4.0*bb*b;
+        D[1] = 4.0*bb*(b - 3.0*a);
+        D[2] = 12.0*a*b*(b - a);
+        D[3] = 4.0*aa*(3.0*b - a);
+        D[4] = 4.0*aa*a;
+    }
+};
+
+/**
+ * Kernel computing the rational Bezier shape functions of a Bezier element from its extraction operator, the weights of
+ * its control points and the Bezier weights (the transpose of the extraction operator times the weights). The kernels of
+ * the degrees up to 4 in each direction are given by FixedBezierKernel and are selected by Get in AssignGeometryData of
+ * the Bezier geometries. For the other degrees Get returns NULL and the geometries use their generic evaluation.
+ */
+template<int TDim>
+class BezierKernel
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(BezierKernel);
+
+    /// Type definitions
+    typedef Vector VectorType;
+    typedef Matrix MatrixType;
+    typedef GeometryData::ShapeFunctionsGradientsType ShapeFunctionsGradientsType;
+
+    /// Destructor
+    virtual ~BezierKernel() {}
+
+    /// Compute the shape function values at a local point
+    virtual void ShapeFunctionsValues(VectorType& rValues, const double* xi,
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights) const = 0;
+
+    /// Compute the shape function values and local gradients at a local point
+    virtual void ShapeFunctionsValuesAndLocalGradients(VectorType& rValues, MatrixType& rLocalGradients, const double* xi,
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights) const = 0;
+
+    /// Compute the shape function values and local gradients at the integration points, from the values and local gradients
+    /// of the Bernstein polynomials at the same points (as given by the geometry data of BezierUtils)
+    virtual void IntegrationPointsValuesAndLocalGradients(MatrixType& rValues, ShapeFunctionsGradientsType& rLocalGradients,
+        const MatrixType& rBezierValues, const ShapeFunctionsGradientsType& rBezierLocalGradients,
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights) const = 0;
+
+    /// Get the kernel of the given degrees, or NULL if there is no kernel of these degrees or the kernels are disabled.
+    /// The degrees beyond TDim are not used.
+    static const BezierKernel* Get(const int& Degree1, const int& Degree2, const int& Degree3);
+
+    /// Enable/disable the kernels. It only affects the geometries assigned afterward, and is used to compare with the generic evaluation.
+    static void SetEnabled(const bool& Enabled) {EnabledFlag() = Enabled;}
+
+    /// Check if the kernels are enabled
+    static bool IsEnabled() {return EnabledFlag();}
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "BezierKernel" << TDim << "D";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+private:
+
+    static bool& EnabledFlag()
+    {
+        static bool enabled = true;
+        return enabled;
+    }
+};
+
+/**
+ * Bezier kernel of fixed degrees. The Bernstein polynomials and the intermediate values are kept in stack arrays, whose
+ * sizes and loop bounds are known at compile time, so the loops over the Bezier functions are fully unrolled.
+ * Only the loop over the control points of the element is left at runtime.
+ */
+template<int TDim, int TOrder1, int TOrder2, int TOrder3>
+class FixedBezierKernel : public BezierKernel<TDim>
+{
+public:
+    /// Type definitions
+    typedef BezierKernel<TDim> BaseType;
+    typedef typename BaseType::VectorType VectorType;
+    typedef typename BaseType::MatrixType MatrixType;
+    typedef typename BaseType::ShapeFunctionsGradientsType ShapeFunctionsGradientsType;
+
+    static const int N1 = TOrder1 + 1;
+    static const int N2 = TOrder2 + 1;
+    static const int N3 = TOrder3 + 1;
+    static const int NB = N1 * N2 * N3; // number of Bezier functions
+    static const int NS = 2 * (TDim / 2 + 1); // stride of the value and derivatives of a Bezier function, padded to an even number
+
+    /// Get the unique instance
+    static const FixedBezierKernel& Instance()
+    {
+        static FixedBezierKernel instance;
+        return instance;
+    }
+
+    /// Destructor
+    virtual ~FixedBezierKernel() {}
+
+    virtual void ShapeFunctionsValues(VectorType& rValues, const double* xi,
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights) const
+    {
+        double B[NB];
+        ComputeBezierValues(B, xi);
+
+        double denom = 0.0;
+        for (int k = 0; k < NB; ++k)
+            denom += B[k] * rBezierWeights[k];
+        const double inv_denom = 1.0 / denom;
+
+        const std::size_t n = rExtractionOperator.size1();
+        if (rValues.size() != n)
+            rValues.resize(n, false);
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            double s = 0.0;
+            for (int k = 0; k < NB; ++k)
+                s += rExtractionOperator(j, k) * B[k];
+            rValues[j] = rWeights[j] * inv_denom * s;
+        }
+    }
+
+    virtual void ShapeFunctionsValuesAndLocalGradients(VectorType& rValues, MatrixType& rLocalGradients, const double* xi,
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights) const
+    {
+        double BG[NB][NS];
+        ComputeBezierValuesAndDerivatives(BG, xi);
+
+        if (rValues.size() != rExtractionOperator.size1())
+            rValues.resize(rExtractionOperator.size1(), false);
+        Rationalize(rValues, rLocalGradients, BG, rExtractionOperator, rWeights, rBezierWeights);
+    }
+
+    virtual void IntegrationPointsValuesAndLocalGradients(MatrixType& rValues, ShapeFunctionsGradientsType& rLocalGradients,
+        const MatrixType& rBezierValues, const ShapeFunctionsGradientsType& rBezierLocalGradients,
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights) const
+    {
+        const std::size_t npoints = rBezierValues.size1();
+        const std::size_t n = rExtractionOperator.size1();
+
+        if (rValues.size1() != npoints || rValues.size2() != n)
+            rValues.resize(npoints, n, false);
+        if (rLocalGradients.size() != npoints)
+            rLocalGradients.resize(npoints);
+
+        double BG[NB][NS];
+        for (std::size_t i = 0; i < npoints; ++i)
+        {
+            const MatrixType& bezier_local_gradients = rBezierLocalGradients[i];
+            for (int k = 0; k < NB; ++k)
+            {
+                BG[k][0] = rBezierValues(i, k);
+                for (int d = 0; d < TDim; ++d)
+                    BG[k][d+1] = bezier_local_gradients(k, d);
+                for (int d = TDim+1; d < NS; ++d)
+                    BG[k][d] = 0.0;
+            }
+
+            boost::numeric::ublas::matrix_row<MatrixType> values(rValues, i);
+            Rationalize(values, rLocalGradients[i], BG, rExtractionOperator, rWeights, rBezierWeights);
+        }
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "FixedBezierKernel" << TDim << "D, degrees = (" << TOrder1;
+        if (TDim > 1) rOStream << ", " << TOrder2;
+        if (TDim > 2) rOStream << ", " << TOrder3;
+        rOStream << ")";
+    }
+
+private:
+
+    /// Compute the tensor product Bernstein polynomials
+    static inline void ComputeBezierValues(double* B, const double* xi)
+    {
+        double B1[N1], B2[N2], B3[N3];
+        BernsteinBasis<TOrder1>::Values(B1, xi[0]);
+        BernsteinBasis<TOrder2>::Values(B2, (TDim > 1) ? xi[1] : 0.0);
+        BernsteinBasis<TOrder3>::Values(B3, (TDim > 2) ? xi[2] : 0.0);
+
+        for (int i = 0; i < N1; ++i)
+            for (int j = 0; j < N2; ++j)
+                for (int k = 0; k < N3; ++k)
+                    B[k + (j + i*N2)*N3] = B1[i] * B2[j] * B3[k];
+    }
+
+    /// Compute the tensor product Bernstein polynomials and their local derivatives. The value of a Bezier function is
+    /// followed by its derivatives.
+    static inline void ComputeBezierValuesAndDerivatives(double (*BG)[NS], const double* xi)
+    {
+        double B1[N1], B2[N2], B3[N3], D1[N1], D2[N2], D3[N3];
+        BernsteinBasis<TOrder1>::ValuesAndDerivatives(B1, D1, xi[0]);
+        BernsteinBasis<TOrder2>::ValuesAndDerivatives(B2, D2, (TDim > 1) ? xi[1] : 0.0);
+        BernsteinBasis<TOrder3>::ValuesAndDerivatives(B3, D3, (TDim > 2) ? xi[2] : 0.0);
+
+        for (int i = 0; i < N1; ++i)
+        {
+            for (int j = 0; j < N2; ++j)
+            {
+                for (int k = 0; k < N3; ++k)
+                {
+                    double* bg = BG[k + (j + i*N2)*N3];
+                    bg[0] = B1[i] * B2[j] * B3[k];
+                    bg[1] = D1[i] * B2[j] * B3[k];
+                    if (TDim > 1) bg[2] = B1[i] * D2[j] * B3[k];
+                    if (TDim > 2) bg[3] = B1[i] * B2[j] * D3[k];
+                    for (int d = TDim+1; d < NS; ++d)
+                        bg[d] = 0.0;
+                }
+            }
+        }
+    }
+
+    /// Compute the rational shape functions and local gradients from the Bernstein polynomials and their derivatives.
+    /// The values shall be sized to the number of control points beforehand.
+    template<class TValuesType>
+    static inline void Rationalize(TValuesType& rValues, MatrixType& rLocalGradients, const double (*BG)[NS],
+        const MatrixType& rExtractionOperator, const VectorType& rWeights, const VectorType& rBezierWeights)
+    {
+        double denom[NS];
+        for (int d = 0; d < NS; ++d)
+            denom[d] = 0.0;
+        for (int k = 0; k < NB; ++k)
+        {
+            const double bw = rBezierWeights[k];
+            for (int d = 0; d < NS; ++d)
+                denom[d] += BG[k][d] * bw;
+        }
+        const double inv_denom = 1.0 / denom[0];
+
+        const std::size_t n = rExtractionOperator.size1();
+        if (rLocalGradients.size1() != n || rLocalGradients.size2() != TDim)
+            rLocalGradients.resize(n, TDim, false);
+
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            // the value and the derivatives are accumulated together, hence the innermost loop has no dependency
+            const double* c_row = &rExtractionOperator(j, 0); // the matrix is row major
+            double s[NS];
+            for (int d = 0; d < NS; ++d)
+                s[d] = 0.0;
+            for (int k = 0; k < NB; ++k)
+            {
+                const double c = c_row[k];
+                for (int d = 0; d < NS; ++d)
+                    s[d] += c * BG[k][d];
+            }
+
+            const double a = rWeights[j] * inv_denom;
+            rValues[j] = a * s[0];
+            for (int d = 0; d < TDim; ++d)
+                rLocalGradients(j, d) = a * (s[d+1] - denom[d+1] * inv_denom * s[0]);
+        }
+    }
+};
+
+/// Selection of the fixed degree kernels. The degrees are resolved one direction at a time.
+template<int TDim>
+struct BezierKernelSelector;
+
+template<>
+struct BezierKernelSelector<1>
+{
+    static const BezierKernel<1>* Get(const int& Degree1, const int& Degree2, const int& Degree3)
+    {
+        switch (Degree1)
+        {
+            case 1: return &FixedBezierKernel<1, 1, 0, 0>::Instance();
+            case 2: return &FixedBezierKernel<1, 2, 0, 0>::Instance();
+            case 3: return &FixedBezierKernel<1, 3, 0, 0>::Instance();
+            case 4: return &FixedBezierKernel<1, 4, 0, 0>::Instance();
+            default: return NULL;
+        }
+    }
+};
+
+template<>
+struct BezierKernelSelector<2>
+{
+    static const BezierKernel<2>* Get(const int& Degree1, const int& Degree2, const int& Degree3)
+    {
+        switch (Degree1)
+        {
+            case 1: return Get<1>(Degree2);
+            case 2: return Get<2>(Degree2);
+            case 3: return Get<3>(Degree2);
+            case 4: return Get<4>(Degree2);
+            default: return NULL;
+        }
+    }
+
+    template<int TOrder1>
+    static const BezierKernel<2>* Get(const int& Degree2)
+    {
+        switch (Degree2)
+        {
+            case 1: return &FixedBezierKernel<2, TOrder1, 1, 0>::Instance();
+            case 2: return &FixedBezierKernel<2, TOrder1, 2, 0>::Instance();
+            case 3: return &FixedBezierKernel<2, TOrder1, 3, 0>::Instance();
+            case 4: return &FixedBezierKernel<2, TOrder1, 4, 0>::Instance();
+            default: return NULL;
+        }
+    }
+};
+
+template<>
+struct BezierKernelSelector<3>
+{
+    static const BezierKernel<3>* Get(const int& Degree1, const int& Degree2, const int& Degree3)
+    {
+        switch (Degree1)
+        {
+            case 1: return Get<1>(Degree2, Degree3);
+            case 2: return Get<2>(Degree2, Degree3);
+            case 3: return Get<3>(Degree2, Degree3);
+            case 4: return Get<4>(Degree2, Degree3);
+            default: return NULL;
+        }
+    }
+
+    template<int TOrder1>
+    static const BezierKernel<3>* Get(const int& Degree2, const int& Degree3)
+    {
+        switch (Degree2)
+        {
+            case 1: return Get<TOrder1, 1>(Degree3);
+            case 2: return Get<TOrder1, 2>(Degree3);
+            case 3: return Get<TOrder1, 3>(Degree3);
+            case 4: return Get<TOrder1, 4>(Degree3);
+            default: return NULL;
+        }
+    }
+
+    template<int TOrder1, int TOrder2>
+    static const BezierKernel<3>* Get(const int& Degree3)
+    {
+        switch (Degree3)
+        {
+            case 1: return &FixedBezierKernel<3, TOrder1, TOrder2, 1>::Instance();
+            case 2: return &FixedBezierKernel<3, TOrder1, TOrder2, 2>::Instance();
+            case 3: return &FixedBezierKernel<3, TOrder1, TOrder2, 3>::Instance();
+            case 4: return &FixedBezierKernel<3, TOrder1, TOrder2, 4>::Instance();
+            default: return NULL;
+        }
+    }
+};
+
+template<int TDim>
+inline const BezierKernel<TDim>* BezierKernel<TDim>::Get(const int& Degree1, const int& Degree2, const int& Degree3)
+{
+    if (!IsEnabled())
+        return NULL;
+    return BezierKernelSelector<TDim>::Get(Degree1, Degree2, Degree3);
+}
+
+///@}
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const BezierKernel<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+///@} addtogroup block
+
+}  // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_BEZIER_KERNEL_H_INCLUDED defined
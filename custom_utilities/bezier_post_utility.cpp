@@ -231,11 +231,7 @@ namespace Kratos
         else
             KRATOS_THROW_ERROR(std::logic_error, rThisVariable.Name(), "is not a supported variable for TransferVariablesToNodes routine.")
 
-        #ifdef ENABLE_PROFILING
-        //profiling variables
-        double start_compute, end_compute;
-        start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierPostUtility::TransferVariablesToNodes<Vector>");
 
         // create a map from node Id to matrix/vector row
         std::map<unsigned int, unsigned int> MapNodeIdToVec;
@@ -249,11 +245,7 @@ namespace Kratos
         noalias(M)= ZeroMatrix(NumberOfNodes, NumberOfNodes);
         ConstructMatrixStructure(M, ElementsArray, MapNodeIdToVec, r_model_part.GetProcessInfo());
         
-        #ifdef ENABLE_PROFILING
-        end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "ConstructMatrixStructure completed: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-        #endif
+        timer.Lap("BezierPostUtility::TransferVariablesToNodes::ConstructMatrixStructure");
 
         // create and initialize vectors        
         SerialDenseSpaceType::MatrixType g(NumberOfNodes, VariableSize);
@@ -366,11 +358,7 @@ namespace Kratos
         for(unsigned int i = 0; i < NumberOfNodes; ++i)
             omp_destroy_lock(&lock_array[i]);
 
-        #ifdef ENABLE_PROFILING
-        end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Assemble the matrix completed: " << end_compute - start_compute << " s" << std::endl;
-        start_compute = end_compute;
-        #endif
+        timer.Lap("BezierPostUtility::TransferVariablesToNodes::Assemble");
 
         #ifdef DEBUG_MULTISOLVE
         KRATOS_WATCH(M)
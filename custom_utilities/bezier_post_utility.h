@@ -34,6 +34,7 @@
 #include "linear_solvers/linear_solver.h"
 #include "utilities/openmp_utils.h"
 #include "custom_geometries/isogeometric_geometry.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "isogeometric_application/isogeometric_application.h"
 #include "utilities/auto_collapse_spatial_binning.h"
 
@@ -41,7 +42,6 @@
 //#define DEBUG_LEVEL2
 //#define DEBUG_MULTISOLVE
 //#define DEBUG_GENERATE_MESH
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -142,9 +142,7 @@ public:
         ModelPart& r_model_part_post
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierPostUtility::TransferNodalResults");
 
         NodesArrayType& pTargetNodes = r_model_part_post.Nodes();
 
@@ -164,12 +162,7 @@ public:
             (*it)->GetSolutionStepValue(rThisVariable) = Results;
         }
 
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Transfer nodal point results for " << rThisVariable.Name() << " completed: " << end_compute - start_compute << " s" << std::endl;
-        #else
         std::cout << "Transfer nodal point results for " << rThisVariable.Name() << " completed" << std::endl;
-        #endif
     }
 
     // Synchronize post model_part with the reference model_part
@@ -181,26 +174,13 @@ public:
         LinearSolverType::Pointer pSolver
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "########################################" << std::endl;
-        std::cout << "Transfer integration point results for "
-                  << rThisVariable.Name() << " starts" << std::endl;
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierPostUtility::TransferIntegrationPointResults");
 
         // firstly transfer rThisVariable from integration points of reference model_part to its nodes
         TransferVariablesToNodes(pSolver, r_model_part, rThisVariable);
         
         // secondly transfer new nodal variables results to the post model_part
         TransferNodalResults(rThisVariable, r_model_part, r_model_part_post);
-
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Transfer integration point results for "
-                  << rThisVariable.Name() << " completed: "
-                  << end_compute - start_compute << "s" << std::endl;
-        std::cout << "########################################" << std::endl;
-        #endif
     }
 
     // Transfer the variable to nodes for model_part
@@ -211,22 +191,9 @@ public:
         LinearSolverType::Pointer pSolver
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "########################################" << std::endl;
-        std::cout << "Transfer integration point results to nodes for "
-                  << rThisVariable.Name() << " starts" << std::endl;
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierPostUtility::TransferVariablesToNodes");
 
         TransferVariablesToNodes(pSolver, r_model_part, rThisVariable);
-
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Transfer integration point results to nodes for "
-                  << rThisVariable.Name() << " completed: "
-                  << end_compute - start_compute << "s" << std::endl;
-        std::cout << "########################################" << std::endl;
-        #endif
     }
 
     ///@}
@@ -542,6 +509,5 @@ inline std::ostream& operator <<(std::ostream& rOStream,
 #undef DEBUG_LEVEL2
 #undef DEBUG_MULTISOLVE
 #undef DEBUG_GENERATE_MESH
-#undef ENABLE_PROFILING
 
 #endif
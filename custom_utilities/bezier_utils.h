@@ -32,8 +32,8 @@
 #include "utilities/math_utils.h"
 #include "custom_geometries/isogeometric_geometry.h"
 #include "custom_utilities/isogeometric_math_utils.h"
+#include "custom_utilities/isogeometric_profiler.h"
 
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -860,9 +860,7 @@ public:
         std::string FileName
     )
     {
-        #ifdef ENABLE_PROFILING
-        double start_compute = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("BezierUtils::DumpShapeFunctionsIntegrationPointsValuesAndLocalGradients");
 
         IntegrationMethod ThisMethod = GeometryData::GI_GAUSS_1;
 
@@ -916,12 +914,6 @@ public:
         }
         Out << "};" << std::endl;
         Out.close();
-
-        #ifdef ENABLE_PROFILING
-        double end_compute = OpenMPUtils::GetCurrentTime();
-        std::cout << "Dumping shape functions values and local gradients completed: "
-                  << (end_compute - start_compute) << " s" << std::endl;
-        #endif
     }
 
     /********************************************************
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <algorithm>
 
 // External includes
 
@@ -450,7 +451,7 @@ public:
     }
 
     /// Compute the refinement coefficients for multiple knots insertion B-Splines refinement in 1D
-    /// The algorithm used here is not efficient, since multiple matrix multiplication is performed. I shall use the algorithm in the NURBS book.
+    /// The coefficients are computed by the sparse operator (see ComputeBsplinesKnotInsertionOperator1D) and then copied to the dense matrix.
     template<class MatrixType, class ValuesContainerType, class ValuesContainerType2, class ValuesContainerType3>
     static void ComputeBsplinesKnotInsertionCoefficients1D(MatrixType& D,
                                                            ValuesContainerType& new_knots,
@@ -461,35 +462,168 @@ public:
         // compute the number of basis function
         int n = knots.size() - p - 1;
 
-        // initialize coefficient matrix
-        D.resize(n, n);
-        noalias(D) = IdentityMatrix(n, n);
+        std::vector<std::size_t> rowPtr, colInd;
+        std::vector<double> values;
+        ComputeBsplinesKnotInsertionOperator1D(rowPtr, colInd, values, new_knots, p, knots, ins_knots);
+
+        // the operator maps old to new control values, hence it is transposed here
+        int new_n = rowPtr.size() - 1;
+        D.resize(n, new_n);
+        noalias(D) = ZeroMatrix(n, new_n);
+        for (int j = 0; j < new_n; ++j)
+            for (std::size_t k = rowPtr[j]; k < rowPtr[j+1]; ++k)
+                D(colInd[k], j) = values[k];
+//        KRATOS_WATCH(D)
+    }
 
-        // copy the knot vector
-        new_knots.resize(knots.size());
-        // std::copy(knots.begin(), knots.end(), new_knots.begin());
-        for (std::size_t i = 0; i < knots.size(); ++i) new_knots[i] = knots[i];
+    /// Compute the sparse operator for multiple knots insertion B-Splines refinement in 1D. The knots are inserted one by one (Boehm's algorithm).
+    /// The operator is stored in compressed row format, one row for each new control value:
+    ///     new_ctrl[j] = sum_{rowPtr[j] <= k < rowPtr[j+1]} values[k] * ctrl[colInd[k]]
+    /// Each row has at most p+1 non-zeros with increasing column indices, hence the storage and time are linear in the number of new control values.
+    template<class ValuesContainerType, class ValuesContainerType2, class ValuesContainerType3>
+    static void ComputeBsplinesKnotInsertionOperator1D(std::vector<std::size_t>& rowPtr,
+                                                       std::vector<std::size_t>& colInd,
+                                                       std::vector<double>& values,
+                                                       ValuesContainerType& new_knots,
+                                                       const int& p,
+                                                       const ValuesContainerType2& knots,
+                                                       const ValuesContainerType3& ins_knots)
+    {
+        // compute the number of basis function
+        int n = knots.size() - p - 1;
+        const int w = p + 1; // maximum number of non-zeros of each row
 
-        ValuesContainerType tmp_knots;
-        tmp_knots.resize(new_knots.size());
-        std::copy(new_knots.begin(), new_knots.end(), tmp_knots.begin());
+        std::vector<double> U(knots.size());
+        for (std::size_t i = 0; i < knots.size(); ++i) U[i] = knots[i];
 
-        // insert individual knots and concatenate coefficient matrix
-        MatrixType Di, Dt;
-        for(std::size_t i = 0; i < ins_knots.size(); ++i)
+        // each row is stored as a band of w coefficients starting at column first[j]; it is the identity initially
+        std::vector<int> first(n);
+        std::vector<double> band(n*w, 0.0);
+        for (int j = 0; j < n; ++j)
         {
-            ComputeBsplinesKnotInsertionCoefficients1D(Di, new_knots, p, tmp_knots, ins_knots[i]);
+            first[j] = j;
+            band[j*w] = 1.0;
+        }
 
-            Dt.resize(D.size1(), Di.size2());
-            noalias(Dt) = prod(D, Di);
+        std::vector<int> new_first;
+        std::vector<double> new_band;
+        std::vector<double> tmp;
+        for (std::size_t ik = 0; ik < ins_knots.size(); ++ik)
+        {
+            const double k = ins_knots[ik];
+            int m = U.size() - p - 1;
+            int s = FindSpan(m, p, k, U);
+
+            // Q_j = P_j for j <= s-p; Q_j = alpha_j * P_j + (1-alpha_j) * P_{j-1} for s-p < j <= s; Q_j = P_{j-1} for j > s
+            new_first.resize(m+1);
+            new_band.resize((m+1)*w);
+            for (int j = 0; j <= s-p; ++j)
+            {
+                new_first[j] = first[j];
+                std::copy(band.begin() + j*w, band.begin() + (j+1)*w, new_band.begin() + j*w);
+            }
+            for (int j = s-p+1; j <= s; ++j)
+            {
+                const double alpha = (k - U[j]) / (U[j+p] - U[j]);
+                const int f = first[j-1];
+                const int shift = first[j] - f;
+                tmp.assign(w + shift, 0.0);
+                for (int t = 0; t < w; ++t)
+                {
+                    tmp[t] += (1.0 - alpha) * band[(j-1)*w + t];
+                    tmp[t + shift] += alpha * band[j*w + t];
+                }
 
-            D.resize(Dt.size1(), Dt.size2());
-            noalias(D) = Dt;
+                // remove the leading zeros and check the band width
+                int start = 0;
+                while (start < w + shift - 1 && tmp[start] == 0.0) ++start;
+                for (int t = start + w; t < w + shift; ++t)
+                    if (tmp[t] != 0.0)
+                        KRATOS_THROW_ERROR(std::logic_error, "The knot insertion operator has more non-zeros than expected at row", j)
+
+                new_first[j] = f + start;
+                const int len = std::min(w, w + shift - start);
+                std::fill(new_band.begin() + j*w, new_band.begin() + (j+1)*w, 0.0);
+                std::copy(tmp.begin() + start, tmp.begin() + start + len, new_band.begin() + j*w);
+            }
+            for (int j = s+1; j <= m; ++j)
+            {
+                new_first[j] = first[j-1];
+                std::copy(band.begin() + (j-1)*w, band.begin() + j*w, new_band.begin() + j*w);
+            }
 
-            tmp_knots.resize(new_knots.size());
-            std::copy(new_knots.begin(), new_knots.end(), tmp_knots.begin());
+            first.swap(new_first);
+            band.swap(new_band);
+
+            // insert the knot
+            U.insert(U.begin() + s + 1, k);
         }
-//        KRATOS_WATCH(D)
+
+        new_knots.resize(U.size());
+        for (std::size_t i = 0; i < U.size(); ++i) new_knots[i] = U[i];
+
+        // compress the operator; the band is clipped to the number of old control values
+        int new_n = first.size();
+        rowPtr.resize(new_n + 1);
+        colInd.clear();
+        values.clear();
+        colInd.reserve(new_n*w);
+        values.reserve(new_n*w);
+        rowPtr[0] = 0;
+        for (int j = 0; j < new_n; ++j)
+        {
+            for (int t = 0; t < w && first[j] + t < n; ++t)
+            {
+                if (band[j*w + t] != 0.0)
+                {
+                    colInd.push_back(first[j] + t);
+                    values.push_back(band[j*w + t]);
+                }
+            }
+            rowPtr[j+1] = values.size();
+        }
+    }
+
+    /// Apply the 1D refinement operator (in compressed row format, see ComputeBsplinesKnotInsertionOperator1D) along direction dim
+    /// of the tensor-product grid of control values. The control values are stored with the first index running fastest.
+    /// On output, rValues contains the refined control values and sizes[dim] is updated. The work is linear in the size of the refined grid.
+    template<typename TDataType>
+    static void ApplyRefinementOperator(std::vector<TDataType>& rValues,
+                                        std::vector<std::size_t>& sizes,
+                                        const std::size_t& dim,
+                                        const std::vector<std::size_t>& rowPtr,
+                                        const std::vector<std::size_t>& colInd,
+                                        const std::vector<double>& values)
+    {
+        std::size_t stride = 1, nouter = 1;
+        for (std::size_t d = 0; d < dim; ++d) stride *= sizes[d];
+        for (std::size_t d = dim+1; d < sizes.size(); ++d) nouter *= sizes[d];
+        const std::size_t n = sizes[dim];
+        const std::size_t new_n = rowPtr.size() - 1;
+
+        if (rValues.size() != stride*n*nouter)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of control values is incompatible with the grid sizes:", rValues.size())
+
+        std::vector<TDataType> new_values(stride*new_n*nouter);
+
+        #pragma omp parallel for
+        for (int a = 0; a < static_cast<int>(nouter); ++a)
+        {
+            for (std::size_t j = 0; j < new_n; ++j)
+            {
+                for (std::size_t b = 0; b < stride; ++b)
+                {
+                    std::size_t k = rowPtr[j];
+                    TDataType v = values[k] * rValues[b + stride*(colInd[k] + n*a)];
+                    for (++k; k < rowPtr[j+1]; ++k)
+                        v += values[k] * rValues[b + stride*(colInd[k] + n*a)];
+                    new_values[b + stride*(j + new_n*a)] = v;
+                }
+            }
+        }
+
+        rValues.swap(new_values);
+        sizes[dim] = new_n;
     }
 
     /// Compute the refinement coefficients for multiple knots insertion B-Splines refinement in 2D
@@ -727,20 +861,336 @@ public:
         IsogeometricMathUtils::outer_prod_vec(D, D3, aux);
     }
 
+    /// Reusable engine for the degree elevation of B-Splines along one dimension.
+    /// The algorithm is the "adapted" modified version of Algorithm A5.9 from 'The NURBS BOOK' pg206 (see bspdegelev).
+    /// All the quantities depending only on the order, the order increment and the knot vector (the Bezier degree
+    /// elevation coefficients, the knot insertion/removal coefficients of each Bezier segment and the new knot vector)
+    /// are computed once by Initialize(). Elevate() then only combines the control values of one line, hence it can be
+    /// called for many lines sharing the same knot vector, and concurrently from several threads as long as each
+    /// thread uses its own work buffer.
+    /// REMARKS: The control values are combined linearly, hence this engine can also be used for weighted NURBS values.
+    class DegreeElevationEngine
+    {
+    public:
+
+        /// Default constructor
+        DegreeElevationEngine() : mOrder(0), mOrderIncrement(0), mNumber(0), mNewNumber(0)
+        {}
+
+        /// Compute the elevation coefficients and the new knot vector for the order d, the knot vector k and the order increment t
+        template<class ValuesContainerType>
+        void Initialize(const int& d, const ValuesContainerType& k, const int& t)
+        {
+            int nk = k.size();
+            int nc = nk - d - 1;
+
+            if (d < 0 || t < 0 || nc < d + 1)
+                KRATOS_THROW_ERROR(std::logic_error, "Invalid knot vector or order for degree elevation, number of knots =", nk)
+
+            mOrder = d;
+            mOrderIncrement = t;
+            mNumber = nc;
+            mSegments.clear();
+            mCoefficients.clear();
+
+            int i, j, q, mpi, r, a, b, cind, oldr, mul, mh, kind, first, last, tr;
+            double inv, ua, ub, numer, den, bet;
+
+            int m = nc - 1 + d + 1;
+            int ph = d + t;
+            int ph2 = ph / 2;
+
+            /* compute bezier degree elevation coefficients   */
+            mBezalfs.resize((ph+1)*(d+1));
+            std::fill(mBezalfs.begin(), mBezalfs.end(), 0.0);
+            mBezalfs[0] = mBezalfs[ph*(d+1) + d] = 1.0;
+
+            for (i = 1; i <= ph2; i++)
+            {
+                inv = 1.0 / bincoeff(ph,i);
+                mpi = std::min(d,i);
+
+                for (j = std::max(0,i-t); j <= mpi; j++)
+                    mBezalfs[i*(d+1) + j] = inv * bincoeff(d,j) * bincoeff(t,i-j);
+            }
+
+            for (i = ph2+1; i <= ph-1; i++)
+            {
+                mpi = std::min(d, i);
+                for (j = std::max(0,i-t); j <= mpi; j++)
+                    mBezalfs[i*(d+1) + j] = mBezalfs[(ph-i)*(d+1) + d-j];
+            }
+
+            /* run through the knot vector once to compute the new knots and the coefficients of each bezier segment */
+            std::vector<double>& ik = mNewKnots;
+            ik.resize(nk*(t+1));
+
+            mh = ph;
+            kind = ph+1;
+            r = -1;
+            a = d;
+            b = d+1;
+            cind = 1;
+            ua = k[0];
+
+            for (i = 0; i <= ph; i++)
+                ik[i] = ua;
+
+            while (b < m)
+            {
+                Segment seg;
+
+                i = b;
+                while (b < m && k[b] == k[b+1])
+                    b++;
+
+                mul = b - i + 1;
+                mh += mul + t;
+                ub = k[b];
+                oldr = r;
+                r = d - mul;
+
+                seg.mul = mul;
+                seg.r = r;
+                seg.oldr = oldr;
+                seg.lbz = (oldr > 0) ? (oldr+2) / 2 : 1;
+                seg.rbz = (r > 0) ? ph - (r+1)/2 : ph;
+                seg.offset = mCoefficients.size();
+
+                /* coefficients to insert knot u(b) r times */
+                if (r > 0)
+                {
+                    numer = ub - ua;
+                    for (q = mul+1; q <= d; q++)
+                        mCoefficients.push_back(numer / (k[a+q]-ua));
+                }
+
+                /* coefficients to remove knot u=k[a] oldr times, in the order of use */
+                if (oldr > 1)
+                {
+                    first = kind - 2;
+                    last = kind;
+                    den = ub - ua;
+                    bet = (ub-ik[kind-1]) / den;
+
+                    for (tr = 1; tr < oldr; tr++)
+                    {
+                        i = first;
+                        j = last;
+                        while (j - i > tr)
+                        {
+                            if (i < cind)
+                                mCoefficients.push_back((ub-ik[i])/(ua-ik[i]));
+                            if (j >= seg.lbz)
+                            {
+                                if (j-tr <= kind-ph+oldr)
+                                    mCoefficients.push_back((ub-ik[j-tr]) / den);
+                                else
+                                    mCoefficients.push_back(bet);
+                            }
+                            i++;
+                            j--;
+                        }
+
+                        first--;
+                        last++;
+                    }
+                }
+
+                /* load the knot ua  */
+                seg.kind_shift = 0;
+                if (a != d)
+                {
+                    for (i = 0; i < ph-oldr; i++)
+                    {
+                        ik[kind] = ua;
+                        kind++;
+                    }
+                    seg.kind_shift = ph-oldr;
+                }
+
+                if (seg.rbz >= seg.lbz)
+                    cind += seg.rbz - seg.lbz + 1;
+
+                if (b < m)
+                {
+                    seg.next = b;
+                    a = b;
+                    b++;
+                    ua = ub;
+                }
+                else
+                {
+                    /* end knot  */
+                    seg.next = -1;
+                    for (i = 0; i <= ph; i++)
+                        ik[kind+i] = ub;
+                }
+
+                mSegments.push_back(seg);
+            }
+
+            mNewNumber = mh - ph;
+            ik.resize(mNewNumber + ph + 1);
+        }
+
+        /// Get the order of the original B-Splines
+        int Order() const {return mOrder;}
+
+        /// Get the order increment
+        int OrderIncrement() const {return mOrderIncrement;}
+
+        /// Get the number of control values of a line
+        std::size_t Number() const {return mNumber;}
+
+        /// Get the number of control values of a line after degree elevation
+        std::size_t NewNumber() const {return mNewNumber;}
+
+        /// Get the knot vector after degree elevation
+        const std::vector<double>& NewKnots() const {return mNewKnots;}
+
+        /// Elevate the degree of one line of control values.
+        /// The input values are ctrl[0], ctrl[stride], ..., ctrl[(Number()-1)*stride] and the output values are
+        /// ictrl[0], ictrl[istride], ..., ictrl[(NewNumber()-1)*istride]. rWork is the work buffer, it is resized
+        /// on the first use and shall not be shared between threads.
+        template<typename TDataType>
+        void Elevate(const TDataType* ctrl, const std::size_t& stride,
+                TDataType* ictrl, const std::size_t& istride,
+                std::vector<TDataType>& rWork, const TDataType& zero) const
+        {
+            const int d = mOrder;
+            const int t = mOrderIncrement;
+            const int ph = d + t;
+
+            if (rWork.size() < static_cast<std::size_t>(2*(d+1) + ph+1))
+                rWork.resize(2*(d+1) + ph+1, zero);
+            TDataType* bpts = &rWork[0];
+            TDataType* Nextbpts = bpts + (d+1);
+            TDataType* ebpts = Nextbpts + (d+1);
+
+            int i, j, q, s, mpi, first, last, tr, kj;
+            int cind = 1;
+            int kind = ph+1;
+
+            ictrl[0] = ctrl[0];
+
+            /* initialise first bezier seg */
+            for (i = 0; i <= d; i++)
+                bpts[i] = ctrl[i*stride];
+
+            for (std::size_t iseg = 0; iseg < mSegments.size(); ++iseg)
+            {
+                const Segment& seg = mSegments[iseg];
+                const double* c = mCoefficients.empty() ? NULL : &mCoefficients[0] + seg.offset;
+
+                if (seg.r > 0)
+                {
+                    /* insert knot to get bezier segment */
+                    for (j = 1; j <= seg.r; j++)
+                    {
+                        s = seg.mul + j;
+
+                        for (q = d; q >= s; q--)
+                            bpts[q] = c[q-s]*bpts[q]+(1.0-c[q-s])*bpts[q-1];
+
+                        Nextbpts[seg.r - j] = bpts[d];
+                    }
+                    c += d - seg.mul;
+                }
+
+                /* degree elevate bezier */
+                for (i = seg.lbz; i <= ph; i++)
+                {
+                    const double* bezalfs = &mBezalfs[i*(d+1)];
+                    ebpts[i] = zero;
+                    mpi = std::min(d, i);
+                    for (j = std::max(0,i-t); j <= mpi; j++)
+                        ebpts[i] = ebpts[i] + bezalfs[j]*bpts[j];
+                }
+
+                if (seg.oldr > 1)
+                {
+                    /* must remove knot u=k[a] oldr times */
+                    first = kind - 2;
+                    last = kind;
+
+                    for (tr = 1; tr < seg.oldr; tr++)
+                    {
+                        i = first;
+                        j = last;
+                        kj = j - kind + 1;
+                        while (j - i > tr)
+                        {
+                            if (i < cind)
+                            {
+                                const double alf = *(c++);
+                                ictrl[i*istride] = alf * ictrl[i*istride] + (1.0-alf) * ictrl[(i-1)*istride];
+                            }
+                            if (j >= seg.lbz)
+                            {
+                                const double gam = *(c++);
+                                ebpts[kj] = gam*ebpts[kj] + (1.0-gam)*ebpts[kj+1];
+                            }
+                            i++;
+                            j--;
+                            kj--;
+                        }
+
+                        first--;
+                        last++;
+                    }
+                }
+
+                kind += seg.kind_shift;
+
+                /* load ctrl pts into ic  */
+                for (j = seg.lbz; j <= seg.rbz; j++)
+                {
+                    ictrl[cind*istride] = ebpts[j];
+                    cind++;
+                }
+
+                if (seg.next >= 0)
+                {
+                    /* setup for next pass thru loop  */
+                    for (j = 0; j < seg.r; j++)
+                        bpts[j] = Nextbpts[j];
+                    for (j = std::max(seg.r, 0); j <= d; j++)
+                        bpts[j] = ctrl[(seg.next-d+j)*stride];
+                }
+            }
+        }
+
+    private:
+
+        /// Knot-dependent data of one bezier segment
+        struct Segment
+        {
+            int mul, r, oldr, lbz, rbz, kind_shift, next;
+            std::size_t offset; // position of the first insertion/removal coefficient of the segment
+        };
+
+        int mOrder;
+        int mOrderIncrement;
+        std::size_t mNumber;
+        std::size_t mNewNumber;
+        std::vector<double> mBezalfs; // (d+t+1) x (d+1) bezier degree elevation coefficients
+        std::vector<Segment> mSegments;
+        std::vector<double> mCoefficients;
+        std::vector<double> mNewKnots;
+    };
+
     /* "Adapted" modified version of Algorithm A5.9 from 'The NURBS BOOK' pg206. */
     /// @param d    degree of the B-Splines
-    /// @param c    value container of the control points. Control points are the matrix [mc x nc]
-    /// @param mc   dimension of the control point
-    /// @param nc   number of control points
+    /// @param ctrl value container of the control points
     /// @param k    value container of the knot vector
-    /// @param nk   number of knots
     /// @param t    the order increment
-    /// @param nh   number of resulted control points (maybe)
-    /// @param ic   new control points
+    /// @param ictrl new control points
     /// @param ik   new knots
     /// REF: int bspdegelev(int d, double *c, int mc, int nc, double *k, int nk,
     ///                          int t, int *nh, double *ic, double *ik)
     /// REMARKS: This function can also be used to elevate the degree of NURBS
+    /// REMARKS: To elevate many lines sharing the same knot vector, use DegreeElevationEngine directly
     template<typename TDataType, class ValuesContainerType, class ValuesContainerType1, class ValuesContainerType2>
     static int ComputeBsplinesDegreeElevation1D(const int& d, // order of B-Splines
             const ValuesContainerType& ctrl, // control values
@@ -750,227 +1200,27 @@ public:
             ValuesContainerType2& ik, // new knot vector
             const TDataType& zero) // a sample zero control value to avoid explicit declaring TDataType
     {
-      int nc = ctrl.size();
-      int nk = k.size();
-      int row, col;
-
-      int ierr = 0;
-      int i, j, q, s, m, ph, ph2, mpi, mh, nh, r, a, b, cind, oldr, mul;
-      int n, lbz, rbz, save, tr, kj, first, kind, last, bet, ii;
-      int nic, nik;
-      double inv, ua, ub, numer, den, alf, gam;
-      double **bezalfs, *alfs;
-
-      /* allocate work space t times larger than original number */
-      /* of control points and knots */
-      ik.resize(nk*(t+1));
-      ictrl.resize(nc*(t+1));
-
-      n = nc - 1;
-
-      // bezalfs = matrix(d+1,d+t+1);
-      // bezalfs = (double**) calloc(d+1, sizeof(double*));
-      // for (int i = 0; i < d+1; ++i)
-      //   bezalfs[i] = (double*) calloc(d+t+1, sizeof(double));
-      bezalfs = (double**) calloc(d+t+1, sizeof(double*));
-      for (int i = 0; i < d+t+1; ++i)
-        bezalfs[i] = (double*) calloc(d+1, sizeof(double));
-
-      ValuesContainerType bpts(d+1);
-      ValuesContainerType ebpts(d+t+1);
-      ValuesContainerType Nextbpts(d+1);
-      alfs = (double *) calloc(d, sizeof(double));
-
-      m = n + d + 1;
-      ph = d + t;
-      ph2 = ph / 2;
-
-      /* compute bezier degree elevation coefficients   */
-      bezalfs[0][0] = bezalfs[ph][d] = 1.0;
-
-      for (i = 1; i <= ph2; i++)
-      {
-        inv = 1.0 / bincoeff(ph,i);
-        mpi = std::min(d,i);
-
-        for (j = std::max(0,i-t); j <= mpi; j++)
-          bezalfs[i][j] = inv * bincoeff(d,j) * bincoeff(t,i-j);
-      }
-
-      for (i = ph2+1; i <= ph-1; i++)
-      {
-        mpi = std::min(d, i);
-        for (j = std::max(0,i-t); j <= mpi; j++)
-          bezalfs[i][j] = bezalfs[ph-i][d-j];
-      }
-
-      mh = ph;
-      kind = ph+1;
-      r = -1;
-      a = d;
-      b = d+1;
-      cind = 1;
-      ua = k[0];
-
-      ictrl[0] = ctrl[0];
-
-      for (i = 0; i <= ph; i++)
-        ik[i] = ua;
-
-      /* initialise first bezier seg */
-      for (i = 0; i <= d; i++)
-          bpts[i] = ctrl[i];
-
-      /* big loop thru knot vector */
-      while (b < m)
-      {
-        i = b;
-        while (b < m && k[b] == k[b+1])
-          b++;
-
-        mul = b - i + 1;
-        mh += mul + t;
-        ub = k[b];
-        oldr = r;
-        r = d - mul;
-
-        /* insert knot u(b) r times */
-        if (oldr > 0)
-          lbz = (oldr+2) / 2;
-        else
-          lbz = 1;
-
-        if (r > 0)
-          rbz = ph - (r+1)/2;
-        else
-          rbz = ph;
-
-        if (r > 0)
-        {
-          /* insert knot to get bezier segment */
-          numer = ub - ua;
-          for (q = d; q > mul; q--)
-            alfs[q-mul-1] = numer / (k[a+q]-ua);
-          for (j = 1; j <= r; j++)
-          {
-            save = r - j;
-            s = mul + j;
-
-            for (q = d; q >= s; q--)
-                bpts[q] = alfs[q-s]*bpts[q]+(1.0-alfs[q-s])*bpts[q-1];
-
-            Nextbpts[save] = bpts[d];
-          }
-        }
-        /* end of insert knot */
+        DegreeElevationEngine engine;
+        engine.Initialize(d, k, t);
 
-        /* degree elevate bezier */
-        for (i = lbz; i <= ph; i++)
-        {
-          ebpts[i] = zero;
-          mpi = std::min(d, i);
-          for (j = std::max(0,i-t); j <= mpi; j++)
-            ebpts[i] = ebpts[i] + bezalfs[i][j]*bpts[j];
-        }
-        /* end of degree elevating bezier */
+        if (ctrl.size() != engine.Number())
+            KRATOS_THROW_ERROR(std::logic_error, "The number of control values is incompatible with the knot vector:", ctrl.size())
 
-        if (oldr > 1)
-        {
-          /* must remove knot u=k[a] oldr times */
-          first = kind - 2;
-          last = kind;
-          den = ub - ua;
-          bet = (ub-ik[kind-1]) / den;
-
-          /* knot removal loop */
-          for (tr = 1; tr < oldr; tr++)
-          {
-            i = first;
-            j = last;
-            kj = j - kind + 1;
-            while (j - i > tr)
-            {
-              /* loop and compute the new control points */
-             /* for one removal step    */
-              if (i < cind)
-              {
-                alf = (ub-ik[i])/(ua-ik[i]);
-                ictrl[i] = alf * ictrl[i] + (1.0-alf) * ictrl[i-1];
-              }
-              if (j >= lbz)
-              {
-                if (j-tr <= kind-ph+oldr)
-                {
-                  gam = (ub-ik[j-tr]) / den;
-                  ebpts[kj] = gam*ebpts[kj] + (1.0-gam)*ebpts[kj+1];
-                }
-                else
-                {
-                  ebpts[kj] = bet*ebpts[kj] + (1.0-bet)*ebpts[kj+1];
-                }
-              }
-              i++;
-              j--;
-              kj--;
-            }
+        const std::vector<double>& new_knots = engine.NewKnots();
+        ik.resize(new_knots.size());
+        for (std::size_t i = 0; i < new_knots.size(); ++i)
+            ik[i] = new_knots[i];
 
-            first--;
-            last++;
-          }
-        }
-        /* end of removing knot n=k[a] */
-
-        /* load the knot ua  */
-        if (a != d)
-          for (i = 0; i < ph-oldr; i++)
-          {
-            ik[kind] = ua;
-            kind++;
-          }
-
-        /* load ctrl pts into ic  */
-        for (j = lbz; j <= rbz; j++)
-        {
-          ictrl[cind] = ebpts[j];
-          cind++;
-        }
+        std::vector<TDataType> work;
+        ictrl.resize(engine.NewNumber());
+        engine.Elevate(&ctrl[0], 1, &ictrl[0], 1, work, zero);
 
-        if (b < m)
-        {
-          /* setup for next pass thru loop  */
-          for (j = 0; j < r; j++)
-            bpts[j] = Nextbpts[j];
-          for (j = r; j <= d; j++)
-            bpts[j] = ctrl[b-d+j];
-          a = b;
-          b++;
-          ua = ub;
-        }
-        else
-          /* end knot  */
-          for (i = 0; i <= ph; i++)
-            ik[kind+i] = ub;
-      }
-      /* end while loop  */
-
-      nh = mh - ph - 1;
-      nic = nh + 1;
-      nik = nic + d + t + 1;
-
-      // resize to the new size
-      ictrl.resize(nic);
-      ik.resize(nik);
-
-      free(alfs);
-      // for (int i = 0; i < d+1; ++i)
-      for (int i = 0; i < d+t+1; ++i)
-        free(bezalfs[i]);
-      free(bezalfs);
-
-      return(ierr);
+        return 0;
     }
 
     /// Degree elevation for B-Splines surface
+    /// The control values are stored with the first index running fastest, i.e. ctrl(i, j) is the (j*n1 + i)-th value.
+    /// The independent lines in each direction are elevated in parallel.
     /// REMARKS: This function can also be used to elevate the degree of NURBS
     template<typename TDataType, class ValuesContainerType, class ValuesContainerType1, class ValuesContainerType2>
     static int ComputeBsplinesDegreeElevation2D(const int& d1, const int& d2, // order of B-Splines
@@ -984,63 +1234,51 @@ public:
             ValuesContainerType2& ik2, // new knot vector
             const TDataType& zero) // a sample zero control value to avoid explicit declaring TDataType
     {
-        // firstly elevate the degree along the v-direction
-        // this can be done by collecting the v-line of control values and then elevate the degree
-
-        int n1 = k1.size() - d1 - 1;
-        int n2 = k2.size() - d2 - 1;
-
-        int new_n1, new_n2;
-
-        ValuesContainerType temp_ictrl(n1, n2); // n1, n2 is just a temporary size
+        DegreeElevationEngine engine1, engine2;
+        engine1.Initialize(d1, k1, t1);
+        engine2.Initialize(d2, k2, t2);
 
-        for (int i = 0; i < n1; ++i)
-        {
-            std::vector<typename ValuesContainerType::DataType> ctrl_v(n2);
-            std::vector<typename ValuesContainerType::DataType> ictrl_v(n2); // n2 is just temporary size
-
-            for (int j = 0; j < n2; ++j)
-                ctrl_v[j] = ctrl(i, j);
+        const int n1 = engine1.Number();
+        const int n2 = engine2.Number();
+        const int new_n1 = engine1.NewNumber();
+        const int new_n2 = engine2.NewNumber();
 
-            ComputeBsplinesDegreeElevation1D(d2, ctrl_v, k2, t2, ictrl_v, ik2, zero);
-            // here it's assumed that newly ik2 is the same for each iteration
+        if (ctrl.Size() != static_cast<std::size_t>(n1*n2))
+            KRATOS_THROW_ERROR(std::logic_error, "The number of control values is incompatible with the knot vectors:", ctrl.Size())
 
-            if (i == 0)
-            {
-                new_n2 = ik2.size() - (d2 + t2) - 1;
-                temp_ictrl.resize(n1, new_n2);
-            }
+        ictrl.resize(new_n1, new_n2);
+        std::vector<TDataType> temp_ictrl(n1*new_n2, zero);
 
-            for (int j = 0; j < new_n2; ++j)
-                temp_ictrl(i, j) = ictrl_v[j];
-        }
+        const TDataType* p_ctrl = &ctrl(0, 0);
+        TDataType* p_temp = &temp_ictrl[0];
+        TDataType* p_ictrl = &ictrl(0, 0);
 
-        // the degree in the second dimension can be elevated in the same way
-        for (int j = 0; j < new_n2; ++j)
+        #pragma omp parallel
         {
-            std::vector<typename ValuesContainerType::DataType> ctrl_u(n1);
-            std::vector<typename ValuesContainerType::DataType> ictrl_u(n1); // n1 is just temporary size
+            std::vector<TDataType> work;
 
+            // firstly elevate the degree along the v-direction
+            #pragma omp for
             for (int i = 0; i < n1; ++i)
-                ctrl_u[i] = temp_ictrl(i, j);
+                engine2.Elevate(p_ctrl + i, n1, p_temp + i, n1, work, zero);
 
-            ComputeBsplinesDegreeElevation1D(d1, ctrl_u, k1, t1, ictrl_u, ik1, zero);
-            // here it's assumed that newly ik1 is the same for each iteration
-
-            if (j == 0)
-            {
-                new_n1 = ik1.size() - (d1 + t1) - 1;
-                ictrl.resize(new_n1, new_n2);
-            }
-
-            for (int i = 0; i < new_n1; ++i)
-                ictrl(i, j) = ictrl_u[i];
+            // the degree in the first dimension can be elevated in the same way
+            #pragma omp for
+            for (int j = 0; j < new_n2; ++j)
+                engine1.Elevate(p_temp + j*n1, 1, p_ictrl + j*new_n1, 1, work, zero);
         }
 
+        ik1.resize(engine1.NewKnots().size());
+        std::copy(engine1.NewKnots().begin(), engine1.NewKnots().end(), ik1.begin());
+        ik2.resize(engine2.NewKnots().size());
+        std::copy(engine2.NewKnots().begin(), engine2.NewKnots().end(), ik2.begin());
+
         return 0;
     }
 
     /// Degree elevation for B-Splines volume
+    /// The control values are stored with the first index running fastest, i.e. ctrl(i, j, k) is the ((k*n2 + j)*n1 + i)-th value.
+    /// The independent lines in each direction are elevated in parallel.
     /// REMARKS: This function can also be used to elevate the degree of NURBS
     template<typename TDataType, class ValuesContainerType, class ValuesContainerType1, class ValuesContainerType2>
     static int ComputeBsplinesDegreeElevation3D(const int& d1, const int& d2, const int& d3, // order of B-Splines
@@ -1057,93 +1295,61 @@ public:
             ValuesContainerType2& ik3, // new knot vector
             const TDataType& zero) // a sample zero control value to avoid explicit declaring TDataType
     {
-        // firstly elevate the degree along the w-direction
-        // this can be done by collecting the w-line of control values and then elevate the degree
-
-        int n1 = k1.size() - d1 - 1;
-        int n2 = k2.size() - d2 - 1;
-        int n3 = k3.size() - d3 - 1;
-
-        int new_n1, new_n2, new_n3;
-
-        ValuesContainerType temp_ictrl(n1, n2, n3); // n1, n2, n3 is just a temporary size
-
-        for (int i = 0; i < n1; ++i)
+        DegreeElevationEngine engine1, engine2, engine3;
+        engine1.Initialize(d1, k1, t1);
+        engine2.Initialize(d2, k2, t2);
+        engine3.Initialize(d3, k3, t3);
+
+        const int n1 = engine1.Number();
+        const int n2 = engine2.Number();
+        const int n3 = engine3.Number();
+        const int new_n1 = engine1.NewNumber();
+        const int new_n2 = engine2.NewNumber();
+        const int new_n3 = engine3.NewNumber();
+
+        if (ctrl.Size() != static_cast<std::size_t>(n1*n2*n3))
+            KRATOS_THROW_ERROR(std::logic_error, "The number of control values is incompatible with the knot vectors:", ctrl.Size())
+
+        ictrl.resize(new_n1, new_n2, new_n3);
+        std::vector<TDataType> temp_ictrl(n1*n2*new_n3, zero);
+        std::vector<TDataType> temp_ictrl2(n1*new_n2*new_n3, zero);
+
+        const TDataType* p_ctrl = &ctrl(0, 0, 0);
+        TDataType* p_temp = &temp_ictrl[0];
+        TDataType* p_temp2 = &temp_ictrl2[0];
+        TDataType* p_ictrl = &ictrl(0, 0, 0);
+
+        #pragma omp parallel
         {
-            for (int j = 0; j < n2; ++j)
-            {
-                std::vector<typename ValuesContainerType::DataType> ctrl_w(n3);
-                std::vector<typename ValuesContainerType::DataType> ictrl_w(n3); // n3 is just temporary size
-
-                for (int k = 0; k < n3; ++k)
-                    ctrl_w[k] = ctrl(i, j, k);
+            std::vector<TDataType> work;
 
-                ComputeBsplinesDegreeElevation1D(d3, ctrl_w, k3, t3, ictrl_w, ik3, zero);
-                // here it's assumed that newly ik3 is the same for each iteration
+            // firstly elevate the degree along the w-direction
+            #pragma omp for
+            for (int ij = 0; ij < n1*n2; ++ij)
+                engine3.Elevate(p_ctrl + ij, n1*n2, p_temp + ij, n1*n2, work, zero);
 
-                if (i == 0 && j == 0)
-                {
-                    new_n3 = ik3.size() - (d3 + t3) - 1;
-                    temp_ictrl.resize(n1, n2, new_n3);
-                }
-
-                for (int k = 0; k < new_n3; ++k)
-                    temp_ictrl(i, j, k) = ictrl_w[k];
-            }
-        }
-
-        ValuesContainerType temp_ictrl2(n1, n2, new_n3); // n1, n2, new_n3 is just a temporary size
-
-        // the degree in the second dimension can be elevated in the same way
-        for (int i = 0; i < n1; ++i)
-        {
-            for (int k = 0; k < new_n3; ++k)
+            // the degree in the second dimension can be elevated in the same way
+            #pragma omp for
+            for (int ik = 0; ik < n1*new_n3; ++ik)
             {
-                std::vector<typename ValuesContainerType::DataType> ctrl_v(n2);
-                std::vector<typename ValuesContainerType::DataType> ictrl_v(n2); // n2 is just temporary size
-
-                for (int j = 0; j < n2; ++j)
-                    ctrl_v[j] = temp_ictrl(i, j, k);
-
-                ComputeBsplinesDegreeElevation1D(d2, ctrl_v, k2, t2, ictrl_v, ik2, zero);
-                // here it's assumed that newly ik2 is the same for each iteration
-
-                if (i == 0 && k == 0)
-                {
-                    new_n2 = ik2.size() - (d2 + t2) - 1;
-                    temp_ictrl2.resize(n1, new_n2, new_n3);
-                }
-
-                for (int j = 0; j < new_n2; ++j)
-                    temp_ictrl2(i, j, k) = ictrl_v[j];
+                const int i = ik % n1;
+                const int k = ik / n1;
+                engine2.Elevate(p_temp + k*n1*n2 + i, n1, p_temp2 + k*n1*new_n2 + i, n1, work, zero);
             }
-        }
-
-        // lastly elevate the degree in the first dimension
-        for (int j = 0; j < new_n2; ++j)
-        {
-            for (int k = 0; k < new_n3; ++k)
-            {
-                std::vector<typename ValuesContainerType::DataType> ctrl_u(n1);
-                std::vector<typename ValuesContainerType::DataType> ictrl_u(n1); // n1 is just temporary size
-
-                for (int i = 0; i < n1; ++i)
-                    ctrl_u[i] = temp_ictrl2(i, j, k);
 
-                ComputeBsplinesDegreeElevation1D(d1, ctrl_u, k1, t1, ictrl_u, ik1, zero);
-                // here it's assumed that newly ik1 is the same for each iteration
-
-                if (j == 0 && k == 0)
-                {
-                    new_n1 = ik1.size() - (d1 + t1) - 1;
-                    ictrl.resize(new_n1, new_n2, new_n3);
-                }
-
-                for (int i = 0; i < new_n1; ++i)
-                    ictrl(i, j, k) = ictrl_u[i];
-            }
+            // lastly elevate the degree in the first dimension
+            #pragma omp for
+            for (int jk = 0; jk < new_n2*new_n3; ++jk)
+                engine1.Elevate(p_temp2 + jk*n1, 1, p_ictrl + jk*new_n1, 1, work, zero);
         }
 
+        ik1.resize(engine1.NewKnots().size());
+        std::copy(engine1.NewKnots().begin(), engine1.NewKnots().end(), ik1.begin());
+        ik2.resize(engine2.NewKnots().size());
+        std::copy(engine2.NewKnots().begin(), engine2.NewKnots().end(), ik2.begin());
+        ik3.resize(engine3.NewKnots().size());
+        std::copy(engine3.NewKnots().begin(), engine3.NewKnots().end(), ik3.begin());
+
         return 0;
     }
 
@@ -1248,12 +1454,18 @@ private:
         static double a[101];
 
         if (n <= 1) return 0.0;
-        while (n > ntop)
+        double value;
+        #pragma omp critical (BSplineUtils_factln)
         {
-            ++ntop;
-            a[ntop] = gammaln(ntop+1.0);
+            // the table is filled lazily, hence it must be guarded when degree elevation is run concurrently on several patches
+            while (n > ntop)
+            {
+                ++ntop;
+                a[ntop] = gammaln(ntop+1.0);
+            }
+            value = a[n];
         }
-        return a[n];
+        return value;
     }
 
     /* Compute logarithm of the gamma function */
@@ -20,6 +20,8 @@
 #include "custom_utilities/control_grid.h"
 #include "custom_utilities/unstructured_control_grid.h"
 #include "custom_utilities/point_based_control_grid.h"
+#include "custom_utilities/nurbs/structured_control_grid.h"
+#include "custom_utilities/trans/batched_transformation.h"
 
 namespace Kratos
 {
@@ -124,26 +126,90 @@ public:
     template<typename TDataType>
     static void ApplyTransformation(ControlGrid<ControlPointType>& rControlPointGrid, const Transformation<TDataType>& trans)
     {
+        ApplyTransformation(rControlPointGrid, BatchedTransformation<TDataType>(trans));
+    }
+
+
+
+    /// Apply the composed homogeneous transformation to a grid of control points
+    template<typename TDataType>
+    static void ApplyTransformation(ControlGrid<ControlPointType>& rControlPointGrid, const BatchedTransformation<TDataType>& trans)
+    {
+        ControlPointType* pData = pContiguousData(rControlPointGrid);
+        if (pData != NULL)
+        {
+            trans.ApplyHomogeneous(pData, rControlPointGrid.size());
+            return;
+        }
+
         for (std::size_t i = 0; i < rControlPointGrid.size(); ++i)
         {
             ControlPointType point = rControlPointGrid.GetData(i);
-            point.ApplyTransformation(trans);
+            trans.ApplyHomogeneous(&point, 1);
             rControlPointGrid.SetData(i, point);
         }
     }
 
 
 
+    /// Extract the weights of a grid of control points
+    static void GetWeights(const ControlGrid<ControlPointType>& rControlPointGrid, std::vector<double>& rWeights)
+    {
+        rWeights.resize(rControlPointGrid.size());
+
+        const ControlPointType* pData = pContiguousData(rControlPointGrid);
+        if (pData != NULL)
+        {
+            const int size = static_cast<int>(rWeights.size());
+            for (int i = 0; i < size; ++i)
+                rWeights[i] = pData[i].W();
+            return;
+        }
+
+        for (std::size_t i = 0; i < rControlPointGrid.size(); ++i)
+            rWeights[i] = rControlPointGrid.GetData(i).W();
+    }
+
+
+
     /// Apply the homogeneous transformation to a grid of points
     template<typename TDataType>
     static void ApplyTransformation(ControlGrid<array_1d<TDataType, 3> >& rControlGrid, const Transformation<TDataType>& trans)
+    {
+        ApplyTransformation(rControlGrid, BatchedTransformation<TDataType>(trans));
+    }
+
+
+
+    /// Apply the composed homogeneous transformation to a grid of points
+    template<typename TDataType>
+    static void ApplyTransformation(ControlGrid<array_1d<TDataType, 3> >& rControlGrid, const BatchedTransformation<TDataType>& trans)
+    {
+        ApplyAffineTransformation(rControlGrid, trans);
+    }
+
+
+
+    /// Apply the homogeneous transformation to a grid of points. The first three components of the vectors are transformed.
+    template<typename TDataType>
+    static void ApplyTransformation(ControlGrid<Vector>& rControlGrid, const Transformation<TDataType>& trans)
+    {
+        ApplyTransformation(rControlGrid, BatchedTransformation<TDataType>(trans));
+    }
+
+
+
+    /// Apply the composed homogeneous transformation to a grid of points. The first three components of the vectors are transformed.
+    template<typename TDataType>
+    static void ApplyTransformation(ControlGrid<Vector>& rControlGrid, const BatchedTransformation<TDataType>& trans)
     {
         for (std::size_t i = 0; i < rControlGrid.size(); ++i)
         {
-            array_1d<TDataType, 3> point = rControlGrid.GetData(i);
-            trans.ApplyTransformation(point);
-            rControlGrid.SetData(i, point);
+            if (rControlGrid.GetData(i).size() < 3)
+                KRATOS_THROW_ERROR(std::logic_error, "The vectors shall have at least 3 components to be transformed in", rControlGrid.Name())
         }
+
+        ApplyAffineTransformation(rControlGrid, trans);
     }
 
 
@@ -181,6 +247,59 @@ public:
     virtual void PrintData(std::ostream& rOStream) const
     {
     }
+
+private:
+
+    /// Get the pointer to the contiguous storage of the control grid, or NULL if the control values are not stored contiguously
+    template<typename TDataType>
+    static TDataType* pContiguousData(ControlGrid<TDataType>& rControlGrid)
+    {
+        if (rControlGrid.size() == 0)
+            return NULL;
+
+        if (BaseStructuredControlGrid<TDataType>* pGrid = dynamic_cast<BaseStructuredControlGrid<TDataType>*>(&rControlGrid))
+            return &(pGrid->Data()[0]);
+
+        if (UnstructuredControlGrid<TDataType>* pGrid = dynamic_cast<UnstructuredControlGrid<TDataType>*>(&rControlGrid))
+            return &((*pGrid)[0]);
+
+        return NULL;
+    }
+
+    /// Get the pointer to the contiguous storage of the control grid, or NULL if the control values are not stored contiguously
+    template<typename TDataType>
+    static const TDataType* pContiguousData(const ControlGrid<TDataType>& rControlGrid)
+    {
+        if (rControlGrid.size() == 0)
+            return NULL;
+
+        if (const BaseStructuredControlGrid<TDataType>* pGrid = dynamic_cast<const BaseStructuredControlGrid<TDataType>*>(&rControlGrid))
+            return &(pGrid->Data()[0]);
+
+        if (const UnstructuredControlGrid<TDataType>* pGrid = dynamic_cast<const UnstructuredControlGrid<TDataType>*>(&rControlGrid))
+            return &((*pGrid)[0]);
+
+        return NULL;
+    }
+
+    /// Apply the affine part of the transformation to a grid of points in physical coordinates
+    template<typename TPointType, typename TDataType>
+    static void ApplyAffineTransformation(ControlGrid<TPointType>& rControlGrid, const BatchedTransformation<TDataType>& trans)
+    {
+        TPointType* pData = pContiguousData(rControlGrid);
+        if (pData != NULL)
+        {
+            trans.ApplyAffine(pData, rControlGrid.size());
+            return;
+        }
+
+        for (std::size_t i = 0; i < rControlGrid.size(); ++i)
+        {
+            TPointType point = rControlGrid.GetData(i);
+            trans.ApplyAffine(&point, 1);
+            rControlGrid.SetData(i, point);
+        }
+    }
 };
 
 /// output stream function
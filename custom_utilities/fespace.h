@@ -103,6 +103,29 @@ public:
         KRATOS_THROW_ERROR(std::logic_error, "Calling base class function", __FUNCTION__)
     }
 
+    /// Get the local indices and the values of the non-zero basis functions at point xi, in ascending order of index.
+    /// By default the zeros are dropped from the full basis vector; the derived class shall override it when the support can be found directly.
+    virtual void GetNonZeroValues(const std::vector<double>& xi, std::vector<std::size_t>& rIndices, std::vector<double>& rValues) const
+    {
+        std::vector<double> values = this->GetValue(xi);
+        rIndices.clear();
+        rValues.clear();
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            if (values[i] != 0.0)
+            {
+                rIndices.push_back(i);
+                rValues.push_back(values[i]);
+            }
+        }
+    }
+
+    /// Create the search structures of the evaluation, which the derived class may otherwise create at the first evaluation.
+    /// It shall be called before evaluating the FESpace from several threads.
+    virtual void UpdateSearchMaps() const
+    {
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /// Reset all the dof numbers for each grid function to -1.
@@ -70,15 +70,20 @@ public:
     template<typename TCoordinatesType>
     TDataType GetValue(const TCoordinatesType& xi) const
     {
-        // firstly get the values of all the basis functions
-        std::vector<double> f_values = pFESpace()->GetValue(xi);
+        // firstly get the non-zero basis functions
+        std::vector<std::size_t> f_indices;
+        std::vector<double> f_values;
+        pFESpace()->GetNonZeroValues(xi, f_indices, f_values);
 
-        // then interpolate the value at local coordinates using the control values
+        // then interpolate the value at local coordinates using the supported control values
         const ControlGrid<TDataType>& r_control_grid = *pControlGrid();
 
-        TDataType v = f_values[0] * r_control_grid.GetData(0);
-        for (std::size_t i = 1; i < r_control_grid.size(); ++i)
-            v += f_values[i] * r_control_grid.GetData(i);
+        if (f_indices.size() == 0)
+            return 0.0 * r_control_grid.GetData(0);
+
+        TDataType v = f_values[0] * r_control_grid.GetData(f_indices[0]);
+        for (std::size_t i = 1; i < f_indices.size(); ++i)
+            v += f_values[i] * r_control_grid.GetData(f_indices[i]);
 
         return v;
     }
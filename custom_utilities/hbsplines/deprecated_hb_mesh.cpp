@@ -10,6 +10,7 @@
 #include "custom_utilities/nurbs/cell_manager_3d.h"
 #include "custom_utilities/triangulation_utils.h"
 #include "custom_utilities/isogeometric_math_utils.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "utilities/auto_collapse_spatial_binning.h"
 
 #ifdef ISOGEOMETRIC_USE_TETGEN
@@ -17,7 +18,6 @@
 #include "custom_external_libraries/tetgen1.5.0/tetgen.h"
 #endif
 
-#define ENABLE_PROFILING
 #define DEBUG_REFINE
 
 namespace Kratos
@@ -549,9 +549,7 @@ namespace Kratos
     template<int TDim>
     void DeprecatedHBMesh<TDim>::Refine(const std::size_t& Id)
     {
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("DeprecatedHBMesh::Refine");
 
         bf_t p_bf;
         bool found = false;
@@ -640,10 +638,7 @@ namespace Kratos
                                                                           ins_knots[1],
                                                                           ins_knots[2]);
 
-        #ifdef ENABLE_PROFILING
-        double time_1 = OpenMPUtils::GetCurrentTime() - start;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("DeprecatedHBMesh::Refine::ComputeCoefficients");
 
         /* create new basis functions */
         unsigned int next_level = p_bf->Level() + 1;
@@ -779,10 +774,7 @@ namespace Kratos
             }
         }
 
-        #ifdef ENABLE_PROFILING
-        double time_2 = OpenMPUtils::GetCurrentTime() - start;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("DeprecatedHBMesh::Refine::CreateCellsAndBfs");
 
         /* remove the cells of the old basis function (remove only the cell in the current level) */
         typename cell_container_t::Pointer pcells_to_remove;
@@ -854,10 +846,7 @@ namespace Kratos
         /* remove the old basis function */
         mBasisFuncs.erase(p_bf);
 
-        #ifdef ENABLE_PROFILING
-        double time_3 = OpenMPUtils::GetCurrentTime() - start;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("DeprecatedHBMesh::Refine::CleanUp");
 
         /* Debug part: to be removed when the code is stable
         for(cell_container_t::iterator it_cell = mpCellManager->begin(); it_cell != mpCellManager->end(); ++it_cell)
@@ -880,14 +869,7 @@ namespace Kratos
         mRefinementHistory.push_back(p_bf->Id());
         if((GetEchoLevel() & ECHO_REFIMENT) == ECHO_REFIMENT)
         {
-        #ifdef ENABLE_PROFILING
-            std::cout << "Refine bf " << p_bf->Id() << " completed" << std::endl;
-            std::cout << " Time to compute the refinement coefficients: " << time_1 << " s" << std::endl;
-            std::cout << " Time to create new cells and new bfs: " << time_2 << " s" << std::endl;
-            std::cout << " Time to clean up: " << time_3 << " s" << std::endl;
-        #else
             std::cout << "Refine bf " << p_bf->Id() << " completed" << std::endl;
-        #endif
         }
     }
 
@@ -961,9 +943,7 @@ namespace Kratos
         if(mLastLevel < 1)
             return;
 
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("DeprecatedHBMesh::LinearDependencyRefine");
 
         // rebuild support domain
         mSupportDomains.clear();
@@ -1062,11 +1042,7 @@ namespace Kratos
             }
         }
 
-        #ifdef ENABLE_PROFILING
-        std::cout << "LinearDependencyRefine cycle " << refine_cycle << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s" << std::endl;
-        #else
         std::cout << "LinearDependencyRefine cycle " << refine_cycle << " completed" << std::endl;
-        #endif
     }
 
     template<int TDim>
@@ -2052,16 +2028,10 @@ namespace Kratos
     void DeprecatedHBMesh<TDim>::ExportCellGeologyAsPostMDPA(std::string fn)
     {
         // generate cell geology
-        std::vector<unsigned int> point_list;
-        std::map<unsigned int, double> X_list;
-        std::map<unsigned int, double> Y_list;
-        std::map<unsigned int, double> Z_list;
-        std::map<unsigned int, double> xi_list;
-        std::map<unsigned int, double> eta_list;
-        std::map<unsigned int, double> zeta_list;
-        std::map<unsigned int, unsigned int> cell_list;
-        std::map<unsigned int, std::vector<std::vector<unsigned int> > > connectivities_list;
-        GenerateCellGeology(point_list, X_list, Y_list, Z_list, xi_list, eta_list, zeta_list, cell_list, connectivities_list);
+        CellGeology Geology;
+        GenerateCellGeology(Geology);
+        const std::size_t NumberOfVertices = Geology.parent_cells.size();
+        const std::size_t NumberOfCells = Geology.cell_ids.size();
 
         // export to post MDPA
         std::ofstream outfile(fn.c_str());
@@ -2082,93 +2052,101 @@ namespace Kratos
 
         // write nodes
         outfile << "Begin Nodes\n";
-        for(std::size_t i = 0; i < point_list.size(); ++i)
-            outfile << point_list[i] << " " << X_list[point_list[i]]
-                                     << " " << Y_list[point_list[i]]
-                                     << " " << Z_list[point_list[i]]
-                                     << "\n";
+        for(std::size_t i = 0; i < NumberOfVertices; ++i)
+            outfile << i + 1 << " " << Geology.coordinates[3*i]
+                             << " " << Geology.coordinates[3*i + 1]
+                             << " " << Geology.coordinates[3*i + 2]
+                             << "\n";
         outfile << "End Nodes\n\n";
 
         // write elements
+        std::vector<std::string> ElementNames;
+        std::vector<unsigned int> ElementSizes;
         if(TDim == 2)
         {
-            unsigned int ElementId = 0;
-
-            // write triangle elements
-            outfile << "Begin Elements KinematicLinear2D3N\n";
-            for(std::map<unsigned int, std::vector<std::vector<unsigned int> > >::iterator it = connectivities_list.begin(); it != connectivities_list.end(); ++it) // iterate through cells
-                for(std::size_t i = 0; i < it->second.size(); ++i) // iterate through elements in cell
-                    if(it->second[i].size() == 3)
-                    {
-                        outfile << ++ElementId << " 1";
-                        for(std::size_t j = 0; j < it->second[i].size(); ++j)
-                            outfile << " " << it->second[i][j];
-                        outfile << std::endl;
-                    }
-            outfile << "End Elements\n\n";
-
-            // write quadrilateral elements
-            outfile << "Begin Elements KinematicLinear2D4N\n";
-            for(std::map<unsigned int, std::vector<std::vector<unsigned int> > >::iterator it = connectivities_list.begin(); it != connectivities_list.end(); ++it) // iterate through cells
-                for(std::size_t i = 0; i < it->second.size(); ++i) // iterate through elements in cell
-                    if(it->second[i].size() == 4)
-                    {
-                        outfile << ++ElementId << " 1";
-                        for(std::size_t j = 0; j < it->second[i].size(); ++j)
-                            outfile << " " << it->second[i][j];
-                        outfile << std::endl;
-                    }
-            outfile << "End Elements\n\n";
+            ElementNames.push_back("KinematicLinear2D3N"); ElementSizes.push_back(3);
+            ElementNames.push_back("KinematicLinear2D4N"); ElementSizes.push_back(4);
         }
         else if(TDim == 3)
         {
-            unsigned int ElementId = 0;
+            ElementNames.push_back("KinematicLinear3D4N"); ElementSizes.push_back(4);
+            ElementNames.push_back("KinematicLinear3D8N"); ElementSizes.push_back(8);
+        }
+        else
+            KRATOS_THROW_ERROR(std::logic_error, "Invalid Dimension", "")
 
-            // write tetrahedra elements
-            outfile << "Begin Elements KinematicLinear3D4N\n";
-            for(std::map<unsigned int, std::vector<std::vector<unsigned int> > >::iterator it = connectivities_list.begin(); it != connectivities_list.end(); ++it) // iterate through cells
-                for(std::size_t i = 0; i < it->second.size(); ++i) // iterate through elements in cell
-                    if(it->second[i].size() == 4)
-                    {
-                        outfile << ++ElementId << " 1";
-                        for(std::size_t j = 0; j < it->second[i].size(); ++j)
-                            outfile << " " << it->second[i][j];
-                        outfile << std::endl;
-                    }
-            outfile << "End Elements\n\n";
+        unsigned int ElementId = 0;
+        for(std::size_t k = 0; k < ElementNames.size(); ++k)
+        {
+            outfile << "Begin Elements " << ElementNames[k] << "\n";
+            for(std::size_t c = 0; c < NumberOfCells; ++c) // iterate through cells
+            {
+                if(Geology.element_sizes[c] != ElementSizes[k])
+                    continue;
 
-            // write hexahedra elements
-            outfile << "Begin Elements KinematicLinear3D8N\n";
-            for(std::map<unsigned int, std::vector<std::vector<unsigned int> > >::iterator it = connectivities_list.begin(); it != connectivities_list.end(); ++it) // iterate through cells
-                for(std::size_t i = 0; i < it->second.size(); ++i) // iterate through elements in cell
-                    if(it->second[i].size() == 8)
-                    {
-                        outfile << ++ElementId << " 1";
-                        for(std::size_t j = 0; j < it->second[i].size(); ++j)
-                            outfile << " " << it->second[i][j];
-                        outfile << std::endl;
-                    }
+                for(std::size_t i = Geology.cell_offsets[c]; i < Geology.cell_offsets[c+1]; i += ElementSizes[k]) // iterate through elements in cell
+                {
+                    outfile << ++ElementId << " 1";
+                    for(std::size_t j = 0; j < ElementSizes[k]; ++j)
+                        outfile << " " << Geology.connectivities[i + j];
+                    outfile << "\n";
+                }
+            }
             outfile << "End Elements\n\n";
         }
-        else
-            KRATOS_THROW_ERROR(std::logic_error, "Invalid Dimension", "")
 
         // write nodal data
         outfile << "Begin NodalData LOCAL_COORDINATES\n";
-        for(std::size_t i = 0; i < point_list.size(); ++i)
-            outfile << point_list[i] << " 0 [3] (" << xi_list[point_list[i]]
-                                     << "," << eta_list[point_list[i]]
-                                     << "," << zeta_list[point_list[i]] << ")\n";
+        for(std::size_t i = 0; i < NumberOfVertices; ++i)
+            outfile << i + 1 << " 0 [3] (" << Geology.local_coordinates[3*i]
+                             << "," << Geology.local_coordinates[3*i + 1]
+                             << "," << Geology.local_coordinates[3*i + 2] << ")\n";
         outfile << "End NodalData\n\n";
 
         outfile << "Begin NodalData PARENT_ELEMENT_ID\n";
-        for(std::size_t i = 0; i < point_list.size(); ++i)
-            outfile << point_list[i] << " 0 " << cell_list[point_list[i]] << "\n";
+        for(std::size_t i = 0; i < NumberOfVertices; ++i)
+            outfile << i + 1 << " 0 " << Geology.parent_cells[i] << "\n";
         outfile << "End NodalData\n\n";
 
         std::cout << "Export post MDPA to " << fn << " completed" << std::endl;
     }
 
+    template<int TDim>
+    void DeprecatedHBMesh<TDim>::ExportCellGeologyAsBinary(std::string fn)
+    {
+        // generate cell geology
+        CellGeology Geology;
+        GenerateCellGeology(Geology);
+
+        std::ofstream outfile(fn.c_str(), std::ios::out | std::ios::binary);
+        if(!outfile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Cannot open file for writing:", fn)
+
+        // write header
+        const char header[] = "HBCELLGEOLOGY";
+        outfile.write(header, 13);
+        const int dim = TDim;
+        const unsigned long long sizes[3] = {Geology.parent_cells.size(), Geology.cell_ids.size(), Geology.connectivities.size()};
+        outfile.write(reinterpret_cast<const char*>(&dim), sizeof(int));
+        outfile.write(reinterpret_cast<const char*>(sizes), sizeof(sizes));
+
+        // write the vertices
+        outfile.write(reinterpret_cast<const char*>(Geology.coordinates.data()), Geology.coordinates.size() * sizeof(double));
+        outfile.write(reinterpret_cast<const char*>(Geology.local_coordinates.data()), Geology.local_coordinates.size() * sizeof(double));
+        outfile.write(reinterpret_cast<const char*>(Geology.parent_cells.data()), Geology.parent_cells.size() * sizeof(unsigned int));
+
+        // write the cells
+        std::vector<unsigned long long> offsets(Geology.cell_offsets.begin(), Geology.cell_offsets.end());
+        outfile.write(reinterpret_cast<const char*>(Geology.cell_ids.data()), Geology.cell_ids.size() * sizeof(unsigned int));
+        outfile.write(reinterpret_cast<const char*>(Geology.element_sizes.data()), Geology.element_sizes.size() * sizeof(unsigned int));
+        outfile.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(unsigned long long));
+        outfile.write(reinterpret_cast<const char*>(Geology.connectivities.data()), Geology.connectivities.size() * sizeof(unsigned int));
+
+        outfile.close();
+
+        std::cout << "Export cell geology to " << fn << " completed" << std::endl;
+    }
+
     template<int TDim>
     void DeprecatedHBMesh<TDim>::GenerateCellGeology(std::vector<unsigned int>& point_list,
                                      std::map<unsigned int, double>& X_list,
@@ -2180,12 +2158,45 @@ namespace Kratos
                                      std::map<unsigned int, unsigned int>& cell_list,
                                      std::map<unsigned int, std::vector<std::vector<unsigned int> > >& Connectivities)
     {
-        // extract all the cell's vertices and lines
+        CellGeology Geology;
+        GenerateCellGeology(Geology);
+
+        for(std::size_t i = 0; i < Geology.parent_cells.size(); ++i)
+        {
+            unsigned int Id = i + 1;
+            X_list[Id] = Geology.coordinates[3*i];
+            Y_list[Id] = Geology.coordinates[3*i + 1];
+            Z_list[Id] = Geology.coordinates[3*i + 2];
+            point_list.push_back(Id);
+            xi_list[Id] = Geology.local_coordinates[3*i];
+            eta_list[Id] = Geology.local_coordinates[3*i + 1];
+            zeta_list[Id] = Geology.local_coordinates[3*i + 2];
+            cell_list[Id] = Geology.parent_cells[i];
+        }
+
+        for(std::size_t c = 0; c < Geology.cell_ids.size(); ++c)
+        {
+            std::vector<std::vector<unsigned int> >& Conns = Connectivities[Geology.cell_ids[c]];
+            const std::size_t n = Geology.element_sizes[c];
+            for(std::size_t i = Geology.cell_offsets[c]; i < Geology.cell_offsets[c+1]; i += n)
+                Conns.push_back(std::vector<unsigned int>(Geology.connectivities.begin() + i, Geology.connectivities.begin() + i + n));
+        }
+    }
+
+    template<int TDim>
+    void DeprecatedHBMesh<TDim>::GenerateCellGeology(CellGeology& rGeology)
+    {
+        // extract all the cell's vertices
         AutoCollapseSpatialBinning Binning(0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0e-6);
         std::map<unsigned int, cell_t> MapVertexToCell; // this container map from vertex id to the cell contain it
-        std::map<unsigned int, std::vector<unsigned int> > MapCellToNodes; // this container contains the vertex Ids in each cell
+        std::vector<cell_t> Cells; // the cells, sorted by Id
+        std::vector<std::vector<unsigned int> > MapCellToNodes; // this container contains the vertex Ids in each cell
         for(cell_container_t::iterator it = mpCellManager->begin(); it != mpCellManager->end(); ++it)
         {
+            Cells.push_back(*it);
+            MapCellToNodes.push_back(std::vector<unsigned int>());
+            std::vector<unsigned int>& CellNodes = MapCellToNodes.back();
+
             if(TDim == 2)
             {
                 unsigned int V1 = Binning.AddNode((*it)->LeftValue(), (*it)->DownValue(), 0.0);
@@ -2197,10 +2208,10 @@ namespace Kratos
                 MapVertexToCell[V2] = (*it);
                 MapVertexToCell[V3] = (*it);
                 MapVertexToCell[V4] = (*it);
-                MapCellToNodes[(*it)->Id()].push_back(V1);
-                MapCellToNodes[(*it)->Id()].push_back(V2);
-                MapCellToNodes[(*it)->Id()].push_back(V4);
-                MapCellToNodes[(*it)->Id()].push_back(V3);
+                CellNodes.push_back(V1);
+                CellNodes.push_back(V2);
+                CellNodes.push_back(V4);
+                CellNodes.push_back(V3);
             }
             else if(TDim == 3)
             {
@@ -2221,294 +2232,355 @@ namespace Kratos
                 MapVertexToCell[V6] = (*it);
                 MapVertexToCell[V7] = (*it);
                 MapVertexToCell[V8] = (*it);
-                MapCellToNodes[(*it)->Id()].push_back(V1);
-                MapCellToNodes[(*it)->Id()].push_back(V2);
-                MapCellToNodes[(*it)->Id()].push_back(V4);
-                MapCellToNodes[(*it)->Id()].push_back(V3);
-                MapCellToNodes[(*it)->Id()].push_back(V5);
-                MapCellToNodes[(*it)->Id()].push_back(V6);
-                MapCellToNodes[(*it)->Id()].push_back(V8);
-                MapCellToNodes[(*it)->Id()].push_back(V7);
+                CellNodes.push_back(V1);
+                CellNodes.push_back(V2);
+                CellNodes.push_back(V4);
+                CellNodes.push_back(V3);
+                CellNodes.push_back(V5);
+                CellNodes.push_back(V6);
+                CellNodes.push_back(V8);
+                CellNodes.push_back(V7);
             }
         }
 
-        // compute the global coordinates of the vertex
-        for(unsigned int i = 0; i < Binning.NumberOfNodes(); ++i)
+        // copy the parametric coordinates and the parent cell of the vertices, so that they are read-only in the parallel loops
+        const std::size_t NumberOfVertices = Binning.NumberOfNodes();
+        std::vector<double> Params(3*NumberOfVertices);
+        std::vector<cell_t> VertexCells(NumberOfVertices);
+        for(std::size_t i = 0; i < NumberOfVertices; ++i)
         {
             unsigned int Id = i + 1;
-            cell_t p_cell = MapVertexToCell[Id];
+            Params[3*i] = Binning.GetX(Id);
+            Params[3*i + 1] = Binning.GetY(Id);
+            Params[3*i + 2] = (TDim == 3) ? Binning.GetZ(Id) : 0.0;
+            VertexCells[i] = MapVertexToCell[Id];
+        }
 
-            // compute the local coordinates of the vertex
-            double xi, eta, zeta, local_xi, local_eta, local_zeta;
-            xi = Binning.GetX(Id);
-            eta = Binning.GetY(Id);
-            if(TDim == 2)
-                zeta = 0.0;
-            else if(TDim == 3)
-                zeta = Binning.GetZ(Id);
+        // create the index map of the basis functions, so that the access in the parallel loop is read-only
+        if(mBasisFuncs.size() != 0)
+            mBasisFuncs[(*mBasisFuncs.begin())->Id()];
 
-            local_xi = (xi - p_cell->LeftValue()) / (p_cell->RightValue() - p_cell->LeftValue());
-            local_eta = (eta - p_cell->DownValue()) / (p_cell->UpValue() - p_cell->DownValue());
-            if(TDim == 2)
-                local_zeta = 0.0;
-            else if(TDim == 3)
-                local_zeta = (zeta - p_cell->BelowValue()) / (p_cell->AboveValue() - p_cell->BelowValue());
+        // compute the global coordinates of the vertex
+        rGeology.coordinates.resize(3*NumberOfVertices);
+        rGeology.local_coordinates.resize(3*NumberOfVertices);
+        rGeology.parent_cells.resize(NumberOfVertices);
 
-            // compute the Bernstein basis function on the local coordinates
-            Vector B;
-            if(TDim == 2)
-            {
-                B.resize((mOrder1 + 1) * (mOrder2 + 1));
-                for(unsigned int k = 0; k < mOrder1 + 1; ++k)
-                    for(unsigned int l = 0; l < mOrder2 + 1; ++l)
-                    {
-                        unsigned int num = k * (mOrder2 + 1) + l;
-                        double B1 = BezierUtils::bernstein2(k, mOrder1, local_xi);
-                        double B2 = BezierUtils::bernstein2(l, mOrder2, local_eta);
-                        B(num) = B1 * B2;
-                    }
-            }
-            else if(TDim == 3)
+        std::string error_message;
+        #pragma omp parallel for schedule(dynamic, 64)
+        for(int i = 0; i < static_cast<int>(NumberOfVertices); ++i)
+        {
+            try
             {
-                B.resize((mOrder1 + 1) * (mOrder2 + 1) * (mOrder3 + 1));
-                for(unsigned int k = 0; k < mOrder1 + 1; ++k)
-                    for(unsigned int l = 0; l < mOrder2 + 1; ++l)
-                        for(unsigned int m = 0; m < mOrder3 + 1; ++m)
+                cell_t p_cell = VertexCells[i];
+
+                // compute the local coordinates of the vertex
+                double local_xi, local_eta, local_zeta;
+                local_xi = (Params[3*i] - p_cell->LeftValue()) / (p_cell->RightValue() - p_cell->LeftValue());
+                local_eta = (Params[3*i + 1] - p_cell->DownValue()) / (p_cell->UpValue() - p_cell->DownValue());
+                if(TDim == 3)
+                    local_zeta = (Params[3*i + 2] - p_cell->BelowValue()) / (p_cell->AboveValue() - p_cell->BelowValue());
+                else
+                    local_zeta = 0.0;
+
+                // compute the Bernstein basis function on the local coordinates
+                Vector B;
+                if(TDim == 2)
+                {
+                    B.resize((mOrder1 + 1) * (mOrder2 + 1));
+                    for(unsigned int k = 0; k < mOrder1 + 1; ++k)
+                        for(unsigned int l = 0; l < mOrder2 + 1; ++l)
                         {
-                            unsigned int num = (k * (mOrder2 + 1) + l) * (mOrder3 + 1) + m;
+                            unsigned int num = k * (mOrder2 + 1) + l;
                             double B1 = BezierUtils::bernstein2(k, mOrder1, local_xi);
                             double B2 = BezierUtils::bernstein2(l, mOrder2, local_eta);
-                            double B3 = BezierUtils::bernstein2(m, mOrder3, local_zeta);
-                            B(num) = B1 * B2 * B3;
+                            B(num) = B1 * B2;
                         }
-            }
+                }
+                else if(TDim == 3)
+                {
+                    B.resize((mOrder1 + 1) * (mOrder2 + 1) * (mOrder3 + 1));
+                    for(unsigned int k = 0; k < mOrder1 + 1; ++k)
+                        for(unsigned int l = 0; l < mOrder2 + 1; ++l)
+                            for(unsigned int m = 0; m < mOrder3 + 1; ++m)
+                            {
+                                unsigned int num = (k * (mOrder2 + 1) + l) * (mOrder3 + 1) + m;
+                                double B1 = BezierUtils::bernstein2(k, mOrder1, local_xi);
+                                double B2 = BezierUtils::bernstein2(l, mOrder2, local_eta);
+                                double B3 = BezierUtils::bernstein2(m, mOrder3, local_zeta);
+                                B(num) = B1 * B2 * B3;
+                            }
+                }
 
-            // get the extraction operator on this cell
-            Matrix C = p_cell->GetExtractionOperator();
+                // get the extraction operator on this cell
+                Matrix C = p_cell->GetExtractionOperator();
 
-            // compute the B-splines shape function values at the local coordinates
-            Vector N(p_cell->NumberOfAnchors());
-            noalias(N) = prod(C, B);
+                // compute the B-splines shape function values at the local coordinates
+                Vector N(p_cell->NumberOfAnchors());
+                noalias(N) = prod(C, B);
 
-            // compute the NURBS shape function at the local coordinates
-            Vector W;
-            p_cell->GetAnchorWeights(W);
-            double Denom = inner_prod(W, N);
-            Vector R(p_cell->NumberOfAnchors());
-            for(std::size_t k = 0; k < p_cell->NumberOfAnchors(); ++k)
-                R(k) = W(k) * N(k) / Denom;
-
-            // get the list of supported basis function of this cell
-            const std::vector<std::size_t>& bfs_id = p_cell->GetSupportedAnchors();
-
-            // compute the glocal coordinates at the local coordinates
-            double X = 0.0, Y = 0.0, Z = 0.0;
-            for(std::size_t k = 0; k < p_cell->NumberOfAnchors(); ++k)
+                // compute the NURBS shape function at the local coordinates
+                Vector W;
+                p_cell->GetAnchorWeights(W);
+                double Denom = inner_prod(W, N);
+                Vector R(p_cell->NumberOfAnchors());
+                for(std::size_t k = 0; k < p_cell->NumberOfAnchors(); ++k)
+                    R(k) = W(k) * N(k) / Denom;
+
+                // get the list of supported basis function of this cell
+                const std::vector<std::size_t>& bfs_id = p_cell->GetSupportedAnchors();
+
+                // compute the glocal coordinates at the local coordinates
+                double X = 0.0, Y = 0.0, Z = 0.0;
+                for(std::size_t k = 0; k < p_cell->NumberOfAnchors(); ++k)
+                {
+                    std::size_t func_id = static_cast<std::size_t>(bfs_id[k]);
+                    X += R(k) * mBasisFuncs[func_id]->GetControlPoint().X();
+                    Y += R(k) * mBasisFuncs[func_id]->GetControlPoint().Y();
+                    Z += R(k) * mBasisFuncs[func_id]->GetControlPoint().Z();
+                }
+
+                // add point to list
+                rGeology.coordinates[3*i] = X;
+                rGeology.coordinates[3*i + 1] = Y;
+                rGeology.coordinates[3*i + 2] = Z;
+                rGeology.local_coordinates[3*i] = local_xi;
+                rGeology.local_coordinates[3*i + 1] = local_eta;
+                rGeology.local_coordinates[3*i + 2] = local_zeta;
+                rGeology.parent_cells[i] = p_cell->Id();
+            }
+            catch (std::exception& e)
             {
-                std::size_t func_id = static_cast<std::size_t>(bfs_id[k]);
-                X += R(k) * mBasisFuncs[func_id]->GetControlPoint().X();
-                Y += R(k) * mBasisFuncs[func_id]->GetControlPoint().Y();
-                Z += R(k) * mBasisFuncs[func_id]->GetControlPoint().Z();
+                #pragma omp critical
+                {
+                    if (error_message.empty())
+                        error_message = e.what();
+                }
             }
-
-            // add point to list
-            X_list[Id] = X;
-            Y_list[Id] = Y;
-            Z_list[Id] = Z;
-            point_list.push_back(Id);
-            xi_list[Id] = local_xi;
-            eta_list[Id] = local_eta;
-            zeta_list[Id] = local_zeta;
-            cell_list[Id] = p_cell->Id();
         }
 
-        // compute the middle nodes in cell and generate the internal mesh for each cell
-        for(cell_container_t::iterator it = mpCellManager->begin(); it != mpCellManager->end(); ++it)
-        {
-            // we check each edge in each cell, if the edge/face contain any vertex, that vertex will be includes in the middle nodes. These cells will be filled with triangular mesh.
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
 
-            // global Node Ids of cell
-            std::vector<unsigned int>& CellNodes = MapCellToNodes[(*it)->Id()];
+        // compute the middle nodes in cell and generate the internal mesh for each cell. The cells are independent, each
+        // cell is meshed in its own buffer and the buffers are gathered in the flat connectivities afterwards.
+        const std::size_t NumberOfCells = Cells.size();
+        std::vector<std::vector<unsigned int> > CellConnectivities(NumberOfCells);
+        rGeology.cell_ids.resize(NumberOfCells);
+        rGeology.element_sizes.resize(NumberOfCells);
 
-            // detect middle nodes
-            std::set<unsigned int> MiddleNodes;
-            if(TDim == 2)
+        #pragma omp parallel for schedule(dynamic)
+        for(int c = 0; c < static_cast<int>(NumberOfCells); ++c)
+        {
+            try
             {
-                // extract edges
-                typedef std::pair<unsigned int, unsigned int> edge_t;
-                std::vector<edge_t> Edges;
+                rGeology.cell_ids[c] = Cells[c]->Id();
+
+                // we check each edge in each cell, if the edge/face contain any vertex, that vertex will be includes in the middle nodes. These cells will be filled with triangular mesh.
 
-                Edges.push_back(edge_t(CellNodes[0], CellNodes[1]));
-                Edges.push_back(edge_t(CellNodes[1], CellNodes[2]));
-                Edges.push_back(edge_t(CellNodes[2], CellNodes[3]));
-                Edges.push_back(edge_t(CellNodes[3], CellNodes[0]));
+                // global Node Ids of cell
+                std::vector<unsigned int> CellNodes = MapCellToNodes[c];
 
-                // detect middle nodes on edges
-                for(std::size_t i = 0; i < Edges.size(); ++i)
+                // detect middle nodes
+                std::set<unsigned int> MiddleNodes;
+                if(TDim == 2)
                 {
-                    unsigned int n1 = Edges[i].first;
-                    unsigned int n2 = Edges[i].second;
-
-                    // check if the line contain any vertex, then these vertices are middle nodes
-                    double xi1  = std::min(Binning.GetX(n1), Binning.GetX(n2));
-                    double eta1 = std::min(Binning.GetY(n1), Binning.GetY(n2));
-                    double xi2  = std::max(Binning.GetX(n1), Binning.GetX(n2));
-                    double eta2 = std::max(Binning.GetY(n1), Binning.GetY(n2));
-                    for(unsigned int i = 0; i < Binning.NumberOfNodes(); ++i)
+                    // extract edges
+                    typedef std::pair<unsigned int, unsigned int> edge_t;
+                    std::vector<edge_t> Edges;
+
+                    Edges.push_back(edge_t(CellNodes[0], CellNodes[1]));
+                    Edges.push_back(edge_t(CellNodes[1], CellNodes[2]));
+                    Edges.push_back(edge_t(CellNodes[2], CellNodes[3]));
+                    Edges.push_back(edge_t(CellNodes[3], CellNodes[0]));
+
+                    // detect middle nodes on edges
+                    for(std::size_t i = 0; i < Edges.size(); ++i)
                     {
-                        unsigned int Id = i + 1;
-                        double xi = Binning.GetX(Id);
-                        double eta = Binning.GetY(Id);
-                        bool is_inside = false;
-                        is_inside = is_inside || (xi1<xi && xi<xi2) && (eta1==eta && eta==eta2); // 1st direction
-                        is_inside = is_inside || (xi1==xi && xi==xi2) && (eta1<eta && eta<eta2); // 2nd direction
-                        if(is_inside)
-                            MiddleNodes.insert(Id);
+                        unsigned int n1 = Edges[i].first - 1;
+                        unsigned int n2 = Edges[i].second - 1;
+
+                        // check if the line contain any vertex, then these vertices are middle nodes
+                        double xi1  = std::min(Params[3*n1], Params[3*n2]);
+                        double eta1 = std::min(Params[3*n1 + 1], Params[3*n2 + 1]);
+                        double xi2  = std::max(Params[3*n1], Params[3*n2]);
+                        double eta2 = std::max(Params[3*n1 + 1], Params[3*n2 + 1]);
+                        for(unsigned int i = 0; i < NumberOfVertices; ++i)
+                        {
+                            double xi = Params[3*i];
+                            double eta = Params[3*i + 1];
+                            bool is_inside = false;
+                            is_inside = is_inside || (xi1<xi && xi<xi2) && (eta1==eta && eta==eta2); // 1st direction
+                            is_inside = is_inside || (xi1==xi && xi==xi2) && (eta1<eta && eta<eta2); // 2nd direction
+                            if(is_inside)
+                                MiddleNodes.insert(i + 1);
+                        }
                     }
                 }
-            }
-            else if(TDim == 3)
-            {
-                // extract faces
-                typedef std::pair<unsigned int, unsigned int> edge_t;
-                typedef std::pair<edge_t, edge_t> face_t;
-                std::vector<face_t> Faces;
-
-                Faces.push_back(face_t(edge_t(CellNodes[0], CellNodes[1]), edge_t(CellNodes[2], CellNodes[3])));
-                Faces.push_back(face_t(edge_t(CellNodes[4], CellNodes[5]), edge_t(CellNodes[6], CellNodes[7])));
-                Faces.push_back(face_t(edge_t(CellNodes[0], CellNodes[1]), edge_t(CellNodes[5], CellNodes[4])));
-                Faces.push_back(face_t(edge_t(CellNodes[1], CellNodes[2]), edge_t(CellNodes[6], CellNodes[5])));
-                Faces.push_back(face_t(edge_t(CellNodes[2], CellNodes[3]), edge_t(CellNodes[7], CellNodes[6])));
-                Faces.push_back(face_t(edge_t(CellNodes[3], CellNodes[0]), edge_t(CellNodes[4], CellNodes[7])));
-
-                // detect middle nodes on faces
-                for(std::size_t i = 0; i < Faces.size(); ++i)
+                else if(TDim == 3)
                 {
-                    unsigned int n1 = Faces[i].first.first;
-                    unsigned int n2 = Faces[i].first.second;
-                    unsigned int n3 = Faces[i].second.first;
-                    unsigned int n4 = Faces[i].second.second;
-
-                    // check if the face contain any vertex, then these vertices are middle nodes
-                    double xi_min  = std::min(std::min(Binning.GetX(n1), Binning.GetX(n2)), std::min(Binning.GetX(n3), Binning.GetX(n4)));
-                    double xi_max  = std::max(std::max(Binning.GetX(n1), Binning.GetX(n2)), std::max(Binning.GetX(n3), Binning.GetX(n4)));
-                    double eta_min  = std::min(std::min(Binning.GetY(n1), Binning.GetY(n2)), std::min(Binning.GetY(n3), Binning.GetY(n4)));
-                    double eta_max  = std::max(std::max(Binning.GetY(n1), Binning.GetY(n2)), std::max(Binning.GetY(n3), Binning.GetY(n4)));
-                    double zeta_min  = std::min(std::min(Binning.GetZ(n1), Binning.GetZ(n2)), std::min(Binning.GetZ(n3), Binning.GetZ(n4)));
-                    double zeta_max  = std::max(std::max(Binning.GetZ(n1), Binning.GetZ(n2)), std::max(Binning.GetZ(n3), Binning.GetZ(n4)));
-                    for(unsigned int i = 0; i < Binning.NumberOfNodes(); ++i)
+                    // extract faces
+                    typedef std::pair<unsigned int, unsigned int> edge_t;
+                    typedef std::pair<edge_t, edge_t> face_t;
+                    std::vector<face_t> Faces;
+
+                    Faces.push_back(face_t(edge_t(CellNodes[0], CellNodes[1]), edge_t(CellNodes[2], CellNodes[3])));
+                    Faces.push_back(face_t(edge_t(CellNodes[4], CellNodes[5]), edge_t(CellNodes[6], CellNodes[7])));
+                    Faces.push_back(face_t(edge_t(CellNodes[0], CellNodes[1]), edge_t(CellNodes[5], CellNodes[4])));
+                    Faces.push_back(face_t(edge_t(CellNodes[1], CellNodes[2]), edge_t(CellNodes[6], CellNodes[5])));
+                    Faces.push_back(face_t(edge_t(CellNodes[2], CellNodes[3]), edge_t(CellNodes[7], CellNodes[6])));
+                    Faces.push_back(face_t(edge_t(CellNodes[3], CellNodes[0]), edge_t(CellNodes[4], CellNodes[7])));
+
+                    // detect middle nodes on faces
+                    for(std::size_t i = 0; i < Faces.size(); ++i)
                     {
-                        unsigned int Id = i + 1;
-                        double xi = Binning.GetX(Id);
-                        double eta = Binning.GetY(Id);
-                        double zeta = Binning.GetZ(Id);
-                        bool is_inside = false;
-                        if(xi_min == xi_max)
-                        {
-                            is_inside = is_inside || xi == xi_min &&
-                                (   ((eta_min<eta && eta<eta_max) && (zeta_min<zeta && zeta<zeta_max))
-                                 || ((eta_min==eta || eta==eta_max) && (zeta_min<zeta && zeta<zeta_max))
-                                 || ((eta_min<eta && eta<eta_max) && (zeta_min==zeta || zeta==zeta_max))   );
-                        }
-                        else if(eta_min == eta_max)
+                        unsigned int n1 = Faces[i].first.first - 1;
+                        unsigned int n2 = Faces[i].first.second - 1;
+                        unsigned int n3 = Faces[i].second.first - 1;
+                        unsigned int n4 = Faces[i].second.second - 1;
+
+                        // check if the face contain any vertex, then these vertices are middle nodes
+                        double xi_min  = std::min(std::min(Params[3*n1], Params[3*n2]), std::min(Params[3*n3], Params[3*n4]));
+                        double xi_max  = std::max(std::max(Params[3*n1], Params[3*n2]), std::max(Params[3*n3], Params[3*n4]));
+                        double eta_min  = std::min(std::min(Params[3*n1 + 1], Params[3*n2 + 1]), std::min(Params[3*n3 + 1], Params[3*n4 + 1]));
+                        double eta_max  = std::max(std::max(Params[3*n1 + 1], Params[3*n2 + 1]), std::max(Params[3*n3 + 1], Params[3*n4 + 1]));
+                        double zeta_min  = std::min(std::min(Params[3*n1 + 2], Params[3*n2 + 2]), std::min(Params[3*n3 + 2], Params[3*n4 + 2]));
+                        double zeta_max  = std::max(std::max(Params[3*n1 + 2], Params[3*n2 + 2]), std::max(Params[3*n3 + 2], Params[3*n4 + 2]));
+                        for(unsigned int i = 0; i < NumberOfVertices; ++i)
                         {
-                            is_inside = is_inside || eta == eta_min &&
-                                (   ((xi_min<xi && xi<xi_max) && (zeta_min<zeta && zeta<zeta_max))
-                                 || ((xi_min==xi || xi==xi_max) && (zeta_min<zeta && zeta<zeta_max))
-                                 || ((xi_min<xi && xi<xi_max) && (zeta_min==zeta || zeta==zeta_max))   );
-                        }
-                        else if(zeta_min == zeta_max)
-                        {
-                            is_inside = is_inside || zeta == zeta_min &&
-                                (   ((xi_min<xi && xi<xi_max) && (eta_min<eta && eta<eta_max))
-                                 || ((xi_min==xi || xi==xi_max) && (eta_min<eta && eta<eta_max))
-                                 || ((xi_min<xi && xi<xi_max) && (eta_min==eta || eta==eta_max))   );
-                        }
-                        else
-                            KRATOS_THROW_ERROR(std::logic_error, "Something wrong with the surface, it must align with 1 of the 3 base surfaces", "")
+                            double xi = Params[3*i];
+                            double eta = Params[3*i + 1];
+                            double zeta = Params[3*i + 2];
+                            bool is_inside = false;
+                            if(xi_min == xi_max)
+                            {
+                                is_inside = is_inside || xi == xi_min &&
+                                    (   ((eta_min<eta && eta<eta_max) && (zeta_min<zeta && zeta<zeta_max))
+                                     || ((eta_min==eta || eta==eta_max) && (zeta_min<zeta && zeta<zeta_max))
+                                     || ((eta_min<eta && eta<eta_max) && (zeta_min==zeta || zeta==zeta_max))   );
+                            }
+                            else if(eta_min == eta_max)
+                            {
+                                is_inside = is_inside || eta == eta_min &&
+                                    (   ((xi_min<xi && xi<xi_max) && (zeta_min<zeta && zeta<zeta_max))
+                                     || ((xi_min==xi || xi==xi_max) && (zeta_min<zeta && zeta<zeta_max))
+                                     || ((xi_min<xi && xi<xi_max) && (zeta_min==zeta || zeta==zeta_max))   );
+                            }
+                            else if(zeta_min == zeta_max)
+                            {
+                                is_inside = is_inside || zeta == zeta_min &&
+                                    (   ((xi_min<xi && xi<xi_max) && (eta_min<eta && eta<eta_max))
+                                     || ((xi_min==xi || xi==xi_max) && (eta_min<eta && eta<eta_max))
+                                     || ((xi_min<xi && xi<xi_max) && (eta_min==eta || eta==eta_max))   );
+                            }
+                            else
+                                KRATOS_THROW_ERROR(std::logic_error, "Something wrong with the surface, it must align with 1 of the 3 base surfaces", "")
 
-                        if(is_inside)
-                            MiddleNodes.insert(Id);
+                            if(is_inside)
+                                MiddleNodes.insert(i + 1);
+                        }
                     }
                 }
-            }
 
-            if(MiddleNodes.size() == 0)
-            {
-                // the cell has no middle nodes, now generate the connectivities
-                std::vector<unsigned int> Conn(CellNodes.begin(), CellNodes.end());
-                Connectivities[(*it)->Id()].push_back(Conn);
-            }
-            else
-            {
-                // insert the middle vertices to the cell
-                CellNodes.insert(CellNodes.end(), MiddleNodes.begin(), MiddleNodes.end());
-
-                // generate triangles in case of 2D
-                if(TDim == 2)
+                std::vector<unsigned int>& Conns = CellConnectivities[c];
+                if(MiddleNodes.size() == 0)
                 {
-                    // prepare the list of points
-                    std::vector<double> XYlist;
-                    for(std::size_t i = 0; i < CellNodes.size(); ++i)
-                    {
-                        XYlist.push_back(Binning.GetX(CellNodes[i]));
-                        XYlist.push_back(Binning.GetY(CellNodes[i]));
-                    }
-
-                    // generate the triangulation
-                    TriangulationUtils util;
-                    std::vector<std::vector<unsigned int> > tris;
-                    util.ComputeDelaunayTriangulation(XYlist, tris);
-
-                    // map the triangle connectivities to node Id
-                    std::vector<std::vector<unsigned int> > Conns(tris.size());
-                    for(std::size_t i = 0; i < tris.size(); ++i)
-                        for(std::size_t j = 0; j < tris[i].size(); ++j)
-                            Conns[i].push_back(CellNodes[tris[i][j]]);
-
-                    Connectivities[(*it)->Id()] = Conns;
+                    // the cell has no middle nodes, now generate the connectivities
+                    rGeology.element_sizes[c] = CellNodes.size();
+                    Conns = CellNodes;
                 }
-                // generate tetrahedrons in case of 3D
-                else if(TDim == 3)
+                else
                 {
-                    #if !defined(ISOGEOMETRIC_USE_TETGEN)
-                    KRATOS_THROW_ERROR(std::runtime_error, __FUNCTION__, "requires Tetgen to generate tetrahedrons for cells")
-                    #endif
+                    // insert the middle vertices to the cell
+                    CellNodes.insert(CellNodes.end(), MiddleNodes.begin(), MiddleNodes.end());
 
-                    tetgenio in, out;
+                    // generate triangles in case of 2D
+                    if(TDim == 2)
+                    {
+                        // prepare the list of points
+                        std::vector<double> XYlist;
+                        for(std::size_t i = 0; i < CellNodes.size(); ++i)
+                        {
+                            XYlist.push_back(Params[3*(CellNodes[i] - 1)]);
+                            XYlist.push_back(Params[3*(CellNodes[i] - 1) + 1]);
+                        }
 
-                    // initialize tetgen I/O
-                    in.initialize();
-                    out.initialize();
+                        // generate the triangulation
+                        TriangulationUtils util;
+                        util.ComputeDelaunayTriangulation(XYlist, Conns);
 
-                    // All indices start from 1.
-                    in.firstnumber = 1;
+                        // map the triangle connectivities to node Id
+                        for(std::size_t i = 0; i < Conns.size(); ++i)
+                            Conns[i] = CellNodes[Conns[i]];
 
-                    // fill in points
-                    in.numberofpoints = CellNodes.size();
-                    in.pointlist = new REAL[in.numberofpoints * 3];
-                    for(std::size_t i = 0; i < CellNodes.size(); ++i)
-                    {
-                        in.pointlist[3*i    ] = Binning.GetX(CellNodes[i]);
-                        in.pointlist[3*i + 1] = Binning.GetY(CellNodes[i]);
-                        in.pointlist[3*i + 2] = Binning.GetZ(CellNodes[i]);
+                        rGeology.element_sizes[c] = 3;
                     }
+                    // generate tetrahedrons in case of 3D
+                    else if(TDim == 3)
+                    {
+                        #if defined(ISOGEOMETRIC_USE_TETGEN)
+                        tetgenio in, out; // each cell has its own tetgen I/O, the predicates of tetgen are thread local and its look-up tables are initialized once
 
-                    // tetrahedralize
-                    std::string settings("Q"); // silent all output
-                    tetrahedralize((char*)settings.c_str(), &in, &out);
+                        // All indices start from 1.
+                        in.firstnumber = 1;
 
-                    // extract the tetrahedrons
-                    unsigned int cnt = 0;
-                    std::vector<std::vector<unsigned int> > Conns(out.numberoftetrahedra);
-                    for(std::size_t i = 0; i < out.numberoftetrahedra; ++i)
-                        for(std::size_t j = 0; j < 4; ++j)
-                            Conns[i].push_back(CellNodes[out.tetrahedronlist[cnt++] - 1]);
+                        // fill in points
+                        in.numberofpoints = CellNodes.size();
+                        in.pointlist = new REAL[in.numberofpoints * 3];
+                        for(std::size_t i = 0; i < CellNodes.size(); ++i)
+                        {
+                            in.pointlist[3*i    ] = Params[3*(CellNodes[i] - 1)];
+                            in.pointlist[3*i + 1] = Params[3*(CellNodes[i] - 1) + 1];
+                            in.pointlist[3*i + 2] = Params[3*(CellNodes[i] - 1) + 2];
+                        }
 
-                    Connectivities[(*it)->Id()] = Conns;
+                        // tetrahedralize; the points are inserted in the input order (-b/1), since the random permutation of
+                        // tetgen uses the global random generator, which is shared between the threads
+                        std::string settings("Qb/1"); // silent all output
+                        tetrahedralize((char*)settings.c_str(), &in, &out);
+
+                        // extract the tetrahedrons
+                        Conns.resize(4*out.numberoftetrahedra);
+                        for(std::size_t i = 0; i < Conns.size(); ++i)
+                            Conns[i] = CellNodes[out.tetrahedronlist[i] - 1];
+
+                        rGeology.element_sizes[c] = 4;
+                        #else
+                        KRATOS_THROW_ERROR(std::runtime_error, __FUNCTION__, "requires Tetgen to generate tetrahedrons for cells")
+                        #endif
+                    }
+                }
+            }
+            catch (std::exception& e)
+            {
+                #pragma omp critical
+                {
+                    if (error_message.empty())
+                        error_message = e.what();
+                }
+            }
+            catch (...) // tetgen throws an error code
+            {
+                #pragma omp critical
+                {
+                    if (error_message.empty())
+                        error_message = "Error generating the cell geology";
                 }
             }
         }
+
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
+
+        // gather the connectivities of the cells
+        rGeology.cell_offsets.resize(NumberOfCells + 1);
+        rGeology.cell_offsets[0] = 0;
+        for(std::size_t c = 0; c < NumberOfCells; ++c)
+            rGeology.cell_offsets[c+1] = rGeology.cell_offsets[c] + CellConnectivities[c].size();
+
+        rGeology.connectivities.resize(rGeology.cell_offsets[NumberOfCells]);
+        #pragma omp parallel for
+        for(int c = 0; c < static_cast<int>(NumberOfCells); ++c)
+            std::copy(CellConnectivities[c].begin(), CellConnectivities[c].end(), rGeology.connectivities.begin() + rGeology.cell_offsets[c]);
     }
 
     /**
@@ -2523,6 +2595,5 @@ namespace Kratos
 
 #undef MDPA_NODE_RENUMBERING
 #undef MDPA_CELL_RENUMBERING
-#undef ENABLE_PROFILING
 #undef DEBUG_REFINE
 
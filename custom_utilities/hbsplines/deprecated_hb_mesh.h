@@ -292,6 +292,14 @@ public:
     /// Export the cell geology as the post MDPA file
     void ExportCellGeologyAsPostMDPA(std::string fn);
 
+    /// Export the cell geology as a binary file, in the native byte order. The file contains, in order:
+    /// the header "HBCELLGEOLOGY" (13 characters), the dimension (int32), the number of vertices n, the number of cells m and
+    /// the size of the connectivities (uint64 each); then the global coordinates of the vertices (n*3 double), their local
+    /// coordinates in the parent cell (n*3 double), the parent cell Id of the vertices (n uint32), the cell Ids (m uint32),
+    /// the number of nodes of the elements of each cell (m uint32), the offsets of the cells in the connectivities ((m+1) uint64)
+    /// and the connectivities (uint32). The vertex Ids are 1...n.
+    void ExportCellGeologyAsBinary(std::string fn);
+
     /**************************************************************************
                             DEBUG INTERFACE
     **************************************************************************/
@@ -338,6 +346,25 @@ private:
         }
     }
 
+    /// Cell geology in flat arrays. The vertex with Id i+1 has the global coordinates coordinates[3*i...3*i+2] and the local
+    /// coordinates local_coordinates[3*i...3*i+2] in its parent cell parent_cells[i]. The elements of the cell cell_ids[c] are
+    /// stored in connectivities[cell_offsets[c]...cell_offsets[c+1]-1], each element having element_sizes[c] nodes
+    /// (4 or 3 in 2D, 8 or 4 in 3D).
+    struct CellGeology
+    {
+        std::vector<double> coordinates;
+        std::vector<double> local_coordinates;
+        std::vector<unsigned int> parent_cells;
+        std::vector<unsigned int> cell_ids;
+        std::vector<unsigned int> element_sizes;
+        std::vector<std::size_t> cell_offsets;
+        std::vector<unsigned int> connectivities;
+    };
+
+    /// Generate the cell geology in flat arrays. The vertices are evaluated and the cells are triangulated/tetrahedralized
+    /// in parallel, each cell independently.
+    void GenerateCellGeology(CellGeology& rGeology);
+
     /// Generate the cell geological map for Matlab rendering and post processing
     void GenerateCellGeology(std::vector<unsigned int>& point_list, // list of node Id (of the active basis function) in the hierarchical mesh
                              std::map<unsigned int, double>& X_list, // global x-coordinate of the node in point_list
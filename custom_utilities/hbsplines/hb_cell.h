@@ -49,11 +49,11 @@ public:
 
     /// Default constructor
     HBCell(const std::size_t& Id, knot_t pLeft, knot_t pRight, knot_t pDown, knot_t pUp)
-    : BaseType(Id, pLeft, pRight, pDown, pUp)
+    : BaseType(Id, pLeft, pRight, pDown, pUp), mIsDirty(true)
     {}
 
     HBCell(const std::size_t& Id, knot_t pLeft, knot_t pRight, knot_t pDown, knot_t pUp, knot_t pBelow, knot_t pAbove)
-    : BaseType(Id, pLeft, pRight, pDown, pUp, pBelow, pAbove)
+    : BaseType(Id, pLeft, pRight, pDown, pUp, pBelow, pAbove), mIsDirty(true)
     {}
 
     /// Destructor
@@ -68,26 +68,19 @@ public:
 
     /// Add the basis function to the set. If it does exist in the set, return the internal one.
     /// Typically one shall add the basis function that has support domain covering this cell.
-    bf_t AddBf(bf_t p_bf)
+    bf_t AddBf(const bf_t& p_bf)
     {
-        for(bf_iterator it = bf_begin(); it != bf_end(); ++it)
-            if(*it == p_bf)
-                return *it;
-        mpBasisFuncs.insert(p_bf);
-        return p_bf;
+        std::pair<bf_iterator, bool> res = mpBasisFuncs.insert(p_bf);
+        if(res.second)
+            mIsDirty = true;
+        return *(res.first);
     }
 
     /// Remove basis function from the set
     void RemoveBf(bf_t p_bf)
     {
-        for(bf_iterator it = bf_begin(); it != bf_end(); ++it)
-        {
-            if(*it == p_bf)
-            {
-                mpBasisFuncs.erase(it);
-                break;
-            }
-        }
+        if(mpBasisFuncs.erase(p_bf) != 0)
+            mIsDirty = true;
     }
 
     /// Iterators
@@ -99,6 +92,12 @@ public:
     /// Number of basis functions that covers this cell
     std::size_t size() const {return mpBasisFuncs.size();}
 
+    /// Check if the set of basis functions has changed since the extraction operator was last computed
+    bool IsDirty() const {return mIsDirty;}
+
+    /// Set/clear the flag marking that the extraction operator of this cell must be recomputed
+    void SetDirty(const bool& IsDirty) {mIsDirty = IsDirty;}
+
     /// Information
     virtual void PrintInfo(std::ostream& rOStream) const
     {
@@ -118,6 +117,7 @@ private:
 
     std::size_t mLevel;
     bf_container_t mpBasisFuncs; // list of basis functions contain this cell in its support
+    bool mIsDirty; // true if the basis functions were added/removed after the last computation of the extraction operator
 };
 
 /// output stream function
@@ -132,25 +132,15 @@ public:
     }
 
     /// Add a cell support this basis function to the list
-    cell_iterator AddCell(cell_t p_cell)
+    cell_iterator AddCell(const cell_t& p_cell)
     {
-        for(cell_iterator it = cell_begin(); it != cell_end(); ++it)
-            if(*it == p_cell)
-                return it;
         return mpCells.insert(p_cell).first;
     }
 
     /// Remove the cell from the list
     void RemoveCell(cell_t p_cell)
     {
-        for(cell_iterator it = cell_begin(); it != cell_end(); ++it)
-        {
-            if(*it == p_cell)
-            {
-                mpCells.erase(it);
-                break;
-            }
-        }
+        mpCells.erase(p_cell);
     }
 
     /// Set the local knot vectors to this basis function
@@ -11,6 +11,7 @@
 
 // System includes
 #include <vector>
+#include <algorithm>
 
 // External includes
 #include <boost/array.hpp>
@@ -65,10 +66,11 @@ public:
     typedef DomainManager::Pointer domain_t;
     typedef std::map<std::size_t, domain_t> domain_container_t;
 
-    typedef std::map<std::size_t, bf_t> function_map_t;
+    typedef std::map<std::size_t, std::size_t> function_map_t;
+    typedef std::map<std::vector<std::vector<knot_t> >, bf_t> knots_map_t;
 
     /// Default constructor
-    HBSplinesFESpace() : BaseType(), m_function_map_is_created(false), mLastLevel(1), mMaxLevel(10)
+    HBSplinesFESpace() : BaseType(), m_function_map_is_created(false), mLastLevel(1), mMaxLevel(10), m_knots_map_is_created(false)
     {
         if (TDim == 2)
         {
@@ -94,9 +96,12 @@ public:
     bf_t CreateBf(const std::size_t& Id, const std::size_t& Level, const std::vector<std::vector<knot_t> >& rpKnots)
     {
         // search in the current list of basis functions, the one that has the same local knot vector with provided ones
-        for(bf_iterator it = bf_begin(); it != bf_end(); ++it)
-            if((*it)->Contain(rpKnots))
-                return *it;
+        if(!m_knots_map_is_created)
+            CreateKnotsMap();
+
+        typename knots_map_t::iterator it = mKnotsMap.find(KnotsKey(rpKnots));
+        if(it != mKnotsMap.end())
+            return it->second;
 
         // create the new bf and add the knot
         bf_t p_bf = bf_t(new BasisFunctionType(Id, Level));
@@ -106,6 +111,7 @@ public:
             p_bf->SetInfo(dim, this->Order(dim));
         }
         mpBasisFuncs.insert(p_bf);
+        mKnotsMap[KnotsKey(rpKnots)] = p_bf;
         m_function_map_is_created = false;
 
         return p_bf;
@@ -114,7 +120,15 @@ public:
     /// Remove the basis functions from the container
     void RemoveBf(bf_t p_bf)
     {
+        if(m_knots_map_is_created)
+        {
+            std::vector<std::vector<knot_t> > pKnots(TDim);
+            for (int dim = 0; dim < TDim; ++dim)
+                pKnots[dim] = p_bf->LocalKnots(dim);
+            mKnotsMap.erase(pKnots);
+        }
         mpBasisFuncs.erase(p_bf);
+        m_function_map_is_created = false;
     }
 
     // Iterators for the basis functions
@@ -194,13 +208,125 @@ public:
     /// Get the values of the basis function i at point xi
     virtual double GetValue(const std::size_t& i, const std::vector<double>& xi) const
     {
-        KRATOS_THROW_ERROR(std::logic_error, "GetValue is not implemented for dimension", TDim)
+        std::vector<std::size_t> indices;
+        std::vector<double> values;
+        this->GetNonZeroValues(xi, indices, values);
+        std::vector<std::size_t>::iterator it = std::lower_bound(indices.begin(), indices.end(), i);
+        if(it != indices.end() && *it == i)
+            return values[it - indices.begin()];
+        return 0.0;
     }
 
     /// Get the values of the basis functions at point xi
     virtual std::vector<double> GetValue(const std::vector<double>& xi) const
     {
-        KRATOS_THROW_ERROR(std::logic_error, "GetValue is not implemented for dimension", TDim)
+        std::vector<std::size_t> indices;
+        std::vector<double> values;
+        this->GetNonZeroValues(xi, indices, values);
+        std::vector<double> all_values(this->TotalNumber(), 0.0);
+        for(std::size_t i = 0; i < indices.size(); ++i)
+            all_values[indices[i]] = values[i];
+        return all_values;
+    }
+
+    /// Get the local indices and the values of the basis functions supported on the active cell containing point xi.
+    /// The cell is located by the spatial index of the cell manager, then the Bernstein polynomials on the cell are
+    /// multiplied with the extraction operator of each supported basis function. The cached extraction operator is used
+    /// if the cell is up-to-date (see ConstructCellManager); otherwise the rows are computed on the fly.
+    /// The values are non-rational, as for the other FESpaces.
+    /// The search maps are created at the first call if they are outdated, hence UpdateSearchMaps shall be called before calling it from several threads.
+    virtual void GetNonZeroValues(const std::vector<double>& xi, std::vector<std::size_t>& rIndices, std::vector<double>& rValues) const
+    {
+        cell_t p_cell = this->FindCell(xi);
+        if(p_cell == NULL)
+        {
+            std::stringstream ss;
+            for(std::size_t dim = 0; dim < xi.size(); ++dim)
+                ss << " " << xi[dim];
+            KRATOS_THROW_ERROR(std::runtime_error, "No active cell contains the point", ss.str())
+        }
+
+        if(!m_function_map_is_created)
+            CreateFunctionsMap();
+
+        // compute the Bernstein polynomials on the cell in each direction
+        const double lower[] = {p_cell->LeftValue(), p_cell->DownValue(), p_cell->BelowValue()};
+        const double upper[] = {p_cell->RightValue(), p_cell->UpValue(), p_cell->AboveValue()};
+        std::vector<double> bernstein[TDim];
+        std::size_t nbezier = 1;
+        for(int dim = 0; dim < TDim; ++dim)
+        {
+            bernstein[dim].resize(this->Order(dim) + 1);
+            BezierUtils::bernstein(bernstein[dim], this->Order(dim), (xi[dim] - lower[dim]) / (upper[dim] - lower[dim]));
+            nbezier *= bernstein[dim].size();
+        }
+
+        // tensor product of the Bernstein polynomials, with the last direction running fastest as in the Bezier geometries
+        std::vector<double> bezier_values(nbezier);
+        for(std::size_t b = 0; b < nbezier; ++b)
+        {
+            std::size_t tmp = b;
+            bezier_values[b] = 1.0;
+            for(int dim = TDim - 1; dim >= 0; --dim)
+            {
+                bezier_values[b] *= bernstein[dim][tmp % bernstein[dim].size()];
+                tmp /= bernstein[dim].size();
+            }
+        }
+
+        // apply the extraction operator of each supported basis function
+        std::vector<std::pair<std::size_t, double> > support;
+        support.reserve(p_cell->size());
+        if(!p_cell->IsDirty() && p_cell->NumberOfAnchors() == p_cell->size())
+        {
+            const std::vector<typename CellType::IndexType>& row_ptr = p_cell->ExtractionRowPointers();
+            const std::vector<typename CellType::IndexType>& col_ind = p_cell->ExtractionColumnIndices();
+            const std::vector<double>& ext_values = p_cell->ExtractionValues();
+            std::size_t j = 0;
+            for(typename CellType::bf_iterator it_bf = p_cell->bf_begin(); it_bf != p_cell->bf_end(); ++it_bf, ++j)
+            {
+                double N = 0.0;
+                for(std::size_t k = row_ptr[j]; k < row_ptr[j+1]; ++k)
+                    N += ext_values[k] * bezier_values[col_ind[k]];
+                support.push_back(std::make_pair(FunctionIndex((*it_bf)->Id()), N));
+            }
+        }
+        else
+        {
+            Vector Crow;
+            for(typename CellType::bf_iterator it_bf = p_cell->bf_begin(); it_bf != p_cell->bf_end(); ++it_bf)
+            {
+                (*it_bf)->ComputeExtractionOperator(Crow, p_cell);
+                double N = 0.0;
+                for(std::size_t k = 0; k < Crow.size(); ++k)
+                    N += Crow(k) * bezier_values[k];
+                support.push_back(std::make_pair(FunctionIndex((*it_bf)->Id()), N));
+            }
+        }
+
+        std::sort(support.begin(), support.end());
+        rIndices.resize(support.size());
+        rValues.resize(support.size());
+        for(std::size_t i = 0; i < support.size(); ++i)
+        {
+            rIndices[i] = support[i].first;
+            rValues[i] = support[i].second;
+        }
+    }
+
+    /// Find the active cell containing the point xi in knot space. A null pointer is returned if the point is outside the domain.
+    cell_t FindCell(const std::vector<double>& xi) const
+    {
+        return mpCellManager->FindCell(xi);
+    }
+
+    /// Create the maps to access the basis functions and the cells by Id/index if they are outdated. The maps are otherwise
+    /// created at the first access, hence this shall be called before evaluating the FESpace from several threads.
+    virtual void UpdateSearchMaps() const
+    {
+        if(!m_function_map_is_created)
+            CreateFunctionsMap();
+        mpCellManager->UpdateCellsMap();
     }
 
     /// Compare between two BSplines patches in terms of parametric information
@@ -274,6 +400,9 @@ public:
             ++cnt;
         }
 
+        // the functions map is keyed by the old ids
+        m_function_map_is_created = false;
+
         return start;
     }
 
@@ -313,22 +442,53 @@ public:
     /// Get the underlying cell manager
     typename cell_container_t::ConstPointer pCellManager() const {return mpCellManager;}
 
-    /// Create the cell manager for all the cells in the support domain of the HBSplinesFESpace
+    /// Create the cell manager for all the cells in the support domain of the HBSplinesFESpace.
+    /// Only the cells whose set of basis functions changed since the last call (e.g. by refinement) have their extraction operators
+    /// recomputed, in parallel. For the other cells only the anchor ids and weights are refreshed, since the basis functions may have been re-enumerated.
     virtual typename BaseType::cell_container_t::Pointer ConstructCellManager() const
     {
-        // for each cell compute the extraction operator and add to the anchor
-        Vector Crow;
-        for(typename cell_container_t::iterator it_cell = mpCellManager->begin(); it_cell != mpCellManager->end(); ++it_cell)
+        std::vector<cell_t> cells(mpCellManager->begin(), mpCellManager->end());
+
+        // for each modified cell compute the extraction operator and add to the anchor
+        std::string error_message;
+        #pragma omp parallel for schedule(dynamic)
+        for(int i = 0; i < static_cast<int>(cells.size()); ++i)
         {
-            (*it_cell)->Reset();
-            for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
+            try
             {
-                (*it_bf)->ComputeExtractionOperator(Crow, *it_cell);
-                (*it_cell)->AddAnchor((*it_bf)->Id(), (*it_bf)->GetValue(CONTROL_POINT).W(), Crow);
+                if(cells[i]->IsDirty() || cells[i]->NumberOfAnchors() != cells[i]->size())
+                {
+                    Vector Crow;
+                    cells[i]->Reset();
+                    for(typename CellType::bf_iterator it_bf = cells[i]->bf_begin(); it_bf != cells[i]->bf_end(); ++it_bf)
+                    {
+                        (*it_bf)->ComputeExtractionOperator(Crow, cells[i]);
+                        cells[i]->AddAnchor((*it_bf)->Id(), (*it_bf)->GetValue(CONTROL_POINT).W(), Crow);
+                    }
+                    cells[i]->SetDirty(false);
+                }
+                else
+                {
+                    std::size_t j = 0;
+                    for(typename CellType::bf_iterator it_bf = cells[i]->bf_begin(); it_bf != cells[i]->bf_end(); ++it_bf, ++j)
+                        cells[i]->SetAnchor(j, (*it_bf)->Id(), (*it_bf)->GetValue(CONTROL_POINT).W());
+                }
+            }
+            catch(std::exception& e)
+            {
+                #pragma omp critical
+                {
+                    if(error_message.empty())
+                        error_message = e.what();
+                }
             }
         }
 
-        // create the compatible cell manager and add to the list
+        if(!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
+
+        // create the compatible cell manager and add to the list. A new container is returned at each call, hence the caller
+        // can add or remove cells without affecting the FESpace; the cells themselves are shared with the FESpace.
         typename BaseType::cell_container_t::Pointer pCompatCellManager;
         if (TDim == 2)
             pCompatCellManager = CellManager2D<typename BaseType::cell_container_t::CellType>::Create();
@@ -345,9 +505,21 @@ public:
     /// Overload operator[], this allows to access the basis function randomly based on index
     bf_t operator[](const std::size_t& i)
     {
-        typename bf_container_t::iterator it = mpBasisFuncs.begin();
-        std::advance(it, i);
-        return *it;
+        // create the index map if it's not created yet
+        if(!m_function_map_is_created)
+            CreateFunctionsMap();
+
+        return mFunctionsVector[i];
+    }
+
+    /// Check if the basis function with the given id exists in the space
+    bool HasBf(const std::size_t& Id) const
+    {
+        // create the index map if it's not created yet
+        if(!m_function_map_is_created)
+            CreateFunctionsMap();
+
+        return mFunctionsMap.find(Id) != mFunctionsMap.end();
     }
 
     /// Overload operator(), this allows to access the basis function based on its id
@@ -360,7 +532,7 @@ public:
         // return the bf if its Id exist in the list
         typename function_map_t::iterator it = mFunctionsMap.find(Id);
         if(it != mFunctionsMap.end())
-            return it->second;
+            return mFunctionsVector[it->second];
         else
             KRATOS_THROW_ERROR(std::runtime_error, "Access index is not found:", Id)
     }
@@ -436,17 +608,50 @@ private:
     typename cell_container_t::Pointer mpCellManager;
 
     bf_container_t mpBasisFuncs;
-    mutable function_map_t mFunctionsMap; // map from basis function id to the basis function. It's mainly used to search for the bf quickly. But it needs to be re-initialized whenever new bf is added to the set
-    bool m_function_map_is_created;
+    mutable function_map_t mFunctionsMap; // map from basis function id to its index. It's mainly used to search for the bf quickly. But it needs to be re-initialized whenever a bf is added to or removed from the set
+    mutable std::vector<bf_t> mFunctionsVector; // the basis functions ordered by index
+    mutable bool m_function_map_is_created;
 
-    void CreateFunctionsMap()
+    void CreateFunctionsMap() const
     {
         mFunctionsMap.clear();
-        for(bf_iterator it = bf_begin(); it != bf_end(); ++it)
-            mFunctionsMap[(*it)->Id()] = *it;
+        mFunctionsVector.assign(bf_begin(), bf_end());
+        for(std::size_t i = 0; i < mFunctionsVector.size(); ++i)
+            mFunctionsMap[mFunctionsVector[i]->Id()] = i;
         m_function_map_is_created = true;
     }
 
+    /// Get the index of the basis function from the functions map
+    std::size_t FunctionIndex(const std::size_t& Id) const
+    {
+        typename function_map_t::const_iterator it = mFunctionsMap.find(Id);
+        if(it == mFunctionsMap.end())
+            KRATOS_THROW_ERROR(std::logic_error, "The basis function is not found in the functions map:", Id)
+        return it->second;
+    }
+
+    knots_map_t mKnotsMap; // map from the local knot vectors to the basis function. It's used to check quickly if a bf exists. It is kept up-to-date by CreateBf and RemoveBf.
+    bool m_knots_map_is_created;
+
+    void CreateKnotsMap()
+    {
+        mKnotsMap.clear();
+        for(bf_iterator it = bf_begin(); it != bf_end(); ++it)
+        {
+            std::vector<std::vector<knot_t> > pKnots(TDim);
+            for (int dim = 0; dim < TDim; ++dim)
+                pKnots[dim] = (*it)->LocalKnots(dim);
+            mKnotsMap[pKnots] = *it;
+        }
+        m_knots_map_is_created = true;
+    }
+
+    /// Extract the key of the knots map, i.e. the local knot vectors in the TDim directions
+    static std::vector<std::vector<knot_t> > KnotsKey(const std::vector<std::vector<knot_t> >& rpKnots)
+    {
+        return std::vector<std::vector<knot_t> >(rpKnots.begin(), rpKnots.begin() + TDim);
+    }
+
     domain_container_t mSupportDomains; // this domain manager manages the support of all bfs in each level
 
     std::vector<std::size_t> mRefinementHistory;
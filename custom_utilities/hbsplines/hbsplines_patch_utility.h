@@ -245,21 +245,21 @@ inline Patch<3>::Pointer HBSplinesPatchUtility_Helper<3>::CreatePatchFromBSpline
     {
         // create and fill the local knot vector
         std::vector<knot_t> pLocalKnots3;
-        for(std::size_t k = 0; k < pFESpace->KnotVector(2).size() + 2; ++k)
+        for(std::size_t k = 0; k < pFESpace->Order(2) + 2; ++k)
             pLocalKnots3.push_back(pFESpace->KnotVector(2).pKnotAt(l + k));
 
         for(std::size_t j = 0; j < number_2; ++j)
         {
             // create and fill the local knot vector
             std::vector<knot_t> pLocalKnots2;
-            for(std::size_t k = 0; k < pFESpace->KnotVector(1).size() + 2; ++k)
+            for(std::size_t k = 0; k < pFESpace->Order(1) + 2; ++k)
                 pLocalKnots2.push_back(pFESpace->KnotVector(1).pKnotAt(j + k));
 
             for(std::size_t i = 0; i < number_1; ++i)
             {
                 // create and fill the local knot vector
                 std::vector<knot_t> pLocalKnots1;
-                for(std::size_t k = 0; k < pFESpace->KnotVector(0).size() + 2; ++k)
+                for(std::size_t k = 0; k < pFESpace->Order(0) + 2; ++k)
                     pLocalKnots1.push_back(pFESpace->KnotVector(0).pKnotAt(i + k));
 
                 // create the basis function object
@@ -298,6 +298,10 @@ inline Patch<3>::Pointer HBSplinesPatchUtility_Helper<3>::CreatePatchFromBSpline
                         }
                     }
                 }
+
+                // transfer the control point
+                ControlPointType c = pPatch->pControlPointGridFunction()->pControlGrid()->GetData(i_func);
+                p_bf->SetValue(CONTROL_POINT, c);
             }
         }
     }
@@ -0,0 +1,180 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_HBSPLINES_POINT_EVALUATOR_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_HBSPLINES_POINT_EVALUATOR_H_INCLUDED
+
+// System includes
+#include <vector>
+
+// External includes
+#include <omp.h>
+
+// Project includes
+#include "includes/define.h"
+#include "custom_utilities/control_grid.h"
+#include "custom_utilities/hbsplines/hbsplines_fespace.h"
+
+namespace Kratos
+{
+
+/**
+Evaluate the control values of a hierarchical B-Splines patch at a set of parametric points.
+The active cell of each point is located by the spatial index of the cell manager, and only the basis functions supported
+on that cell are evaluated, through their extraction operators and the Bernstein polynomials (see HBSplinesFESpace::GetNonZeroValues).
+The extraction operators cached by HBSplinesFESpace::ConstructCellManager are used for the up-to-date cells, hence it shall be called
+after the refinement. The supports are computed in parallel at construction, so the points can be sampled repeatedly at the cost of
+a sparse product. The interface follows BSplinesPatchSampler.
+ */
+template<int TDim>
+class HBSplinesPointEvaluator
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(HBSplinesPointEvaluator);
+
+    /// Type definition
+    typedef HBSplinesFESpace<TDim> HBSplinesFESpaceType;
+
+    /// Constructor with the local coordinates of the points
+    HBSplinesPointEvaluator(typename HBSplinesFESpaceType::ConstPointer pFESpace, const std::vector<std::vector<double> >& points)
+    : mPoints(points)
+    {
+        // create the search maps, so that the evaluation is read-only
+        pFESpace->UpdateSearchMaps();
+
+        const std::size_t npoints = mPoints.size();
+        std::vector<std::vector<std::size_t> > indices(npoints);
+        std::vector<std::vector<double> > values(npoints);
+
+        std::string error_message;
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (int i = 0; i < static_cast<int>(npoints); ++i)
+        {
+            try
+            {
+                pFESpace->GetNonZeroValues(mPoints[i], indices[i], values[i]);
+            }
+            catch (std::exception& e)
+            {
+                #pragma omp critical
+                {
+                    if (error_message.empty())
+                        error_message = e.what();
+                }
+            }
+        }
+
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
+
+        // pack the supports in compressed rows
+        mRowPtr.resize(npoints + 1);
+        mRowPtr[0] = 0;
+        for (std::size_t i = 0; i < npoints; ++i)
+            mRowPtr[i+1] = mRowPtr[i] + indices[i].size();
+
+        mIndices.resize(mRowPtr[npoints]);
+        mValues.resize(mRowPtr[npoints]);
+        for (std::size_t i = 0; i < npoints; ++i)
+        {
+            std::copy(indices[i].begin(), indices[i].end(), mIndices.begin() + mRowPtr[i]);
+            std::copy(values[i].begin(), values[i].end(), mValues.begin() + mRowPtr[i]);
+        }
+    }
+
+    /// Destructor
+    virtual ~HBSplinesPointEvaluator() {}
+
+    /// Get the total number of points
+    std::size_t NumberOfPoints() const {return mPoints.size();}
+
+    /// Get the local coordinates of the point
+    void LocalCoordinates(const std::size_t& point, std::vector<double>& xi) const
+    {
+        xi = mPoints[point];
+    }
+
+    /// Get the non-zero basis functions at a point. The indices are the local indices in the control grid.
+    /// If the weights are provided, the rational basis functions are computed.
+    void GetSupport(const std::size_t& point, std::vector<std::size_t>& rIndices, std::vector<double>& rValues,
+            const std::vector<double>& rWeights) const
+    {
+        rIndices.assign(mIndices.begin() + mRowPtr[point], mIndices.begin() + mRowPtr[point+1]);
+        rValues.assign(mValues.begin() + mRowPtr[point], mValues.begin() + mRowPtr[point+1]);
+
+        if (rWeights.size() != 0)
+        {
+            double W = 0.0;
+            for (std::size_t s = 0; s < rIndices.size(); ++s)
+            {
+                rValues[s] *= rWeights[rIndices[s]];
+                W += rValues[s];
+            }
+            for (std::size_t s = 0; s < rIndices.size(); ++s)
+                rValues[s] /= W;
+        }
+    }
+
+    /// Evaluate the control grid at all points. If the weights are provided, the rational basis functions are used.
+    /// For the control points, the weights shall not be provided, since the control points are stored in homogeneous coordinates.
+    template<typename TDataType>
+    void Sample(std::vector<TDataType>& rResults, const ControlGrid<TDataType>& rControlGrid, const std::vector<double>& rWeights) const
+    {
+        const std::size_t npoints = this->NumberOfPoints();
+        rResults.resize(npoints);
+
+        #pragma omp parallel
+        {
+            std::vector<std::size_t> indices;
+            std::vector<double> values;
+
+            #pragma omp for
+            for (int i = 0; i < static_cast<int>(npoints); ++i)
+            {
+                this->GetSupport(i, indices, values, rWeights);
+                TDataType v = values[0] * rControlGrid.GetData(indices[0]);
+                for (std::size_t s = 1; s < indices.size(); ++s)
+                    v += values[s] * rControlGrid.GetData(indices[s]);
+                rResults[i] = v;
+            }
+        }
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "HBSplinesPointEvaluator" << TDim << "D, number of points = " << NumberOfPoints();
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+private:
+
+    std::vector<std::vector<double> > mPoints;
+    std::vector<std::size_t> mRowPtr;
+    std::vector<std::size_t> mIndices;
+    std::vector<double> mValues;
+
+};
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const HBSplinesPointEvaluator<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_HBSPLINES_POINT_EVALUATOR_H_INCLUDED defined
@@ -24,6 +24,7 @@
 #include "custom_utilities/grid_function.h"
 #include "custom_utilities/patch.h"
 #include "custom_utilities/hbsplines/hbsplines_fespace.h"
+#include "custom_utilities/isogeometric_profiler.h"
 
 
 namespace Kratos
@@ -36,8 +37,31 @@ struct HBSplinesRefinementUtility_Helper
     typedef KnotArray1D<double> knot_container_t;
     typedef typename knot_container_t::knot_t knot_t;
 
+    /// Buffer for the refinement of a single basis function, i.e. its children and the contributions to their control values
+    struct RefinementBuffer
+    {
+        std::vector<std::vector<knot_t> > new_local_knots; // local knot vectors with the inserted knots
+        std::vector<std::vector<double> > ins_knots; // inserted knots in each direction
+        std::vector<std::vector<std::vector<knot_t> > > children_knots; // local knot vectors of each child
+        std::vector<std::vector<knot_t> > cells; // knots of the nonzero-area cells covered by the children
+        std::vector<std::vector<std::size_t> > children_cells; // indices of the cells of each child
+        std::vector<ControlPoint<double> > control_points;
+        std::vector<std::vector<double> > double_values;
+        std::vector<std::vector<array_1d<double, 3> > > array_1d_values;
+        std::vector<std::vector<Vector> > vector_values;
+    };
+
     static void Refine(typename Patch<TDim>::Pointer pPatch, const std::size_t& Id, const int& EchoLevel);
 
+    static void RefineFunctions(typename Patch<TDim>::Pointer pPatch, const std::vector<std::size_t>& Ids, const int& EchoLevel);
+
+    static void ComputeChildren(const typename HBSplinesFESpace<TDim>::BasisFunctionType& r_bf,
+            const HBSplinesFESpace<TDim>& r_fespace,
+            const std::vector<Variable<double>*>& double_variables,
+            const std::vector<Variable<array_1d<double, 3> >*>& array_1d_variables,
+            const std::vector<Variable<Vector>*>& vector_variables,
+            RefinementBuffer& r_buffer);
+
     static void RefineWindow(typename Patch<TDim>::Pointer pPatch, const std::vector<std::vector<double> >& window, const int& EchoLevel);
 
     static void LinearDependencyRefine(typename Patch<TDim>::Pointer pPatch, const std::size_t& refine_cycle, const int& EchoLevel);
@@ -67,6 +91,16 @@ public:
     }
 
 
+    /// Refine a set of B-Splines basis functions
+    /// The basis functions are refined level by level, starting from the coarsest one. In each level the children and
+    /// the transfer of the control values are computed in parallel and then merged into the space.
+    template<int TDim>
+    static void RefineFunctions(typename Patch<TDim>::Pointer pPatch, const std::vector<std::size_t>& Ids, const int& EchoLevel)
+    {
+        HBSplinesRefinementUtility_Helper<TDim>::RefineFunctions(pPatch, Ids, EchoLevel);
+    }
+
+
     /// Refine the basis functions in a region
     template<int TDim>
     static void RefineWindow(typename Patch<TDim>::Pointer pPatch, const std::vector<std::vector<double> >& window, const int& EchoLevel)
@@ -107,302 +141,256 @@ inline std::ostream& operator <<(std::ostream& rOStream, const HBSplinesRefineme
 
 template<int TDim>
 inline void HBSplinesRefinementUtility_Helper<TDim>::Refine(typename Patch<TDim>::Pointer pPatch, const std::size_t& Id, const int& EchoLevel)
+{
+    std::vector<std::size_t> Ids(1, Id);
+    RefineFunctions(pPatch, Ids, EchoLevel);
+}
+
+template<int TDim>
+inline void HBSplinesRefinementUtility_Helper<TDim>::RefineFunctions(typename Patch<TDim>::Pointer pPatch, const std::vector<std::size_t>& Ids, const int& EchoLevel)
 {
     if (pPatch->pFESpace()->Type() != HBSplinesFESpace<TDim>::StaticType())
         KRATOS_THROW_ERROR(std::logic_error, __FUNCTION__, "only support the hierarchical B-Splines patch")
 
     // Type definitions
     typedef typename HBSplinesFESpace<TDim>::bf_t bf_t;
-    typedef typename HBSplinesFESpace<TDim>::bf_container_t bf_container_t;
     typedef typename HBSplinesFESpace<TDim>::CellType CellType;
     typedef typename HBSplinesFESpace<TDim>::cell_t cell_t;
     typedef typename HBSplinesFESpace<TDim>::cell_container_t cell_container_t;
+    typedef typename HBSplinesFESpace<TDim>::BasisFunctionType::cell_iterator bf_cell_iterator;
+    typedef std::set<cell_t, typename cell_container_t::cell_compare> cell_set_t;
     typedef typename Patch<TDim>::ControlPointType ControlPointType;
 
     // extract the hierarchical B-Splines space
     typename HBSplinesFESpace<TDim>::Pointer pFESpace = boost::dynamic_pointer_cast<HBSplinesFESpace<TDim> >(pPatch->pFESpace());
 
-    #ifdef ENABLE_PROFILING
-    double start = OpenMPUtils::GetCurrentTime();
-    #endif
+    IsogeometricProfiler::ScopedTimer timer("HBSplinesRefinementUtility::RefineFunctions");
 
-    // get the correct basis function
-    bf_t p_bf;
-    bool found = false;
-    for(typename bf_container_t::iterator it = pFESpace->bf_begin(); it != pFESpace->bf_end(); ++it)
+    // get the basis functions and group them by level. The levels are refined in ascending order, so that the children
+    // receive the contributions from all their parents before they are refined.
+    std::map<std::size_t, std::vector<bf_t> > level_bfs;
+    std::set<std::size_t> collected_ids;
+    for(std::size_t i = 0; i < Ids.size(); ++i)
     {
-        if((*it)->Id() == Id)
+        if(!pFESpace->HasBf(Ids[i])) continue;
+        if(!collected_ids.insert(Ids[i]).second) continue;
+
+        bf_t p_bf = (*pFESpace)(Ids[i]);
+
+        // does not refine if maximum level is reached
+        if(p_bf->Level() == pFESpace->MaxLevel())
         {
-            p_bf = *it;
-            found = true;
+            std::cout << "Maximum level is reached, basis function " << p_bf->Id() << " is skipped" << std::endl;
+            continue;
         }
-    }
-
-    if(!found) return;
 
-    // does not refine if maximum level is reached
-    if(p_bf->Level() == pFESpace->MaxLevel())
-    {
-        std::cout << "Maximum level is reached, basis function " << p_bf->Id() << " is skipped" << std::endl;
-        return;
+        level_bfs[p_bf->Level()].push_back(p_bf);
     }
 
+    if(level_bfs.size() == 0) return;
+
     // get the list of variables in the patch
     std::vector<Variable<double>*> double_variables = pPatch->template ExtractVariables<Variable<double> >();
     std::vector<Variable<array_1d<double, 3> >*> array_1d_variables = pPatch->template ExtractVariables<Variable<array_1d<double, 3> > >();
     std::vector<Variable<Vector>*> vector_variables = pPatch->template ExtractVariables<Variable<Vector> >();
 
-    /* create a list of basis function in the next level representing this basis function */
-    // create a list of new knots
     double tol = 1.0e-10; // TODO what is this? can we parameterize?
-    std::vector<std::vector<knot_t> > pnew_local_knots(TDim);
-    std::vector<std::vector<double> > ins_knots(TDim);
-    for(unsigned int dim = 0; dim < TDim; ++dim)
+    std::size_t last_id = pFESpace->LastId();
+
+    for(typename std::map<std::size_t, std::vector<bf_t> >::iterator it_level = level_bfs.begin(); it_level != level_bfs.end(); ++it_level)
     {
-        const std::vector<knot_t>& pLocalKnots = p_bf->LocalKnots(dim);
+        const std::vector<bf_t>& bfs = it_level->second;
+        const std::size_t next_level = it_level->first + 1;
+        if(next_level > pFESpace->LastLevel()) pFESpace->SetLastLevel(next_level);
 
-        for(std::vector<knot_t>::const_iterator it = pLocalKnots.begin(); it != pLocalKnots.end(); ++it)
-        {
-            pnew_local_knots[dim].push_back(*it);
+        std::vector<RefinementBuffer> buffers(bfs.size());
 
-            std::vector<knot_t>::const_iterator it2 = it + 1;
-            if(it2 != pLocalKnots.end())
+        /* create a list of new knots for each basis function. The knots are shared in the knot vectors of the space, hence it is done serially */
+        for(std::size_t ib = 0; ib < bfs.size(); ++ib)
+        {
+            buffers[ib].new_local_knots.resize(TDim);
+            buffers[ib].ins_knots.resize(TDim);
+            for(unsigned int dim = 0; dim < TDim; ++dim)
             {
-                if(fabs((*it2)->Value() - (*it)->Value()) > tol)
+                const std::vector<knot_t>& pLocalKnots = bfs[ib]->LocalKnots(dim);
+
+                for(std::vector<knot_t>::const_iterator it = pLocalKnots.begin(); it != pLocalKnots.end(); ++it)
                 {
-                    // now we just add the middle one, but in the general we can add arbitrary values
-                    // TODO: find the way to generalize this or parameterize this
-                    double ins_knot = 0.5 * ((*it)->Value() + (*it2)->Value());
-                    knot_t p_new_knot;
-                    p_new_knot = pFESpace->KnotVector(dim).pCreateUniqueKnot(ins_knot, tol);
-                    pnew_local_knots[dim].push_back(p_new_knot);
-                    ins_knots[dim].push_back(p_new_knot->Value());
+                    buffers[ib].new_local_knots[dim].push_back(*it);
+
+                    std::vector<knot_t>::const_iterator it2 = it + 1;
+                    if(it2 != pLocalKnots.end())
+                    {
+                        if(fabs((*it2)->Value() - (*it)->Value()) > tol)
+                        {
+                            // now we just add the middle one, but in the general we can add arbitrary values
+                            // TODO: find the way to generalize this or parameterize this
+                            double ins_knot = 0.5 * ((*it)->Value() + (*it2)->Value());
+                            knot_t p_new_knot = pFESpace->KnotVector(dim).pCreateUniqueKnot(ins_knot, tol);
+                            buffers[ib].new_local_knots[dim].push_back(p_new_knot);
+                            buffers[ib].ins_knots[dim].push_back(p_new_knot->Value());
+                        }
+                    }
                 }
             }
         }
-    }
 
-    /* compute the refinement coefficients */
-    Vector RefinedCoeffs;
-    std::vector<std::vector<double> > local_knots(TDim);
-    for(std::size_t dim = 0; dim < TDim; ++dim)
-        p_bf->LocalKnots(dim, local_knots[dim]);
+        timer.Lap("HBSplinesRefinementUtility::RefineFunctions::CreateKnots");
 
-    std::vector<std::vector<double> > new_knots(TDim);
-    if (TDim == 2)
-    {
-        BSplineUtils::ComputeBsplinesKnotInsertionCoefficients2DLocal(RefinedCoeffs,
-            new_knots[0], new_knots[1],
-            pFESpace->Order(0), pFESpace->Order(1),
-            local_knots[0], local_knots[1],
-            ins_knots[0], ins_knots[1]);
-    }
-    else if (TDim == 3)
-    {
-        BSplineUtils::ComputeBsplinesKnotInsertionCoefficients3DLocal(RefinedCoeffs,
-            new_knots[0], new_knots[1], new_knots[2],
-            pFESpace->Order(0), pFESpace->Order(1), pFESpace->Order(2),
-            local_knots[0], local_knots[1], local_knots[2],
-            ins_knots[0], ins_knots[1], ins_knots[2]);
-    }
-    // KRATOS_WATCH(RefinedCoeffs)
-
-    #ifdef ENABLE_PROFILING
-    double time_1 = OpenMPUtils::GetCurrentTime() - start;
-    start = OpenMPUtils::GetCurrentTime();
-    #endif
+        /* compute the children of each basis function and the transfer of the control values */
+        std::string error_message;
+        #pragma omp parallel for schedule(dynamic)
+        for(int ib = 0; ib < static_cast<int>(bfs.size()); ++ib)
+        {
+            try
+            {
+                ComputeChildren(*bfs[ib], *pFESpace, double_variables, array_1d_variables, vector_variables, buffers[ib]);
+            }
+            catch(std::exception& e)
+            {
+                #pragma omp critical
+                {
+                    if(error_message.empty())
+                        error_message = e.what();
+                }
+            }
+        }
 
-    /* create new basis functions */
-    unsigned int next_level = p_bf->Level() + 1;
-    if(next_level > pFESpace->LastLevel()) pFESpace->SetLastLevel(next_level);
-    double area_tol = 1.0e-6; // tolerance to accept the nonzero-area cell. We should parameterize it.
-    std::size_t last_id = pFESpace->LastId();
-    typename cell_container_t::Pointer pnew_cells;
+        if(!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
 
-    if (TDim == 2)
-    {
-        pnew_cells = typename cell_container_t::Pointer(new CellManager2D<CellType>());
+        timer.Lap("HBSplinesRefinementUtility::RefineFunctions::ComputeCoefficients");
 
-        std::size_t number_1 = pnew_local_knots[0].size() - pFESpace->Order(0) - 1;
-        std::size_t number_2 = pnew_local_knots[1].size() - pFESpace->Order(1) - 1;
-        for(std::size_t j = 0; j < number_2; ++j)
+        /* merge the children into the space */
+        for(std::size_t ib = 0; ib < bfs.size(); ++ib)
         {
-            // create and fill the local knot vector
-            std::vector<knot_t> pLocalKnots2;
-            for(std::size_t k = 0; k < pFESpace->Order(1) + 2; ++k)
-                pLocalKnots2.push_back(pnew_local_knots[1][j + k]);
+            bf_t p_bf = bfs[ib];
+            const RefinementBuffer& r_buffer = buffers[ib];
 
-            for(std::size_t i = 0; i < number_1; ++i)
+            /* create new basis functions and their cells */
+            cell_set_t pnew_cells;
+            std::vector<cell_t> pnew_cells_list(r_buffer.cells.size());
+            for(std::size_t i_func = 0; i_func < r_buffer.children_knots.size(); ++i_func)
             {
-                // create and fill the local knot vector
-                std::vector<knot_t> pLocalKnots1;
-                for(std::size_t k = 0; k < pFESpace->Order(0) + 2; ++k)
-                    pLocalKnots1.push_back(pnew_local_knots[0][i + k]);
-
-                // create the basis function object
-                std::vector<std::vector<knot_t> > pLocalKnots = {pLocalKnots1, pLocalKnots2};
-                bf_t pnew_bf = pFESpace->CreateBf(last_id+1, next_level, pLocalKnots);
+                bf_t pnew_bf = pFESpace->CreateBf(last_id+1, next_level, r_buffer.children_knots[i_func]);
                 if (pnew_bf->Id() == last_id+1) ++last_id;
 
-                std::size_t i_func = j * number_1 + i;
-
                 // transfer the control point information
-                ControlPointType oldC = p_bf->GetValue(CONTROL_POINT);
                 ControlPointType newC = pnew_bf->GetValue(CONTROL_POINT);
-                newC += RefinedCoeffs[i_func] * oldC;
+                newC += r_buffer.control_points[i_func];
                 pnew_bf->SetValue(CONTROL_POINT, newC);
 
                 // transfer other control values from p_bf to pnew_bf
                 for (std::size_t i = 0; i < double_variables.size(); ++i)
                 {
-                    double old_value = p_bf->GetValue(*double_variables[i]);
                     double new_value = pnew_bf->GetValue(*double_variables[i]);
-                    new_value += RefinedCoeffs[i_func] * old_value;
+                    new_value += r_buffer.double_values[i_func][i];
                     pnew_bf->SetValue(*double_variables[i], new_value);
                 }
 
                 for (std::size_t i = 0; i < array_1d_variables.size(); ++i)
                 {
-                    array_1d<double, 3> old_value = p_bf->GetValue(*array_1d_variables[i]);
                     array_1d<double, 3> new_value = pnew_bf->GetValue(*array_1d_variables[i]);
-                    new_value += RefinedCoeffs[i_func] * old_value;
+                    new_value += r_buffer.array_1d_values[i_func][i];
                     pnew_bf->SetValue(*array_1d_variables[i], new_value);
                 }
 
                 for (std::size_t i = 0; i < vector_variables.size(); ++i)
                 {
-                    Vector old_value = p_bf->GetValue(*vector_variables[i]);
                     Vector new_value = pnew_bf->GetValue(*vector_variables[i]);
-                    new_value += RefinedCoeffs[i_func] * old_value;
+                    new_value += r_buffer.vector_values[i_func][i];
                     pnew_bf->SetValue(*vector_variables[i], new_value);
                 }
 
-                // create the cells for the basis function
-                for(std::size_t i1 = 0; i1 < pFESpace->Order(0) + 1; ++i1)
+                // create the cells for the basis function. The children share the cells, hence each cell is only created once.
+                for(std::size_t i_cell = 0; i_cell < r_buffer.children_cells[i_func].size(); ++i_cell)
                 {
-                    knot_t pLeft = pnew_local_knots[0][i + i1];
-                    knot_t pRight = pnew_local_knots[0][i + i1 + 1];
-                    for(std::size_t j1 = 0; j1 < pFESpace->Order(1) + 1; ++j1)
+                    cell_t& pnew_cell = pnew_cells_list[r_buffer.children_cells[i_func][i_cell]];
+                    if(pnew_cell == NULL)
                     {
-                        knot_t pDown = pnew_local_knots[1][j + j1];
-                        knot_t pUp = pnew_local_knots[1][j + j1 + 1];
-
-                        // check if the cell domain area is nonzero
-                        double area = (pRight->Value() - pLeft->Value()) * (pUp->Value() - pDown->Value());
-                        if(fabs(area) > area_tol)
-                        {
-                            std::vector<knot_t> pKnots = {pLeft, pRight, pDown, pUp};
-                            cell_t pnew_cell = pFESpace->pCellManager()->CreateCell(pKnots);
-                            pnew_cell->SetLevel(next_level);
-                            pnew_bf->AddCell(pnew_cell);
-                            pnew_cell->AddBf(pnew_bf);
-                            pnew_cells->insert(pnew_cell);
-                        }
+                        pnew_cell = pFESpace->pCellManager()->CreateCell(r_buffer.cells[r_buffer.children_cells[i_func][i_cell]]);
+                        pnew_cell->SetLevel(next_level);
                     }
+                    pnew_bf->AddCell(pnew_cell);
+                    pnew_cell->AddBf(pnew_bf);
+                    pnew_cells.insert(pnew_cell);
                 }
             }
-        }
-    }
-    else if (TDim == 3)
-    {
-        pnew_cells = typename cell_container_t::Pointer(new CellManager3D<CellType>());
 
-        std::size_t number_1 = pnew_local_knots[0].size() - pFESpace->Order(0) - 1;
-        std::size_t number_2 = pnew_local_knots[1].size() - pFESpace->Order(1) - 1;
-        std::size_t number_3 = pnew_local_knots[2].size() - pFESpace->Order(2) - 1;
-        for(std::size_t l = 0; l < number_3; ++l)
-        {
-            // create and fill the local knot vector
-            std::vector<knot_t> pLocalKnots3;
-            for(std::size_t k = 0; k < pFESpace->Order(2) + 2; ++k)
-                pLocalKnots3.push_back(pnew_local_knots[2][l + k]);
+            /* remove the cells of the old basis function (remove only the cell in the current level) */
+            cell_set_t pcells_to_remove;
 
-            for(std::size_t j = 0; j < number_2; ++j)
+            // firstly we check if the cell c of the current bf in the current level cover any sub-cells. Then the sub-cell includes all bfs of the cell c.
+            for(bf_cell_iterator it_cell = p_bf->cell_begin(); it_cell != p_bf->cell_end(); ++it_cell)
             {
-                // create and fill the local knot vector
-                std::vector<knot_t> pLocalKnots2;
-                for(std::size_t k = 0; k < pFESpace->Order(1) + 2; ++k)
-                    pLocalKnots2.push_back(pnew_local_knots[1][j + k]);
-
-                for(std::size_t i = 0; i < number_1; ++i)
+                if((*it_cell)->Level() == p_bf->Level())
                 {
-                    // create and fill the local knot vector
-                    std::vector<knot_t> pLocalKnots1;
-                    for(std::size_t k = 0; k < pFESpace->Order(0) + 2; ++k)
-                        pLocalKnots1.push_back(pnew_local_knots[0][i + k]);
-
-                    // create the basis function object
-                    std::vector<std::vector<knot_t> > pLocalKnots = {pLocalKnots1, pLocalKnots2, pLocalKnots3};
-                    bf_t pnew_bf = pFESpace->CreateBf(last_id+1, next_level, pLocalKnots);
-                    if (pnew_bf->Id() == last_id+1) ++last_id;
-
-                    // update the coordinates
-                    std::size_t i_func = (l * number_2 + j) * number_1 + i;
-
-                    // transfer the control point information
-                    ControlPointType oldC = p_bf->GetValue(CONTROL_POINT);
-                    ControlPointType newC = pnew_bf->GetValue(CONTROL_POINT);
-                    newC += RefinedCoeffs[i_func] * oldC;
-                    pnew_bf->SetValue(CONTROL_POINT, newC);
-
-                    // transfer other control values from p_bf to pnew_bf
-                    for (std::size_t i = 0; i < double_variables.size(); ++i)
+                    for(typename cell_set_t::iterator it_subcell = pnew_cells.begin(); it_subcell != pnew_cells.end(); ++it_subcell)
                     {
-                        double old_value = p_bf->GetValue(*double_variables[i]);
-                        double new_value = pnew_bf->GetValue(*double_variables[i]);
-                        new_value += RefinedCoeffs[i_func] * old_value;
-                        pnew_bf->SetValue(*double_variables[i], new_value);
+                        if((*it_subcell)->template IsCovered<TDim>(*it_cell))
+                        {
+                            for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
+                            {
+                                (*it_subcell)->AddBf(*it_bf);
+                                (*it_bf)->AddCell(*it_subcell);
+                            }
+                        }
                     }
 
-                    for (std::size_t i = 0; i < array_1d_variables.size(); ++i)
-                    {
-                        array_1d<double, 3> old_value = p_bf->GetValue(*array_1d_variables[i]);
-                        array_1d<double, 3> new_value = pnew_bf->GetValue(*array_1d_variables[i]);
-                        new_value += RefinedCoeffs[i_func] * old_value;
-                        pnew_bf->SetValue(*array_1d_variables[i], new_value);
-                    }
+                    // mark to remove the old cell
+                    pcells_to_remove.insert(*it_cell);
+                }
+            }
 
-                    for (std::size_t i = 0; i < vector_variables.size(); ++i)
+            // secondly, it happens that new cell c cover several existing cells. In this case cell c must be removed, and its bfs will be transferred to sub-cells.
+            for(typename cell_set_t::iterator it_cell = pnew_cells.begin(); it_cell != pnew_cells.end(); ++it_cell)
+            {
+                std::vector<cell_t> p_cells = pFESpace->pCellManager()->GetCells(*it_cell);
+                if(p_cells.size() > 0)
+                {
+                    if((EchoLevel & ECHO_REFIMENT) == ECHO_REFIMENT)
                     {
-                        Vector old_value = p_bf->GetValue(*vector_variables[i]);
-                        Vector new_value = pnew_bf->GetValue(*vector_variables[i]);
-                        new_value += RefinedCoeffs[i_func] * old_value;
-                        pnew_bf->SetValue(*vector_variables[i], new_value);
+                        std::cout << "cell " << (*it_cell)->Id() << " is detected to contain some smaller cells:";
+                        for(std::size_t i = 0; i < p_cells.size(); ++i)
+                            std::cout << " " << p_cells[i]->Id();
+                        std::cout << std::endl;
                     }
 
-                    // create the cells for the basis function
-                    for(std::size_t i1 = 0; i1 < pFESpace->Order(0) + 1; ++i1)
+                    pcells_to_remove.insert(*it_cell);
+                    for(std::size_t i = 0; i < p_cells.size(); ++i)
                     {
-                        knot_t pLeft = pnew_local_knots[0][i + i1];
-                        knot_t pRight = pnew_local_knots[0][i + i1 + 1];
-
-                        for(std::size_t j1 = 0; j1 < pFESpace->Order(1) + 1; ++j1)
+                        for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
                         {
-                            knot_t pDown = pnew_local_knots[1][j + j1];
-                            knot_t pUp = pnew_local_knots[1][j + j1 + 1];
-
-                            for(std::size_t l1 = 0; l1 < pFESpace->Order(2) + 1; ++l1)
-                            {
-                                knot_t pBelow = pnew_local_knots[2][l + l1];
-                                knot_t pAbove = pnew_local_knots[2][l + l1 + 1];
-
-                                // check if the cell domain area is nonzero
-                                double area = (pRight->Value() - pLeft->Value()) * (pUp->Value() - pDown->Value()) * (pAbove->Value() - pBelow->Value());
-                                if(fabs(area) > area_tol)
-                                {
-                                    std::vector<knot_t> pKnots = {pLeft, pRight, pDown, pUp, pBelow, pAbove};
-                                    cell_t pnew_cell = pFESpace->pCellManager()->CreateCell(pKnots);
-                                    pnew_cell->SetLevel(next_level);
-                                    pnew_bf->AddCell(pnew_cell);
-                                    pnew_cell->AddBf(pnew_bf);
-                                    pnew_cells->insert(pnew_cell);
-                                }
-                            }
+                            p_cells[i]->AddBf(*it_bf);
+                            (*it_bf)->AddCell(p_cells[i]);
                         }
                     }
                 }
             }
+
+            /* remove the cells. Since the cells and the bfs refer to each other, only the bfs of the removed cell need to be updated */
+            for(typename cell_set_t::iterator it_cell = pcells_to_remove.begin(); it_cell != pcells_to_remove.end(); ++it_cell)
+            {
+                pFESpace->pCellManager()->erase(*it_cell);
+                for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
+                    (*it_bf)->RemoveCell(*it_cell);
+            }
+
+            /* remove the basis function from all its cells */
+            for(bf_cell_iterator it_cell = p_bf->cell_begin(); it_cell != p_bf->cell_end(); ++it_cell)
+                (*it_cell)->RemoveBf(p_bf);
+
+            /* remove the old basis function */
+            pFESpace->RemoveBf(p_bf);
+
+            pFESpace->RecordRefinementHistory(p_bf->Id());
+            if((EchoLevel & ECHO_REFIMENT) == ECHO_REFIMENT)
+            {
+                std::cout << "Refine bf " << p_bf->Id() << " completed" << std::endl;
+            }
         }
+
+        timer.Lap("HBSplinesRefinementUtility::RefineFunctions::CreateCellsAndBfs");
     }
 
     // update the weight information for all the grid functions (except the control point grid function)
@@ -432,115 +420,146 @@ inline void HBSplinesRefinementUtility_Helper<TDim>::Refine(typename Patch<TDim>
         pThisFESpace->SetWeights(Weights);
     }
 
-    #ifdef ENABLE_PROFILING
-    double time_2 = OpenMPUtils::GetCurrentTime() - start;
-    start = OpenMPUtils::GetCurrentTime();
-    #endif
+    timer.Lap("HBSplinesRefinementUtility::RefineFunctions::UpdateWeights");
+}
+
+template<int TDim>
+inline void HBSplinesRefinementUtility_Helper<TDim>::ComputeChildren(const typename HBSplinesFESpace<TDim>::BasisFunctionType& r_bf,
+        const HBSplinesFESpace<TDim>& r_fespace,
+        const std::vector<Variable<double>*>& double_variables,
+        const std::vector<Variable<array_1d<double, 3> >*>& array_1d_variables,
+        const std::vector<Variable<Vector>*>& vector_variables,
+        RefinementBuffer& r_buffer)
+{
+    typedef typename Patch<TDim>::ControlPointType ControlPointType;
 
-    /* remove the cells of the old basis function (remove only the cell in the current level) */
-    typename cell_container_t::Pointer pcells_to_remove;
+    /* compute the refinement coefficients */
+    Vector RefinedCoeffs;
+    std::vector<std::vector<double> > local_knots(TDim);
+    for(std::size_t dim = 0; dim < TDim; ++dim)
+        r_bf.LocalKnots(dim, local_knots[dim]);
+
+    std::vector<std::vector<double> > new_knots(TDim);
     if (TDim == 2)
-        pcells_to_remove = typename cell_container_t::Pointer(new CellManager2D<CellType>());
+    {
+        BSplineUtils::ComputeBsplinesKnotInsertionCoefficients2DLocal(RefinedCoeffs,
+            new_knots[0], new_knots[1],
+            r_fespace.Order(0), r_fespace.Order(1),
+            local_knots[0], local_knots[1],
+            r_buffer.ins_knots[0], r_buffer.ins_knots[1]);
+    }
     else if (TDim == 3)
-        pcells_to_remove = typename cell_container_t::Pointer(new CellManager3D<CellType>());
-
-    // firstly we check if the cell c of the current bf in the current level cover any sub-cells. Then the sub-cell includes all bfs of the cell c.
-    for(typename HBSplinesFESpace<TDim>::BasisFunctionType::cell_iterator it_cell = p_bf->cell_begin(); it_cell != p_bf->cell_end(); ++it_cell)
     {
-        if((*it_cell)->Level() == p_bf->Level())
-        {
-            for(typename cell_container_t::iterator it_subcell = pnew_cells->begin(); it_subcell != pnew_cells->end(); ++it_subcell)
-            {
-                if((*it_subcell)->template IsCovered<TDim>(*it_cell))
-                {
-                    for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
-                    {
-                        (*it_subcell)->AddBf(*it_bf);
-                        (*it_bf)->AddCell(*it_subcell);
-                    }
-                }
-            }
+        BSplineUtils::ComputeBsplinesKnotInsertionCoefficients3DLocal(RefinedCoeffs,
+            new_knots[0], new_knots[1], new_knots[2],
+            r_fespace.Order(0), r_fespace.Order(1), r_fespace.Order(2),
+            local_knots[0], local_knots[1], local_knots[2],
+            r_buffer.ins_knots[0], r_buffer.ins_knots[1], r_buffer.ins_knots[2]);
+    }
 
-            // mark to remove the old cell
-            pcells_to_remove->insert(*it_cell);
-        }
+    /* compute the cells covered by the children, the index of the cells runs fastest in the last direction */
+    double area_tol = 1.0e-6; // tolerance to accept the nonzero-area cell. We should parameterize it.
+    std::vector<std::size_t> number_of_spans(TDim);
+    std::size_t number_of_cells = 1;
+    for(std::size_t dim = 0; dim < TDim; ++dim)
+    {
+        number_of_spans[dim] = r_buffer.new_local_knots[dim].size() - 1;
+        number_of_cells *= number_of_spans[dim];
     }
 
-    // secondly, it happens that new cell c cover several existing cells. In this case cell c must be removed, and its bfs will be transferred to sub-cells.
-    for(typename cell_container_t::iterator it_cell = pnew_cells->begin(); it_cell != pnew_cells->end(); ++it_cell)
+    r_buffer.cells.resize(number_of_cells);
+    std::vector<std::size_t> span(TDim);
+    for(std::size_t i_cell = 0; i_cell < number_of_cells; ++i_cell)
     {
-        std::vector<cell_t> p_cells = pFESpace->pCellManager()->GetCells(*it_cell);
-        if(p_cells.size() > 0)
+        std::size_t aux = i_cell;
+        for(int dim = TDim-1; dim >= 0; --dim)
         {
-            if((EchoLevel & ECHO_REFIMENT) == ECHO_REFIMENT)
-            {
-                std::cout << "cell " << (*it_cell)->Id() << " is detected to contain some smaller cells:";
-                for(std::size_t i = 0; i < p_cells.size(); ++i)
-                    std::cout << " " << p_cells[i]->Id();
-                std::cout << std::endl;
-            }
+            span[dim] = aux % number_of_spans[dim];
+            aux /= number_of_spans[dim];
+        }
 
-            pcells_to_remove->insert(*it_cell);
-            for(std::size_t i = 0; i < p_cells.size(); ++i)
-            {
-                for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
-                {
-                    p_cells[i]->AddBf(*it_bf);
-                    (*it_bf)->AddCell(p_cells[i]);
-                }
-            }
+        std::vector<knot_t> pKnots(2*TDim);
+        double area = 1.0;
+        for(std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            pKnots[2*dim] = r_buffer.new_local_knots[dim][span[dim]];
+            pKnots[2*dim+1] = r_buffer.new_local_knots[dim][span[dim]+1];
+            area *= pKnots[2*dim+1]->Value() - pKnots[2*dim]->Value();
         }
+
+        // the cells with zero area are left empty
+        if(fabs(area) > area_tol)
+            r_buffer.cells[i_cell].swap(pKnots);
     }
 
-    /* remove the cells */
-    for(typename cell_container_t::iterator it_cell = pcells_to_remove->begin(); it_cell != pcells_to_remove->end(); ++it_cell)
+    /* compute the children, the index of the children runs fastest in the first direction */
+    std::vector<std::size_t> number(TDim);
+    std::size_t number_of_children = 1, number_of_child_cells = 1;
+    for(std::size_t dim = 0; dim < TDim; ++dim)
     {
-        pFESpace->pCellManager()->erase(*it_cell);
-        for(typename bf_container_t::iterator it_bf = pFESpace->bf_begin(); it_bf != pFESpace->bf_end(); ++it_bf)
-            (*it_bf)->RemoveCell(*it_cell);
+        number[dim] = r_buffer.new_local_knots[dim].size() - r_fespace.Order(dim) - 1;
+        number_of_children *= number[dim];
+        number_of_child_cells *= r_fespace.Order(dim) + 1;
     }
 
-    /* remove the basis function from all the cells */
-    for(typename cell_container_t::iterator it_cell = pFESpace->pCellManager()->begin(); it_cell != pFESpace->pCellManager()->end(); ++it_cell)
-        (*it_cell)->RemoveBf(p_bf);
-
-    /* remove the old basis function */
-    pFESpace->RemoveBf(p_bf);
+    r_buffer.children_knots.resize(number_of_children);
+    r_buffer.children_cells.resize(number_of_children);
+    r_buffer.control_points.resize(number_of_children);
+    r_buffer.double_values.resize(number_of_children);
+    r_buffer.array_1d_values.resize(number_of_children);
+    r_buffer.vector_values.resize(number_of_children);
 
-    #ifdef ENABLE_PROFILING
-    double time_3 = OpenMPUtils::GetCurrentTime() - start;
-    start = OpenMPUtils::GetCurrentTime();
-    #endif
+    const ControlPointType& oldC = r_bf.GetValue(CONTROL_POINT);
 
-    /* Debug part: to be removed when the code is stable
-    for(typename cell_container_t::iterator it_cell = pFESpace->pCellManager()->begin(); it_cell != pFESpace->pCellManager()->end(); ++it_cell)
+    std::vector<std::size_t> index(TDim);
+    for(std::size_t i_func = 0; i_func < number_of_children; ++i_func)
     {
-        std::cout << "cell " << (*it_cell)->Id() << " supports:";
-        for(typename CellType::bf_iterator it_bf = (*it_cell)->bf_begin(); it_bf != (*it_cell)->bf_end(); ++it_bf)
-            std::cout << " " << (*it_bf)->Id();
-        std::cout << std::endl;
-    }
+        std::size_t aux = i_func;
+        for(std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            index[dim] = aux % number[dim];
+            aux /= number[dim];
+        }
 
-    for(typename bf_container_t::iterator it_bf = mBasisFuncs.begin(); it_bf != mBasisFuncs.end(); ++it_bf)
-    {
-        std::cout << "bf " << (*it_bf)->Id() << " contains cell:";
-        for(DeprecatedHBBasisFunction::cell_iterator it_cell = (*it_bf)->cell_begin(); it_cell != (*it_bf)->cell_end(); ++it_cell)
-            std::cout << " " << (*it_cell)->Id();
-        std::cout << std::endl;
-    }
-    */
+        // fill the local knot vectors
+        std::vector<std::vector<knot_t> >& pLocalKnots = r_buffer.children_knots[i_func];
+        pLocalKnots.resize(TDim);
+        for(std::size_t dim = 0; dim < TDim; ++dim)
+            pLocalKnots[dim].assign(r_buffer.new_local_knots[dim].begin() + index[dim],
+                r_buffer.new_local_knots[dim].begin() + index[dim] + r_fespace.Order(dim) + 2);
 
-    pFESpace->RecordRefinementHistory(p_bf->Id());
-    if((EchoLevel & ECHO_REFIMENT) == ECHO_REFIMENT)
-    {
-        #ifdef ENABLE_PROFILING
-        std::cout << "Refine bf " << p_bf->Id() << " completed" << std::endl;
-        std::cout << " Time to compute the refinement coefficients: " << time_1 << " s" << std::endl;
-        std::cout << " Time to create new cells and new bfs: " << time_2 << " s" << std::endl;
-        std::cout << " Time to clean up: " << time_3 << " s" << std::endl;
-        #else
-        std::cout << "Refine bf " << p_bf->Id() << " completed" << std::endl;
-        #endif
+        // compute the contribution of the control values to the child
+        r_buffer.control_points[i_func] = RefinedCoeffs[i_func] * oldC;
+
+        r_buffer.double_values[i_func].resize(double_variables.size());
+        for (std::size_t i = 0; i < double_variables.size(); ++i)
+            r_buffer.double_values[i_func][i] = RefinedCoeffs[i_func] * r_bf.GetValue(*double_variables[i]);
+
+        r_buffer.array_1d_values[i_func].resize(array_1d_variables.size());
+        for (std::size_t i = 0; i < array_1d_variables.size(); ++i)
+            r_buffer.array_1d_values[i_func][i] = RefinedCoeffs[i_func] * r_bf.GetValue(*array_1d_variables[i]);
+
+        r_buffer.vector_values[i_func].resize(vector_variables.size());
+        for (std::size_t i = 0; i < vector_variables.size(); ++i)
+            r_buffer.vector_values[i_func][i] = RefinedCoeffs[i_func] * r_bf.GetValue(*vector_variables[i]);
+
+        // collect the cells with nonzero area in the support of the child, in the same order as the cells
+        for(std::size_t i_cell = 0; i_cell < number_of_child_cells; ++i_cell)
+        {
+            aux = i_cell;
+            for(int dim = TDim-1; dim >= 0; --dim)
+            {
+                span[dim] = index[dim] + aux % (r_fespace.Order(dim) + 1);
+                aux /= (r_fespace.Order(dim) + 1);
+            }
+
+            std::size_t cell_index = 0;
+            for(std::size_t dim = 0; dim < TDim; ++dim)
+                cell_index = cell_index * number_of_spans[dim] + span[dim];
+
+            if(r_buffer.cells[cell_index].size() != 0)
+                r_buffer.children_cells[i_func].push_back(cell_index);
+        }
     }
 }
 
@@ -562,20 +581,26 @@ inline void HBSplinesRefinementUtility_Helper<2>::RefineWindow(typename Patch<2>
     // extract the hierarchical B-Splines space
     typename HBSplinesFESpace<2>::Pointer pFESpace = boost::dynamic_pointer_cast<HBSplinesFESpace<2> >(pPatch->pFESpace());
 
-    // search and mark all basis functions need to refine on all level (starting from the last level) which support is contained in the refining domain
+    // search and mark all basis functions need to refine on all level which support is contained in the refining domain
+    // the marked bfs are then refined together, level by level
+    std::vector<std::size_t> refined_bfs;
     for(typename bf_container_t::iterator it_bf = pFESpace->bf_begin(); it_bf != pFESpace->bf_end(); ++it_bf)
     {
+        bf_t p_bf = *it_bf;
+
         // get the bounding box (support domain of the basis function)
-        std::vector<double> bounding_box = (*it_bf)->GetBoundingBox();
+        std::vector<double> bounding_box = p_bf->GetBoundingBox();
 
         // check if the bounding box lie in the refined domain
         // Remarks: this can be changed by a refinement indicator (i.e from error estimator)
         if(    bounding_box[0] >= window[0][0] && bounding_box[1] <= window[0][1]
             && bounding_box[2] >= window[1][0] && bounding_box[3] <= window[1][1] )
         {
-            Refine(pPatch, (*it_bf)->Id(), EchoLevel);
+            refined_bfs.push_back(p_bf->Id());
         }
     }
+
+    RefineFunctions(pPatch, refined_bfs, EchoLevel);
 }
 
 template<>
@@ -596,11 +621,15 @@ inline void HBSplinesRefinementUtility_Helper<3>::RefineWindow(typename Patch<3>
     // extract the hierarchical B-Splines space
     typename HBSplinesFESpace<3>::Pointer pFESpace = boost::dynamic_pointer_cast<HBSplinesFESpace<3> >(pPatch->pFESpace());
 
-    // search and mark all basis functions need to refine on all level (starting from the last level) which support is contained in the refining domain
+    // search and mark all basis functions need to refine on all level which support is contained in the refining domain
+    // the marked bfs are then refined together, level by level
+    std::vector<std::size_t> refined_bfs;
     for(typename bf_container_t::iterator it_bf = pFESpace->bf_begin(); it_bf != pFESpace->bf_end(); ++it_bf)
     {
+        bf_t p_bf = *it_bf;
+
         // get the bounding box (support domain of the basis function)
-        std::vector<double> bounding_box = (*it_bf)->GetBoundingBox();
+        std::vector<double> bounding_box = p_bf->GetBoundingBox();
 
         // check if the bounding box lie in the refined domain
         // Remarks: this can be changed by a refinement indicator (i.e from error estimator)
@@ -608,9 +637,11 @@ inline void HBSplinesRefinementUtility_Helper<3>::RefineWindow(typename Patch<3>
             && bounding_box[2] >= window[1][0] && bounding_box[3] <= window[1][1]
             && bounding_box[4] >= window[2][0] && bounding_box[5] <= window[2][1] )
         {
-            Refine(pPatch, (*it_bf)->Id(), EchoLevel);
+            refined_bfs.push_back(p_bf->Id());
         }
     }
+
+    RefineFunctions(pPatch, refined_bfs, EchoLevel);
 }
 
 
@@ -634,9 +665,7 @@ inline void HBSplinesRefinementUtility_Helper<TDim>::LinearDependencyRefine(type
 
     if(pFESpace->LastLevel() < 1) return;
 
-    #ifdef ENABLE_PROFILING
-    double start = OpenMPUtils::GetCurrentTime();
-    #endif
+    IsogeometricProfiler::ScopedTimer timer("HBSplinesRefinementUtility::LinearDependencyRefine");
 
     // rebuild support domain
     pFESpace->ClearSupportDomain();
@@ -731,19 +760,14 @@ inline void HBSplinesRefinementUtility_Helper<TDim>::LinearDependencyRefine(type
                 std::cout << " of level " << level << " will be refined to maintain the linear independence..." << std::endl;
             }
 
-            for(std::size_t i = 0; i < refined_bfs.size(); ++i)
-                Refine(pPatch, refined_bfs[i], EchoLevel);
+            RefineFunctions(pPatch, refined_bfs, EchoLevel);
 
             // perform another round to make sure all bfs has support domain in the domain manager of each level
             LinearDependencyRefine(pPatch, refine_cycle + 1, EchoLevel);
         }
     }
 
-    #ifdef ENABLE_PROFILING
-    std::cout << "LinearDependencyRefine cycle " << refine_cycle << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s" << std::endl;
-    #else
     std::cout << "LinearDependencyRefine cycle " << refine_cycle << " completed" << std::endl;
-    #endif
 }
 
 } // namespace Kratos.
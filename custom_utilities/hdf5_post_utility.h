@@ -35,7 +35,6 @@
 //#define DEBUG_LEVEL2
 //#define DEBUG_MULTISOLVE
 //#define DEBUG_GENERATE_MESH
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -1253,7 +1252,6 @@ inline std::ostream& operator <<(std::ostream& rOStream, const HDF5PostUtility&
 #undef DEBUG_LEVEL2
 #undef DEBUG_MULTISOLVE
 #undef DEBUG_GENERATE_MESH
-#undef ENABLE_PROFILING
 
 #endif
 
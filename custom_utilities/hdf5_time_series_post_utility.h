@@ -0,0 +1,576 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_HDF5_TIME_SERIES_POST_UTILITY_H_INCLUDED )
+#define  KRATOS_HDF5_TIME_SERIES_POST_UTILITY_H_INCLUDED
+
+// System includes
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+// External includes
+#include <omp.h>
+#include "H5Cpp.h"
+
+// Project includes
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/node.h"
+#include "includes/element.h"
+#include "includes/ublas_interface.h"
+#include "utilities/openmp_utils.h"
+#include "custom_utilities/isogeometric_profiler.h"
+
+
+//#define DEBUG_LEVEL1
+
+namespace Kratos
+{
+///@addtogroup IsogeometricApplication
+
+///@{
+///@name Kratos Classes
+///@{
+
+/// Time-series writer/reader for post-processing results in HDF5.
+/*** The mesh (node ids, coordinates and element connectivity) is written only once in the group /Mesh.
+ * Each nodal variable is stored in /Results/<variable name> as an extendible dataset of dimension
+ * (number of steps) x (number of components) x (number of nodes). The dataset is chunked, so that
+ * every new time step is appended without rewriting the file, and may be compressed by the
+ * deflate filter, optionally preceded by the shuffle filter. The time values are kept in /Time.
+ * The values are gathered into a contiguous structure-of-arrays buffer (all values of the first
+ * component, then the second component, ...), which is kept between writes and given to HDF5 directly.
+ * The nodal results are always stored in the order of the nodes in /Mesh/NodeIds.
+ */
+class HDF5TimeSeriesPostUtility
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    typedef typename ModelPart::NodesContainerType NodesArrayType;
+
+    typedef typename ModelPart::ElementsContainerType ElementsArrayType;
+
+    typedef std::size_t IndexType;
+
+    /// Pointer definition of HDF5TimeSeriesPostUtility
+    KRATOS_CLASS_POINTER_DEFINITION(HDF5TimeSeriesPostUtility);
+
+    ///@}
+    ///@name Life Cycle
+    ///@{
+
+    /// Default constructor. The file is truncated.
+    HDF5TimeSeriesPostUtility(const std::string h5_filename)
+    : mChunkSize(65536), mCompressionLevel(0), mShuffle(false), mNumberOfNodes(0), mCurrentStep(-1)
+    {
+        mpFile = boost::shared_ptr<H5::H5File>(new H5::H5File(h5_filename, H5F_ACC_TRUNC));
+        Initialize(true);
+    }
+
+    /// Constructor with access mode. With "Read-Write", new steps are appended to the existing series.
+    HDF5TimeSeriesPostUtility(const std::string h5_filename, const std::string AccessMode)
+    : mChunkSize(65536), mCompressionLevel(0), mShuffle(false), mNumberOfNodes(0), mCurrentStep(-1)
+    {
+        unsigned int mode = H5F_ACC_TRUNC;
+
+        if(AccessMode == std::string("Truncation"))
+        {
+            mode = H5F_ACC_TRUNC;
+        }
+        else if(AccessMode == std::string("Read-Only"))
+        {
+            mode = H5F_ACC_RDONLY;
+        }
+        else if(AccessMode == std::string("Read-Write"))
+        {
+            mode = H5F_ACC_RDWR;
+        }
+        else
+            KRATOS_THROW_ERROR(std::logic_error, "This access mode is not supported:", AccessMode)
+
+        mpFile = boost::shared_ptr<H5::H5File>(new H5::H5File(h5_filename, mode));
+        Initialize(mode != H5F_ACC_RDONLY);
+    }
+
+    /// Destructor.
+    virtual ~HDF5TimeSeriesPostUtility()
+    {
+    }
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    /// Set the number of entities per chunk. It only affects datasets created afterwards.
+    void SetChunkSize(const std::size_t& ChunkSize)
+    {
+        if(ChunkSize == 0)
+            KRATOS_THROW_ERROR(std::logic_error, "The chunk size must be positive", "")
+        mChunkSize = ChunkSize;
+    }
+
+    /// Set the deflate level (0..9). Level 0 disables the compression.
+    void SetCompressionLevel(const int& Level)
+    {
+        if(Level < 0 || Level > 9)
+            KRATOS_THROW_ERROR(std::logic_error, "The compression level must be in [0, 9], given:", Level)
+        mCompressionLevel = Level;
+    }
+
+    /// Enable/disable the shuffle filter
+    void SetShuffle(const bool& Shuffle)
+    {
+        mShuffle = Shuffle;
+    }
+
+    /// Write the nodes and the element connectivity. This shall be called only once per file.
+    void WriteMesh(ModelPart::Pointer pModelPart)
+    {
+        IsogeometricProfiler::ScopedTimer timer("HDF5TimeSeriesPostUtility::WriteMesh");
+
+        if(Exists("/Mesh"))
+            KRATOS_THROW_ERROR(std::logic_error, "The mesh has been written to this file already", "")
+
+        H5::Group mesh_group = mpFile->createGroup("/Mesh");
+
+        /* nodes */
+        NodesArrayType& pNodes = pModelPart->Nodes();
+        const std::size_t num_nodes = pNodes.size();
+        std::vector<int> node_ids(num_nodes);
+        std::vector<double> coordinates(3*num_nodes);
+
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(num_nodes); ++i)
+        {
+            typename NodesArrayType::ptr_iterator it = pNodes.ptr_begin() + i;
+            node_ids[i] = (*it)->Id();
+            coordinates[i] = (*it)->X0();
+            coordinates[num_nodes + i] = (*it)->Y0();
+            coordinates[2*num_nodes + i] = (*it)->Z0();
+        }
+
+        hsize_t node_dims[] = {num_nodes};
+        WriteFixedDataSet("/Mesh/NodeIds", H5::PredType::NATIVE_INT, 1, node_dims, node_ids.data());
+
+        hsize_t coord_dims[] = {3, num_nodes};
+        WriteFixedDataSet("/Mesh/Coordinates", H5::PredType::NATIVE_DOUBLE, 2, coord_dims, coordinates.data());
+
+        /* elements, as flat connectivity with offsets */
+        ElementsArrayType& pElements = pModelPart->Elements();
+        const std::size_t num_elements = pElements.size();
+        std::vector<int> element_ids(num_elements);
+        std::vector<int> offsets(num_elements + 1);
+        offsets[0] = 0;
+        IndexType cnt = 0;
+        for(typename ElementsArrayType::ptr_iterator it = pElements.ptr_begin(); it != pElements.ptr_end(); ++it)
+        {
+            element_ids[cnt] = (*it)->Id();
+            offsets[cnt + 1] = offsets[cnt] + (*it)->GetGeometry().size();
+            ++cnt;
+        }
+
+        std::vector<int> connectivities(offsets[num_elements]);
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(num_elements); ++i)
+        {
+            typename ElementsArrayType::ptr_iterator it = pElements.ptr_begin() + i;
+            for(std::size_t j = 0; j < (*it)->GetGeometry().size(); ++j)
+                connectivities[offsets[i] + j] = (*it)->GetGeometry()[j].Id();
+        }
+
+        hsize_t elem_dims[] = {num_elements};
+        WriteFixedDataSet("/Mesh/ElementIds", H5::PredType::NATIVE_INT, 1, elem_dims, element_ids.data());
+
+        hsize_t offset_dims[] = {num_elements + 1};
+        WriteFixedDataSet("/Mesh/ElementOffsets", H5::PredType::NATIVE_INT, 1, offset_dims, offsets.data());
+
+        hsize_t conn_dims[] = {connectivities.size()};
+        WriteFixedDataSet("/Mesh/Connectivities", H5::PredType::NATIVE_INT, 1, conn_dims, connectivities.data());
+
+        mNumberOfNodes = num_nodes;
+    }
+
+    /// Append a new time step. All subsequent WriteNodalResults will be written to this step.
+    void BeginStep(const double& Time)
+    {
+        H5::DataSet dataset = mpFile->openDataSet("/Time");
+        H5::DataSpace fspace = dataset.getSpace();
+        hsize_t dims[1];
+        fspace.getSimpleExtentDims(dims, NULL);
+
+        hsize_t new_dims[] = {dims[0] + 1};
+        dataset.extend(new_dims);
+
+        fspace = dataset.getSpace();
+        hsize_t offset[] = {dims[0]};
+        hsize_t count[] = {1};
+        fspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+        H5::DataSpace mspace(1, count);
+        dataset.write(&Time, H5::PredType::NATIVE_DOUBLE, mspace, fspace);
+
+        mCurrentStep = static_cast<int>(dims[0]);
+    }
+
+    /// Write the nodal values of the variable at current step
+    template<class TVariableType>
+    void WriteNodalResults(const TVariableType& rThisVariable, ModelPart::Pointer pModelPart)
+    {
+        IsogeometricProfiler::ScopedTimer timer("HDF5TimeSeriesPostUtility::WriteNodalResults");
+
+        if(mCurrentStep < 0)
+            KRATOS_THROW_ERROR(std::logic_error, "BeginStep must be called before writing results", "")
+
+        NodesArrayType& pNodes = pModelPart->Nodes();
+        if(pNodes.size() != mNumberOfNodes)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of nodes is not the same as the written mesh:", pNodes.size())
+
+        // an empty mesh has no nodal values, and the dataset can not be chunked along a node dimension of zero size
+        if(mNumberOfNodes == 0)
+            return;
+
+        const std::size_t ncomp = GatherNodalValues(rThisVariable, pNodes);
+        if(ncomp == 0)
+            return;
+
+        std::string name = std::string("/Results/") + rThisVariable.Name();
+        H5::DataSet dataset;
+        if(!Exists(name))
+            dataset = CreateExtendibleDataSet(name, ncomp);
+        else
+            dataset = mpFile->openDataSet(name);
+
+        H5::DataSpace fspace = dataset.getSpace();
+        hsize_t dims[3];
+        fspace.getSimpleExtentDims(dims, NULL);
+        if(dims[1] != ncomp)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of components is changed for variable", rThisVariable.Name())
+
+        if(dims[0] < static_cast<hsize_t>(mCurrentStep + 1))
+        {
+            hsize_t new_dims[] = {static_cast<hsize_t>(mCurrentStep + 1), dims[1], dims[2]};
+            dataset.extend(new_dims);
+            fspace = dataset.getSpace();
+        }
+
+        hsize_t offset[] = {static_cast<hsize_t>(mCurrentStep), 0, 0};
+        hsize_t count[] = {1, ncomp, mNumberOfNodes};
+        fspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+        H5::DataSpace mspace(3, count);
+        dataset.write(&mBuffer[0], H5::PredType::NATIVE_DOUBLE, mspace, fspace);
+
+        IsogeometricProfiler::AddCount("HDF5TimeSeriesPostUtility::WriteNodalResults::Bytes", ncomp*mNumberOfNodes*sizeof(double));
+    }
+
+    /// Read the nodal values of the variable at a specific step
+    template<class TVariableType>
+    void ReadNodalResults(const TVariableType& rThisVariable, ModelPart::Pointer pModelPart, const std::size_t& Step)
+    {
+        if(mNumberOfNodes == 0)
+            return;
+
+        std::string name = std::string("/Results/") + rThisVariable.Name();
+        if(!Exists(name))
+            KRATOS_THROW_ERROR(std::logic_error, "There is no time series for variable", rThisVariable.Name())
+
+        H5::DataSet dataset = mpFile->openDataSet(name);
+        H5::DataSpace fspace = dataset.getSpace();
+        hsize_t dims[3];
+        fspace.getSimpleExtentDims(dims, NULL);
+        if(Step >= dims[0])
+            KRATOS_THROW_ERROR(std::logic_error, "The step does not exist in the time series:", Step)
+
+        hsize_t offset[] = {Step, 0, 0};
+        hsize_t count[] = {1, dims[1], dims[2]};
+        fspace.selectHyperslab(H5S_SELECT_SET, count, offset);
+        H5::DataSpace mspace(3, count);
+        mBuffer.resize(dims[1]*dims[2]);
+        dataset.read(&mBuffer[0], H5::PredType::NATIVE_DOUBLE, mspace, fspace);
+
+        std::vector<int> node_ids(dims[2]);
+        H5::DataSet id_dataset = mpFile->openDataSet("/Mesh/NodeIds");
+        id_dataset.read(&node_ids[0], H5::PredType::NATIVE_INT);
+
+        ScatterNodalValues(rThisVariable, pModelPart->Nodes(), node_ids, dims[1]);
+    }
+
+    /// Get the number of steps in the series
+    std::size_t NumberOfSteps() const
+    {
+        return static_cast<std::size_t>(mCurrentStep + 1);
+    }
+
+    ///@}
+    ///@name Input and output
+    ///@{
+
+    /// Turn back information as a string.
+    virtual std::string Info() const
+    {
+        std::stringstream buffer;
+        buffer << "HDF5TimeSeriesPostUtility";
+        return buffer.str();
+    }
+
+    /// Print information about this object.
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "HDF5TimeSeriesPostUtility";
+    }
+
+    /// Print object's data.
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << " Number of steps: " << NumberOfSteps() << std::endl;
+        rOStream << " Chunk size: " << mChunkSize << std::endl;
+        rOStream << " Compression level: " << mCompressionLevel << std::endl;
+        rOStream << " Shuffle: " << mShuffle << std::endl;
+    }
+
+    ///@}
+
+private:
+    ///@name Member Variables
+    ///@{
+
+    boost::shared_ptr<H5::H5File> mpFile;
+    std::size_t mChunkSize;
+    int mCompressionLevel;
+    bool mShuffle;
+    std::size_t mNumberOfNodes;
+    int mCurrentStep;
+    std::vector<double> mBuffer; // structure-of-arrays buffer, reused between writes
+
+    ///@}
+    ///@name Private Operations
+    ///@{
+
+    /// Create the /Time and /Results, or recover the state from an existing series
+    void Initialize(const bool Writable)
+    {
+        if(!Exists("/Time"))
+        {
+            if(!Writable)
+                KRATOS_THROW_ERROR(std::logic_error, "The file does not contain a time series:", mpFile->getFileName())
+
+            hsize_t dims[] = {0};
+            hsize_t maxdims[] = {H5S_UNLIMITED};
+            H5::DataSpace space(1, dims, maxdims);
+            H5::DSetCreatPropList plist;
+            hsize_t chunk_dims[] = {64};
+            plist.setChunk(1, chunk_dims);
+            mpFile->createDataSet("/Time", H5::PredType::NATIVE_DOUBLE, space, plist);
+            mpFile->createGroup("/Results");
+        }
+        else
+        {
+            H5::DataSet dataset = mpFile->openDataSet("/Time");
+            hsize_t dims[1];
+            dataset.getSpace().getSimpleExtentDims(dims, NULL);
+            mCurrentStep = static_cast<int>(dims[0]) - 1;
+        }
+
+        if(Exists("/Mesh/NodeIds"))
+        {
+            H5::DataSet dataset = mpFile->openDataSet("/Mesh/NodeIds");
+            hsize_t dims[1];
+            dataset.getSpace().getSimpleExtentDims(dims, NULL);
+            mNumberOfNodes = dims[0];
+        }
+    }
+
+    /// Check if a link exists in the file. The parent of the link must exist.
+    bool Exists(const std::string& name) const
+    {
+        std::size_t pos = name.find('/', 1);
+        if(pos != std::string::npos)
+            if(H5Lexists(mpFile->getId(), name.substr(0, pos).c_str(), H5P_DEFAULT) <= 0)
+                return false;
+        return H5Lexists(mpFile->getId(), name.c_str(), H5P_DEFAULT) > 0;
+    }
+
+    /// Apply the chunk and the filters to the dataset creation property list
+    void SetFilters(H5::DSetCreatPropList& plist, const int rank, const hsize_t* chunk_dims) const
+    {
+        plist.setChunk(rank, chunk_dims);
+        if(mShuffle)
+            plist.setShuffle();
+        if(mCompressionLevel > 0)
+            plist.setDeflate(mCompressionLevel);
+    }
+
+    /// Write a chunked dataset of fixed size. The chunk is taken along the last dimension.
+    void WriteFixedDataSet(const std::string& name, const H5::PredType& type, const int rank, const hsize_t* dims, const void* data)
+    {
+        hsize_t chunk_dims[2];
+        for(int i = 0; i < rank; ++i)
+            chunk_dims[i] = dims[i];
+        chunk_dims[rank-1] = std::min(static_cast<hsize_t>(mChunkSize), dims[rank-1]);
+
+        H5::DataSpace space(rank, dims);
+        if(chunk_dims[rank-1] == 0)
+        {
+            mpFile->createDataSet(name, type, space);
+            return;
+        }
+
+        H5::DSetCreatPropList plist;
+        SetFilters(plist, rank, chunk_dims);
+        H5::DataSet dataset = mpFile->createDataSet(name, type, space, plist);
+        dataset.write(data, type);
+    }
+
+    /// Create the extendible dataset (step x component x node) for a nodal variable
+    H5::DataSet CreateExtendibleDataSet(const std::string& name, const std::size_t& ncomp)
+    {
+        hsize_t dims[] = {0, ncomp, mNumberOfNodes};
+        hsize_t maxdims[] = {H5S_UNLIMITED, ncomp, mNumberOfNodes};
+        H5::DataSpace space(3, dims, maxdims);
+
+        hsize_t chunk_dims[] = {1, ncomp, std::max(static_cast<hsize_t>(1), std::min(static_cast<hsize_t>(mChunkSize), static_cast<hsize_t>(mNumberOfNodes)))};
+        H5::DSetCreatPropList plist;
+        SetFilters(plist, 3, chunk_dims);
+
+        return mpFile->createDataSet(name, H5::PredType::NATIVE_DOUBLE, space, plist);
+    }
+
+    /*****************************************************
+        GATHER/SCATTER NODAL VALUES TO/FROM THE BUFFER
+    *****************************************************/
+    std::size_t GatherNodalValues(const Variable<double>& rThisVariable, NodesArrayType& pNodes)
+    {
+        const std::size_t n = pNodes.size();
+        mBuffer.resize(n);
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n); ++i)
+            mBuffer[i] = (*(pNodes.ptr_begin() + i))->GetSolutionStepValue(rThisVariable);
+        return 1;
+    }
+
+    std::size_t GatherNodalValues(const Variable<array_1d<double, 3> >& rThisVariable, NodesArrayType& pNodes)
+    {
+        const std::size_t n = pNodes.size();
+        mBuffer.resize(3*n);
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n); ++i)
+        {
+            const array_1d<double, 3>& v = (*(pNodes.ptr_begin() + i))->GetSolutionStepValue(rThisVariable);
+            mBuffer[i] = v[0];
+            mBuffer[n + i] = v[1];
+            mBuffer[2*n + i] = v[2];
+        }
+        return 3;
+    }
+
+    std::size_t GatherNodalValues(const Variable<Vector>& rThisVariable, NodesArrayType& pNodes)
+    {
+        const std::size_t n = pNodes.size();
+        if(n == 0)
+            return 0;
+
+        const std::size_t len = (*(pNodes.ptr_begin()))->GetSolutionStepValue(rThisVariable).size();
+        if(len == 0)
+        {
+            std::cout << "Vector variable " << rThisVariable.Name() << " is empty, skipping" << std::endl;
+            return 0;
+        }
+
+        for(typename NodesArrayType::ptr_iterator it = pNodes.ptr_begin(); it != pNodes.ptr_end(); ++it)
+            if((*it)->GetSolutionStepValue(rThisVariable).size() != len)
+                KRATOS_THROW_ERROR(std::logic_error, "The Vector values have different sizes at node", (*it)->Id())
+
+        mBuffer.resize(len*n);
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(n); ++i)
+        {
+            const Vector& v = (*(pNodes.ptr_begin() + i))->GetSolutionStepValue(rThisVariable);
+            for(std::size_t j = 0; j < len; ++j)
+                mBuffer[j*n + i] = v[j];
+        }
+        return len;
+    }
+
+    void ScatterNodalValues(const Variable<double>& rThisVariable, NodesArrayType& pNodes,
+            const std::vector<int>& node_ids, const std::size_t& ncomp)
+    {
+        for(std::size_t i = 0; i < node_ids.size(); ++i)
+            pNodes[node_ids[i]].GetSolutionStepValue(rThisVariable) = mBuffer[i];
+    }
+
+    void ScatterNodalValues(const Variable<array_1d<double, 3> >& rThisVariable, NodesArrayType& pNodes,
+            const std::vector<int>& node_ids, const std::size_t& ncomp)
+    {
+        const std::size_t n = node_ids.size();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            array_1d<double, 3>& v = pNodes[node_ids[i]].GetSolutionStepValue(rThisVariable);
+            v[0] = mBuffer[i];
+            v[1] = mBuffer[n + i];
+            v[2] = mBuffer[2*n + i];
+        }
+    }
+
+    void ScatterNodalValues(const Variable<Vector>& rThisVariable, NodesArrayType& pNodes,
+            const std::vector<int>& node_ids, const std::size_t& ncomp)
+    {
+        const std::size_t n = node_ids.size();
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            Vector& v = pNodes[node_ids[i]].GetSolutionStepValue(rThisVariable);
+            if(v.size() != ncomp)
+                v.resize(ncomp, false);
+            for(std::size_t j = 0; j < ncomp; ++j)
+                v[j] = mBuffer[j*n + i];
+        }
+    }
+
+    ///@}
+    ///@name Un accessible methods
+    ///@{
+
+    /// Assignment operator.
+    HDF5TimeSeriesPostUtility& operator=(HDF5TimeSeriesPostUtility const& rOther)
+    {
+        return *this;
+    }
+
+    /// Copy constructor.
+    HDF5TimeSeriesPostUtility(HDF5TimeSeriesPostUtility const& rOther)
+    {
+    }
+
+    ///@}
+
+}; // Class HDF5TimeSeriesPostUtility
+
+///@}
+
+///@name Input and output
+///@{
+
+/// output stream function
+inline std::ostream& operator <<(std::ostream& rOStream, const HDF5TimeSeriesPostUtility& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+
+    return rOStream;
+}
+///@}
+
+///@} addtogroup block
+
+}// namespace Kratos.
+
+#undef DEBUG_LEVEL1
+
+#endif
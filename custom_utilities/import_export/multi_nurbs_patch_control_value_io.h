@@ -0,0 +1,637 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_NURBS_PATCH_CONTROL_VALUE_IO_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_NURBS_PATCH_CONTROL_VALUE_IO_H_INCLUDED
+
+// System includes
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstring>
+#include <stdint.h>
+
+// External includes
+
+// Project includes
+#include "includes/define.h"
+#include "includes/kratos_components.h"
+#include "containers/array_1d.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/nurbs/structured_control_grid.h"
+#include "custom_utilities/nurbs/bsplines_patch_sampler.h"
+#include "custom_utilities/import_export/multipatch_exporter.h"
+#include "custom_utilities/import_export/multipatch_importer.h"
+
+namespace Kratos
+{
+
+/**
+Low-level routines to read/write the NURBS multipatch and the control values in binary format.
+The data are written in native byte order. The layout of the file is:
+    header:     "IGACTRL\0", int32 version, int32 dim, uint64 number of patches
+    per patch:  uint64 id, uint64 neighbour ids (2*dim), per direction uint64 order, number, number of knots and the knots,
+                then the control points in homogeneous coordinates (wx, wy, wz, w)
+    per step:   int32 tag, double time, uint64 number of variables
+    per variable: uint32 length of name, name, int32 type (1: double, 2: array_1d, 3: Vector), uint64 number of components,
+                uint64 number of values, then the control values of all patches (in the order of the header), component fastest
+ */
+class MultiNURBSPatchBinaryIOHelper
+{
+public:
+
+    static const int VERSION = 1;
+    static const int STEP_TAG = 1;
+
+    enum ValueType
+    {
+        _DOUBLE_ = 1,
+        _ARRAY_1D_ = 2,
+        _VECTOR_ = 3
+    };
+
+    template<typename TDataType>
+    static void Write(std::ostream& rOStream, const TDataType& v)
+    {
+        rOStream.write(reinterpret_cast<const char*>(&v), sizeof(TDataType));
+    }
+
+    template<typename TDataType>
+    static void Write(std::ostream& rOStream, const std::vector<TDataType>& v)
+    {
+        if (v.size() != 0)
+            rOStream.write(reinterpret_cast<const char*>(v.data()), v.size()*sizeof(TDataType));
+    }
+
+    static void Write(std::ostream& rOStream, const std::string& s)
+    {
+        Write(rOStream, static_cast<uint32_t>(s.size()));
+        rOStream.write(s.c_str(), s.size());
+    }
+
+    template<typename TDataType>
+    static void Read(std::istream& rIStream, TDataType& v)
+    {
+        rIStream.read(reinterpret_cast<char*>(&v), sizeof(TDataType));
+        if (!rIStream)
+            KRATOS_THROW_ERROR(std::runtime_error, "Unexpected end of file", "")
+    }
+
+    template<typename TDataType>
+    static void Read(std::istream& rIStream, std::vector<TDataType>& v, const std::size_t& n)
+    {
+        v.resize(n);
+        if (n != 0)
+            rIStream.read(reinterpret_cast<char*>(v.data()), n*sizeof(TDataType));
+        if (!rIStream)
+            KRATOS_THROW_ERROR(std::runtime_error, "Unexpected end of file", "")
+    }
+
+    static void Read(std::istream& rIStream, std::string& s)
+    {
+        uint32_t len;
+        Read(rIStream, len);
+        s.resize(len);
+        if (len != 0)
+            rIStream.read(&s[0], len);
+        if (!rIStream)
+            KRATOS_THROW_ERROR(std::runtime_error, "Unexpected end of file", "")
+    }
+
+    /// Write the header of the multipatch file
+    template<int TDim>
+    static void WriteHeader(std::ostream& rOStream, const std::size_t& npatches)
+    {
+        rOStream.write("IGACTRL", 8);
+        Write(rOStream, static_cast<int32_t>(VERSION));
+        Write(rOStream, static_cast<int32_t>(TDim));
+        Write(rOStream, static_cast<uint64_t>(npatches));
+    }
+
+    /// Write the geometry of a patch. If WithTopology is false, the neighbour ids are written as 0.
+    template<int TDim>
+    static void WritePatch(std::ostream& rOStream, const Patch<TDim>& rPatch, const bool& WithTopology = true)
+    {
+        typedef typename Patch<TDim>::ControlPointType ControlPointType;
+
+        if (rPatch.pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+            KRATOS_THROW_ERROR(std::logic_error, __FUNCTION__, "does not support non-NURBS patch")
+
+        typename BSplinesFESpace<TDim>::ConstPointer pFESpace = boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >(rPatch.pFESpace());
+
+        Write(rOStream, static_cast<uint64_t>(rPatch.Id()));
+        for (int side = 0; side < 2*TDim; ++side)
+        {
+            typename Patch<TDim>::ConstPointer pNeighbor = rPatch.pNeighbor(static_cast<BoundarySide>(side));
+            Write(rOStream, static_cast<uint64_t>((WithTopology && pNeighbor != NULL) ? pNeighbor->Id() : 0));
+        }
+
+        std::vector<double> values;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            Write(rOStream, static_cast<uint64_t>(pFESpace->Order(dim)));
+            Write(rOStream, static_cast<uint64_t>(pFESpace->Number(dim)));
+            values.resize(pFESpace->KnotVector(dim).size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+                values[i] = pFESpace->KnotVector(dim)[i];
+            Write(rOStream, static_cast<uint64_t>(values.size()));
+            Write(rOStream, values);
+        }
+
+        typename ControlGrid<ControlPointType>::ConstPointer pControlPointGrid = rPatch.pControlPointGridFunction()->pControlGrid();
+        values.resize(4*pControlPointGrid->size());
+        for (std::size_t i = 0; i < pControlPointGrid->size(); ++i)
+        {
+            const ControlPointType& c = pControlPointGrid->GetData(i);
+            for (std::size_t j = 0; j < 4; ++j)
+                values[4*i + j] = c[j];
+        }
+        Write(rOStream, values);
+    }
+
+    /// Write the header and the geometry of the multipatch
+    template<int TDim>
+    static void WriteMultiPatch(std::ostream& rOStream, const MultiPatch<TDim>& rMultiPatch)
+    {
+        WriteHeader<TDim>(rOStream, rMultiPatch.size());
+        for (typename MultiPatch<TDim>::PatchContainerType::const_iterator it = rMultiPatch.begin(); it != rMultiPatch.end(); ++it)
+            WritePatch<TDim>(rOStream, *it);
+    }
+
+    /// Read the header of the multipatch file and return the number of patches
+    template<int TDim>
+    static std::size_t ReadHeader(std::istream& rIStream)
+    {
+        char magic[8];
+        rIStream.read(magic, 8);
+        if (!rIStream || std::strncmp(magic, "IGACTRL", 8) != 0)
+            KRATOS_THROW_ERROR(std::logic_error, "The file is not a multipatch binary file", "")
+
+        int32_t version, dim;
+        Read(rIStream, version);
+        Read(rIStream, dim);
+        if (version > VERSION)
+            KRATOS_THROW_ERROR(std::logic_error, "Unsupported file version", version)
+        if (dim != TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The dimension of the multipatch in the file is", dim)
+
+        uint64_t npatches;
+        Read(rIStream, npatches);
+        return npatches;
+    }
+
+    /// Read the geometry of a patch. The control points are restored bit-exactly.
+    /// The ids of the neighbours are returned, to be restored by RestoreTopology.
+    template<int TDim>
+    static typename Patch<TDim>::Pointer ReadPatch(std::istream& rIStream, std::vector<uint64_t>& neighbor_ids)
+    {
+        typedef typename Patch<TDim>::ControlPointType ControlPointType;
+
+        uint64_t id, tmp;
+        Read(rIStream, id);
+        Read(rIStream, neighbor_ids, 2*TDim);
+
+        typename BSplinesFESpace<TDim>::Pointer pNewFESpace = BSplinesFESpace<TDim>::Create();
+        std::vector<std::size_t> numbers(TDim);
+        std::vector<double> values;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            Read(rIStream, tmp); std::size_t order = tmp;
+            Read(rIStream, tmp); numbers[dim] = tmp;
+            Read(rIStream, tmp);
+            Read(rIStream, values, tmp);
+            pNewFESpace->SetKnotVector(dim, values);
+            pNewFESpace->SetInfo(dim, numbers[dim], order);
+        }
+
+        typename Patch<TDim>::Pointer pNewPatch = Patch<TDim>::Create(id, pNewFESpace);
+
+        typename StructuredControlGrid<TDim, ControlPointType>::Pointer pControlPointGrid = StructuredControlGrid<TDim, ControlPointType>::Create(numbers);
+        Read(rIStream, values, 4*pControlPointGrid->size());
+        ControlPointType c;
+        for (std::size_t i = 0; i < pControlPointGrid->size(); ++i)
+        {
+            for (std::size_t j = 0; j < 4; ++j)
+                c[j] = values[4*i + j];
+            pControlPointGrid->SetData(i, c);
+        }
+        pControlPointGrid->SetName("CONTROL_POINT");
+        pNewPatch->CreateControlPointGridFunction(pControlPointGrid);
+
+        return pNewPatch;
+    }
+
+    /// Restore the neighbours of the patches, in the order of the patches in the multipatch
+    template<int TDim>
+    static void RestoreTopology(MultiPatch<TDim>& rMultiPatch, const std::vector<std::vector<uint64_t> >& neighbor_ids)
+    {
+        std::size_t ip = 0;
+        for (typename MultiPatch<TDim>::PatchContainerType::ptr_iterator it = rMultiPatch.Patches().ptr_begin();
+                it != rMultiPatch.Patches().ptr_end(); ++it, ++ip)
+        {
+            for (int side = 0; side < 2*TDim; ++side)
+                if (neighbor_ids[ip][side] != 0)
+                    (*it)->pSetNeighbor(static_cast<BoundarySide>(side), rMultiPatch.pGetPatch(neighbor_ids[ip][side]));
+        }
+    }
+
+    /// Read the header and the geometry of the multipatch. The control points are restored bit-exactly.
+    template<int TDim>
+    static typename MultiPatch<TDim>::Pointer ReadMultiPatch(std::istream& rIStream)
+    {
+        std::size_t npatches = ReadHeader<TDim>(rIStream);
+
+        typename MultiPatch<TDim>::Pointer pMultiPatch = typename MultiPatch<TDim>::Pointer(new MultiPatch<TDim>());
+        std::vector<std::vector<uint64_t> > neighbor_ids(npatches);
+        for (std::size_t ip = 0; ip < npatches; ++ip)
+            pMultiPatch->AddPatch(ReadPatch<TDim>(rIStream, neighbor_ids[ip]));
+
+        RestoreTopology<TDim>(*pMultiPatch, neighbor_ids);
+
+        return pMultiPatch;
+    }
+
+    /// Number of components and packing of the control values
+    static int Type(const double& v) {return _DOUBLE_;}
+    static int Type(const array_1d<double, 3>& v) {return _ARRAY_1D_;}
+    static int Type(const Vector& v) {return _VECTOR_;}
+
+    static std::size_t Size(const double& v) {return 1;}
+    static std::size_t Size(const array_1d<double, 3>& v) {return 3;}
+    static std::size_t Size(const Vector& v) {return v.size();}
+
+    static void Pack(const double& v, double* p) {p[0] = v;}
+    static void Pack(const array_1d<double, 3>& v, double* p) {for (std::size_t i = 0; i < 3; ++i) p[i] = v[i];}
+    static void Pack(const Vector& v, double* p) {for (std::size_t i = 0; i < v.size(); ++i) p[i] = v[i];}
+
+    static void Unpack(double& v, const double* p, const std::size_t& n) {v = p[0];}
+    static void Unpack(array_1d<double, 3>& v, const double* p, const std::size_t& n) {for (std::size_t i = 0; i < 3; ++i) v[i] = p[i];}
+    static void Unpack(Vector& v, const double* p, const std::size_t& n) {v.resize(n, false); for (std::size_t i = 0; i < n; ++i) v[i] = p[i];}
+
+    /// Write the control values of a variable of all patches
+    template<int TDim, class TVariableType>
+    static void WriteControlValues(std::ostream& rOStream, const MultiPatch<TDim>& rMultiPatch, const TVariableType& rVariable)
+    {
+        typedef typename TVariableType::Type DataType;
+
+        std::size_t ncomponents = 0, nvalues = 0;
+        for (typename MultiPatch<TDim>::PatchContainerType::const_iterator it = rMultiPatch.begin(); it != rMultiPatch.end(); ++it)
+        {
+            typename ControlGrid<DataType>::ConstPointer pControlGrid = it->pGetGridFunction(rVariable)->pControlGrid();
+            if (pControlGrid->size() != 0 && ncomponents == 0)
+                ncomponents = Size(pControlGrid->GetData(0));
+            nvalues += pControlGrid->size();
+        }
+
+        Write(rOStream, rVariable.Name());
+        Write(rOStream, static_cast<int32_t>(Type(DataType())));
+        Write(rOStream, static_cast<uint64_t>(ncomponents));
+        Write(rOStream, static_cast<uint64_t>(nvalues*ncomponents));
+
+        std::vector<double> values;
+        for (typename MultiPatch<TDim>::PatchContainerType::const_iterator it = rMultiPatch.begin(); it != rMultiPatch.end(); ++it)
+        {
+            typename ControlGrid<DataType>::ConstPointer pControlGrid = it->pGetGridFunction(rVariable)->pControlGrid();
+            values.resize(pControlGrid->size()*ncomponents);
+            for (std::size_t i = 0; i < pControlGrid->size(); ++i)
+            {
+                const DataType& v = pControlGrid->GetData(i);
+                if (Size(v) != ncomponents)
+                    KRATOS_THROW_ERROR(std::logic_error, "The control values have inconsistent size for variable", rVariable.Name())
+                Pack(v, &values[i*ncomponents]);
+            }
+            Write(rOStream, values);
+        }
+    }
+
+    /// Read the control values of a variable to all patches. The grid function is created if it does not exist.
+    template<int TDim, class TVariableType>
+    static void ReadControlValues(std::istream& rIStream, MultiPatch<TDim>& rMultiPatch, const TVariableType& rVariable,
+            const std::size_t& ncomponents)
+    {
+        typedef typename TVariableType::Type DataType;
+
+        std::vector<double> values;
+        for (typename MultiPatch<TDim>::PatchContainerType::ptr_iterator it = rMultiPatch.Patches().ptr_begin();
+                it != rMultiPatch.Patches().ptr_end(); ++it)
+        {
+            typename ControlGrid<DataType>::Pointer pControlGrid;
+            if ((*it)->HasGridFunction(rVariable))
+            {
+                pControlGrid = (*it)->pGetGridFunction(rVariable)->pControlGrid();
+            }
+            else
+            {
+                typename BSplinesFESpace<TDim>::ConstPointer pFESpace = boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >((*it)->pFESpace());
+                std::vector<std::size_t> numbers(TDim);
+                for (std::size_t dim = 0; dim < TDim; ++dim)
+                    numbers[dim] = pFESpace->Number(dim);
+                pControlGrid = StructuredControlGrid<TDim, DataType>::Create(numbers);
+                (*it)->CreateGridFunction(rVariable, pControlGrid);
+            }
+
+            Read(rIStream, values, pControlGrid->size()*ncomponents);
+            DataType v;
+            for (std::size_t i = 0; i < pControlGrid->size(); ++i)
+            {
+                Unpack(v, &values[i*ncomponents], ncomponents);
+                pControlGrid->SetData(i, v);
+            }
+        }
+    }
+};
+
+/**
+Export the NURBS multipatch and the control values of the nodal variables at each time step to binary file.
+The multipatch definition is written once by Export and each call of WriteStep appends the control values of
+the registered variables, hence the results can be re-sampled at any resolution afterwards without re-running
+the simulation (see MultiNURBSPatchControlValueReader).
+ */
+template<int TDim>
+class MultiNURBSPatchControlValueWriter : public MultiPatchExporter<TDim>
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(MultiNURBSPatchControlValueWriter);
+
+    /// Type definition
+    typedef MultiPatchExporter<TDim> BaseType;
+    typedef MultiNURBSPatchBinaryIOHelper HelperType;
+
+    /// Default constructor
+    MultiNURBSPatchControlValueWriter() : BaseType() {}
+
+    /// Destructor
+    virtual ~MultiNURBSPatchControlValueWriter() {}
+
+    /// Register a variable to be written at each step
+    void AddVariable(const Variable<double>& rVariable) {mDoubleVariables.push_back(&rVariable);}
+    void AddVariable(const Variable<array_1d<double, 3> >& rVariable) {mArray1DVariables.push_back(&rVariable);}
+    void AddVariable(const Variable<Vector>& rVariable) {mVectorVariables.push_back(&rVariable);}
+
+    /// Export a multipatch. Only the geometry is written; the existing file is overwritten.
+    virtual void Export(typename MultiPatch<TDim>::Pointer pMultiPatch, const std::string& filename) const
+    {
+        std::ofstream outfile(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!outfile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Error opening file", filename)
+
+        HelperType::WriteMultiPatch<TDim>(outfile, *pMultiPatch);
+
+        outfile.close();
+
+        std::cout << "MultiPatch geometry is exported to " << filename << " successfully" << std::endl;
+    }
+
+    /// Append the control values of the registered variables to the file. The grid functions must be up-to-date,
+    /// i.e. MultiPatchModelPart::SynchronizeBackward shall be called before.
+    void WriteStep(typename MultiPatch<TDim>::Pointer pMultiPatch, const std::string& filename, const double& time) const
+    {
+        std::ofstream outfile(filename.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+        if (!outfile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Error opening file", filename)
+
+        HelperType::Write(outfile, static_cast<int32_t>(HelperType::STEP_TAG));
+        HelperType::Write(outfile, time);
+        HelperType::Write(outfile, static_cast<uint64_t>(mDoubleVariables.size() + mArray1DVariables.size() + mVectorVariables.size()));
+
+        for (std::size_t i = 0; i < mDoubleVariables.size(); ++i)
+            HelperType::WriteControlValues<TDim>(outfile, *pMultiPatch, *mDoubleVariables[i]);
+
+        for (std::size_t i = 0; i < mArray1DVariables.size(); ++i)
+            HelperType::WriteControlValues<TDim>(outfile, *pMultiPatch, *mArray1DVariables[i]);
+
+        for (std::size_t i = 0; i < mVectorVariables.size(); ++i)
+            HelperType::WriteControlValues<TDim>(outfile, *pMultiPatch, *mVectorVariables[i]);
+
+        outfile.close();
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "MultiNURBSPatchControlValueWriter";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << " Variables:";
+        for (std::size_t i = 0; i < mDoubleVariables.size(); ++i)
+            rOStream << " " << mDoubleVariables[i]->Name();
+        for (std::size_t i = 0; i < mArray1DVariables.size(); ++i)
+            rOStream << " " << mArray1DVariables[i]->Name();
+        for (std::size_t i = 0; i < mVectorVariables.size(); ++i)
+            rOStream << " " << mVectorVariables[i]->Name();
+    }
+
+private:
+
+    std::vector<const Variable<double>*> mDoubleVariables;
+    std::vector<const Variable<array_1d<double, 3> >*> mArray1DVariables;
+    std::vector<const Variable<Vector>*> mVectorVariables;
+
+}; // end class MultiNURBSPatchControlValueWriter
+
+/**
+Read the NURBS multipatch and the control values written by MultiNURBSPatchControlValueWriter, and sample
+the results on a uniform grid of any resolution.
+ */
+template<int TDim>
+class MultiNURBSPatchControlValueReader : public MultiPatchImporter<TDim>
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(MultiNURBSPatchControlValueReader);
+
+    /// Type definition
+    typedef MultiPatchImporter<TDim> BaseType;
+    typedef MultiNURBSPatchBinaryIOHelper HelperType;
+    typedef typename Patch<TDim>::ControlPointType ControlPointType;
+
+    /// Default constructor
+    MultiNURBSPatchControlValueReader() : BaseType() {}
+
+    /// Destructor
+    virtual ~MultiNURBSPatchControlValueReader() {}
+
+    /// Import the multipatch geometry
+    virtual typename MultiPatch<TDim>::Pointer Import(const std::string& filename) const
+    {
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!infile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Error opening file", filename)
+
+        return HelperType::ReadMultiPatch<TDim>(infile);
+    }
+
+    /// Get the time of all the steps in the file
+    std::vector<double> Times(const std::string& filename) const
+    {
+        std::vector<double> times;
+        std::vector<std::streampos> positions;
+        this->ScanSteps(filename, times, positions);
+        return times;
+    }
+
+    /// Get the number of steps in the file
+    std::size_t NumberOfSteps(const std::string& filename) const
+    {
+        return this->Times(filename).size();
+    }
+
+    /// Read the control values at the step (0-based) and assign to the grid functions of the multipatch.
+    /// The variables which are not registered in the kernel are skipped.
+    void ReadStep(typename MultiPatch<TDim>::Pointer pMultiPatch, const std::string& filename, const std::size_t& step) const
+    {
+        std::vector<double> times;
+        std::vector<std::streampos> positions;
+        this->ScanSteps(filename, times, positions);
+
+        if (step >= positions.size())
+            KRATOS_THROW_ERROR(std::logic_error, "The step does not exist in the file:", step)
+
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+        infile.seekg(positions[step]);
+
+        int32_t tag;
+        double time;
+        uint64_t nvars;
+        HelperType::Read(infile, tag);
+        HelperType::Read(infile, time);
+        HelperType::Read(infile, nvars);
+
+        std::string name;
+        int32_t type;
+        uint64_t ncomponents, nvalues;
+        for (std::size_t i = 0; i < nvars; ++i)
+        {
+            HelperType::Read(infile, name);
+            HelperType::Read(infile, type);
+            HelperType::Read(infile, ncomponents);
+            HelperType::Read(infile, nvalues);
+
+            if (type == HelperType::_DOUBLE_ && KratosComponents<Variable<double> >::Has(name))
+                HelperType::ReadControlValues<TDim>(infile, *pMultiPatch, KratosComponents<Variable<double> >::Get(name), ncomponents);
+            else if (type == HelperType::_ARRAY_1D_ && KratosComponents<Variable<array_1d<double, 3> > >::Has(name))
+                HelperType::ReadControlValues<TDim>(infile, *pMultiPatch, KratosComponents<Variable<array_1d<double, 3> > >::Get(name), ncomponents);
+            else if (type == HelperType::_VECTOR_ && KratosComponents<Variable<Vector> >::Has(name))
+                HelperType::ReadControlValues<TDim>(infile, *pMultiPatch, KratosComponents<Variable<Vector> >::Get(name), ncomponents);
+            else
+                infile.seekg(nvalues*sizeof(double), std::ios::cur);
+        }
+
+        infile.close();
+    }
+
+    /// Sample the physical coordinates of a patch with the given number of divisions in each direction
+    static void SampleCoordinates(typename Patch<TDim>::ConstPointer pPatch, const std::vector<std::size_t>& divisions,
+            std::vector<array_1d<double, 3> >& rPoints)
+    {
+        BSplinesPatchSampler<TDim> sampler(boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >(pPatch->pFESpace()), divisions);
+
+        // the control points are in homogeneous coordinates, so the B-Splines basis is used
+        std::vector<ControlPointType> points;
+        sampler.Sample(points, *(pPatch->pControlPointGridFunction()->pControlGrid()), std::vector<double>());
+
+        rPoints.resize(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            rPoints[i][0] = points[i].X();
+            rPoints[i][1] = points[i].Y();
+            rPoints[i][2] = points[i].Z();
+        }
+    }
+
+    /// Sample a variable of a patch with the given number of divisions in each direction
+    template<class TVariableType>
+    static void Sample(typename Patch<TDim>::ConstPointer pPatch, const TVariableType& rVariable, const std::vector<std::size_t>& divisions,
+            std::vector<typename TVariableType::Type>& rValues)
+    {
+        BSplinesPatchSampler<TDim> sampler(boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >(pPatch->pFESpace()), divisions);
+        sampler.Sample(rValues, *(pPatch->pGetGridFunction(rVariable)->pControlGrid()), pPatch->GetControlWeights());
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "MultiNURBSPatchControlValueReader";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+private:
+
+    /// Locate the start of each step record, skipping over the control values
+    void ScanSteps(const std::string& filename, std::vector<double>& times, std::vector<std::streampos>& positions) const
+    {
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!infile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Error opening file", filename)
+
+        HelperType::ReadMultiPatch<TDim>(infile);
+
+        times.clear();
+        positions.clear();
+
+        int32_t tag;
+        while (infile.peek() != std::char_traits<char>::eof())
+        {
+            std::streampos pos = infile.tellg();
+
+            double time;
+            uint64_t nvars;
+            HelperType::Read(infile, tag);
+            if (tag != HelperType::STEP_TAG)
+                KRATOS_THROW_ERROR(std::logic_error, "Invalid step record in", filename)
+            HelperType::Read(infile, time);
+            HelperType::Read(infile, nvars);
+
+            std::string name;
+            int32_t type;
+            uint64_t ncomponents, nvalues;
+            for (std::size_t i = 0; i < nvars; ++i)
+            {
+                HelperType::Read(infile, name);
+                HelperType::Read(infile, type);
+                HelperType::Read(infile, ncomponents);
+                HelperType::Read(infile, nvalues);
+                infile.seekg(nvalues*sizeof(double), std::ios::cur);
+            }
+
+            times.push_back(time);
+            positions.push_back(pos);
+        }
+    }
+
+}; // end class MultiNURBSPatchControlValueReader
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const MultiNURBSPatchControlValueWriter<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const MultiNURBSPatchControlValueReader<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_NURBS_PATCH_CONTROL_VALUE_IO_H_INCLUDED defined
@@ -11,6 +11,9 @@
 
 // System includes
 #include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 
@@ -19,6 +22,7 @@
 // Project includes
 #include "includes/define.h"
 #include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/nurbs/structured_control_grid.h"
 #include "custom_utilities/import_export/multipatch_importer.h"
 
 namespace Kratos
@@ -80,389 +84,537 @@ int GetDimensionOfGeo(const std::string& fn)
 }
 
 
-template<int TDim>
-class MultiNURBSPatchGeoImporter : public MultiPatchImporter<TDim>
+/// Tokenizer of a geo file held in memory.
+/// It walks through the lines, skipping the empty lines and the comments, and parses the numbers in place, i.e.
+/// no string is created for the tokens. The buffer must be terminated by a character which is not part of a number.
+class GeoTokenizer
 {
 public:
-    KRATOS_CLASS_POINTER_DEFINITION(MultiNURBSPatchGeoImporter);
 
-    virtual typename Patch<TDim>::Pointer ImportSingle(const std::string& filename)
+    /// Constructor with the range [begin, end) of the buffer
+    GeoTokenizer(const char* begin, const char* end)
+    : mpCurrent(begin), mpEnd(end), mpLineBegin(begin), mpLineEnd(begin), mpToken(begin)
+    {}
+
+    /// Read the whole file into a buffer, terminated by '\0'
+    static void ReadFile(const std::string& filename, std::vector<char>& rBuffer)
     {
-        std::ifstream infile(filename.c_str());
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
         if(!infile)
             KRATOS_THROW_ERROR(std::logic_error, "Error open file", filename)
 
-        std::vector<std::size_t> orders;
-        std::vector<std::size_t> numbers;
-        std::vector<std::vector<double> > knots(3);
-        std::vector<std::vector<double> > wcoords(3);
-        std::vector<double> weights;
+        infile.seekg(0, std::ios::end);
+        std::size_t size = static_cast<std::size_t>(infile.tellg());
+        infile.seekg(0, std::ios::beg);
 
-        // firstly check the version
-        std::string firstline;
-        std::vector<std::string> words;
-        std::getline(infile, firstline);
-        boost::trim_if(firstline, boost::is_any_of("\t ")); // ignore trailing spaces
-        boost::split(words, firstline, boost::is_any_of(" \t"), boost::token_compress_on);
+        rBuffer.resize(size + 1);
+        if (size > 0)
+            infile.read(&rBuffer[0], size);
+        rBuffer[size] = '\0';
+    }
 
-        if(words[3] == std::string("v.0.7"))
+    /// Move to the next line which is neither empty nor a comment. Return false at the end of the buffer.
+    bool NextLine()
+    {
+        while (mpCurrent < mpEnd)
         {
-            ReadV07Single(infile, orders, numbers, knots, wcoords, weights);
+            const char* eol = static_cast<const char*>(std::memchr(mpCurrent, '\n', mpEnd - mpCurrent));
+            mpLineBegin = mpCurrent;
+            mpLineEnd = (eol != NULL) ? eol : mpEnd;
+            mpCurrent = (eol != NULL) ? eol + 1 : mpEnd;
+
+            // ignore leading and trailing spaces
+            while (mpLineBegin < mpLineEnd && IsSpace(*mpLineBegin)) ++mpLineBegin;
+            while (mpLineEnd > mpLineBegin && IsSpace(*(mpLineEnd-1))) --mpLineEnd;
+
+            if (mpLineBegin != mpLineEnd && *mpLineBegin != '#')
+            {
+                mpToken = mpLineBegin;
+                return true;
+            }
         }
-        else if(words[3] == std::string("v.2.1"))
+        return false;
+    }
+
+    /// Count the number of tokens in the current line
+    std::size_t CountTokens() const
+    {
+        std::size_t cnt = 0;
+        const char* p = mpLineBegin;
+        while (p < mpLineEnd)
         {
-            ReadV21Single(infile, orders, numbers, knots, wcoords, weights);
+            while (p < mpLineEnd && IsSpace(*p)) ++p;
+            if (p == mpLineEnd) break;
+            ++cnt;
+            while (p < mpLineEnd && !IsSpace(*p)) ++p;
         }
+        return cnt;
+    }
 
-        infile.close();
+    /// Check if the current line starts with the keyword
+    bool IsKeyword(const char* keyword) const
+    {
+        std::size_t len = std::strlen(keyword);
+        return (static_cast<std::size_t>(mpLineEnd - mpLineBegin) >= len)
+            && (std::strncmp(mpLineBegin, keyword, len) == 0)
+            && (mpLineBegin + len == mpLineEnd || IsSpace(mpLineBegin[len]));
+    }
 
-        // create the FESpace
-        typename BSplinesFESpace<TDim>::Pointer pNewFESpace = BSplinesFESpace<TDim>::Create();
-        for (int dim = 0; dim < TDim; ++dim)
+    /// Read the next integer in the current line
+    int ReadInt()
+    {
+        SkipSpaces();
+        char* p;
+        long v = std::strtol(mpToken, &p, 10);
+        if (p == mpToken || p > mpLineEnd)
+            KRATOS_THROW_ERROR(std::logic_error, "Expect an integer at line:", Line())
+        mpToken = SkipToken(p);
+        return static_cast<int>(v);
+    }
+
+    /// Read all the remaining numbers in the current line and append them to rValues. Return the number of values read.
+    std::size_t ReadValues(std::vector<double>& rValues)
+    {
+        std::size_t cnt = 0;
+        SkipSpaces();
+        while (mpToken < mpLineEnd)
         {
-            pNewFESpace->SetKnotVector(dim, knots[dim]);
-            pNewFESpace->SetInfo(dim, numbers[dim], orders[dim]);
+            const char* p;
+            double v = ParseDouble(mpToken, p);
+            if (p == mpToken || p > mpLineEnd)
+                KRATOS_THROW_ERROR(std::logic_error, "Expect a number at line:", Line())
+            rValues.push_back(v);
+            ++cnt;
+            mpToken = SkipToken(p);
+            SkipSpaces();
         }
+        return cnt;
+    }
 
-        // reset function indices and enumerate it first time to give each function in the FESpace a different id
-        pNewFESpace->ResetFunctionIndices();
-        std::size_t start = 0;
-        pNewFESpace->Enumerate(start);
+    /// Get the beginning of the current line
+    const char* LineBegin() const {return mpLineBegin;}
 
-        // create new patch
-        typename Patch<TDim>::Pointer pNewPatch = Patch<TDim>::Create(0, pNewFESpace);
+    /// Get a copy of the current line, for the error message
+    std::string Line() const {return std::string(mpLineBegin, mpLineEnd);}
 
-        // create control grid and assign to new patch
-        typedef ControlPoint<double> ControlPointType;
-        typename StructuredControlGrid<TDim, ControlPointType>::Pointer pControlPointGrid = StructuredControlGrid<TDim, ControlPointType>::Create(numbers);
-        std::size_t total_number = 1;
-        for (int dim = 0; dim < TDim; ++dim)
-            total_number *= numbers[dim];
+private:
 
-        for (std::size_t i = 0; i < total_number; ++i)
-        {
-            ControlPointType c;
-            if (TDim == 2)
-                c.SetCoordinates(wcoords[0][i]/weights[i], wcoords[1][i]/weights[i], 0.0, weights[i]);
-            else if (TDim == 3)
-                c.SetCoordinates(wcoords[0][i]/weights[i], wcoords[1][i]/weights[i], wcoords[2][i]/weights[i], weights[i]);
-            pControlPointGrid->SetData(i, c);
-        }
+    const char* mpCurrent; // the beginning of the next line
+    const char* mpEnd;
+    const char* mpLineBegin;
+    const char* mpLineEnd;
+    const char* mpToken;
 
-        pControlPointGrid->SetName("CONTROL_POINT");
-        pNewPatch->CreateControlPointGridFunction(pControlPointGrid);
+    static bool IsSpace(const char& c) {return c == ' ' || c == '\t' || c == '\r';}
 
-        std::cout << __FUNCTION__ << ": Read NURBS from " << filename << " completed" << std::endl;
-        return pNewPatch;
+    void SkipSpaces()
+    {
+        while (mpToken < mpLineEnd && IsSpace(*mpToken)) ++mpToken;
     }
 
-    virtual typename MultiPatch<TDim>::Pointer Import(const std::string& filename)
+    /// Parse a double starting at p. The numbers with at most 15 significant digits and a small exponent are
+    /// converted exactly by one multiplication or division (Clinger's fast path), the others by std::strtod.
+    static double ParseDouble(const char* p, const char*& rEnd)
     {
-        KRATOS_THROW_ERROR(std::logic_error, __FUNCTION__, "is not implemented")
+        static const double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        const char* q = p;
+        bool negative = false;
+        if (*q == '-' || *q == '+')
+            negative = (*(q++) == '-');
+
+        unsigned long long mantissa = 0;
+        int ndigits = 0, exponent = 0;
+        const char* digits_begin = q;
+        while (*q >= '0' && *q <= '9')
+        {
+            if (mantissa != 0 || *q != '0') ++ndigits;
+            mantissa = 10*mantissa + (*q - '0');
+            ++q;
+            if (ndigits > 15) break;
+        }
+        if (*q == '.' && ndigits <= 15)
+        {
+            ++q;
+            while (*q >= '0' && *q <= '9')
+            {
+                if (mantissa != 0 || *q != '0') ++ndigits;
+                mantissa = 10*mantissa + (*q - '0');
+                --exponent;
+                ++q;
+                if (ndigits > 15) break;
+            }
+        }
+        const bool has_digits = (q != digits_begin) && !(q == digits_begin + 1 && *digits_begin == '.');
+        if (has_digits && ndigits <= 15 && (*q == 'e' || *q == 'E'))
+        {
+            const char* r = q + 1;
+            bool negative_exponent = false;
+            if (*r == '-' || *r == '+')
+                negative_exponent = (*(r++) == '-');
+            if (*r >= '0' && *r <= '9')
+            {
+                int e = 0;
+                while (*r >= '0' && *r <= '9' && e < 1000)
+                    e = 10*e + (*(r++) - '0');
+                exponent += negative_exponent ? -e : e;
+                q = r;
+            }
+        }
+
+        if (has_digits && ndigits <= 15 && exponent >= -22 && exponent <= 22 && !(*q >= '0' && *q <= '9') && *q != '.')
+        {
+            double v = static_cast<double>(mantissa);
+            v = (exponent < 0) ? v / pow10[-exponent] : v * pow10[exponent];
+            rEnd = q;
+            return negative ? -v : v;
+        }
+
+        // fall back to the library for the long or special numbers
+        char* end;
+        double v = std::strtod(p, &end);
+        rEnd = end;
+        return v;
     }
 
-    /// Information
-    virtual void PrintInfo(std::ostream& rOStream) const
+    /// Skip the rest of a token which is not part of the number (e.g. "1.0d0")
+    const char* SkipToken(const char* p) const
     {
-        rOStream << "MultiNURBSPatchGeoImporter";
+        while (p < mpLineEnd && !IsSpace(*p)) ++p;
+        return p;
     }
+};
 
-    virtual void PrintData(std::ostream& rOStream) const
+
+template<int TDim>
+class MultiNURBSPatchGeoImporter : public MultiPatchImporter<TDim>
+{
+public:
+    KRATOS_CLASS_POINTER_DEFINITION(MultiNURBSPatchGeoImporter);
+
+    /// Type definition
+    typedef ControlPoint<double> ControlPointType;
+
+    /// Data of a patch read from the geo file
+    struct GeoPatchData
     {
-    }
+        std::vector<std::size_t> orders;
+        std::vector<std::size_t> numbers;
+        std::vector<std::vector<double> > knots;
+        std::vector<std::vector<double> > wcoords;
+        std::vector<double> weights;
 
-private:
+        GeoPatchData() : knots(3), wcoords(3) {}
+    };
 
-    void ReadV07Single(std::ifstream& infile, std::vector<std::size_t>& orders,
-        std::vector<std::size_t>& numbers,
-        std::vector<std::vector<double> >& knots,
-        std::vector<std::vector<double> >& wcoords,
-        std::vector<double>& weights)
+    /// Import a single patch from geo file (v.0.7 or v.2.1)
+    virtual typename Patch<TDim>::Pointer ImportSingle(const std::string& filename) const
     {
-        std::string line;
-        std::vector<std::string> words;
-        int read_mode = _READ_PATCH;
-        int npatches, dim_index = 0;
+        std::vector<char> buffer;
+        GeoTokenizer::ReadFile(filename, buffer);
+        GeoTokenizer tokenizer(&buffer[0], &buffer[0] + buffer.size() - 1);
 
-        while(!infile.eof())
+        GeoPatchData data;
+
+        // firstly check the version
+        int version = ReadVersion(tokenizer);
+        if (version == 7)
         {
-            std::getline(infile, line);
-            boost::trim_if(line, boost::is_any_of("\t ")); // ignore trailing spaces
-            boost::split(words, line, boost::is_any_of(" \t"), boost::token_compress_on);
+            ReadV07Single(tokenizer, data);
+        }
+        else if (version == 21)
+        {
+            ReadV21Single(tokenizer, data);
+        }
+        else
+            KRATOS_THROW_ERROR(std::logic_error, "Unsupported version of geo file", filename)
 
-            if(words.size() != 0)
-            {
-                if(words[0] == std::string("#") || words[0][0] == '#')
-                    continue;
+        typename Patch<TDim>::Pointer pNewPatch = CreatePatch(0, data);
 
-                if(read_mode == _READ_PATCH)
-                {
-                    // bound check
-                    if(words.size() < 2)
-                    {
-                        std::cout << "Error at line: " << line << std::endl;
-                        KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain information about dimension and number of patches, current number of information =", words.size())
-                    }
+        std::cout << __FUNCTION__ << ": Read NURBS from " << filename << " completed" << std::endl;
+        return pNewPatch;
+    }
 
-                    // read info
-                    int Dim = atoi(words[0].c_str());
-                    if (Dim != TDim)
-                        KRATOS_THROW_ERROR(std::logic_error, "The input dimension is invalid", "")
-                    npatches = atoi(words[1].c_str());
-                    if(npatches > 1)
-                    {
-                        KRATOS_WATCH(line)
-                        KRATOS_WATCH(words[0])
-                        KRATOS_WATCH(words[1])
-                        KRATOS_THROW_ERROR(std::logic_error, "At present, the number of patches > 1 is not supported, npatches =", npatches)
-                    }
-                    read_mode = _READ_ORDER;
-                    continue;
-                }
+    /// Import all the patches from geo file (v.2.1). The patches are parsed in parallel.
+    /// The patches are numbered following the order in the file, starting from 1. The interface sections
+    /// are not read, hence the topology of the multipatch must be set after import.
+    virtual typename MultiPatch<TDim>::Pointer Import(const std::string& filename) const
+    {
+        std::vector<char> buffer;
+        GeoTokenizer::ReadFile(filename, buffer);
+        GeoTokenizer tokenizer(&buffer[0], &buffer[0] + buffer.size() - 1);
+
+        std::vector<GeoPatchData> data;
 
-                if(read_mode == _READ_ORDER)
+        int version = ReadVersion(tokenizer);
+        if (version == 7)
+        {
+            data.resize(1);
+            ReadV07Single(tokenizer, data[0]);
+        }
+        else if (version == 21)
+        {
+            // read the header
+            if (!tokenizer.NextLine() || tokenizer.CountTokens() < 3)
+                KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain information about dimension, rational dimension and number of patches, line:", tokenizer.Line())
+            int Dim = tokenizer.ReadInt();
+            if (Dim != TDim)
+                KRATOS_THROW_ERROR(std::logic_error, "The input dimension is invalid", "")
+            int rdim = tokenizer.ReadInt();
+            int npatches = tokenizer.ReadInt();
+
+            // locate the patch sections, a section ends at the next patch or at the interfaces/boundaries/subdomains
+            std::vector<const char*> sections;
+            const char* sections_end = &buffer[0] + buffer.size() - 1;
+            while (tokenizer.NextLine())
+            {
+                if (tokenizer.IsKeyword("PATCH"))
                 {
-                    // bound check
-                    if(words.size() != TDim)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Order section must contained number of information equal to dimension, current number of information =", words.size())
-
-                    // read info
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        orders.push_back(static_cast<std::size_t>(atoi(words[i].c_str())));
-                    read_mode = _READ_NUMBER;
-                    continue;
+                    sections.push_back(tokenizer.LineBegin());
                 }
-
-                if(read_mode == _READ_NUMBER)
+                else if (tokenizer.IsKeyword("INTERFACE") || tokenizer.IsKeyword("BOUNDARY") || tokenizer.IsKeyword("SUBDOMAIN"))
                 {
-                    // bound check
-                    if(words.size() != TDim)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Number section must contained number of information equal to dimension, current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        numbers.push_back(static_cast<std::size_t>(atoi(words[i].c_str())));
-                    read_mode = _READ_KNOTS;
-                    continue;
+                    sections_end = tokenizer.LineBegin();
+                    break;
                 }
-
-                if(read_mode == _READ_KNOTS)
+            }
+            if (sections.size() != static_cast<std::size_t>(npatches))
+                KRATOS_THROW_ERROR(std::logic_error, "The number of PATCH sections is not the same as the number of patches in the header:", sections.size())
+            sections.push_back(sections_end);
+
+            // parse the patches in parallel
+            data.resize(npatches);
+            std::string error_message;
+            #pragma omp parallel for schedule(dynamic)
+            for (int ip = 0; ip < npatches; ++ip)
+            {
+                try
                 {
-                    // bound check
-                    int knot_len = numbers[dim_index] + orders[dim_index] + 1;
-                    if(words.size() != knot_len)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Knots section must contained number of information equal to n+p+1, current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < knot_len; ++i)
-                    {
-                        double k = atof(words[i].c_str());
-                        knots[dim_index].push_back(k);
-                    }
-
-                    ++dim_index;
-                    if(dim_index == TDim)
-                    {
-                        dim_index = 0;
-                        read_mode = _READ_COORDINATES;
-                    }
-                    continue;
+                    GeoTokenizer patch_tokenizer(sections[ip], sections[ip+1]);
+                    patch_tokenizer.NextLine(); // PATCH
+                    ReadPatch(patch_tokenizer, rdim, data[ip]);
                 }
-
-                if(read_mode == _READ_COORDINATES)
+                catch (std::exception& e)
                 {
-                    // bound check
-                    int num_basis = 1;
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        num_basis *= numbers[i];
-                    if(words.size() != num_basis)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Coordinates section must contained number of information equal to prod(ni), current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < num_basis; ++i)
-                        wcoords[dim_index].push_back(atof(words[i].c_str()));
-
-                    ++dim_index;
-                    if(dim_index == TDim)
+                    #pragma omp critical
                     {
-                        dim_index = 0;
-                        read_mode = _READ_WEIGHTS;
+                        if (error_message.empty())
+                            error_message = e.what();
                     }
-                    continue;
-                }
-
-                if(read_mode == _READ_WEIGHTS)
-                {
-                    // bound check
-                    int num_basis = 1;
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        num_basis *= numbers[i];
-                    if(words.size() != num_basis)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Weights section must contained number of information equal to prod(ni), current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < num_basis; ++i)
-                        weights.push_back(atof(words[i].c_str()));
-
-                    read_mode = _NO_READ;
-                    continue;
                 }
             }
+            if (!error_message.empty())
+                KRATOS_THROW_ERROR(std::logic_error, "Error reading the patches:", error_message)
         }
+        else
+            KRATOS_THROW_ERROR(std::logic_error, "Unsupported version of geo file", filename)
+
+        typename MultiPatch<TDim>::Pointer pMultiPatch = typename MultiPatch<TDim>::Pointer(new MultiPatch<TDim>());
+        for (std::size_t ip = 0; ip < data.size(); ++ip)
+            pMultiPatch->AddPatch(CreatePatch(ip+1, data[ip]));
+
+        std::cout << __FUNCTION__ << ": Read " << data.size() << " NURBS patches from " << filename << " completed" << std::endl;
+        return pMultiPatch;
     }
 
-    void ReadV21Single(std::ifstream& infile, std::vector<std::size_t>& orders,
-        std::vector<std::size_t>& numbers,
-        std::vector<std::vector<double> >& knots,
-        std::vector<std::vector<double> >& wcoords,
-        std::vector<double>& weights)
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
     {
-        std::string line;
-        std::vector<std::string> words;
-        int read_mode = _READ_PATCH;
-        int ipatch = 0, npatches, rdim, dim_index = 0;
+        rOStream << "MultiNURBSPatchGeoImporter";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
 
-        while(!infile.eof())
+private:
+
+    /// Read the version in the first line, e.g. "# nurbs mesh v.2.1". Return 7 for v.0.7, 21 for v.2.1 and 0 otherwise.
+    static int ReadVersion(GeoTokenizer& rTokenizer)
+    {
+        // the version is in a comment line, hence it is read before skipping the comments
+        const char* p = rTokenizer.LineBegin();
+        const char* eol = p;
+        while (*eol != '\n' && *eol != '\0') ++eol;
+        std::string firstline(p, eol);
+        if (firstline.find("v.0.7") != std::string::npos)
+            return 7;
+        if (firstline.find("v.2.1") != std::string::npos)
+            return 21;
+        return 0;
+    }
+
+    /// Create the patch from the data read from geo file
+    static typename Patch<TDim>::Pointer CreatePatch(const std::size_t& Id, const GeoPatchData& data)
+    {
+        // create the FESpace
+        typename BSplinesFESpace<TDim>::Pointer pNewFESpace = BSplinesFESpace<TDim>::Create();
+        for (int dim = 0; dim < TDim; ++dim)
         {
-            std::getline(infile, line);
-            boost::trim_if(line, boost::is_any_of("\t ")); // ignore trailing spaces
-            boost::split(words, line, boost::is_any_of(" \t"), boost::token_compress_on);
+            pNewFESpace->SetKnotVector(dim, data.knots[dim]);
+            pNewFESpace->SetInfo(dim, data.numbers[dim], data.orders[dim]);
+        }
 
-            if(words.size() != 0)
-            {
-                if(words[0] == std::string("#") || words[0][0] == '#')
-                    continue;
+        // reset function indices and enumerate it first time to give each function in the FESpace a different id
+        pNewFESpace->ResetFunctionIndices();
+        std::size_t start = 0;
+        pNewFESpace->Enumerate(start);
 
-                if(read_mode == _READ_PATCH)
-                {
-                    // bound check
-                    if(words.size() < 2)
-                    {
-                        std::cout << "Error at line: " << line << std::endl;
-                        KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain information about dimension and number of patches, current number of information =", words.size())
-                    }
+        // create new patch
+        typename Patch<TDim>::Pointer pNewPatch = Patch<TDim>::Create(Id, pNewFESpace);
 
-                    // read info
-                    int Dim = atoi(words[0].c_str());
-                    if (Dim != TDim)
-                        KRATOS_THROW_ERROR(std::logic_error, "The input dimension is invalid", "")
-                    rdim = atoi(words[1].c_str());
-                    npatches = atoi(words[2].c_str());
-                    KRATOS_WATCH(rdim)
-                    KRATOS_WATCH(npatches)
-                    if(npatches > 1)
-                    {
-                        KRATOS_WATCH(line)
-                        KRATOS_WATCH(words[0])
-                        KRATOS_WATCH(words[1])
-                        KRATOS_THROW_ERROR(std::logic_error, "At present, the number of patches > 1 is not supported, npatches =", npatches)
-                    }
-                    read_mode = _CHECK_PATCH;
-                    continue;
-                }
+        // create control grid and assign to new patch
+        typename StructuredControlGrid<TDim, ControlPointType>::Pointer pControlPointGrid = StructuredControlGrid<TDim, ControlPointType>::Create(data.numbers);
+        std::size_t total_number = 1;
+        for (int dim = 0; dim < TDim; ++dim)
+            total_number *= data.numbers[dim];
 
-                if(read_mode == _CHECK_PATCH)
-                {
-                    // bound check
-                    if(words.size() < 2)
-                    {
-                        std::cout << "Error at line: " << line << std::endl;
-                        KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain PATCH and the patch index, current number of information =", words.size())
-                    }
+        const std::vector<std::vector<double> >& wcoords = data.wcoords;
+        const std::vector<double>& weights = data.weights;
+        for (std::size_t i = 0; i < total_number; ++i)
+        {
+            ControlPointType c;
+            if (TDim == 2)
+                c.SetCoordinates(wcoords[0][i]/weights[i], wcoords[1][i]/weights[i], 0.0, weights[i]);
+            else if (TDim == 3)
+                c.SetCoordinates(wcoords[0][i]/weights[i], wcoords[1][i]/weights[i], wcoords[2][i]/weights[i], weights[i]);
+            pControlPointGrid->SetData(i, c);
+        }
 
-                    if(words[0] == "PATCH")
-                    {
-                        if(ipatch == npatches)
-                            break;
-                        ++ipatch;
-                    }
-                    else
-                        KRATOS_THROW_ERROR(std::logic_error, "The patch section has wrong keyword", words[0])
-                    read_mode = _READ_ORDER;
-                    continue;
-                }
+        pControlPointGrid->SetName("CONTROL_POINT");
+        pNewPatch->CreateControlPointGridFunction(pControlPointGrid);
 
-                if(read_mode == _READ_ORDER)
-                {
-                    // bound check
-                    if(words.size() != TDim)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Order section must contained number of information equal to dimension, current number of information =", words.size())
-
-                    // read info
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        orders.push_back(static_cast<std::size_t>(atoi(words[i].c_str())));
-                    read_mode = _READ_NUMBER;
-                    continue;
-                }
+        return pNewPatch;
+    }
 
-                if(read_mode == _READ_NUMBER)
-                {
-                    // bound check
-                    if(words.size() != TDim)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Number section must contained number of information equal to dimension, current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        numbers.push_back(static_cast<std::size_t>(atoi(words[i].c_str())));
-                    read_mode = _READ_KNOTS;
-                    continue;
-                }
+    static void ReadV07Single(GeoTokenizer& rTokenizer, GeoPatchData& data)
+    {
+        if (!rTokenizer.NextLine())
+            return;
 
-                if(read_mode == _READ_KNOTS)
-                {
-                    // bound check
-                    int knot_len = numbers[dim_index] + orders[dim_index] + 1;
-                    if(words.size() != knot_len)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Knots section must contained number of information equal to n+p+1, current number of information =", words.size())
+        // bound check
+        if(rTokenizer.CountTokens() < 2)
+        {
+            std::cout << "Error at line: " << rTokenizer.Line() << std::endl;
+            KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain information about dimension and number of patches, current number of information =", rTokenizer.CountTokens())
+        }
 
-                    for(std::size_t i = 0; i < knot_len; ++i)
-                    {
-                        double k = atof(words[i].c_str());
-                        knots[dim_index].push_back(k);
-                    }
+        // read info
+        int Dim = rTokenizer.ReadInt();
+        if (Dim != TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The input dimension is invalid", "")
+        int npatches = rTokenizer.ReadInt();
+        if(npatches > 1)
+        {
+            KRATOS_WATCH(rTokenizer.Line())
+            KRATOS_THROW_ERROR(std::logic_error, "At present, the number of patches > 1 is not supported, npatches =", npatches)
+        }
 
-                    ++dim_index;
-                    if(dim_index == TDim)
-                    {
-                        dim_index = 0;
-                        read_mode = _READ_COORDINATES;
-                    }
-                    continue;
-                }
+        ReadPatch(rTokenizer, TDim, data);
+    }
 
-                if(read_mode == _READ_COORDINATES)
-                {
-                    // bound check
-                    int num_basis = 1;
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        num_basis *= numbers[i];
-                    if(words.size() != num_basis)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Coordinates section must contained number of information equal to prod(ni), current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < num_basis; ++i)
-                        wcoords[dim_index].push_back(atof(words[i].c_str()));
-
-                    ++dim_index;
-                    if(dim_index == rdim)
-                    {
-                        dim_index = 0;
-                        read_mode = _READ_WEIGHTS;
-                    }
-                    continue;
-                }
+    static void ReadV21Single(GeoTokenizer& rTokenizer, GeoPatchData& data)
+    {
+        if (!rTokenizer.NextLine())
+            return;
 
-                if(read_mode == _READ_WEIGHTS)
-                {
-                    // bound check
-                    int num_basis = 1;
-                    for(std::size_t i = 0; i < TDim; ++i)
-                        num_basis *= numbers[i];
-                    if(words.size() != num_basis)
-                        KRATOS_THROW_ERROR(std::logic_error, "The Weights section must contained number of information equal to prod(ni), current number of information =", words.size())
-
-                    for(std::size_t i = 0; i < num_basis; ++i)
-                        weights.push_back(atof(words[i].c_str()));
-
-                    read_mode = _NO_READ;
-                    continue;
-                }
-            }
+        // bound check
+        if(rTokenizer.CountTokens() < 3)
+        {
+            std::cout << "Error at line: " << rTokenizer.Line() << std::endl;
+            KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain information about dimension and number of patches, current number of information =", rTokenizer.CountTokens())
+        }
+
+        // read info
+        int Dim = rTokenizer.ReadInt();
+        if (Dim != TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The input dimension is invalid", "")
+        int rdim = rTokenizer.ReadInt();
+        int npatches = rTokenizer.ReadInt();
+        KRATOS_WATCH(rdim)
+        KRATOS_WATCH(npatches)
+        if(npatches > 1)
+        {
+            KRATOS_WATCH(rTokenizer.Line())
+            KRATOS_THROW_ERROR(std::logic_error, "At present, the number of patches > 1 is not supported by ImportSingle, npatches =", npatches)
+        }
+
+        // bound check
+        if (!rTokenizer.NextLine())
+            return;
+        if(rTokenizer.CountTokens() < 2)
+        {
+            std::cout << "Error at line: " << rTokenizer.Line() << std::endl;
+            KRATOS_THROW_ERROR(std::logic_error, "The Patch section need to contain PATCH and the patch index, current number of information =", rTokenizer.CountTokens())
         }
+        if(!rTokenizer.IsKeyword("PATCH"))
+            KRATOS_THROW_ERROR(std::logic_error, "The patch section has wrong keyword", rTokenizer.Line())
+
+        ReadPatch(rTokenizer, rdim, data);
+    }
+
+    /// Read the orders, numbers, knots, coordinates and weights of a patch, in this order. The coordinates are given in rdim lines.
+    static void ReadPatch(GeoTokenizer& rTokenizer, const int& rdim, GeoPatchData& data)
+    {
+        std::vector<double> values;
+        std::size_t n;
+
+        // orders
+        if (!rTokenizer.NextLine())
+            KRATOS_THROW_ERROR(std::logic_error, "The Order section is missing", "")
+        n = rTokenizer.ReadValues(values);
+        if(n != TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The Order section must contained number of information equal to dimension, current number of information =", n)
+        for(std::size_t i = 0; i < TDim; ++i)
+            data.orders.push_back(static_cast<std::size_t>(values[i]));
+
+        // numbers
+        values.clear();
+        if (!rTokenizer.NextLine())
+            KRATOS_THROW_ERROR(std::logic_error, "The Number section is missing", "")
+        n = rTokenizer.ReadValues(values);
+        if(n != TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The Number section must contained number of information equal to dimension, current number of information =", n)
+        for(std::size_t i = 0; i < TDim; ++i)
+            data.numbers.push_back(static_cast<std::size_t>(values[i]));
+
+        // knots
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            std::size_t knot_len = data.numbers[dim] + data.orders[dim] + 1;
+            data.knots[dim].reserve(knot_len);
+            if (!rTokenizer.NextLine())
+                KRATOS_THROW_ERROR(std::logic_error, "The Knots section is missing", "")
+            n = rTokenizer.ReadValues(data.knots[dim]);
+            if(n != knot_len)
+                KRATOS_THROW_ERROR(std::logic_error, "The Knots section must contained number of information equal to n+p+1, current number of information =", n)
+        }
+
+        std::size_t num_basis = 1;
+        for(std::size_t i = 0; i < TDim; ++i)
+            num_basis *= data.numbers[i];
+
+        // coordinates
+        if (rdim > 3)
+            KRATOS_THROW_ERROR(std::logic_error, "The rational dimension is invalid:", rdim)
+        for (int dim = 0; dim < rdim; ++dim)
+        {
+            data.wcoords[dim].reserve(num_basis);
+            if (!rTokenizer.NextLine())
+                KRATOS_THROW_ERROR(std::logic_error, "The Coordinates section is missing", "")
+            n = rTokenizer.ReadValues(data.wcoords[dim]);
+            if(n != num_basis)
+                KRATOS_THROW_ERROR(std::logic_error, "The Coordinates section must contained number of information equal to prod(ni), current number of information =", n)
+        }
+
+        // weights
+        data.weights.reserve(num_basis);
+        if (!rTokenizer.NextLine())
+            KRATOS_THROW_ERROR(std::logic_error, "The Weights section is missing", "")
+        n = rTokenizer.ReadValues(data.weights);
+        if(n != num_basis)
+            KRATOS_THROW_ERROR(std::logic_error, "The Weights section must contained number of information equal to prod(ni), current number of information =", n)
     }
 
 };
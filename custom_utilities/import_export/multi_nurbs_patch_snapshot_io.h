@@ -0,0 +1,606 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_NURBS_PATCH_SNAPSHOT_IO_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_NURBS_PATCH_SNAPSHOT_IO_H_INCLUDED
+
+// System includes
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <streambuf>
+#include <fstream>
+#include <cstring>
+#include <stdint.h>
+
+// External includes
+#ifdef ISOGEOMETRIC_USE_ZLIB
+#include <zlib.h>
+#endif
+
+// Project includes
+#include "includes/define.h"
+#include "custom_utilities/nurbs/structured_control_grid.h"
+#include "custom_utilities/import_export/multipatch_exporter.h"
+#include "custom_utilities/import_export/multipatch_importer.h"
+#include "custom_utilities/import_export/multi_nurbs_patch_control_value_io.h"
+
+namespace Kratos
+{
+
+/**
+Low-level routines of the binary snapshot of the NURBS multipatch. The layout of the file is:
+    header:     "IGASNAP\0", int32 version, int32 compression level, int32 shuffle, uint64 size of the payload,
+                uint64 block size, uint64 number of blocks, uint64 stored size of each block, then the blocks
+    payload:    the multipatch geometry and topology as written by MultiNURBSPatchBinaryIOHelper::WriteMultiPatch,
+                then per patch: uint64 number of grid functions,
+                per grid function: uint32 length of name, name, int32 type (1: double, 2: array_1d, 3: Vector),
+                uint64 number of components, uint64 number of values, then the control values, component fastest
+The payload is streamed into blocks which are compressed independently (with zlib), hence in parallel. If the shuffle
+is enabled, the bytes of the doubles in each block are regrouped by significance before compression, which
+improves the compression ratio of the floating point data. With compression level 0 the blocks are stored as-is.
+ */
+class MultiNURBSPatchSnapshotIOHelper
+{
+public:
+
+    static const int VERSION = 1;
+    static const std::size_t BLOCK_SIZE = 1 << 22;
+
+    typedef MultiNURBSPatchBinaryIOHelper HelperType;
+    typedef std::vector<std::vector<char> > BlockContainerType;
+
+    /// Stream buffer which writes the payload directly to the blocks, so that the payload is not assembled in one string
+    class BlockOutputBuffer : public std::streambuf
+    {
+    public:
+        BlockOutputBuffer() : mSize(0) {}
+
+        /// Close the last block and return the blocks. No more data shall be written after this.
+        BlockContainerType& Blocks()
+        {
+            if (!mBlocks.empty())
+            {
+                mSize += pptr() - pbase();
+                mBlocks.back().resize(pptr() - pbase());
+                setp(NULL, NULL);
+            }
+            return mBlocks;
+        }
+
+        /// Get the size of the payload. Only valid after Blocks() is called.
+        std::size_t Size() const {return mSize;}
+
+    protected:
+        virtual int_type overflow(int_type c)
+        {
+            if (!mBlocks.empty())
+                mSize += pptr() - pbase();
+            mBlocks.push_back(std::vector<char>(BLOCK_SIZE));
+            setp(&mBlocks.back()[0], &mBlocks.back()[0] + BLOCK_SIZE);
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+    private:
+        BlockContainerType mBlocks;
+        std::size_t mSize;
+    };
+
+    /// Stream buffer which reads the payload directly from the blocks
+    class BlockInputBuffer : public std::streambuf
+    {
+    public:
+        BlockInputBuffer() : mCurrent(0) {}
+
+        /// Get the blocks to be filled by ReadBlocks
+        BlockContainerType& Blocks() {return mBlocks;}
+
+    protected:
+        virtual int_type underflow()
+        {
+            while (mCurrent < mBlocks.size() && mBlocks[mCurrent].empty())
+                ++mCurrent;
+            if (mCurrent == mBlocks.size())
+                return traits_type::eof();
+            char* begin = &mBlocks[mCurrent][0];
+            setg(begin, begin, begin + mBlocks[mCurrent].size());
+            ++mCurrent;
+            return traits_type::to_int_type(*gptr());
+        }
+
+    private:
+        BlockContainerType mBlocks;
+        std::size_t mCurrent;
+    };
+
+    /// Write the grid functions (except the control point grid function) of a patch
+    template<int TDim>
+    static void WriteGridFunctions(std::ostream& rOStream, const Patch<TDim>& rPatch)
+    {
+        typename Patch<TDim>::DoubleGridFunctionContainerType DoubleGridFunctions_ = rPatch.DoubleGridFunctions();
+        typename Patch<TDim>::Array1DGridFunctionContainerType Array1DGridFunctions_ = rPatch.Array1DGridFunctions();
+        typename Patch<TDim>::VectorGridFunctionContainerType VectorGridFunctions_ = rPatch.VectorGridFunctions();
+
+        HelperType::Write(rOStream, static_cast<uint64_t>(DoubleGridFunctions_.size() + Array1DGridFunctions_.size() + VectorGridFunctions_.size()));
+
+        for (std::size_t i = 0; i < DoubleGridFunctions_.size(); ++i)
+            WriteControlGrid(rOStream, *(DoubleGridFunctions_[i]->pControlGrid()));
+
+        for (std::size_t i = 0; i < Array1DGridFunctions_.size(); ++i)
+            WriteControlGrid(rOStream, *(Array1DGridFunctions_[i]->pControlGrid()));
+
+        for (std::size_t i = 0; i < VectorGridFunctions_.size(); ++i)
+            WriteControlGrid(rOStream, *(VectorGridFunctions_[i]->pControlGrid()));
+    }
+
+    /// Read the grid functions of a patch and add them to the patch
+    template<int TDim>
+    static void ReadGridFunctions(std::istream& rIStream, Patch<TDim>& rPatch)
+    {
+        typename BSplinesFESpace<TDim>::ConstPointer pFESpace = boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >(rPatch.pFESpace());
+        std::vector<std::size_t> numbers(TDim);
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            numbers[dim] = pFESpace->Number(dim);
+
+        uint64_t nfunctions;
+        HelperType::Read(rIStream, nfunctions);
+
+        std::string name;
+        int32_t type;
+        uint64_t ncomponents, nvalues;
+        for (std::size_t i = 0; i < nfunctions; ++i)
+        {
+            HelperType::Read(rIStream, name);
+            HelperType::Read(rIStream, type);
+            HelperType::Read(rIStream, ncomponents);
+            HelperType::Read(rIStream, nvalues);
+
+            if (type == HelperType::_DOUBLE_)
+                ReadControlGrid<TDim, double>(rIStream, rPatch, numbers, name, ncomponents, nvalues);
+            else if (type == HelperType::_ARRAY_1D_)
+                ReadControlGrid<TDim, array_1d<double, 3> >(rIStream, rPatch, numbers, name, ncomponents, nvalues);
+            else if (type == HelperType::_VECTOR_)
+                ReadControlGrid<TDim, Vector>(rIStream, rPatch, numbers, name, ncomponents, nvalues);
+            else
+                KRATOS_THROW_ERROR(std::logic_error, "Invalid type of grid function", type)
+        }
+    }
+
+    /// Shuffle and compress the blocks of the payload in place, and write them to stream
+    static void WriteBlocks(std::ostream& rOStream, BlockContainerType& rBlocks, const std::size_t& PayloadSize,
+            const int& CompressionLevel, const bool& Shuffle)
+    {
+        const std::size_t block_size = BLOCK_SIZE;
+        const std::size_t nblocks = rBlocks.size();
+
+        std::string error_message;
+        #pragma omp parallel
+        {
+            std::vector<char> buffer;
+
+            #pragma omp for schedule(dynamic)
+            for (int ib = 0; ib < static_cast<int>(nblocks); ++ib)
+            {
+                const std::size_t size = rBlocks[ib].size();
+                if (!Shuffle && CompressionLevel == 0)
+                    continue;
+
+                if (Shuffle)
+                {
+                    buffer.resize(size);
+                    ShuffleBytes(&rBlocks[ib][0], &buffer[0], size);
+                }
+                else
+                    buffer.swap(rBlocks[ib]);
+
+                if (CompressionLevel == 0)
+                {
+                    rBlocks[ib].swap(buffer);
+                    continue;
+                }
+
+                #ifdef ISOGEOMETRIC_USE_ZLIB
+                uLongf stored_size = compressBound(size);
+                rBlocks[ib].resize(stored_size);
+                int stat = compress2(reinterpret_cast<Bytef*>(&rBlocks[ib][0]), &stored_size, reinterpret_cast<const Bytef*>(&buffer[0]), size, CompressionLevel);
+                if (stat != Z_OK)
+                {
+                    #pragma omp critical
+                    {
+                        if (error_message.empty())
+                            error_message = "zlib error in compress2";
+                    }
+                }
+                rBlocks[ib].resize(stored_size);
+                #endif
+            }
+        }
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, "Error compressing the snapshot:", error_message)
+
+        rOStream.write("IGASNAP", 8);
+        HelperType::Write(rOStream, static_cast<int32_t>(VERSION));
+        HelperType::Write(rOStream, static_cast<int32_t>(CompressionLevel));
+        HelperType::Write(rOStream, static_cast<int32_t>(Shuffle ? 1 : 0));
+        HelperType::Write(rOStream, static_cast<uint64_t>(PayloadSize));
+        HelperType::Write(rOStream, static_cast<uint64_t>(block_size));
+        HelperType::Write(rOStream, static_cast<uint64_t>(nblocks));
+        for (std::size_t ib = 0; ib < nblocks; ++ib)
+            HelperType::Write(rOStream, static_cast<uint64_t>(rBlocks[ib].size()));
+        for (std::size_t ib = 0; ib < nblocks; ++ib)
+            HelperType::Write(rOStream, rBlocks[ib]);
+    }
+
+    /// Read the blocks from stream, and decompress and unshuffle them in place
+    static void ReadBlocks(std::istream& rIStream, BlockContainerType& rBlocks)
+    {
+        char magic[8];
+        rIStream.read(magic, 8);
+        if (!rIStream || std::strncmp(magic, "IGASNAP", 8) != 0)
+            KRATOS_THROW_ERROR(std::logic_error, "The file is not a multipatch snapshot file", "")
+
+        int32_t version, level, shuffle;
+        uint64_t payload_size, block_size, nblocks;
+        HelperType::Read(rIStream, version);
+        HelperType::Read(rIStream, level);
+        HelperType::Read(rIStream, shuffle);
+        HelperType::Read(rIStream, payload_size);
+        HelperType::Read(rIStream, block_size);
+        HelperType::Read(rIStream, nblocks);
+        if (version > VERSION)
+            KRATOS_THROW_ERROR(std::logic_error, "Unsupported snapshot version", version)
+        if (block_size == 0 || nblocks != (payload_size + block_size - 1) / block_size)
+            KRATOS_THROW_ERROR(std::logic_error, "Invalid number of blocks in the snapshot:", nblocks)
+
+        #ifndef ISOGEOMETRIC_USE_ZLIB
+        if (level != 0)
+            KRATOS_THROW_ERROR(std::logic_error, "The snapshot is compressed but the application is not compiled with zlib, compression level:", level)
+        #endif
+
+        std::vector<uint64_t> stored_sizes;
+        HelperType::Read(rIStream, stored_sizes, nblocks);
+
+        rBlocks.resize(nblocks);
+        for (std::size_t ib = 0; ib < nblocks; ++ib)
+            HelperType::Read(rIStream, rBlocks[ib], stored_sizes[ib]);
+
+        std::string error_message;
+        #pragma omp parallel
+        {
+            std::vector<char> buffer;
+
+            #pragma omp for schedule(dynamic)
+            for (int ib = 0; ib < static_cast<int>(nblocks); ++ib)
+            {
+                const std::size_t offset = ib*block_size;
+                const std::size_t size = std::min(static_cast<std::size_t>(block_size), static_cast<std::size_t>(payload_size - offset));
+
+                if (level != 0)
+                {
+                    #ifdef ISOGEOMETRIC_USE_ZLIB
+                    buffer.resize(size);
+                    uLongf raw_size = size;
+                    int stat = uncompress(reinterpret_cast<Bytef*>(&buffer[0]), &raw_size, reinterpret_cast<const Bytef*>(&rBlocks[ib][0]), rBlocks[ib].size());
+                    if (stat != Z_OK || raw_size != size)
+                        buffer.clear();
+                    buffer.swap(rBlocks[ib]);
+                    #endif
+                }
+
+                if (rBlocks[ib].size() != size)
+                {
+                    #pragma omp critical
+                    {
+                        if (error_message.empty())
+                            error_message = "corrupted block";
+                    }
+                    continue;
+                }
+
+                if (shuffle != 0)
+                {
+                    buffer.resize(size);
+                    UnshuffleBytes(&rBlocks[ib][0], &buffer[0], size);
+                    buffer.swap(rBlocks[ib]);
+                }
+            }
+        }
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, "Error reading the snapshot:", error_message)
+    }
+
+private:
+
+    /// Write the control values of a grid function
+    template<typename TDataType>
+    static void WriteControlGrid(std::ostream& rOStream, const ControlGrid<TDataType>& rControlGrid)
+    {
+        std::size_t ncomponents = (rControlGrid.size() != 0) ? HelperType::Size(rControlGrid.GetData(0)) : 0;
+
+        HelperType::Write(rOStream, rControlGrid.Name());
+        HelperType::Write(rOStream, static_cast<int32_t>(HelperType::Type(TDataType())));
+        HelperType::Write(rOStream, static_cast<uint64_t>(ncomponents));
+        HelperType::Write(rOStream, static_cast<uint64_t>(rControlGrid.size()*ncomponents));
+
+        std::vector<double> values(rControlGrid.size()*ncomponents);
+        for (std::size_t i = 0; i < rControlGrid.size(); ++i)
+        {
+            const TDataType& v = rControlGrid.GetData(i);
+            if (HelperType::Size(v) != ncomponents)
+                KRATOS_THROW_ERROR(std::logic_error, "The control values have inconsistent size for grid function", rControlGrid.Name())
+            HelperType::Pack(v, &values[i*ncomponents]);
+        }
+        HelperType::Write(rOStream, values);
+    }
+
+    /// Read the control values and create the grid function on the patch
+    template<int TDim, typename TDataType>
+    static void ReadControlGrid(std::istream& rIStream, Patch<TDim>& rPatch, const std::vector<std::size_t>& numbers,
+            const std::string& name, const std::size_t& ncomponents, const std::size_t& nvalues)
+    {
+        typename StructuredControlGrid<TDim, TDataType>::Pointer pControlGrid = StructuredControlGrid<TDim, TDataType>::Create(numbers);
+        if (nvalues != pControlGrid->size()*ncomponents)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of control values does not match the patch for grid function", name)
+
+        std::vector<double> values;
+        HelperType::Read(rIStream, values, nvalues);
+
+        TDataType v;
+        for (std::size_t i = 0; i < pControlGrid->size(); ++i)
+        {
+            HelperType::Unpack(v, &values[i*ncomponents], ncomponents);
+            pControlGrid->SetData(i, v);
+        }
+        pControlGrid->SetName(name);
+        rPatch.template CreateGridFunction<TDataType>(pControlGrid);
+    }
+
+    /// Regroup the bytes of the doubles by significance. The trailing bytes which do not make a double are copied.
+    static void ShuffleBytes(const char* src, char* dst, const std::size_t& size)
+    {
+        const std::size_t n = size / sizeof(double);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < sizeof(double); ++j)
+                dst[j*n + i] = src[i*sizeof(double) + j];
+        for (std::size_t i = n*sizeof(double); i < size; ++i)
+            dst[i] = src[i];
+    }
+
+    /// Inverse of ShuffleBytes
+    static void UnshuffleBytes(const char* src, char* dst, const std::size_t& size)
+    {
+        const std::size_t n = size / sizeof(double);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < sizeof(double); ++j)
+                dst[i*sizeof(double) + j] = src[j*n + i];
+        for (std::size_t i = n*sizeof(double); i < size; ++i)
+            dst[i] = src[i];
+    }
+};
+
+/**
+Export the NURBS patch/multipatch to a binary snapshot, i.e. the topology, the orders, the knot vectors, the control
+points and all the grid functions of the patches. The snapshot is restored bit-exactly by MultiNURBSPatchSnapshotReader.
+This is the format of choice to checkpoint large refined multipatches; the ASCII exporters (geo, GLVis, MATLAB) are
+meant for visualization.
+ */
+template<int TDim>
+class MultiNURBSPatchSnapshotWriter : public MultiPatchExporter<TDim>
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(MultiNURBSPatchSnapshotWriter);
+
+    /// Type definition
+    typedef MultiPatchExporter<TDim> BaseType;
+    typedef MultiNURBSPatchBinaryIOHelper HelperType;
+    typedef MultiNURBSPatchSnapshotIOHelper SnapshotHelperType;
+
+    /// Default constructor
+    MultiNURBSPatchSnapshotWriter() : BaseType(), mCompressionLevel(0), mShuffle(true) {}
+
+    /// Destructor
+    virtual ~MultiNURBSPatchSnapshotWriter() {}
+
+    /// Set the compression level (0: no compression, 1: fastest, ..., 9: best). Compression requires zlib.
+    void SetCompressionLevel(const int& Level)
+    {
+        if(Level < 0 || Level > 9)
+            KRATOS_THROW_ERROR(std::logic_error, "The compression level must be in [0, 9], given:", Level)
+        #ifndef ISOGEOMETRIC_USE_ZLIB
+        if(Level != 0)
+            KRATOS_THROW_ERROR(std::logic_error, "The application is not compiled with zlib, compression is not supported. Level:", Level)
+        #endif
+        mCompressionLevel = Level;
+    }
+
+    /// Get the compression level
+    const int& CompressionLevel() const {return mCompressionLevel;}
+
+    /// Enable/disable the byte shuffle before compression. The shuffle is not applied with compression level 0.
+    void SetShuffle(const bool& Shuffle)
+    {
+        mShuffle = Shuffle;
+    }
+
+    /// Export a single patch. The neighbours are not written.
+    virtual void Export(typename Patch<TDim>::Pointer pPatch, const std::string& filename) const
+    {
+        SnapshotHelperType::BlockOutputBuffer buffer;
+        std::ostream payload(&buffer);
+
+        HelperType::WriteHeader<TDim>(payload, 1);
+        HelperType::WritePatch<TDim>(payload, *pPatch, false);
+        SnapshotHelperType::WriteGridFunctions<TDim>(payload, *pPatch);
+
+        this->WriteFile(buffer, filename);
+
+        std::cout << "Patch " << pPatch->Id() << " is exported to " << filename << " successfully" << std::endl;
+    }
+
+    /// Export a multipatch
+    virtual void Export(typename MultiPatch<TDim>::Pointer pMultiPatch, const std::string& filename) const
+    {
+        SnapshotHelperType::BlockOutputBuffer buffer;
+        std::ostream payload(&buffer);
+
+        HelperType::WriteMultiPatch<TDim>(payload, *pMultiPatch);
+        for (typename MultiPatch<TDim>::PatchContainerType::const_iterator it = pMultiPatch->begin(); it != pMultiPatch->end(); ++it)
+            SnapshotHelperType::WriteGridFunctions<TDim>(payload, *it);
+
+        this->WriteFile(buffer, filename);
+
+        std::cout << "MultiPatch is exported to " << filename << " successfully" << std::endl;
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "MultiNURBSPatchSnapshotWriter";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << " Compression level: " << mCompressionLevel << ", shuffle: " << mShuffle;
+    }
+
+private:
+
+    int mCompressionLevel;
+    bool mShuffle;
+
+    void WriteFile(SnapshotHelperType::BlockOutputBuffer& rBuffer, const std::string& filename) const
+    {
+        std::ofstream outfile(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!outfile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Error opening file", filename)
+
+        SnapshotHelperType::BlockContainerType& blocks = rBuffer.Blocks();
+        SnapshotHelperType::WriteBlocks(outfile, blocks, rBuffer.Size(), mCompressionLevel, mShuffle && (mCompressionLevel > 0));
+
+        outfile.close();
+    }
+
+}; // end class MultiNURBSPatchSnapshotWriter
+
+/**
+Import the NURBS patch/multipatch from the binary snapshot written by MultiNURBSPatchSnapshotWriter.
+The grid functions are restored with the name of their control grids, hence pGetGridFunction works
+for the variables registered in the kernel.
+ */
+template<int TDim>
+class MultiNURBSPatchSnapshotReader : public MultiPatchImporter<TDim>
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(MultiNURBSPatchSnapshotReader);
+
+    /// Type definition
+    typedef MultiPatchImporter<TDim> BaseType;
+    typedef MultiNURBSPatchBinaryIOHelper HelperType;
+    typedef MultiNURBSPatchSnapshotIOHelper SnapshotHelperType;
+
+    /// Default constructor
+    MultiNURBSPatchSnapshotReader() : BaseType() {}
+
+    /// Destructor
+    virtual ~MultiNURBSPatchSnapshotReader() {}
+
+    /// Import the first patch of the snapshot. The neighbours are not restored.
+    virtual typename Patch<TDim>::Pointer ImportSingle(const std::string& filename) const
+    {
+        SnapshotHelperType::BlockInputBuffer buffer;
+        this->ReadFile(buffer, filename);
+        std::istream payload(&buffer);
+
+        std::size_t npatches = HelperType::ReadHeader<TDim>(payload);
+        if (npatches == 0)
+            KRATOS_THROW_ERROR(std::logic_error, "There is no patch in", filename)
+
+        std::vector<uint64_t> neighbor_ids;
+        typename Patch<TDim>::Pointer pNewPatch = HelperType::ReadPatch<TDim>(payload, neighbor_ids);
+        SnapshotHelperType::ReadGridFunctions<TDim>(payload, *pNewPatch);
+
+        return pNewPatch;
+    }
+
+    /// Import the multipatch
+    virtual typename MultiPatch<TDim>::Pointer Import(const std::string& filename) const
+    {
+        SnapshotHelperType::BlockInputBuffer buffer;
+        this->ReadFile(buffer, filename);
+        std::istream payload(&buffer);
+
+        std::size_t npatches = HelperType::ReadHeader<TDim>(payload);
+
+        typename MultiPatch<TDim>::Pointer pMultiPatch = typename MultiPatch<TDim>::Pointer(new MultiPatch<TDim>());
+        std::vector<std::vector<uint64_t> > neighbor_ids(npatches);
+        for (std::size_t ip = 0; ip < npatches; ++ip)
+            pMultiPatch->AddPatch(HelperType::ReadPatch<TDim>(payload, neighbor_ids[ip]));
+
+        HelperType::RestoreTopology<TDim>(*pMultiPatch, neighbor_ids);
+
+        for (typename MultiPatch<TDim>::PatchContainerType::iterator it = pMultiPatch->begin(); it != pMultiPatch->end(); ++it)
+            SnapshotHelperType::ReadGridFunctions<TDim>(payload, *it);
+
+        return pMultiPatch;
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "MultiNURBSPatchSnapshotReader";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+private:
+
+    void ReadFile(SnapshotHelperType::BlockInputBuffer& rBuffer, const std::string& filename) const
+    {
+        std::ifstream infile(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!infile)
+            KRATOS_THROW_ERROR(std::runtime_error, "Error opening file", filename)
+
+        SnapshotHelperType::ReadBlocks(infile, rBuffer.Blocks());
+
+        infile.close();
+    }
+
+}; // end class MultiNURBSPatchSnapshotReader
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const MultiNURBSPatchSnapshotWriter<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const MultiNURBSPatchSnapshotReader<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_NURBS_PATCH_SNAPSHOT_IO_H_INCLUDED defined
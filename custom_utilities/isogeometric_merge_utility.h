@@ -10,12 +10,19 @@
 #define  KRATOS_ISOGEOMETRIC_MERGE_UTILITY_H_INCLUDED
 
 // System includes
+#include <cmath>
 #include <string>
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <typeinfo>
+#include <typeindex>
 #include <iostream>
 
 // External includes 
 #include <omp.h>
+#include <boost/functional/hash.hpp>
 
 // Project includes
 #include "includes/define.h"
@@ -28,6 +35,7 @@
 #include "spaces/ublas_space.h"
 #include "linear_solvers/linear_solver.h"
 #include "utilities/openmp_utils.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "isogeometric_application.h"
 
 
@@ -35,7 +43,6 @@
 //#define DEBUG_LEVEL2
 //#define DEBUG_MULTISOLVE
 //#define DEBUG_GENERATE_MESH
-#define ENABLE_PROFILING
 
 namespace Kratos
 {
@@ -61,38 +68,11 @@ namespace Kratos
 ///@name Kratos Classes
 ///@{
 
-template<class PointType>
-class LoosePointType
-{
-public:
-    LoosePointType(PointType& rP) : mrP(rP) {}
-    ~LoosePointType() {}
-    bool operator<(const LoosePointType& rOther) const
-    {
-        if(mrP.X0() < rOther.mrP.X0() - 1.0e-6)
-            return true;
-        if(mrP.X0() > rOther.mrP.X0() + 1.0e-6)
-            return false;
-        if(mrP.Y0() < rOther.mrP.Y0() - 1.0e-6)
-            return true;
-        if(mrP.Y0() > rOther.mrP.Y0() + 1.0e-6)
-            return false;
-        if(mrP.Z0() < rOther.mrP.Z0() - 1.0e-6)
-            return true;
-        if(mrP.Z0() > rOther.mrP.Z0() + 1.0e-6)
-            return false;
-        return false;
-    }
-    PointType& GetPoint() const {return mrP;}
-//    PointType GetPoint() {return mrP;}
-private:
-    PointType& mrP;
-};
-
-
 /// Short class definition.
 /**
  * A utility to combine multiple model_part into one model_part and skipping the coincident nodes. It is useful to combine multiple FEM model_part arised from Bezier mesh in multipatch isogeometric analysis.
+ * Two nodes are coincident if their initial coordinates differ by at most the tolerance in every direction. The coincident nodes are found
+ * by hashing the nodes in a uniform grid with the cell size proportional to the tolerance, hence only the cells overlapped by the tolerance box of a node are searched.
  */
 class IsogeometricMergeUtility
 {
@@ -141,7 +121,7 @@ public:
     ///@{
 
     /// Default constructor.
-    IsogeometricMergeUtility()
+    IsogeometricMergeUtility() : mTolerance(1.0e-6)
     {
     }
 
@@ -162,44 +142,60 @@ public:
     {
         mpModelPartContainer.push_back(pModelPart);
     }
-    
+
+    /// Set the tolerance to detect the coincident nodes
+    void SetTolerance(const double& Tolerance)
+    {
+        if(Tolerance <= 0.0)
+            KRATOS_THROW_ERROR(std::invalid_argument, "The tolerance must be positive, given", Tolerance)
+        mTolerance = Tolerance;
+    }
+
+    /// Get the tolerance to detect the coincident nodes
+    double GetTolerance() const {return mTolerance;}
+
     void Export(ModelPart::Pointer pModelPart)
     {
-        // firstly iterate through all the nodes in all model part to extract a non-repeated list of nodes
-        typedef std::pair<int, int> KeyType;
-        typedef std::set<LoosePointType<PointType> > SetType;
-        typedef std::map<KeyType, SetType::iterator> MapType;
-        SetType PointSet;
-        MapType PointMap;
-
-//        std::set<PointType> PointSetDummy;
-//      // note: this does not work since node does not implement operator<
-//        for(int i = 0; i < mpModelPartContainer.size(); ++i)
-//        {
-//            NodesContainerType ThisNodes = mpModelPartContainer[i]->Nodes();
-//            for(NodesContainerType::iterator it = ThisNodes.begin(); it != ThisNodes.end(); ++it)
-//            {
-//                PointSetDummy.insert(*it);
-//            }
-//        }
-//        KRATOS_WATCH(PointSetDummy.size())
-        
-        for(int i = 0; i < mpModelPartContainer.size(); ++i)
+        IsogeometricProfiler::ScopedTimer timer("IsogeometricMergeUtility::Export");
+
+        // firstly iterate through all the nodes in all model part to extract a non-repeated list of nodes.
+        // A node is merged to the first extracted node which is within the tolerance; its (id, merged index) is kept for each model_part.
+        std::size_t NumberOfNodes = 0;
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
+            NumberOfNodes += mpModelPartContainer[i]->Nodes().size();
+
+        std::vector<NodeType::Pointer> MergedPoints;
+        std::vector<std::size_t> NextInCell; // linked list of the merged points in each grid cell, stored as index + 1 (0 terminates the list)
+        std::vector<std::vector<std::pair<std::size_t, std::size_t> > > NodeMaps(mpModelPartContainer.size());
+        GridType Grid;
+        MergedPoints.reserve(NumberOfNodes);
+        NextInCell.reserve(NumberOfNodes);
+        Grid.reserve(NumberOfNodes);
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
         {
-            NodesContainerType ThisNodes = mpModelPartContainer[i]->Nodes();
-            for(NodesContainerType::iterator it = ThisNodes.begin(); it != ThisNodes.end(); ++it)
+            NodesContainerType& rNodes = mpModelPartContainer[i]->Nodes();
+            NodeMaps[i].reserve(rNodes.size());
+            for(NodesContainerType::ptr_iterator it = rNodes.ptr_begin(); it != rNodes.ptr_end(); ++it)
             {
-                LoosePointType<PointType> P(*it);
-                std::pair<SetType::iterator, bool> iP = PointSet.insert(P);
-                KeyType K(i, it->Id());
-                PointMap[K] = iP.first;
+                std::size_t merged_index = FindCoincidentPoint(Grid, NextInCell, MergedPoints, **it);
+                if(merged_index == MergedPoints.size())
+                {
+                    std::pair<GridType::iterator, bool> it_cell = Grid.insert(GridType::value_type(GetGridKey((*it)->X0(), (*it)->Y0(), (*it)->Z0()), 0));
+                    NextInCell.push_back(it_cell.first->second);
+                    it_cell.first->second = merged_index + 1;
+                    MergedPoints.push_back(*it);
+                }
+
+                NodeMaps[i].push_back(std::pair<std::size_t, std::size_t>((*it)->Id(), merged_index));
             }
+
+            std::sort(NodeMaps[i].begin(), NodeMaps[i].end());
         }
-        KRATOS_WATCH(PointSet.size())
-        
+        KRATOS_WATCH(MergedPoints.size())
+
         // create a unified variables_list
         VariablesList ThisVariablesList;
-        for(int i = 0; i < mpModelPartContainer.size(); ++i)
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
         {
             VariablesList& tmp = mpModelPartContainer[i]->GetNodalSolutionStepVariablesList();
             for(VariablesList::ptr_const_iterator it = tmp.ptr_begin(); it != tmp.ptr_end(); ++it)
@@ -209,10 +205,10 @@ public:
         for(VariablesList::ptr_const_iterator it = ThisVariablesList.ptr_begin(); it != ThisVariablesList.ptr_end(); ++it)
             pModelPart->GetNodalSolutionStepVariablesList().Add(*(*it));
         KRATOS_WATCH(pModelPart->GetNodalSolutionStepVariablesList())
-        
+
         // create a maximum buffer
         int buffer_size = 0;
-        for(int i = 0; i < mpModelPartContainer.size(); ++i)
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
         {
             int tmp_buff_size = mpModelPartContainer[i]->GetBufferSize();
             if(tmp_buff_size > buffer_size)
@@ -220,113 +216,58 @@ public:
         }
         pModelPart->SetBufferSize(buffer_size);
         KRATOS_WATCH(pModelPart->GetBufferSize())
-        
+
+        // create the new nodes, the id of the new node is the merged index + 1
+        std::vector<NodeType::Pointer> NewNodes(MergedPoints.size());
+        VariablesList* pVariablesList = &(pModelPart->GetNodalSolutionStepVariablesList());
+        const std::size_t BufferSize = pModelPart->GetBufferSize();
+        #pragma omp parallel for
+        for(int i = 0; i < static_cast<int>(MergedPoints.size()); ++i)
+        {
+            NodeType::Pointer NewNode( new Node<3>( i+1, *MergedPoints[i] ) );
+            NewNode->SetSolutionStepVariablesList(pVariablesList); // to make sure it synchronized with model_part variables list
+            NewNode->SetBufferSize(BufferSize);
+            NewNodes[i] = NewNode;
+        }
+
         // add nodes to the new model part
-        int lastNode = 0;
-        std::map<LoosePointType<PointType>, int> NodeIds; // map from reduced node set to new node set id
-        for(SetType::iterator it = PointSet.begin(); it != PointSet.end(); ++it)
+        // note: pModelPart->AddNode(NewNode) created segmentation fault error
+        pModelPart->Nodes().reserve(pModelPart->Nodes().size() + NewNodes.size());
+        for(std::size_t i = 0; i < NewNodes.size(); ++i)
         {
-            NodeType::Pointer NewNode( new Node<3>( 0, it->GetPoint() ) );;
-            NewNode->SetId(++lastNode);
-            NodeIds[*it] = lastNode;
-            NewNode->SetSolutionStepVariablesList(&(pModelPart->GetNodalSolutionStepVariablesList())); // to make sure it synchronized with model_part variables list
-            NewNode->SetBufferSize(pModelPart->GetBufferSize());
-//            pModelPart->AddNode(NewNode); // for some reason it created segmentation fault error
             #if defined(KRATOS_SD_REF_NUMBER_2)
-            pModelPart->Nodes().push_back(*NewNode);
+            pModelPart->Nodes().push_back(*NewNodes[i]);
             #elif defined(KRATOS_SD_REF_NUMBER_3)
-            pModelPart->Nodes().push_back(NewNode);
+            pModelPart->Nodes().push_back(NewNodes[i]);
             #endif
-//            // TODO: transfer nodal data
-
-//            NodeType temp_node;
-//            temp_node.SetSolutionStepVariablesList(&pModelPart->GetNodalSolutionStepVariablesList());
-//            temp_node.SetBufferSize(pModelPart->GetBufferSize());
-//            temp_node.SetId(++lastNode);
-//            NodeIds[*it] = lastNode;
-//            temp_node.X() = it->GetPoint().X();
-//            temp_node.Y() = it->GetPoint().Y();
-//            temp_node.Z() = it->GetPoint().Z();
-//            temp_node.X0() = temp_node.X();
-//            temp_node.Y0() = temp_node.Y();
-//            temp_node.Z0() = temp_node.Z();
-//            pModelPart->Nodes().push_back(temp_node);
         }
-        
+        pModelPart->Nodes().Unique();
+
         // add elements to the new model part
-        int lastElement = 0;
-        std::string NodeKey = std::string("Node");
-        typedef typename KratosComponents<Element>::ComponentsContainerType ElementComponentsContainerType;
-        ElementsContainerType NewElements;
-        ElementComponentsContainerType ElementComponents = KratosComponents<Element>::GetComponents();
-        for(int i = 0; i < mpModelPartContainer.size(); ++i)
-        {
-            ElementsContainerType pElements = mpModelPartContainer[i]->Elements();
-            for(ElementsContainerType::ptr_iterator it = pElements.ptr_begin(); it != pElements.ptr_end(); ++it)
-            {
-                std::string element_name;
-                for(ElementComponentsContainerType::iterator cit = ElementComponents.begin(); cit != ElementComponents.end(); ++cit)
-                    if(typeid(*(cit->second)).name() == typeid(*(*it)).name())
-                        if(typeid(cit->second->GetGeometry()).name() == typeid((*it)->GetGeometry()).name())
-                            element_name = cit->first;
-//                KRATOS_WATCH(element_name)
-                Element const& r_clone_element = KratosComponents<Element>::Get(element_name);
-                Properties::Pointer p_temp_properties = (*it)->pGetProperties();
-                Element::NodesArrayType temp_element_nodes;
-                for(int j = 0; j < (*it)->GetGeometry().size(); ++j)
-                {
-                    KeyType K(i, (*it)->GetGeometry()[j].Id());
-                    SetType::iterator iP = PointMap[K];
-                    temp_element_nodes.push_back(*(FindKey(pModelPart->Nodes(), NodeIds[*iP], NodeKey).base()));
-                }
-                Element::Pointer elem = r_clone_element.Create(++lastElement, temp_element_nodes, p_temp_properties);
-                elem->Data() = (*it)->Data(); // transfer elemental data
-                NewElements.push_back(elem);
-            }
-        }
-        // add new elements
-        for( ElementsContainerType::ptr_iterator it = NewElements.ptr_begin(); it != NewElements.ptr_end(); ++it )
-            pModelPart->Elements().push_back( *it );
-        NewElements.clear();
-        
+        std::vector<ElementsContainerType*> SourceElements;
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
+            SourceElements.push_back(&(mpModelPartContainer[i]->Elements()));
+        std::vector<Element::Pointer> NewElements;
+        CloneEntities<Element>(SourceElements, NodeMaps, NewNodes, "Element", NewElements);
+        pModelPart->Elements().reserve(pModelPart->Elements().size() + NewElements.size());
+        for(std::size_t i = 0; i < NewElements.size(); ++i)
+            pModelPart->Elements().push_back(NewElements[i]);
+        pModelPart->Elements().Unique();
+
         // add conditions to the new model part
-        int lastCondition = 0;
-        typedef typename KratosComponents<Condition>::ComponentsContainerType ConditionComponentsContainerType;
-        ConditionsContainerType NewConditions;
-        ConditionComponentsContainerType ConditionComponents = KratosComponents<Condition>::GetComponents();
-        for(int i = 0; i < mpModelPartContainer.size(); ++i)
-        {
-            ConditionsContainerType pConditions = mpModelPartContainer[i]->Conditions();
-            for(ConditionsContainerType::ptr_iterator it = pConditions.ptr_begin(); it != pConditions.ptr_end(); ++it)
-            {
-                std::string condition_name;
-                for(ConditionComponentsContainerType::iterator cit = ConditionComponents.begin(); cit != ConditionComponents.end(); ++cit)
-                    if(typeid(*(cit->second)).name() == typeid(*(*it)).name())
-                        if(typeid(cit->second->GetGeometry()).name() == typeid((*it)->GetGeometry()).name())
-                            condition_name = cit->first;
-//                KRATOS_WATCH(condition_name)
-                Condition const& r_clone_condition = KratosComponents<Condition>::Get(condition_name);
-                Properties::Pointer p_temp_properties = (*it)->pGetProperties();
-                Condition::NodesArrayType temp_condition_nodes;
-                for(int j = 0; j < (*it)->GetGeometry().size(); ++j)
-                {
-                    KeyType K(i, (*it)->GetGeometry()[j].Id());
-                    SetType::iterator iP = PointMap[K];
-                    temp_condition_nodes.push_back(*(FindKey(pModelPart->Nodes(), NodeIds[*iP], NodeKey).base()));
-                }
-                Condition::Pointer cond = r_clone_condition.Create(++lastCondition, temp_condition_nodes, p_temp_properties);
-                cond->Data() = (*it)->Data(); // transfer conditional data
-                NewConditions.push_back(cond);
-            }
-        }
-        // add new conditions
-        for( ConditionsContainerType::ptr_iterator it = NewConditions.ptr_begin(); it != NewConditions.ptr_end(); ++it )
-            pModelPart->Conditions().push_back( *it );
-        NewConditions.clear(); 
-        
+        std::vector<ConditionsContainerType*> SourceConditions;
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
+            SourceConditions.push_back(&(mpModelPartContainer[i]->Conditions()));
+        std::vector<Condition::Pointer> NewConditions;
+        CloneEntities<Condition>(SourceConditions, NodeMaps, NewNodes, "Condition", NewConditions);
+        pModelPart->Conditions().reserve(pModelPart->Conditions().size() + NewConditions.size());
+        for(std::size_t i = 0; i < NewConditions.size(); ++i)
+            pModelPart->Conditions().push_back(NewConditions[i]);
+        pModelPart->Conditions().Unique();
+
         // add properties to the model_part
         int lastProperties = 0;
-        for(int i = 0; i < mpModelPartContainer.size(); ++i)
+        for(std::size_t i = 0; i < mpModelPartContainer.size(); ++i)
         {
             for(ModelPart::PropertiesIterator it = mpModelPartContainer[i]->PropertiesBegin(); it != mpModelPartContainer[i]->PropertiesEnd(); ++it)
             {
@@ -335,9 +276,12 @@ public:
                 pModelPart->AddProperties(tmp);
             }
         }
+
+        IsogeometricProfiler::AddCount("IsogeometricMergeUtility::Export::Nodes", NewNodes.size());
+        IsogeometricProfiler::AddCount("IsogeometricMergeUtility::Export::Elements", NewElements.size());
+        IsogeometricProfiler::AddCount("IsogeometricMergeUtility::Export::Conditions", NewConditions.size());
     }
-    
-    
+
     ///@}
     ///@name Access
     ///@{
@@ -425,6 +369,8 @@ private:
     ///@name Member Variables
     ///@{
 
+    double mTolerance;
+
     ///@}
     ///@name Private Operators
     ///@{
@@ -434,23 +380,170 @@ private:
     ///@{
     
     
-    //**********AUXILIARY FUNCTION**************************************************************
-    //******************************************************************************************
-    template<class TContainerType, class TKeyType>
-    typename TContainerType::iterator FindKey(TContainerType& ThisContainer, TKeyType& ThisKey, std::string& ComponentName)
+    /// Index of a cell of the uniform grid hashing the nodes
+    struct GridKey
     {
-        typename TContainerType::iterator i_result;
-        if((i_result = ThisContainer.find(ThisKey)) == ThisContainer.end())
+        long long i, j, k;
+        bool operator==(const GridKey& rOther) const {return i == rOther.i && j == rOther.j && k == rOther.k;}
+    };
+
+    struct GridKeyHasher
+    {
+        std::size_t operator()(const GridKey& rKey) const
+        {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, rKey.i);
+            boost::hash_combine(seed, rKey.j);
+            boost::hash_combine(seed, rKey.k);
+            return seed;
+        }
+    };
+
+    /// map from the grid cell to the last merged point inside, stored as index + 1
+    typedef std::unordered_map<GridKey, std::size_t, GridKeyHasher> GridType;
+
+    /// Size of the grid cell relative to the tolerance. The tolerance box of a node then overlaps one or two cells in each direction.
+    static double CellSizeFactor() {return 4.0;}
+
+    GridKey GetGridKey(const double& X, const double& Y, const double& Z) const
+    {
+        const double CellSize = CellSizeFactor() * mTolerance;
+        const GridKey Key = {static_cast<long long>(std::floor(X / CellSize)),
+                             static_cast<long long>(std::floor(Y / CellSize)),
+                             static_cast<long long>(std::floor(Z / CellSize))};
+        return Key;
+    }
+
+    /// Search the grid cells overlapped by the tolerance box of rPoint for the merged point coincident with rPoint. If there are many, the smallest index is returned.
+    /// Return rMergedPoints.size() if rPoint is not coincident with any merged point.
+    std::size_t FindCoincidentPoint(const GridType& rGrid, const std::vector<std::size_t>& rNextInCell,
+            const std::vector<NodeType::Pointer>& rMergedPoints, const NodeType& rPoint) const
+    {
+        const GridKey Min = GetGridKey(rPoint.X0() - mTolerance, rPoint.Y0() - mTolerance, rPoint.Z0() - mTolerance);
+        const GridKey Max = GetGridKey(rPoint.X0() + mTolerance, rPoint.Y0() + mTolerance, rPoint.Z0() + mTolerance);
+
+        std::size_t found = rMergedPoints.size();
+        for(long long i = Min.i; i <= Max.i; ++i)
+        {
+            for(long long j = Min.j; j <= Max.j; ++j)
+            {
+                for(long long k = Min.k; k <= Max.k; ++k)
+                {
+                    const GridKey Key = {i, j, k};
+                    GridType::const_iterator it_cell = rGrid.find(Key);
+                    if(it_cell == rGrid.end())
+                        continue;
+
+                    for(std::size_t next = it_cell->second; next != 0; next = rNextInCell[next - 1])
+                    {
+                        const std::size_t index = next - 1;
+                        const NodeType& rOther = *rMergedPoints[index];
+                        if(    std::abs(rPoint.X0() - rOther.X0()) <= mTolerance
+                            && std::abs(rPoint.Y0() - rOther.Y0()) <= mTolerance
+                            && std::abs(rPoint.Z0() - rOther.Z0()) <= mTolerance
+                            && index < found )
+                                found = index;
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    /// Find the registered component of the same type and geometry type as rEntity. The result is cached by the pair of type_index,
+    /// hence the registered components are only scanned once for each type of entity.
+    template<class TEntityType>
+    static const TEntityType& FindComponent(const TEntityType& rEntity, std::map<std::pair<std::type_index, std::type_index>, const TEntityType*>& rCache,
+            const std::string& ComponentName)
+    {
+        const std::pair<std::type_index, std::type_index> Key(typeid(rEntity), typeid(rEntity.GetGeometry()));
+        typename std::map<std::pair<std::type_index, std::type_index>, const TEntityType*>::iterator it = rCache.find(Key);
+        if(it != rCache.end())
+            return *(it->second);
+
+        typedef typename KratosComponents<TEntityType>::ComponentsContainerType ComponentsContainerType;
+        const ComponentsContainerType& Components = KratosComponents<TEntityType>::GetComponents();
+        const TEntityType* pComponent = NULL;
+        for(typename ComponentsContainerType::const_iterator cit = Components.begin(); cit != Components.end(); ++cit)
+            if(typeid(*(cit->second)) == typeid(rEntity))
+                if(typeid(cit->second->GetGeometry()) == typeid(rEntity.GetGeometry()))
+                    pComponent = cit->second;
+
+        if(pComponent == NULL)
         {
             std::stringstream buffer;
-            buffer << ComponentName << " #" << ThisKey << " is not found.";
-            KRATOS_THROW_ERROR(std::invalid_argument, buffer.str(), "");
+            buffer << "No registered " << ComponentName << " matches the type of " << ComponentName << " #" << rEntity.Id();
+            KRATOS_THROW_ERROR(std::logic_error, buffer.str(), "")
         }
 
-        return i_result;
+        rCache[Key] = pComponent;
+        return *pComponent;
     }
-    
-    
+
+    /// Clone the elements/conditions of all the model_parts with the merged nodes. The ids of the clones are consecutive, following
+    /// the order of the model_parts. The registered components are resolved serially, then the clones are created in parallel.
+    template<class TEntityType, class TContainerType>
+    void CloneEntities(const std::vector<TContainerType*>& rSources,
+            const std::vector<std::vector<std::pair<std::size_t, std::size_t> > >& rNodeMaps,
+            const std::vector<NodeType::Pointer>& rNewNodes,
+            const std::string& ComponentName,
+            std::vector<typename TEntityType::Pointer>& rNewEntities) const
+    {
+        std::vector<typename TEntityType::Pointer> Entities;
+        std::vector<std::size_t> ModelPartIndices;
+        std::vector<const TEntityType*> Components;
+        std::map<std::pair<std::type_index, std::type_index>, const TEntityType*> Cache;
+        for(std::size_t i = 0; i < rSources.size(); ++i)
+        {
+            for(typename TContainerType::ptr_iterator it = rSources[i]->ptr_begin(); it != rSources[i]->ptr_end(); ++it)
+            {
+                Entities.push_back(*it);
+                ModelPartIndices.push_back(i);
+                Components.push_back(&FindComponent(**it, Cache, ComponentName));
+            }
+        }
+
+        rNewEntities.resize(Entities.size());
+        std::string error_message;
+        #pragma omp parallel for
+        for(int e = 0; e < static_cast<int>(Entities.size()); ++e)
+        {
+            try
+            {
+                const std::vector<std::pair<std::size_t, std::size_t> >& rNodeMap = rNodeMaps[ModelPartIndices[e]];
+                typename TEntityType::NodesArrayType temp_nodes;
+                for(std::size_t j = 0; j < Entities[e]->GetGeometry().size(); ++j)
+                {
+                    const std::size_t Id = Entities[e]->GetGeometry()[j].Id();
+                    std::vector<std::pair<std::size_t, std::size_t> >::const_iterator it_node
+                        = std::lower_bound(rNodeMap.begin(), rNodeMap.end(), std::pair<std::size_t, std::size_t>(Id, 0));
+                    if(it_node == rNodeMap.end() || it_node->first != Id)
+                    {
+                        std::stringstream buffer;
+                        buffer << "Node #" << Id << " of " << ComponentName << " #" << Entities[e]->Id() << " is not found.";
+                        KRATOS_THROW_ERROR(std::invalid_argument, buffer.str(), "");
+                    }
+                    temp_nodes.push_back(rNewNodes[it_node->second]);
+                }
+
+                typename TEntityType::Pointer pNewEntity = Components[e]->Create(e+1, temp_nodes, Entities[e]->pGetProperties());
+                pNewEntity->Data() = Entities[e]->Data(); // transfer elemental/conditional data
+                rNewEntities[e] = pNewEntity;
+            }
+            catch(std::exception& ex)
+            {
+                #pragma omp critical
+                {
+                    if(error_message.empty())
+                        error_message = ex.what();
+                }
+            }
+        }
+
+        if(!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
+    }
+
     ///@}
     ///@name Private  Access
     ///@{
@@ -513,7 +606,6 @@ private:
 #undef DEBUG_LEVEL2
 #undef DEBUG_MULTISOLVE
 #undef DEBUG_GENERATE_MESH
-#undef ENABLE_PROFILING
 
 #endif // ISOGEOMETRIC_MERGE_UTILITY
 
@@ -0,0 +1,373 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_ISOGEOMETRIC_PROFILER_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_ISOGEOMETRIC_PROFILER_H_INCLUDED
+
+// System includes
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <limits>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+// External includes
+#include <omp.h>
+
+// Project includes
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+
+namespace Kratos
+{
+///@addtogroup IsogeometricApplication
+///@{
+
+///@name Kratos Classes
+///@{
+
+/// Runtime registry of timers and counters for the hot paths of the isogeometric application.
+/**
+ * The registry is off by default. It is switched on by Enable() (also from Python) or by setting the
+ * environment variable ISOGEOMETRIC_PROFILING to a non-zero value before the application is loaded.
+ * When it is off, a timer costs only a relaxed atomic load.
+ * The records are kept per thread (the region names are keyed by the address of the name, so no string
+ * is built on the hot path) and merged by name when the summary is printed or written to JSON/CSV.
+ * Names given as std::string are interned once by Intern(...).
+ * With SetEcho(true) each recorded timer is also printed to std::cout as ">>> name: time s".
+ * Typical usage:
+ *      IsogeometricProfiler::ScopedTimer timer("BezierUtils::ComputeShapeFunctions");
+ *      ...
+ *      timer.Lap("BezierUtils::ComputeShapeFunctions::Dump"); // record a sub-section and restart
+ */
+class IsogeometricProfiler
+{
+public:
+    ///@name Type Definitions
+    ///@{
+
+    /// Aggregated statistics of a region
+    struct Entry
+    {
+        std::size_t Calls;
+        double Total;
+        double Min;
+        double Max;
+        long Count;
+
+        Entry() : Calls(0), Total(0.0), Min(std::numeric_limits<double>::max()), Max(0.0), Count(0) {}
+
+        void AddTime(const double& t)
+        {
+            ++Calls;
+            Total += t;
+            if (t < Min) Min = t;
+            if (t > Max) Max = t;
+        }
+
+        void Merge(const Entry& rOther)
+        {
+            Calls += rOther.Calls;
+            Total += rOther.Total;
+            if (rOther.Min < Min) Min = rOther.Min;
+            if (rOther.Max > Max) Max = rOther.Max;
+            Count += rOther.Count;
+        }
+    };
+
+    /// Timer of a named region. The time is recorded when Stop() is called or when the timer goes out of scope.
+    /// If the registry is disabled at construction, the timer does nothing.
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(const char* Name) : mName(Name), mActive(IsEnabled())
+        {
+            if (mActive) mStart = OpenMPUtils::GetCurrentTime();
+        }
+
+        ~ScopedTimer()
+        {
+            Stop();
+        }
+
+        /// Record the time since the construction (or the last Lap) under the name of the timer
+        void Stop()
+        {
+            if (mActive)
+            {
+                AddTime(mName, OpenMPUtils::GetCurrentTime() - mStart);
+                mActive = false;
+            }
+        }
+
+        /// Record the time since the construction (or the last Lap) under another name and restart the timer
+        void Lap(const char* Name)
+        {
+            if (mActive)
+            {
+                double now = OpenMPUtils::GetCurrentTime();
+                AddTime(Name, now - mStart);
+                mStart = now;
+            }
+        }
+
+        /// Elapsed time since the construction (or the last Lap); zero if the registry is disabled
+        double Elapsed() const
+        {
+            return mActive ? OpenMPUtils::GetCurrentTime() - mStart : 0.0;
+        }
+
+    private:
+        const char* mName;
+        bool mActive;
+        double mStart;
+
+        ScopedTimer(const ScopedTimer&);
+        ScopedTimer& operator=(const ScopedTimer&);
+    };
+
+    ///@}
+    ///@name Operations
+    ///@{
+
+    static void Enable() {Instance().mEnabled.store(true, std::memory_order_relaxed);}
+
+    static void Disable() {Instance().mEnabled.store(false, std::memory_order_relaxed);}
+
+    static bool IsEnabled() {return Instance().mEnabled.load(std::memory_order_relaxed);}
+
+    /// Print each recorded timer to std::cout
+    static void SetEcho(bool Value) {Instance().mEcho.store(Value, std::memory_order_relaxed);}
+
+    /// Return a name with static lifetime equal to the given string, to be used for timers with run-time names
+    static const char* Intern(const std::string& Name)
+    {
+        IsogeometricProfiler& r = Instance();
+        std::lock_guard<std::mutex> lock(r.mMutex);
+        return r.mNames.insert(Name).first->c_str();
+    }
+
+    /// Record a time (in seconds) for a region
+    static void AddTime(const char* Name, const double& Time)
+    {
+        IsogeometricProfiler& r = Instance();
+        if (!r.mEnabled.load(std::memory_order_relaxed))
+            return;
+
+        ThreadData& d = r.LocalData();
+        {
+            std::lock_guard<std::mutex> lock(d.Mutex);
+            d.Entries[Name].AddTime(Time);
+        }
+
+        if (r.mEcho.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(r.mMutex);
+            std::cout << ">>> " << Name << ": " << Time << " s" << std::endl;
+        }
+    }
+
+    /// Increase the counter of a region
+    static void AddCount(const char* Name, const long& Increment = 1)
+    {
+        IsogeometricProfiler& r = Instance();
+        if (!r.mEnabled.load(std::memory_order_relaxed))
+            return;
+
+        ThreadData& d = r.LocalData();
+        std::lock_guard<std::mutex> lock(d.Mutex);
+        d.Entries[Name].Count += Increment;
+    }
+
+    /// Clear all the records. The enabled state is kept.
+    static void Reset()
+    {
+        IsogeometricProfiler& r = Instance();
+        std::lock_guard<std::mutex> lock(r.mMutex);
+        for (std::size_t i = 0; i < r.mThreadData.size(); ++i)
+        {
+            std::lock_guard<std::mutex> lock_thread(r.mThreadData[i]->Mutex);
+            r.mThreadData[i]->Entries.clear();
+        }
+    }
+
+    /// Print the merged statistics of all regions
+    static void PrintSummary(std::ostream& rOStream)
+    {
+        std::map<std::string, Entry> merged;
+        std::vector<std::map<std::string, Entry> > per_thread;
+        Instance().Collect(merged, per_thread);
+
+        rOStream << "IsogeometricProfiler summary (" << per_thread.size() << " threads):" << std::endl;
+        rOStream << std::left << std::setw(60) << "region" << std::right
+                 << std::setw(10) << "calls" << std::setw(14) << "total [s]"
+                 << std::setw(14) << "mean [s]" << std::setw(14) << "max [s]" << std::setw(12) << "count" << std::endl;
+        for (std::map<std::string, Entry>::const_iterator it = merged.begin(); it != merged.end(); ++it)
+        {
+            const Entry& e = it->second;
+            rOStream << std::left << std::setw(60) << it->first << std::right
+                     << std::setw(10) << e.Calls << std::setw(14) << e.Total
+                     << std::setw(14) << (e.Calls > 0 ? e.Total / e.Calls : 0.0)
+                     << std::setw(14) << e.Max << std::setw(12) << e.Count << std::endl;
+        }
+    }
+
+    /// Print the summary to std::cout
+    static void PrintSummary()
+    {
+        PrintSummary(std::cout);
+    }
+
+    /// Write the merged and per-thread statistics in JSON format
+    static void WriteJSON(const std::string& FileName)
+    {
+        std::map<std::string, Entry> merged;
+        std::vector<std::map<std::string, Entry> > per_thread;
+        Instance().Collect(merged, per_thread);
+
+        std::ofstream outfile(FileName.c_str());
+        if (!outfile.is_open())
+            KRATOS_THROW_ERROR(std::runtime_error, "Can't open file", FileName)
+
+        outfile << std::setprecision(9);
+        outfile << "{\n  \"regions\": [";
+        WriteJSONEntries(outfile, merged, "    ");
+        outfile << "\n  ],\n  \"threads\": [";
+        for (std::size_t i = 0; i < per_thread.size(); ++i)
+        {
+            outfile << (i == 0 ? "" : ",") << "\n    {\"thread\": " << i << ", \"regions\": [";
+            WriteJSONEntries(outfile, per_thread[i], "      ");
+            outfile << "\n    ]}";
+        }
+        outfile << "\n  ]\n}\n";
+        outfile.close();
+    }
+
+    /// Write the per-thread and merged (thread = all) statistics in CSV format
+    static void WriteCSV(const std::string& FileName)
+    {
+        std::map<std::string, Entry> merged;
+        std::vector<std::map<std::string, Entry> > per_thread;
+        Instance().Collect(merged, per_thread);
+
+        std::ofstream outfile(FileName.c_str());
+        if (!outfile.is_open())
+            KRATOS_THROW_ERROR(std::runtime_error, "Can't open file", FileName)
+
+        outfile << std::setprecision(9);
+        outfile << "region,thread,calls,total,min,max,count\n";
+        WriteCSVEntries(outfile, merged, "all");
+        for (std::size_t i = 0; i < per_thread.size(); ++i)
+        {
+            std::stringstream ss;
+            ss << i;
+            WriteCSVEntries(outfile, per_thread[i], ss.str());
+        }
+        outfile.close();
+    }
+
+    ///@}
+
+private:
+
+    struct ThreadData
+    {
+        std::mutex Mutex;
+        std::map<const char*, Entry> Entries;
+    };
+
+    std::atomic<bool> mEnabled;
+    std::atomic<bool> mEcho;
+    std::mutex mMutex;
+    std::vector<ThreadData*> mThreadData; // never freed, the thread-local pointers refer to them until exit
+    std::set<std::string> mNames;
+
+    IsogeometricProfiler() : mEnabled(false), mEcho(false)
+    {
+        const char* env = std::getenv("ISOGEOMETRIC_PROFILING");
+        if (env != NULL && std::strlen(env) > 0 && std::strcmp(env, "0") != 0)
+            mEnabled.store(true);
+    }
+
+    static IsogeometricProfiler& Instance()
+    {
+        static IsogeometricProfiler profiler;
+        return profiler;
+    }
+
+    ThreadData& LocalData()
+    {
+        static thread_local ThreadData* pData = NULL;
+        if (pData == NULL)
+        {
+            pData = new ThreadData();
+            std::lock_guard<std::mutex> lock(mMutex);
+            mThreadData.push_back(pData);
+        }
+        return *pData;
+    }
+
+    void Collect(std::map<std::string, Entry>& rMerged, std::vector<std::map<std::string, Entry> >& rPerThread)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        rPerThread.resize(mThreadData.size());
+        for (std::size_t i = 0; i < mThreadData.size(); ++i)
+        {
+            std::lock_guard<std::mutex> lock_thread(mThreadData[i]->Mutex);
+            for (std::map<const char*, Entry>::const_iterator it = mThreadData[i]->Entries.begin();
+                    it != mThreadData[i]->Entries.end(); ++it)
+            {
+                rPerThread[i][it->first].Merge(it->second);
+                rMerged[it->first].Merge(it->second);
+            }
+        }
+    }
+
+    static void WriteJSONEntries(std::ostream& rOStream, const std::map<std::string, Entry>& rEntries, const std::string& Indent)
+    {
+        bool first = true;
+        for (std::map<std::string, Entry>::const_iterator it = rEntries.begin(); it != rEntries.end(); ++it)
+        {
+            const Entry& e = it->second;
+            rOStream << (first ? "" : ",") << "\n" << Indent
+                     << "{\"name\": \"" << it->first << "\", \"calls\": " << e.Calls
+                     << ", \"total\": " << e.Total << ", \"min\": " << (e.Calls > 0 ? e.Min : 0.0)
+                     << ", \"max\": " << e.Max << ", \"count\": " << e.Count << "}";
+            first = false;
+        }
+    }
+
+    static void WriteCSVEntries(std::ostream& rOStream, const std::map<std::string, Entry>& rEntries, const std::string& Thread)
+    {
+        for (std::map<std::string, Entry>::const_iterator it = rEntries.begin(); it != rEntries.end(); ++it)
+        {
+            const Entry& e = it->second;
+            rOStream << it->first << "," << Thread << "," << e.Calls << "," << e.Total << ","
+                     << (e.Calls > 0 ? e.Min : 0.0) << "," << e.Max << "," << e.Count << "\n";
+        }
+    }
+
+    IsogeometricProfiler(const IsogeometricProfiler&);
+    IsogeometricProfiler& operator=(const IsogeometricProfiler&);
+};
+
+///@}
+
+///@} addtogroup block
+
+}// namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_ISOGEOMETRIC_PROFILER_H_INCLUDED defined
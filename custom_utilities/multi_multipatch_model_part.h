@@ -22,12 +22,11 @@
 #include "utilities/openmp_utils.h"
 #include "custom_utilities/patch.h"
 #include "custom_utilities/multipatch_utility.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "custom_utilities/multipatch_model_part.h"
 #include "custom_geometries/isogeometric_geometry.h"
 #include "isogeometric_application/isogeometric_application.h"
 
-#define ENABLE_PROFILING
-
 namespace Kratos
 {
 
@@ -108,9 +107,7 @@ public:
     /// create the nodes from the control points and add to the model_part
     void CreateNodes()
     {
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiMultiPatchModelPart::CreateNodes");
 
         std::size_t node_counter = 0;
         std::size_t cnt = 0;
@@ -135,11 +132,7 @@ public:
             }
         }
 
-        #ifdef ENABLE_PROFILING
-        std::cout << ">>> " << __FUNCTION__ << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s" << std::endl;
-        #else
         std::cout << __FUNCTION__ << " completed" << std::endl;
-        #endif
     }
 
     /// create the conditions out from the patches and add to the model_part
@@ -150,9 +143,7 @@ public:
     {
         if (IsReady()) return ModelPart::ElementsContainerType(); // call BeginModelPart first before adding elements
 
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiMultiPatchModelPart::AddElements");
 
         // get the Properties
         Properties::Pointer p_temp_properties = mpModelPart->pGetProperties(prop_id);
@@ -185,11 +176,7 @@ public:
         // sort the element container and make it consistent
         mpModelPart->Elements().Unique();
 
-        #ifdef ENABLE_PROFILING
-        std::cout << ">>> " << __FUNCTION__ << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s, " << pNewElements.size() << " elements of type " << element_name << " are generated" << std::endl;
-        #else
-        std::cout << __FUNCTION__ << " completed" << std::endl;
-        #endif
+        std::cout << __FUNCTION__ << " completed, " << pNewElements.size() << " elements of type " << element_name << " are generated" << std::endl;
 
         return pNewElements;
     }
@@ -200,9 +187,7 @@ public:
     {
         if (IsReady()) return ModelPart::ConditionsContainerType(); // call BeginModelPart first before adding conditions
 
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiMultiPatchModelPart::AddConditions");
 
         // construct the boundary patch
         typename Patch<TDim-1>::Pointer pBoundaryPatch = pPatch->ConstructBoundaryPatch(side);
@@ -225,11 +210,7 @@ public:
         // sort the condition container and make it consistent
         mpModelPart->Conditions().Unique();
 
-        #ifdef ENABLE_PROFILING
-        std::cout << ">>> " << __FUNCTION__ << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s, " << pNewConditions.size() << " conditions of type " << condition_name << " are generated" << std::endl;
-        #else
-        std::cout << __FUNCTION__ << " completed" << std::endl;
-        #endif
+        std::cout << __FUNCTION__ << " completed, " << pNewConditions.size() << " conditions of type " << condition_name << " are generated" << std::endl;
 
         return pNewConditions;
     }
@@ -342,9 +323,7 @@ private:
         TNodeContainerType& rNodes, const std::string& element_name,
         const std::size_t& starting_id, Properties::Pointer p_temp_properties)
     {
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiMultiPatchModelPart::CreateEntitiesFromFESpace");
 
         // construct the cell manager out from the FESpaces
         typedef typename TFESpace::cell_container_t cell_container_t;
@@ -360,10 +339,7 @@ private:
                 KRATOS_THROW_ERROR(std::logic_error, "The cell manager does not match at index", ip)
         }
 
-        #ifdef ENABLE_PROFILING
-        std::cout << "  >> ConstructCellManager: " << OpenMPUtils::GetCurrentTime()-start << " s" << std::endl;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("MultiMultiPatchModelPart::CreateEntitiesFromFESpace::ConstructCellManager");
 
         // container for newly created elements
         PointerVectorSet<TEntityType, IndexedObject> pNewElements;
@@ -445,10 +421,7 @@ private:
             pNewElements.push_back(pNewElement);
         }
 
-        #ifdef ENABLE_PROFILING
-        std::cout << "  >> generate entities: " << OpenMPUtils::GetCurrentTime()-start << " s" << std::endl;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("MultiMultiPatchModelPart::CreateEntitiesFromFESpace::GenerateEntities");
 
         return pNewElements;
     }
@@ -468,7 +441,6 @@ inline std::ostream& operator <<(std::ostream& rOStream, const MultiMultiPatchMo
 } // namespace Kratos.
 
 #undef DEBUG_GEN_ENTITY
-#undef ENABLE_PROFILING
 
 #endif // KRATOS_ISOGEOMETRIC_APPLICATION_MULTI_MULTIPATCH_MODEL_PART_H_INCLUDED
 
@@ -22,11 +22,10 @@
 #include "utilities/openmp_utils.h"
 #include "custom_utilities/patch.h"
 #include "custom_utilities/multipatch_utility.h"
+#include "custom_utilities/isogeometric_profiler.h"
 #include "custom_geometries/isogeometric_geometry.h"
 #include "isogeometric_application/isogeometric_application.h"
 
-#define ENABLE_PROFILING
-
 namespace Kratos
 {
 
@@ -90,9 +89,7 @@ public:
     /// create the nodes from the control points and add to the model_part
     void CreateNodes()
     {
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiPatchModelPart::CreateNodes");
 
         // create new nodes from control points
         for (std::size_t i = 0; i < mpMultiPatch->EquationSystemSize(); ++i)
@@ -110,11 +107,7 @@ public:
             ModelPart::NodeType::Pointer pNewNode = mpModelPart->CreateNewNode(CONVERT_INDEX_IGA_TO_KRATOS(i), point.X(), point.Y(), point.Z());
         }
 
-        #ifdef ENABLE_PROFILING
-        std::cout << ">>> " << __FUNCTION__ << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s" << std::endl;
-        #else
         std::cout << __FUNCTION__ << " completed" << std::endl;
-        #endif
     }
 
     /// create the conditions out from the patch and add to the model_part
@@ -124,9 +117,7 @@ public:
     {
         if (IsReady()) return ModelPart::ElementsContainerType(); // call BeginModelPart first before adding elements
 
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiPatchModelPart::AddElements");
 
         // get the Properties
         Properties::Pointer p_temp_properties = mpModelPart->pGetProperties(prop_id);
@@ -145,11 +136,7 @@ public:
         // sort the element container and make it consistent
         mpModelPart->Elements().Unique();
 
-        #ifdef ENABLE_PROFILING
-        std::cout << ">>> " << __FUNCTION__ << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s, ";
-        #else
         std::cout << __FUNCTION__ << " completed, ";
-        #endif
         std::cout << pNewElements.size() << " elements of type " << element_name << " are generated for patch " << pPatch->Id() << std::endl;
 
         return pNewElements;
@@ -161,9 +148,7 @@ public:
     {
         if (IsReady()) return ModelPart::ConditionsContainerType(); // call BeginModelPart first before adding conditions
 
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiPatchModelPart::AddConditions");
 
         // construct the boundary patch
         typename Patch<TDim-1>::Pointer pBoundaryPatch = pPatch->ConstructBoundaryPatch(side);
@@ -186,11 +171,7 @@ public:
         // sort the condition container and make it consistent
         mpModelPart->Conditions().Unique();
 
-        #ifdef ENABLE_PROFILING
-        std::cout << ">>> " << __FUNCTION__ << " completed: " << OpenMPUtils::GetCurrentTime() - start << " s, ";
-        #else
         std::cout << __FUNCTION__ << " completed, ";
-        #endif
         std::cout << pNewConditions.size() << " conditions of type " << condition_name << " are generated for patch " << pPatch->Id() << std::endl;
 
         return pNewConditions;
@@ -275,18 +256,13 @@ public:
         TNodeContainerType& rNodes, const std::string& element_name,
         const std::size_t& starting_id, Properties::Pointer p_temp_properties)
     {
-        #ifdef ENABLE_PROFILING
-        double start = OpenMPUtils::GetCurrentTime();
-        #endif
+        IsogeometricProfiler::ScopedTimer timer("MultiPatchModelPart::CreateEntitiesFromFESpace");
 
         // construct the cell manager out from the FESpace
         typedef typename TFESpace::cell_container_t cell_container_t;
         typename cell_container_t::Pointer pCellManager = pFESpace->ConstructCellManager();
 
-        #ifdef ENABLE_PROFILING
-        std::cout << "  >> ConstructCellManager: " << OpenMPUtils::GetCurrentTime()-start << " s" << std::endl;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("MultiPatchModelPart::CreateEntitiesFromFESpace::ConstructCellManager");
 
         // container for newly created elements
         PointerVectorSet<TEntityType, IndexedObject> pNewElements;
@@ -360,10 +336,7 @@ public:
             pNewElements.push_back(pNewElement);
         }
 
-        #ifdef ENABLE_PROFILING
-        std::cout << "  >> generate entities: " << OpenMPUtils::GetCurrentTime()-start << " s" << std::endl;
-        start = OpenMPUtils::GetCurrentTime();
-        #endif
+        timer.Lap("MultiPatchModelPart::CreateEntitiesFromFESpace::GenerateEntities");
 
         return pNewElements;
     }
@@ -404,7 +377,6 @@ inline std::ostream& operator <<(std::ostream& rOStream, const MultiPatchModelPa
 } // namespace Kratos.
 
 #undef DEBUG_GEN_ENTITY
-#undef ENABLE_PROFILING
 
 #endif // KRATOS_ISOGEOMETRIC_APPLICATION_MULTIPATCH_MODEL_PART_H_INCLUDED
 
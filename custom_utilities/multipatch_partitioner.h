@@ -0,0 +1,500 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_MULTIPATCH_PARTITIONER_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_MULTIPATCH_PARTITIONER_H_INCLUDED
+
+// System includes
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <numeric>
+#include <iomanip>
+
+// External includes
+#ifdef ISOGEOMETRIC_USE_PARMETIS
+#include <metis.h>
+#endif
+
+// Project includes
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+#include "custom_utilities/patch.h"
+#include "custom_utilities/isogeometric_profiler.h"
+
+namespace Kratos
+{
+
+/**
+Partition the elements (cells) of a multipatch, taking into account the patch topology and the cost of the elements.
+Each element is weighted by (p1+1)x...x(pd+1) times its number of integration points. Two elements are connected in
+the partitioning graph if they share control points, with the number of shared control points as the edge weight;
+the edges inside a patch are scaled by the intra-patch factor (> 1), hence the cut preferably happens at the patch
+interfaces. When METIS is available (ISOGEOMETRIC_USE_PARMETIS), the graph is partitioned by METIS_PartGraphKway;
+otherwise the patches are packed to the partitions as a whole and only the patches exceeding the target load are split.
+The partitions of each patch are given in the order of the cells in the cell manager, which is the order of the
+elements created by MultiPatchModelPart::AddElements.
+ */
+template<int TDim>
+class MultiPatchPartitioner
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(MultiPatchPartitioner);
+
+    /// Type definition
+    typedef Patch<TDim> PatchType;
+    typedef MultiPatch<TDim> MultiPatchType;
+    typedef typename FESpace<TDim>::cell_container_t cell_container_t;
+
+    /// Default constructor
+    MultiPatchPartitioner(typename MultiPatchType::Pointer pMultiPatch)
+    : mpMultiPatch(pMultiPatch), mIntegrationMethod(1), mIntraPatchFactor(10), mImbalanceTolerance(1.05)
+    , mNumberOfPartitions(0), mNumberOfAnchors(0), mHaloSize(0), mNumberOfInterfaceControlPoints(0)
+    , mInterPatchCut(0), mIntraPatchCut(0), mNumberOfCutPatches(0)
+    {}
+
+    /// Destructor
+    virtual ~MultiPatchPartitioner() {}
+
+    /// Set the integration method used to estimate the number of integration points (0: GI_GAUSS_1, 1: GI_GAUSS_2, ...)
+    void SetIntegrationMethod(const int& Method) {mIntegrationMethod = Method;}
+
+    /// Set the scaling of the graph edges inside a patch. The larger it is, the more the cut is pushed to the patch interfaces.
+    void SetIntraPatchFactor(const int& Factor) {mIntraPatchFactor = Factor;}
+
+    /// Set the allowed load imbalance, e.g. 1.05
+    void SetImbalanceTolerance(const double& Tolerance) {mImbalanceTolerance = Tolerance;}
+
+    /// Partition the multipatch
+    void Partition(const std::size_t& NumberOfPartitions)
+    {
+        IsogeometricProfiler::ScopedTimer timer("MultiPatchPartitioner::Partition");
+
+        if (NumberOfPartitions == 0)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of partitions must be positive", "")
+
+        mNumberOfPartitions = NumberOfPartitions;
+
+        this->BuildGraph();
+
+        mPartitions.resize(mWeights.size());
+        if (mNumberOfPartitions == 1)
+        {
+            std::fill(mPartitions.begin(), mPartitions.end(), 0);
+        }
+        else
+        {
+            #ifdef ISOGEOMETRIC_USE_PARMETIS
+            this->PartitionGraph();
+            #else
+            this->PartitionPatches();
+            #endif
+        }
+
+        this->ComputeStatistics();
+    }
+
+    /// Get the partitions of the elements of a patch, in the order of the cells of the patch
+    std::vector<int> GetPartitions(const std::size_t& PatchId) const
+    {
+        std::map<std::size_t, std::size_t>::const_iterator it = mPatchIndex.find(PatchId);
+        if (it == mPatchIndex.end())
+            KRATOS_THROW_ERROR(std::logic_error, "The patch is not partitioned:", PatchId)
+
+        const std::size_t& ip = it->second;
+        return std::vector<int>(mPartitions.begin() + mPatchOffsets[ip], mPartitions.begin() + mPatchOffsets[ip+1]);
+    }
+
+    /// Get the partitions of all elements, with the elements of the patches concatenated in the order of the patches in the multipatch
+    const std::vector<int>& GetElementPartitions() const {return mPartitions;}
+
+    /// Get the element weights, in the same order as GetElementPartitions
+    const std::vector<int>& GetElementWeights() const {return mWeights;}
+
+    /// Get the estimated load of each partition
+    const std::vector<double>& PartitionLoads() const {return mLoads;}
+
+    /// Get the estimated load imbalance, i.e. the maximum load over the average load
+    double EstimatedImbalance() const
+    {
+        if (mLoads.size() == 0) return 0.0;
+        double total = std::accumulate(mLoads.begin(), mLoads.end(), 0.0);
+        if (total == 0.0) return 1.0;
+        return *std::max_element(mLoads.begin(), mLoads.end()) * mLoads.size() / total;
+    }
+
+    /// Get the halo size, i.e. the total number of ghost control points over all partitions
+    const std::size_t& HaloSize() const {return mHaloSize;}
+
+    /// Get the number of control points shared by more than one partition
+    const std::size_t& NumberOfInterfaceControlPoints() const {return mNumberOfInterfaceControlPoints;}
+
+    /// Get the number of patches which are split over several partitions
+    const std::size_t& NumberOfCutPatches() const {return mNumberOfCutPatches;}
+
+    /// Report the partitioning quality
+    void Report(std::ostream& rOStream) const
+    {
+        rOStream << "MultiPatchPartitioner" << TDim << "D report:" << std::endl;
+        rOStream << "  number of partitions: " << mNumberOfPartitions << std::endl;
+        rOStream << "  number of elements: " << mWeights.size() << ", number of patches: " << mPatchIds.size() << std::endl;
+        rOStream << "  partition loads:";
+        for (std::size_t i = 0; i < mLoads.size(); ++i)
+            rOStream << " " << mLoads[i];
+        rOStream << std::endl;
+        std::streamsize precision = rOStream.precision();
+        rOStream << "  estimated load imbalance: " << std::setprecision(4) << EstimatedImbalance() << std::setprecision(precision) << std::endl;
+        rOStream << "  halo size (ghost control points): " << mHaloSize << std::endl;
+        rOStream << "  interface control points: " << mNumberOfInterfaceControlPoints << std::endl;
+        rOStream << "  edge cut (shared control points): " << mInterPatchCut << " at patch interfaces, " << mIntraPatchCut << " inside patches" << std::endl;
+        rOStream << "  number of cut patches: " << mNumberOfCutPatches << std::endl;
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "MultiPatchPartitioner" << TDim << "D";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        if (mNumberOfPartitions != 0)
+            this->Report(rOStream);
+    }
+
+private:
+
+    typename MultiPatchType::Pointer mpMultiPatch;
+    int mIntegrationMethod;
+    int mIntraPatchFactor;
+    double mImbalanceTolerance;
+    std::size_t mNumberOfPartitions;
+
+    // graph data
+    std::vector<std::size_t> mPatchIds;
+    std::map<std::size_t, std::size_t> mPatchIndex;
+    std::vector<std::size_t> mPatchOffsets; // the elements of the i-th patch are [mPatchOffsets[i], mPatchOffsets[i+1])
+    std::vector<std::size_t> mElementPatch; // the patch index of each element
+    std::vector<double> mElementCenters; // the parametric center of each element, TDim values per element
+    std::vector<int> mWeights;
+    std::vector<std::size_t> mAnchorOffsets; // the control points of the i-th element are mAnchors[mAnchorOffsets[i]], ...
+    std::vector<std::size_t> mAnchors;
+    std::size_t mNumberOfAnchors; // the control points are numbered in [0, mNumberOfAnchors)
+    std::vector<int> mXadj, mAdjncy, mAdjwgt; // CSR graph, the edge weights are not scaled
+
+    // results
+    std::vector<int> mPartitions;
+    std::vector<double> mLoads;
+    std::size_t mHaloSize;
+    std::size_t mNumberOfInterfaceControlPoints;
+    std::size_t mInterPatchCut;
+    std::size_t mIntraPatchCut;
+    std::size_t mNumberOfCutPatches;
+
+    /// Collect the elements, their weights and control points, and build the element graph
+    void BuildGraph()
+    {
+        if (!mpMultiPatch->IsEnumerated())
+            mpMultiPatch->Enumerate();
+
+        mPatchIds.clear();
+        mPatchIndex.clear();
+        mPatchOffsets.assign(1, 0);
+        mElementPatch.clear();
+        mElementCenters.clear();
+        mWeights.clear();
+        mAnchorOffsets.assign(1, 0);
+        mAnchors.clear();
+
+        for (typename MultiPatchType::PatchContainerType::ptr_iterator it = mpMultiPatch->Patches().ptr_begin();
+                it != mpMultiPatch->Patches().ptr_end(); ++it)
+        {
+            typename FESpace<TDim>::ConstPointer pFESpace = (*it)->pFESpace();
+
+            // the cost of an element of this patch
+            int weight = 1;
+            for (int dim = 0; dim < TDim; ++dim)
+            {
+                const int p = static_cast<int>(pFESpace->Order(dim));
+                weight *= (p + 1) * (mIntegrationMethod + 2 + p / 2); // see BezierUtils::AllIntegrationPoints
+            }
+
+            const std::size_t ip = mPatchIds.size();
+            mPatchIndex[(*it)->Id()] = ip;
+            mPatchIds.push_back((*it)->Id());
+
+            typename cell_container_t::Pointer pCellManager = pFESpace->ConstructCellManager();
+            for (typename cell_container_t::iterator it_cell = pCellManager->begin(); it_cell != pCellManager->end(); ++it_cell)
+            {
+                const std::vector<std::size_t>& anchors = (*it_cell)->GetSupportedAnchors();
+                mAnchors.insert(mAnchors.end(), anchors.begin(), anchors.end());
+                mAnchorOffsets.push_back(mAnchors.size());
+                mElementPatch.push_back(ip);
+                mWeights.push_back(weight);
+
+                mElementCenters.push_back(0.5 * ((*it_cell)->LeftValue() + (*it_cell)->RightValue()));
+                if (TDim > 1)
+                    mElementCenters.push_back(0.5 * ((*it_cell)->DownValue() + (*it_cell)->UpValue()));
+                if (TDim > 2)
+                    mElementCenters.push_back(0.5 * ((*it_cell)->BelowValue() + (*it_cell)->AboveValue()));
+            }
+
+            mPatchOffsets.push_back(mWeights.size());
+        }
+
+        const std::size_t ne = mWeights.size();
+
+        // map each control point to the elements supported on it
+        std::size_t max_anchor = 0;
+        for (std::size_t i = 0; i < mAnchors.size(); ++i)
+            max_anchor = std::max(max_anchor, mAnchors[i]);
+        mNumberOfAnchors = (mAnchors.size() == 0) ? 0 : max_anchor + 1;
+        std::vector<std::size_t> anchor_element_offsets(max_anchor + 2, 0);
+        for (std::size_t i = 0; i < mAnchors.size(); ++i)
+            ++anchor_element_offsets[mAnchors[i] + 1];
+        for (std::size_t i = 0; i <= max_anchor; ++i)
+            anchor_element_offsets[i+1] += anchor_element_offsets[i];
+        std::vector<std::size_t> anchor_elements(mAnchors.size());
+        std::vector<std::size_t> fill(anchor_element_offsets.begin(), anchor_element_offsets.end() - 1);
+        for (std::size_t e = 0; e < ne; ++e)
+            for (std::size_t j = mAnchorOffsets[e]; j < mAnchorOffsets[e+1]; ++j)
+                anchor_elements[fill[mAnchors[j]]++] = e;
+
+        // the graph edges, weighted by the number of shared control points
+        mXadj.assign(1, 0);
+        mAdjncy.clear();
+        mAdjwgt.clear();
+        std::map<std::size_t, int> neighbours;
+        for (std::size_t e = 0; e < ne; ++e)
+        {
+            neighbours.clear();
+            for (std::size_t j = mAnchorOffsets[e]; j < mAnchorOffsets[e+1]; ++j)
+            {
+                const std::size_t& a = mAnchors[j];
+                for (std::size_t k = anchor_element_offsets[a]; k < anchor_element_offsets[a+1]; ++k)
+                    if (anchor_elements[k] != e)
+                        ++neighbours[anchor_elements[k]];
+            }
+
+            for (std::map<std::size_t, int>::iterator it = neighbours.begin(); it != neighbours.end(); ++it)
+            {
+                mAdjncy.push_back(it->first);
+                mAdjwgt.push_back(it->second);
+            }
+            mXadj.push_back(mAdjncy.size());
+        }
+    }
+
+    #ifdef ISOGEOMETRIC_USE_PARMETIS
+    /// Partition the element graph by METIS
+    void PartitionGraph()
+    {
+        idx_t nvtxs = mWeights.size();
+        idx_t ncon = 1;
+        idx_t nparts = mNumberOfPartitions;
+        idx_t objval;
+
+        std::vector<idx_t> xadj(mXadj.begin(), mXadj.end());
+        std::vector<idx_t> adjncy(mAdjncy.begin(), mAdjncy.end());
+        std::vector<idx_t> vwgt(mWeights.begin(), mWeights.end());
+        std::vector<idx_t> adjwgt(mAdjwgt.size());
+        for (std::size_t e = 0; e < mWeights.size(); ++e)
+            for (int j = mXadj[e]; j < mXadj[e+1]; ++j)
+                adjwgt[j] = (mElementPatch[e] == mElementPatch[mAdjncy[j]]) ? mAdjwgt[j] * mIntraPatchFactor : mAdjwgt[j];
+        std::vector<idx_t> part(nvtxs);
+
+        idx_t options[METIS_NOPTIONS];
+        METIS_SetDefaultOptions(options);
+        options[METIS_OPTION_UFACTOR] = static_cast<idx_t>((mImbalanceTolerance - 1.0) * 1000);
+
+        int status = METIS_PartGraphKway(&nvtxs, &ncon, &xadj[0], adjncy.data(), &vwgt[0], NULL, adjwgt.data(),
+                                         &nparts, NULL, NULL, options, &objval, &part[0]);
+        if (status != METIS_OK)
+            KRATOS_THROW_ERROR(std::runtime_error, "METIS_PartGraphKway failed with status", status)
+
+        std::copy(part.begin(), part.end(), mPartitions.begin());
+    }
+    #endif
+
+    /// Pack the patches as a whole to the least loaded partition. The patch exceeding the target load is split
+    /// into slabs along its parametric directions, which are distributed to the least loaded partitions.
+    void PartitionPatches()
+    {
+        const std::size_t np = mPatchIds.size();
+        std::vector<double> patch_weights(np, 0.0);
+        for (std::size_t e = 0; e < mWeights.size(); ++e)
+            patch_weights[mElementPatch[e]] += mWeights[e];
+
+        const double total = std::accumulate(patch_weights.begin(), patch_weights.end(), 0.0);
+        const double target = total / mNumberOfPartitions;
+
+        std::vector<std::size_t> order(np);
+        for (std::size_t i = 0; i < np; ++i)
+            order[i] = i;
+        std::stable_sort(order.begin(), order.end(), PatchWeightComparator(patch_weights));
+
+        std::vector<double> loads(mNumberOfPartitions, 0.0);
+        std::vector<int> anchor_partitions(mNumberOfAnchors, -1);
+        std::vector<std::size_t> shared(mNumberOfPartitions);
+        std::vector<std::size_t> elements;
+        for (std::size_t k = 0; k < np; ++k)
+        {
+            const std::size_t ip = order[k];
+
+            // among the partitions which can take the whole patch, choose the one sharing the most control points with it, then the lightest
+            std::fill(shared.begin(), shared.end(), 0);
+            for (std::size_t j = mAnchorOffsets[mPatchOffsets[ip]]; j < mAnchorOffsets[mPatchOffsets[ip+1]]; ++j)
+                if (anchor_partitions[mAnchors[j]] != -1)
+                    ++shared[anchor_partitions[mAnchors[j]]];
+
+            int selected = -1;
+            for (std::size_t i = 0; i < mNumberOfPartitions; ++i)
+            {
+                if (loads[i] + patch_weights[ip] > mImbalanceTolerance * target)
+                    continue;
+                if ((selected == -1) || (shared[i] > shared[selected])
+                        || ((shared[i] == shared[selected]) && (loads[i] < loads[selected])))
+                    selected = i;
+            }
+
+            if (selected != -1)
+            {
+                for (std::size_t e = mPatchOffsets[ip]; e < mPatchOffsets[ip+1]; ++e)
+                    mPartitions[e] = selected;
+                for (std::size_t j = mAnchorOffsets[mPatchOffsets[ip]]; j < mAnchorOffsets[mPatchOffsets[ip+1]]; ++j)
+                    anchor_partitions[mAnchors[j]] = selected;
+                loads[selected] += patch_weights[ip];
+                continue;
+            }
+
+            // split the patch in the slabs of the elements ordered by their parametric centers
+            elements.resize(mPatchOffsets[ip+1] - mPatchOffsets[ip]);
+            for (std::size_t e = 0; e < elements.size(); ++e)
+                elements[e] = mPatchOffsets[ip] + e;
+            std::sort(elements.begin(), elements.end(), ElementCenterComparator(mElementCenters));
+
+            std::size_t e = 0;
+            while (e < elements.size())
+            {
+                int lightest = std::min_element(loads.begin(), loads.end()) - loads.begin();
+                const double capacity = std::max(target - loads[lightest], static_cast<double>(mWeights[elements[e]]));
+                double filled = 0.0;
+                while (e < elements.size() && filled + 0.5 * mWeights[elements[e]] <= capacity)
+                {
+                    mPartitions[elements[e]] = lightest;
+                    filled += mWeights[elements[e]];
+                    ++e;
+                }
+                if (filled == 0.0) // always make progress
+                {
+                    mPartitions[elements[e]] = lightest;
+                    filled += mWeights[elements[e]];
+                    ++e;
+                }
+                loads[lightest] += filled;
+            }
+
+            for (std::size_t e = mPatchOffsets[ip]; e < mPatchOffsets[ip+1]; ++e)
+                for (std::size_t j = mAnchorOffsets[e]; j < mAnchorOffsets[e+1]; ++j)
+                    anchor_partitions[mAnchors[j]] = mPartitions[e];
+        }
+    }
+
+    /// Compute the loads, the halo size and the edge cuts of the current partitioning
+    void ComputeStatistics()
+    {
+        mLoads.assign(mNumberOfPartitions, 0.0);
+        for (std::size_t e = 0; e < mWeights.size(); ++e)
+            mLoads[mPartitions[e]] += mWeights[e];
+
+        // collect the partitions touching each control point; the lowest one owns it, the others hold a ghost copy
+        std::vector<std::pair<std::size_t, int> > anchor_partitions(mAnchors.size());
+        for (std::size_t e = 0; e < mWeights.size(); ++e)
+            for (std::size_t j = mAnchorOffsets[e]; j < mAnchorOffsets[e+1]; ++j)
+                anchor_partitions[j] = std::make_pair(mAnchors[j], mPartitions[e]);
+        std::sort(anchor_partitions.begin(), anchor_partitions.end());
+        anchor_partitions.erase(std::unique(anchor_partitions.begin(), anchor_partitions.end()), anchor_partitions.end());
+
+        mHaloSize = 0;
+        mNumberOfInterfaceControlPoints = 0;
+        std::size_t i = 0;
+        while (i < anchor_partitions.size())
+        {
+            std::size_t j = i;
+            while (j < anchor_partitions.size() && anchor_partitions[j].first == anchor_partitions[i].first)
+                ++j;
+            if (j - i > 1)
+            {
+                mHaloSize += j - i - 1;
+                ++mNumberOfInterfaceControlPoints;
+            }
+            i = j;
+        }
+
+        mInterPatchCut = 0;
+        mIntraPatchCut = 0;
+        for (std::size_t e = 0; e < mWeights.size(); ++e)
+            for (int j = mXadj[e]; j < mXadj[e+1]; ++j)
+            {
+                const std::size_t other = mAdjncy[j];
+                if (other < e || mPartitions[e] == mPartitions[other])
+                    continue;
+                if (mElementPatch[e] == mElementPatch[other])
+                    mIntraPatchCut += mAdjwgt[j];
+                else
+                    mInterPatchCut += mAdjwgt[j];
+            }
+
+        mNumberOfCutPatches = 0;
+        for (std::size_t ip = 0; ip < mPatchIds.size(); ++ip)
+        {
+            for (std::size_t e = mPatchOffsets[ip] + 1; e < mPatchOffsets[ip+1]; ++e)
+                if (mPartitions[e] != mPartitions[mPatchOffsets[ip]])
+                {
+                    ++mNumberOfCutPatches;
+                    break;
+                }
+        }
+    }
+
+    /// Sort the patches by decreasing weight
+    struct PatchWeightComparator
+    {
+        PatchWeightComparator(const std::vector<double>& rWeights) : mrWeights(rWeights) {}
+        bool operator()(const std::size_t& a, const std::size_t& b) const {return mrWeights[a] > mrWeights[b];}
+        const std::vector<double>& mrWeights;
+    };
+
+    /// Sort the elements lexicographically by their parametric centers
+    struct ElementCenterComparator
+    {
+        ElementCenterComparator(const std::vector<double>& rCenters) : mrCenters(rCenters) {}
+        bool operator()(const std::size_t& a, const std::size_t& b) const
+        {
+            return std::lexicographical_compare(mrCenters.begin() + a*TDim, mrCenters.begin() + (a+1)*TDim,
+                                                mrCenters.begin() + b*TDim, mrCenters.begin() + (b+1)*TDim);
+        }
+        const std::vector<double>& mrCenters;
+    };
+
+};
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const MultiPatchPartitioner<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_MULTIPATCH_PARTITIONER_H_INCLUDED defined
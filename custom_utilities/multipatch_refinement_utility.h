@@ -11,6 +11,9 @@
 
 // System includes
 #include <vector>
+#include <map>
+#include <set>
+#include <queue>
 
 // External includes
 #include <boost/array.hpp>
@@ -28,6 +31,25 @@
 namespace Kratos
 {
 
+/// Helper to perform the degree elevation on the structured control grid of any data type, in specific dimension
+template<int TDim>
+struct MultiPatchRefinementUtility_Helper
+{
+    template<typename TDataType>
+    static void ComputeBsplinesDegreeElevation(
+        const StructuredControlGrid<TDim, TDataType>& ControlValues,
+        const BSplinesFESpace<TDim>& rFESpace,
+        const std::vector<std::size_t>& order_increment,
+        StructuredControlGrid<TDim, TDataType>& NewControlValues,
+        std::vector<std::vector<double> >& new_knots,
+        const TDataType& zero)
+    {
+        std::stringstream ss;
+        ss << __FUNCTION__ << " is not implemented for dimension " << TDim;
+        KRATOS_THROW_ERROR(std::logic_error, ss.str(), "")
+    }
+};
+
 /**
 Utility to control the refinement on multipatch structure
  */
@@ -41,6 +63,12 @@ public:
     typedef KnotArray1D<double> knot_container_t;
     typedef typename knot_container_t::knot_t knot_t;
 
+    /// Knots to be inserted in each dimension of the patches, indexed by patch Id
+    typedef std::map<std::size_t, std::vector<std::vector<double> > > knot_insertion_request_t;
+
+    /// Order increment in each dimension of the patches, indexed by patch Id
+    typedef std::map<std::size_t, std::vector<std::size_t> > degree_elevation_request_t;
+
     /// Default constructor
     MultiPatchRefinementUtility() {}
 
@@ -52,29 +80,69 @@ public:
     *************************************************************************/
 
     /// Insert the knots to the NURBS patch and make it compatible across neighbors
+    /// The refinement is performed in two phases, see PropagateKnotInsertion and ApplyKnotInsertion. On output, pPatch points to the refined patch.
     template<int TDim>
     void InsertKnots(typename Patch<TDim>::Pointer& pPatch, const std::vector<std::vector<double> >& ins_knots)
     {
-        std::set<std::size_t> refined_patches;
-        InsertKnots<TDim>(pPatch, refined_patches, ins_knots);
+        typename MultiPatch<TDim>::Pointer pMultiPatch = pPatch->pParentMultiPatch();
+        if (pMultiPatch == NULL)
+            KRATOS_THROW_ERROR(std::logic_error, "The parent multipatch is not defined for patch", pPatch->Id())
+
+        knot_insertion_request_t requests;
+        this->PropagateKnotInsertion<TDim>(pPatch, ins_knots, requests);
+        this->ApplyKnotInsertion<TDim>(*pMultiPatch, requests);
+        pPatch = pMultiPatch->pGetPatch(pPatch->Id());
     }
 
     /// Insert the knots to the NURBS patch and make it compatible across neighbors
+    /// The patches are refined one after another by recursing through the neighbors; refined_patches keeps the Id of the visited patches.
     template<int TDim>
     void InsertKnots(typename Patch<TDim>::Pointer& pPatch, std::set<std::size_t>& refined_patches, const std::vector<std::vector<double> >& ins_knots);
 
+    /// Phase one of the knot insertion: add the knots to be inserted on the patch to the requests and propagate them across the interfaces
+    /// to the neighbors, until no request changes anymore. The function can be called several times to collect the requests of several patches.
+    /// If a knot is requested several times for a patch, the largest requested multiplicity is kept.
+    template<int TDim>
+    void PropagateKnotInsertion(typename Patch<TDim>::Pointer pPatch, const std::vector<std::vector<double> >& ins_knots,
+            knot_insertion_request_t& rRequests) const;
+
+    /// Phase two of the knot insertion: insert the knots to all the requested patches, and transfer all of their grid functions.
+    /// The patches and the grid functions are processed in parallel. The refined patches replace the old ones in the multipatch.
+    /// The knots are inserted by sparse operators applied direction by direction, hence no dense transformation matrix is formed.
+    template<int TDim>
+    void ApplyKnotInsertion(MultiPatch<TDim>& rMultiPatch, const knot_insertion_request_t& rRequests) const;
+
     /// Degree elevation for the NURBS patch and make it compatible across neighbors
+    /// The refinement is performed in two phases, see PropagateDegreeElevation and ApplyDegreeElevation. On output, pPatch points to the refined patch.
     template<int TDim>
     void DegreeElevate(typename Patch<TDim>::Pointer& pPatch, const std::vector<std::size_t>& order_increment)
     {
-        std::set<std::size_t> refined_patches;
-        DegreeElevate<TDim>(pPatch, refined_patches, order_increment);
+        typename MultiPatch<TDim>::Pointer pMultiPatch = pPatch->pParentMultiPatch();
+        if (pMultiPatch == NULL)
+            KRATOS_THROW_ERROR(std::logic_error, "The parent multipatch is not defined for patch", pPatch->Id())
+
+        degree_elevation_request_t requests;
+        this->PropagateDegreeElevation<TDim>(pPatch, order_increment, requests);
+        this->ApplyDegreeElevation<TDim>(*pMultiPatch, requests);
+        pPatch = pMultiPatch->pGetPatch(pPatch->Id());
     }
 
     /// Degree elevation for the NURBS patch and make it compatible across neighbors
+    /// The patches are elevated one after another by recursing through the neighbors; refined_patches keeps the Id of the visited patches.
     template<int TDim>
     void DegreeElevate(typename Patch<TDim>::Pointer& pPatch, std::set<std::size_t>& refined_patches, const std::vector<std::size_t>& order_increment);
 
+    /// Phase one of the degree elevation: add the order increment of the patch to the requests and propagate it across the interfaces
+    /// to the neighbors, until no request changes anymore. If several increments are requested for a patch, the largest one is kept.
+    template<int TDim>
+    void PropagateDegreeElevation(typename Patch<TDim>::Pointer pPatch, const std::vector<std::size_t>& order_increment,
+            degree_elevation_request_t& rRequests) const;
+
+    /// Phase two of the degree elevation: elevate the degree of all the requested patches, and of all of their grid functions.
+    /// The patches and the grid functions are processed in parallel. The refined patches replace the old ones in the multipatch.
+    template<int TDim>
+    void ApplyDegreeElevation(MultiPatch<TDim>& rMultiPatch, const degree_elevation_request_t& rRequests) const;
+
     /*************************************************************************
                               HIERARCHICAL B-SPLINES
     *************************************************************************/
@@ -112,11 +180,106 @@ private:
         StructuredControlGrid<TDim, ControlPoint<double> >& NewControlPoints,
         std::vector<std::vector<double> >& new_knots) const
     {
-        std::stringstream ss;
-        ss << __FUNCTION__ << " is not implemented for dimension " << TDim;
-        KRATOS_THROW_ERROR(std::logic_error, ss.str(), "")
+        ControlPoint<double> null_control_point(0.0);
+        MultiPatchRefinementUtility_Helper<TDim>::ComputeBsplinesDegreeElevation(ControlPoints, rFESpace, order_increment,
+                NewControlPoints, new_knots, null_control_point);
+    }
+
+    /// Get the parametric dimensions of the patch which are shared with the neighbor on the boundary side.
+    /// The neighbors are assumed to have the same parametric orientation.
+    template<int TDim>
+    static void GetSharedDimensions(const BoundarySide& side, const bool& include_1d, std::vector<std::size_t>& dims);
+
+    /// Merge the knots to the existing knots; the multiplicity of each knot is the largest one of both. Return true if the existing knots are changed.
+    static bool MergeKnots(std::vector<double>& rKnots, const std::vector<double>& rNewKnots);
+
+    /// Sparse knot insertion operator in one direction, in compressed row format. It is empty if no knot is inserted in this direction.
+    struct KnotInsertionOperator1D
+    {
+        std::vector<std::size_t> RowPtr;
+        std::vector<std::size_t> ColInd;
+        std::vector<double> Values;
+    };
+
+    /// Apply the knot insertion operators direction by direction to the tensor-product grid of control values
+    template<typename TDataType>
+    static void ApplyKnotInsertionOperators(const std::vector<KnotInsertionOperator1D>& operators,
+            std::vector<TDataType>& rValues, std::vector<std::size_t>& sizes)
+    {
+        for (std::size_t dim = 0; dim < operators.size(); ++dim)
+        {
+            if (!operators[dim].RowPtr.empty())
+                BSplineUtils::ApplyRefinementOperator(rValues, sizes, dim, operators[dim].RowPtr, operators[dim].ColInd, operators[dim].Values);
+        }
     }
 
+    /// Create the control grid of a grid function after knot insertion
+    template<int TDim, typename TDataType>
+    static typename ControlGrid<TDataType>::Pointer ComputeKnotInsertedControlGrid(const std::vector<KnotInsertionOperator1D>& operators,
+            const std::vector<std::size_t>& old_size, const std::vector<double>& old_weights,
+            const ControlGrid<TDataType>& rControlGrid, const std::vector<double>& new_weights);
+
+    /// Create the control grid of a grid function after degree elevation
+    template<int TDim, typename TDataType>
+    static typename ControlGrid<TDataType>::Pointer ComputeDegreeElevatedControlGrid(const BSplinesFESpace<TDim>& rFESpace,
+            const std::vector<std::size_t>& order_increment, const std::vector<double>& old_weights,
+            const ControlGrid<TDataType>& rControlGrid, const std::vector<double>& new_weights);
+
+    /// Create the refined control grids of all the grid functions of the old patches in parallel, and add them to the new patches.
+    /// TRefineFunctor::Apply is called with (i, old control grid) and returns the new control grid for the i-th patch.
+    template<int TDim, class TRefineFunctor>
+    static void TransferGridFunctions(const std::vector<typename Patch<TDim>::Pointer>& old_patches,
+            std::vector<typename Patch<TDim>::Pointer>& new_patches, const TRefineFunctor& rRefine);
+
+    /// Functor to transfer the control grid of a grid function by knot insertion
+    template<int TDim>
+    struct KnotInsertionTransfer
+    {
+        const std::vector<std::vector<KnotInsertionOperator1D> >& operators;
+        const std::vector<std::vector<std::size_t> >& old_sizes;
+        const std::vector<std::vector<double> >& old_weights;
+        const std::vector<std::vector<double> >& new_weights;
+
+        KnotInsertionTransfer(const std::vector<std::vector<KnotInsertionOperator1D> >& rOperators,
+                const std::vector<std::vector<std::size_t> >& rOldSizes,
+                const std::vector<std::vector<double> >& rOldWeights, const std::vector<std::vector<double> >& rNewWeights)
+        : operators(rOperators), old_sizes(rOldSizes), old_weights(rOldWeights), new_weights(rNewWeights)
+        {}
+
+        template<typename TDataType>
+        typename ControlGrid<TDataType>::Pointer Apply(const std::size_t& i, const ControlGrid<TDataType>& rControlGrid) const
+        {
+            return ComputeKnotInsertedControlGrid<TDim, TDataType>(operators[i], old_sizes[i], old_weights[i], rControlGrid, new_weights[i]);
+        }
+    };
+
+    /// Functor to transfer the control grid of a grid function by degree elevation
+    template<int TDim>
+    struct DegreeElevationTransfer
+    {
+        const std::vector<typename BSplinesFESpace<TDim>::Pointer>& fespaces;
+        const std::vector<std::vector<std::size_t> >& order_increments;
+        const std::vector<std::vector<double> >& old_weights;
+        const std::vector<std::vector<double> >& new_weights;
+
+        DegreeElevationTransfer(const std::vector<typename BSplinesFESpace<TDim>::Pointer>& rFESpaces,
+                const std::vector<std::vector<std::size_t> >& rOrderIncrements,
+                const std::vector<std::vector<double> >& rOldWeights, const std::vector<std::vector<double> >& rNewWeights)
+        : fespaces(rFESpaces), order_increments(rOrderIncrements), old_weights(rOldWeights), new_weights(rNewWeights)
+        {}
+
+        template<typename TDataType>
+        typename ControlGrid<TDataType>::Pointer Apply(const std::size_t& i, const ControlGrid<TDataType>& rControlGrid) const
+        {
+            return ComputeDegreeElevatedControlGrid<TDim, TDataType>(*fespaces[i], order_increments[i], old_weights[i], rControlGrid, new_weights[i]);
+        }
+    };
+
+    /// Replace the old patches by the refined ones in the multipatch and update the neighbor relations
+    template<int TDim>
+    static void ReplacePatches(MultiPatch<TDim>& rMultiPatch, const std::vector<typename Patch<TDim>::Pointer>& old_patches,
+            const std::vector<typename Patch<TDim>::Pointer>& new_patches);
+
 };
 
 /// output stream function
@@ -9,7 +9,12 @@
 #if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_MULTIPATCH_REFINEMENT_UTILITY_HPP_INCLUDED )
 #define  KRATOS_ISOGEOMETRIC_APPLICATION_MULTIPATCH_REFINEMENT_UTILITY_HPP_INCLUDED
 
+// System includes
+#include <algorithm>
+#include <omp.h>
+
 // Project includes
+#include "custom_utilities/isogeometric_profiler.h"
 #include "custom_utilities/multipatch_refinement_utility.h"
 
 namespace Kratos
@@ -483,6 +488,609 @@ void MultiPatchRefinementUtility::DegreeElevate(typename Patch<TDim>::Pointer& p
 }
 
 
+/// Phase one of the knot insertion
+template<int TDim>
+void MultiPatchRefinementUtility::PropagateKnotInsertion(typename Patch<TDim>::Pointer pPatch, const std::vector<std::vector<double> >& ins_knots,
+        knot_insertion_request_t& rRequests) const
+{
+    if (pPatch->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+        KRATOS_THROW_ERROR(std::logic_error, __FUNCTION__, "only support the NURBS patch")
+
+    std::queue<typename Patch<TDim>::Pointer> patches;
+
+    std::vector<std::vector<double> >& seed_knots = rRequests[pPatch->Id()];
+    seed_knots.resize(TDim);
+    bool changed = false;
+    for (std::size_t dim = 0; dim < TDim; ++dim)
+        changed = MergeKnots(seed_knots[dim], ins_knots[dim]) || changed;
+    if (changed)
+        patches.push(pPatch);
+
+    // propagate the request through the interfaces until no request changes
+    std::vector<std::size_t> dims;
+    while (!patches.empty())
+    {
+        typename Patch<TDim>::Pointer pThisPatch = patches.front();
+        patches.pop();
+
+        const std::vector<std::vector<double> >& knots = rRequests[pThisPatch->Id()];
+
+        for (int i = _LEFT_; i < 2*TDim; ++i)
+        {
+            BoundarySide side = static_cast<BoundarySide>(i);
+            typename Patch<TDim>::Pointer pNeighbor = pThisPatch->pNeighbor(side);
+            if (pNeighbor == NULL)
+                continue;
+            if (pNeighbor->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+                continue;
+
+            GetSharedDimensions<TDim>(side, false, dims);
+
+            std::vector<std::vector<double> >& neib_knots = rRequests[pNeighbor->Id()];
+            neib_knots.resize(TDim);
+            bool neib_changed = false;
+            for (std::size_t k = 0; k < dims.size(); ++k)
+                neib_changed = MergeKnots(neib_knots[dims[k]], knots[dims[k]]) || neib_changed;
+
+            if (neib_changed)
+                patches.push(pNeighbor);
+        }
+    }
+}
+
+/// Phase two of the knot insertion
+template<int TDim>
+void MultiPatchRefinementUtility::ApplyKnotInsertion(MultiPatch<TDim>& rMultiPatch, const knot_insertion_request_t& rRequests) const
+{
+    IsogeometricProfiler::ScopedTimer timer("MultiPatchRefinementUtility::ApplyKnotInsertion");
+
+    // collect the patches which really need refinement
+    std::vector<typename Patch<TDim>::Pointer> old_patches;
+    std::vector<std::vector<std::vector<double> > > ins_knots;
+    for (typename knot_insertion_request_t::const_iterator it = rRequests.begin(); it != rRequests.end(); ++it)
+    {
+        bool empty = true;
+        for (std::size_t dim = 0; dim < it->second.size(); ++dim)
+            empty = empty && it->second[dim].empty();
+        if (empty)
+            continue;
+
+        typename Patch<TDim>::Pointer pPatch = rMultiPatch.pGetPatch(it->first);
+        if (pPatch->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+            KRATOS_THROW_ERROR(std::logic_error, "Knot insertion only supports the NURBS patch. Error at patch", pPatch->Id())
+
+        old_patches.push_back(pPatch);
+        ins_knots.push_back(it->second);
+    }
+
+    const std::size_t npatches = old_patches.size();
+    std::vector<typename Patch<TDim>::Pointer> new_patches(npatches);
+    std::vector<std::vector<KnotInsertionOperator1D> > operators(npatches);
+    std::vector<std::vector<std::size_t> > old_sizes(npatches);
+    std::vector<std::vector<double> > old_weights(npatches);
+    std::vector<std::vector<double> > new_weights(npatches);
+
+    // compute the knot insertion operators, the new FESpace and the control points of all the patches
+    std::string error_message;
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < static_cast<int>(npatches); ++i)
+    {
+        try
+        {
+            typename Patch<TDim>::Pointer pPatch = old_patches[i];
+
+            typename BSplinesFESpace<TDim>::Pointer pFESpace = boost::dynamic_pointer_cast<BSplinesFESpace<TDim> >(pPatch->pFESpace());
+            typename BSplinesFESpace<TDim>::Pointer pNewFESpace = typename BSplinesFESpace<TDim>::Pointer(new BSplinesFESpace<TDim>());
+
+            operators[i].resize(TDim);
+            old_sizes[i].resize(TDim);
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+            {
+                old_sizes[i][dim] = pFESpace->Number(dim);
+
+                std::vector<double> new_knots;
+                if (ins_knots[i][dim].empty())
+                {
+                    new_knots.resize(pFESpace->KnotVector(dim).size());
+                    for (std::size_t j = 0; j < new_knots.size(); ++j)
+                        new_knots[j] = pFESpace->KnotVector(dim)[j];
+                }
+                else
+                {
+                    BSplineUtils::ComputeBsplinesKnotInsertionOperator1D(operators[i][dim].RowPtr, operators[i][dim].ColInd, operators[i][dim].Values,
+                            new_knots, pFESpace->Order(dim), pFESpace->KnotVector(dim), ins_knots[i][dim]);
+                }
+
+                pNewFESpace->SetKnotVector(dim, new_knots);
+                pNewFESpace->SetInfo(dim, new_knots.size() - pPatch->Order(dim) - 1, pPatch->Order(dim));
+            }
+
+            new_patches[i] = typename Patch<TDim>::Pointer(new Patch<TDim>(pPatch->Id()));
+            new_patches[i]->SetFESpace(pNewFESpace);
+
+            // the control points are in homogeneous coordinates, hence they are transformed directly
+            typename ControlGrid<ControlPoint<double> >::ConstPointer pControlPoints = pPatch->pControlPointGridFunction()->pControlGrid();
+            std::vector<ControlPoint<double> > points(pControlPoints->size());
+            for (std::size_t j = 0; j < points.size(); ++j)
+                points[j] = pControlPoints->GetData(j);
+
+            std::vector<std::size_t> new_size(old_sizes[i]);
+            ApplyKnotInsertionOperators(operators[i], points, new_size);
+
+            typename ControlGrid<ControlPoint<double> >::Pointer pNewControlPoints = typename ControlGrid<ControlPoint<double> >::Pointer (new StructuredControlGrid<TDim, ControlPoint<double> >(new_size));
+            for (std::size_t j = 0; j < points.size(); ++j)
+                pNewControlPoints->SetData(j, points[j]);
+            pNewControlPoints->SetName(pControlPoints->Name());
+            new_patches[i]->CreateControlPointGridFunction(pNewControlPoints);
+
+            old_weights[i] = pPatch->GetControlWeights();
+            new_weights[i] = new_patches[i]->GetControlWeights();
+        }
+        catch (std::exception& e)
+        {
+            #pragma omp critical
+            {
+                if (error_message.empty())
+                    error_message = e.what();
+            }
+        }
+    }
+
+    if (!error_message.empty())
+        KRATOS_THROW_ERROR(std::runtime_error, "Error during knot insertion:", error_message)
+
+    timer.Lap("MultiPatchRefinementUtility::ApplyKnotInsertion::ControlPoints");
+
+    // transfer all the grid functions
+    KnotInsertionTransfer<TDim> transfer(operators, old_sizes, old_weights, new_weights);
+    TransferGridFunctions<TDim>(old_patches, new_patches, transfer);
+
+    timer.Lap("MultiPatchRefinementUtility::ApplyKnotInsertion::GridFunctions");
+
+    ReplacePatches<TDim>(rMultiPatch, old_patches, new_patches);
+}
+
+/// Phase one of the degree elevation
+template<int TDim>
+void MultiPatchRefinementUtility::PropagateDegreeElevation(typename Patch<TDim>::Pointer pPatch, const std::vector<std::size_t>& order_increment,
+        degree_elevation_request_t& rRequests) const
+{
+    if (pPatch->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+        KRATOS_THROW_ERROR(std::logic_error, __FUNCTION__, "only support the NURBS patch")
+
+    std::queue<typename Patch<TDim>::Pointer> patches;
+
+    std::vector<std::size_t>& seed_increment = rRequests[pPatch->Id()];
+    seed_increment.resize(TDim, 0);
+    bool changed = false;
+    for (std::size_t dim = 0; dim < TDim; ++dim)
+    {
+        if (order_increment[dim] > seed_increment[dim])
+        {
+            seed_increment[dim] = order_increment[dim];
+            changed = true;
+        }
+    }
+    if (changed)
+        patches.push(pPatch);
+
+    // propagate the request through the interfaces until no request changes
+    std::vector<std::size_t> dims;
+    while (!patches.empty())
+    {
+        typename Patch<TDim>::Pointer pThisPatch = patches.front();
+        patches.pop();
+
+        const std::vector<std::size_t>& increment = rRequests[pThisPatch->Id()];
+
+        for (int i = _LEFT_; i < 2*TDim; ++i)
+        {
+            BoundarySide side = static_cast<BoundarySide>(i);
+            typename Patch<TDim>::Pointer pNeighbor = pThisPatch->pNeighbor(side);
+            if (pNeighbor == NULL)
+                continue;
+            if (pNeighbor->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+                continue;
+
+            GetSharedDimensions<TDim>(side, true, dims);
+
+            std::vector<std::size_t>& neib_increment = rRequests[pNeighbor->Id()];
+            neib_increment.resize(TDim, 0);
+            bool neib_changed = false;
+            for (std::size_t k = 0; k < dims.size(); ++k)
+            {
+                if (increment[dims[k]] > neib_increment[dims[k]])
+                {
+                    neib_increment[dims[k]] = increment[dims[k]];
+                    neib_changed = true;
+                }
+            }
+
+            if (neib_changed)
+                patches.push(pNeighbor);
+        }
+    }
+}
+
+/// Phase two of the degree elevation
+template<int TDim>
+void MultiPatchRefinementUtility::ApplyDegreeElevation(MultiPatch<TDim>& rMultiPatch, const degree_elevation_request_t& rRequests) const
+{
+    IsogeometricProfiler::ScopedTimer timer("MultiPatchRefinementUtility::ApplyDegreeElevation");
+
+    // collect the patches which really need refinement
+    std::vector<typename Patch<TDim>::Pointer> old_patches;
+    std::vector<typename BSplinesFESpace<TDim>::Pointer> fespaces;
+    std::vector<std::vector<std::size_t> > order_increments;
+    for (typename degree_elevation_request_t::const_iterator it = rRequests.begin(); it != rRequests.end(); ++it)
+    {
+        if (std::count(it->second.begin(), it->second.end(), 0) == static_cast<int>(it->second.size()))
+            continue;
+
+        typename Patch<TDim>::Pointer pPatch = rMultiPatch.pGetPatch(it->first);
+        if (pPatch->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+            KRATOS_THROW_ERROR(std::logic_error, "Degree elevation only supports the NURBS patch. Error at patch", pPatch->Id())
+
+        old_patches.push_back(pPatch);
+        fespaces.push_back(boost::dynamic_pointer_cast<BSplinesFESpace<TDim> >(pPatch->pFESpace()));
+        order_increments.push_back(it->second);
+    }
+
+    const std::size_t npatches = old_patches.size();
+    std::vector<typename Patch<TDim>::Pointer> new_patches(npatches);
+    std::vector<std::vector<double> > old_weights(npatches);
+    std::vector<std::vector<double> > new_weights(npatches);
+
+    // elevate the degree of the FESpace and the control points of all the patches
+    std::string error_message;
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < static_cast<int>(npatches); ++i)
+    {
+        try
+        {
+            typename Patch<TDim>::Pointer pPatch = old_patches[i];
+            typename BSplinesFESpace<TDim>::Pointer pFESpace = fespaces[i];
+            typename BSplinesFESpace<TDim>::Pointer pNewFESpace = typename BSplinesFESpace<TDim>::Pointer(new BSplinesFESpace<TDim>());
+
+            std::vector<std::vector<double> > new_knots(TDim);
+
+            std::vector<std::size_t> new_size(TDim);
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+                new_size[dim] = pFESpace->Number(dim);
+
+            typename StructuredControlGrid<TDim, ControlPoint<double> >::Pointer pControlPoints
+                = boost::dynamic_pointer_cast<StructuredControlGrid<TDim, ControlPoint<double> > >(pPatch->pControlPointGridFunction()->pControlGrid());
+            if (pControlPoints == NULL)
+                KRATOS_THROW_ERROR(std::logic_error, "The control point grid is not structured at patch", pPatch->Id())
+
+            typename StructuredControlGrid<TDim, ControlPoint<double> >::Pointer pNewControlPoints
+                = typename StructuredControlGrid<TDim, ControlPoint<double> >::Pointer(new StructuredControlGrid<TDim, ControlPoint<double> >(new_size)); // note here that the size is just temporary, it will be raised later on.
+
+            this->ComputeBsplinesDegreeElevation<TDim>(*pControlPoints, *pFESpace, order_increments[i], *pNewControlPoints, new_knots);
+
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+            {
+                new_size[dim] = new_knots[dim].size() - pFESpace->Order(dim) - order_increments[i][dim] - 1;
+                pNewFESpace->SetKnotVector(dim, new_knots[dim]);
+                pNewFESpace->SetInfo(dim, new_size[dim], pFESpace->Order(dim) + order_increments[i][dim]);
+            }
+
+            new_patches[i] = typename Patch<TDim>::Pointer(new Patch<TDim>(pPatch->Id()));
+            pNewControlPoints->SetName(pPatch->pControlPointGridFunction()->pControlGrid()->Name());
+            new_patches[i]->SetFESpace(pNewFESpace);
+            new_patches[i]->CreateControlPointGridFunction(pNewControlPoints);
+
+            old_weights[i] = pPatch->GetControlWeights();
+            new_weights[i] = new_patches[i]->GetControlWeights();
+        }
+        catch (std::exception& e)
+        {
+            #pragma omp critical
+            {
+                if (error_message.empty())
+                    error_message = e.what();
+            }
+        }
+    }
+
+    if (!error_message.empty())
+        KRATOS_THROW_ERROR(std::runtime_error, "Error during degree elevation:", error_message)
+
+    timer.Lap("MultiPatchRefinementUtility::ApplyDegreeElevation::ControlPoints");
+
+    // elevate the degree of all the grid functions
+    DegreeElevationTransfer<TDim> transfer(fespaces, order_increments, old_weights, new_weights);
+    TransferGridFunctions<TDim>(old_patches, new_patches, transfer);
+
+    timer.Lap("MultiPatchRefinementUtility::ApplyDegreeElevation::GridFunctions");
+
+    ReplacePatches<TDim>(rMultiPatch, old_patches, new_patches);
+}
+
+template<int TDim>
+void MultiPatchRefinementUtility::GetSharedDimensions(const BoundarySide& side, const bool& include_1d, std::vector<std::size_t>& dims)
+{
+    dims.clear();
+    if (side == _LEFT_ || side == _RIGHT_)
+    {
+        if (TDim == 1 && include_1d)
+        {
+            dims.push_back(0);
+        }
+        else if (TDim == 2)
+        {
+            dims.push_back(1);
+        }
+        else if (TDim == 3)
+        {
+            dims.push_back(1);
+            dims.push_back(2);
+        }
+    }
+    else if (side == _TOP_ || side == _BOTTOM_)
+    {
+        if (TDim == 2)
+        {
+            dims.push_back(0);
+        }
+        else if (TDim == 3)
+        {
+            dims.push_back(0);
+            dims.push_back(1);
+        }
+    }
+    else if (side == _FRONT_ || side == _BACK_)
+    {
+        dims.push_back(0);
+        dims.push_back(2);
+    }
+}
+
+inline bool MultiPatchRefinementUtility::MergeKnots(std::vector<double>& rKnots, const std::vector<double>& rNewKnots)
+{
+    const double tol = 1.0e-10;
+
+    if (rNewKnots.empty())
+        return false;
+
+    std::vector<double> new_knots(rNewKnots);
+    std::sort(new_knots.begin(), new_knots.end());
+
+    std::vector<double> merged_knots;
+    merged_knots.reserve(rKnots.size() + new_knots.size());
+
+    bool changed = false;
+    std::size_t i = 0, j = 0;
+    while (i < rKnots.size() || j < new_knots.size())
+    {
+        double v;
+        if (j == new_knots.size() || (i < rKnots.size() && rKnots[i] < new_knots[j] - tol))
+            v = rKnots[i];
+        else
+            v = new_knots[j];
+
+        std::size_t mul = 0, new_mul = 0;
+        while (i < rKnots.size() && fabs(rKnots[i] - v) < tol) {++i; ++mul;}
+        while (j < new_knots.size() && fabs(new_knots[j] - v) < tol) {++j; ++new_mul;}
+
+        if (new_mul > mul)
+        {
+            changed = true;
+            mul = new_mul;
+        }
+
+        for (std::size_t k = 0; k < mul; ++k)
+            merged_knots.push_back(v);
+    }
+
+    if (changed)
+        rKnots.swap(merged_knots);
+
+    return changed;
+}
+
+template<int TDim, typename TDataType>
+typename ControlGrid<TDataType>::Pointer MultiPatchRefinementUtility::ComputeKnotInsertedControlGrid(const std::vector<KnotInsertionOperator1D>& operators,
+        const std::vector<std::size_t>& old_size, const std::vector<double>& old_weights,
+        const ControlGrid<TDataType>& rControlGrid, const std::vector<double>& new_weights)
+{
+    if (rControlGrid.size() != old_weights.size())
+        KRATOS_THROW_ERROR(std::logic_error, "The size of the control grid is incompatible with the weights:", rControlGrid.Name())
+
+    // the control values are weighted before the transformation, and unweighted afterwards, so that the grid function is preserved
+    std::vector<TDataType> values(rControlGrid.size());
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = rControlGrid.GetData(i) * old_weights[i];
+
+    std::vector<std::size_t> new_size(old_size);
+    ApplyKnotInsertionOperators(operators, values, new_size);
+
+    if (values.size() != new_weights.size())
+        KRATOS_THROW_ERROR(std::logic_error, "The size of the refined control grid is incompatible with the new weights:", rControlGrid.Name())
+
+    typename ControlGrid<TDataType>::Pointer pNewControlGrid = typename ControlGrid<TDataType>::Pointer (new StructuredControlGrid<TDim, TDataType>(new_size));
+    for (std::size_t i = 0; i < values.size(); ++i)
+        pNewControlGrid->SetData(i, values[i] / new_weights[i]);
+    pNewControlGrid->SetName(rControlGrid.Name());
+    return pNewControlGrid;
+}
+
+template<int TDim, typename TDataType>
+typename ControlGrid<TDataType>::Pointer MultiPatchRefinementUtility::ComputeDegreeElevatedControlGrid(const BSplinesFESpace<TDim>& rFESpace,
+        const std::vector<std::size_t>& order_increment, const std::vector<double>& old_weights,
+        const ControlGrid<TDataType>& rControlGrid, const std::vector<double>& new_weights)
+{
+    if (rControlGrid.size() != old_weights.size())
+        KRATOS_THROW_ERROR(std::logic_error, "The size of the control grid is incompatible with the weights:", rControlGrid.Name())
+
+    std::vector<std::size_t> old_size(TDim);
+    for (std::size_t dim = 0; dim < TDim; ++dim)
+        old_size[dim] = rFESpace.Number(dim);
+
+    // the degree elevation is applied on the weighted control values, as for the homogeneous coordinates of the control points
+    StructuredControlGrid<TDim, TDataType> WeightedControlValues(old_size);
+    for (std::size_t i = 0; i < rControlGrid.size(); ++i)
+        WeightedControlValues.SetData(i, rControlGrid.GetData(i) * old_weights[i]);
+
+    typename StructuredControlGrid<TDim, TDataType>::Pointer pNewControlGrid
+        = typename StructuredControlGrid<TDim, TDataType>::Pointer(new StructuredControlGrid<TDim, TDataType>(old_size)); // the size will be raised later on
+
+    std::vector<std::vector<double> > new_knots(TDim);
+    TDataType zero = rControlGrid.GetData(0) * 0.0;
+    MultiPatchRefinementUtility_Helper<TDim>::ComputeBsplinesDegreeElevation(WeightedControlValues, rFESpace, order_increment,
+            *pNewControlGrid, new_knots, zero);
+
+    if (pNewControlGrid->size() != new_weights.size())
+        KRATOS_THROW_ERROR(std::logic_error, "The size of the elevated control grid is incompatible with the new weights:", rControlGrid.Name())
+
+    for (std::size_t i = 0; i < pNewControlGrid->size(); ++i)
+        pNewControlGrid->SetData(i, pNewControlGrid->GetData(i) / new_weights[i]);
+
+    pNewControlGrid->SetName(rControlGrid.Name());
+    return pNewControlGrid;
+}
+
+template<int TDim, class TRefineFunctor>
+void MultiPatchRefinementUtility::TransferGridFunctions(const std::vector<typename Patch<TDim>::Pointer>& old_patches,
+        std::vector<typename Patch<TDim>::Pointer>& new_patches, const TRefineFunctor& rRefine)
+{
+    const std::size_t npatches = old_patches.size();
+
+    std::vector<typename Patch<TDim>::DoubleGridFunctionContainerType> DoubleGridFunctions_(npatches);
+    std::vector<typename Patch<TDim>::Array1DGridFunctionContainerType> Array1DGridFunctions_(npatches);
+    std::vector<typename Patch<TDim>::VectorGridFunctionContainerType> VectorGridFunctions_(npatches);
+
+    std::vector<std::vector<typename ControlGrid<double>::Pointer> > NewDoubleControlGrids(npatches);
+    std::vector<std::vector<typename ControlGrid<array_1d<double, 3> >::Pointer> > NewArray1DControlGrids(npatches);
+    std::vector<std::vector<typename ControlGrid<Vector>::Pointer> > NewVectorControlGrids(npatches);
+
+    // each task is (patch index, type of grid function, index of grid function)
+    std::vector<boost::array<std::size_t, 3> > tasks;
+    boost::array<std::size_t, 3> task;
+    for (std::size_t i = 0; i < npatches; ++i)
+    {
+        task[0] = i;
+
+        DoubleGridFunctions_[i] = old_patches[i]->DoubleGridFunctions();
+        NewDoubleControlGrids[i].resize(DoubleGridFunctions_[i].size());
+        task[1] = 0;
+        for (std::size_t j = 0; j < DoubleGridFunctions_[i].size(); ++j)
+        {
+            task[2] = j;
+            tasks.push_back(task);
+        }
+
+        Array1DGridFunctions_[i] = old_patches[i]->Array1DGridFunctions();
+        NewArray1DControlGrids[i].resize(Array1DGridFunctions_[i].size());
+        task[1] = 1;
+        for (std::size_t j = 0; j < Array1DGridFunctions_[i].size(); ++j)
+        {
+            task[2] = j;
+            tasks.push_back(task);
+        }
+
+        VectorGridFunctions_[i] = old_patches[i]->VectorGridFunctions();
+        NewVectorControlGrids[i].resize(VectorGridFunctions_[i].size());
+        task[1] = 2;
+        for (std::size_t j = 0; j < VectorGridFunctions_[i].size(); ++j)
+        {
+            task[2] = j;
+            tasks.push_back(task);
+        }
+    }
+
+    std::string error_message;
+    #pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < static_cast<int>(tasks.size()); ++t)
+    {
+        const std::size_t& i = tasks[t][0];
+        const std::size_t& j = tasks[t][2];
+
+        try
+        {
+            if (tasks[t][1] == 0)
+                NewDoubleControlGrids[i][j] = rRefine.Apply(i, *(DoubleGridFunctions_[i][j]->pControlGrid()));
+            else if (tasks[t][1] == 1)
+                NewArray1DControlGrids[i][j] = rRefine.Apply(i, *(Array1DGridFunctions_[i][j]->pControlGrid()));
+            else
+                NewVectorControlGrids[i][j] = rRefine.Apply(i, *(VectorGridFunctions_[i][j]->pControlGrid()));
+        }
+        catch (std::exception& e)
+        {
+            #pragma omp critical
+            {
+                if (error_message.empty())
+                    error_message = e.what();
+            }
+        }
+    }
+
+    if (!error_message.empty())
+        KRATOS_THROW_ERROR(std::runtime_error, "Error during the transfer of grid functions:", error_message)
+
+    // add the grid functions to the new patches, in the same order as in the old patches
+    for (std::size_t i = 0; i < npatches; ++i)
+    {
+        for (std::size_t j = 0; j < NewDoubleControlGrids[i].size(); ++j)
+            new_patches[i]->template CreateGridFunction<double>(NewDoubleControlGrids[i][j]);
+
+        for (std::size_t j = 0; j < NewArray1DControlGrids[i].size(); ++j)
+            new_patches[i]->template CreateGridFunction<array_1d<double, 3> >(NewArray1DControlGrids[i][j]);
+
+        for (std::size_t j = 0; j < NewVectorControlGrids[i].size(); ++j)
+            new_patches[i]->template CreateGridFunction<Vector>(NewVectorControlGrids[i][j]);
+    }
+}
+
+template<int TDim>
+void MultiPatchRefinementUtility::ReplacePatches(MultiPatch<TDim>& rMultiPatch, const std::vector<typename Patch<TDim>::Pointer>& old_patches,
+        const std::vector<typename Patch<TDim>::Pointer>& new_patches)
+{
+    std::map<std::size_t, typename Patch<TDim>::Pointer> refined_patches;
+    for (std::size_t i = 0; i < new_patches.size(); ++i)
+        refined_patches[new_patches[i]->Id()] = new_patches[i];
+
+    // update the neighbor relations. Only the NURBS neighbors are kept, as in the recursive refinement.
+    for (std::size_t i = 0; i < old_patches.size(); ++i)
+    {
+        for (int j = _LEFT_; j < 2*TDim; ++j)
+        {
+            BoundarySide side = static_cast<BoundarySide>(j);
+            typename Patch<TDim>::Pointer pNeighbor = old_patches[i]->pNeighbor(side);
+            if (pNeighbor == NULL)
+                continue;
+            if (pNeighbor->pFESpace()->Type() != BSplinesFESpace<TDim>::StaticType())
+                continue;
+
+            typename std::map<std::size_t, typename Patch<TDim>::Pointer>::iterator it = refined_patches.find(pNeighbor->Id());
+            if (it != refined_patches.end())
+            {
+                new_patches[i]->pSetNeighbor(side, it->second);
+            }
+            else
+            {
+                new_patches[i]->pSetNeighbor(side, pNeighbor);
+                BoundarySide other_side = pNeighbor->FindBoundarySide(old_patches[i]);
+                if (other_side != _NUMBER_OF_BOUNDARY_SIDE)
+                    pNeighbor->pSetNeighbor(other_side, new_patches[i]);
+            }
+        }
+    }
+
+    // replace the patches in the multipatch. Since the Id is kept, the order of the container is not changed.
+    typename MultiPatch<TDim>::Pointer pMultiPatch = rMultiPatch.shared_from_this();
+    for (typename MultiPatch<TDim>::PatchContainerType::ptr_iterator it = rMultiPatch.Patches().ptr_begin();
+            it != rMultiPatch.Patches().ptr_end(); ++it)
+    {
+        typename std::map<std::size_t, typename Patch<TDim>::Pointer>::iterator it_refined = refined_patches.find((*it)->Id());
+        if (it_refined != refined_patches.end())
+        {
+            it_refined->second->pSetParentMultiPatch(pMultiPatch);
+            *it = it_refined->second;
+        }
+    }
+}
+
 template<>
 void MultiPatchRefinementUtility::ComputeBsplinesKnotInsertionCoefficients<1>(
     Matrix& T,
@@ -526,61 +1134,70 @@ void MultiPatchRefinementUtility::ComputeBsplinesKnotInsertionCoefficients<3>(
 }
 
 template<>
-void MultiPatchRefinementUtility::ComputeBsplinesDegreeElevation<1>(
-    const StructuredControlGrid<1, ControlPoint<double> >& ControlPoints,
-    const BSplinesFESpace<1>& rFESpace,
-    const std::vector<std::size_t>& order_increment,
-    StructuredControlGrid<1, ControlPoint<double> >& NewControlPoints,
-    std::vector<std::vector<double> >& new_knots) const
+struct MultiPatchRefinementUtility_Helper<1>
 {
-    ControlPoint<double> null_control_point(0.0);
-
-    BSplineUtils::ComputeBsplinesDegreeElevation1D(rFESpace.Order(0),
-            ControlPoints,
-            rFESpace.KnotVector(0),
-            order_increment[0],
-            NewControlPoints,
-            new_knots[0],
-            null_control_point);
-}
+    template<typename TDataType>
+    static void ComputeBsplinesDegreeElevation(
+        const StructuredControlGrid<1, TDataType>& ControlValues,
+        const BSplinesFESpace<1>& rFESpace,
+        const std::vector<std::size_t>& order_increment,
+        StructuredControlGrid<1, TDataType>& NewControlValues,
+        std::vector<std::vector<double> >& new_knots,
+        const TDataType& zero)
+    {
+        BSplineUtils::ComputeBsplinesDegreeElevation1D(rFESpace.Order(0),
+                ControlValues,
+                rFESpace.KnotVector(0),
+                order_increment[0],
+                NewControlValues,
+                new_knots[0],
+                zero);
+    }
+};
 
 template<>
-void MultiPatchRefinementUtility::ComputeBsplinesDegreeElevation<2>(
-    const StructuredControlGrid<2, ControlPoint<double> >& ControlPoints,
-    const BSplinesFESpace<2>& rFESpace,
-    const std::vector<std::size_t>& order_increment,
-    StructuredControlGrid<2, ControlPoint<double> >& NewControlPoints,
-    std::vector<std::vector<double> >& new_knots) const
+struct MultiPatchRefinementUtility_Helper<2>
 {
-    ControlPoint<double> null_control_point(0.0);
-
-    BSplineUtils::ComputeBsplinesDegreeElevation2D(rFESpace.Order(0), rFESpace.Order(1),
-            ControlPoints,
-            rFESpace.KnotVector(0), rFESpace.KnotVector(1),
-            order_increment[0], order_increment[1],
-            NewControlPoints,
-            new_knots[0], new_knots[1],
-            null_control_point);
-}
+    template<typename TDataType>
+    static void ComputeBsplinesDegreeElevation(
+        const StructuredControlGrid<2, TDataType>& ControlValues,
+        const BSplinesFESpace<2>& rFESpace,
+        const std::vector<std::size_t>& order_increment,
+        StructuredControlGrid<2, TDataType>& NewControlValues,
+        std::vector<std::vector<double> >& new_knots,
+        const TDataType& zero)
+    {
+        BSplineUtils::ComputeBsplinesDegreeElevation2D(rFESpace.Order(0), rFESpace.Order(1),
+                ControlValues,
+                rFESpace.KnotVector(0), rFESpace.KnotVector(1),
+                order_increment[0], order_increment[1],
+                NewControlValues,
+                new_knots[0], new_knots[1],
+                zero);
+    }
+};
 
 template<>
-void MultiPatchRefinementUtility::ComputeBsplinesDegreeElevation<3>(
-    const StructuredControlGrid<3, ControlPoint<double> >& ControlPoints,
-    const BSplinesFESpace<3>& rFESpace,
-    const std::vector<std::size_t>& order_increment,
-    StructuredControlGrid<3, ControlPoint<double> >& NewControlPoints,
-    std::vector<std::vector<double> >& new_knots) const
+struct MultiPatchRefinementUtility_Helper<3>
 {
-    ControlPoint<double> null_control_point(0.0);
-
-    BSplineUtils::ComputeBsplinesDegreeElevation3D(rFESpace.Order(0), rFESpace.Order(1), rFESpace.Order(2),
-            ControlPoints,
-            rFESpace.KnotVector(0), rFESpace.KnotVector(1), rFESpace.KnotVector(2),
-            order_increment[0], order_increment[1], order_increment[2],
-            NewControlPoints,
-            new_knots[0], new_knots[1], new_knots[2],
-            null_control_point);
-}
+    template<typename TDataType>
+    static void ComputeBsplinesDegreeElevation(
+        const StructuredControlGrid<3, TDataType>& ControlValues,
+        const BSplinesFESpace<3>& rFESpace,
+        const std::vector<std::size_t>& order_increment,
+        StructuredControlGrid<3, TDataType>& NewControlValues,
+        std::vector<std::vector<double> >& new_knots,
+        const TDataType& zero)
+    {
+        BSplineUtils::ComputeBsplinesDegreeElevation3D(rFESpace.Order(0), rFESpace.Order(1), rFESpace.Order(2),
+                ControlValues,
+                rFESpace.KnotVector(0), rFESpace.KnotVector(1), rFESpace.KnotVector(2),
+                order_increment[0], order_increment[1], order_increment[2],
+                NewControlValues,
+                new_knots[0], new_knots[1], new_knots[2],
+                zero);
+    }
+};
 
 } // namespace Kratos.
 
@@ -13,15 +13,21 @@
 #include <vector>
 
 // External includes
+#include <omp.h>
 
 // Project includes
 #include "includes/define.h"
 #include "includes/model_part.h"
+#include "utilities/openmp_utils.h"
 #include "custom_utilities/control_point.h"
 #include "custom_utilities/grid_function.h"
 #include "custom_utilities/fespace.h"
+#include "custom_utilities/weighted_fespace.h"
 #include "custom_utilities/patch.h"
 #include "custom_utilities/multipatch_utility.h"
+#include "custom_utilities/isogeometric_profiler.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/nurbs/bsplines_patch_sampler.h"
 
 // #define DEBUG_MESH_GENERATION
 
@@ -93,30 +99,17 @@ public:
     void WriteModelPart(ModelPart& r_model_part) const
     {
         // get the sample element
-        std::string element_name = mBaseElementName;
-        if (TDim == 2)
-            element_name = element_name + "2D4N";
-        else if (TDim == 3)
-            element_name = element_name + "3D8N";
+        Element const& rCloneElement = this->GetCloneElement();
 
         std::string NodeKey = std::string("Node");
 
-        if(!KratosComponents<Element>::Has(element_name))
-        {
-            std::stringstream buffer;
-            buffer << "Element " << element_name << " is not registered in Kratos.";
-            buffer << " Please check the spelling of the element name and see if the application which containing it, is registered corectly.";
-            KRATOS_THROW_ERROR(std::runtime_error, buffer.str(), "");
-        }
-
-        Element const& rCloneElement = KratosComponents<Element>::Get(element_name);
-
         // generate nodes and elements for each patch
         std::size_t NodeCounter = mLastNodeId;
         std::size_t NodeCounter_old = NodeCounter;
         std::size_t ElementCounter = mLastElemId;
         std::size_t PropertiesCounter = mLastPropId;
         std::vector<double> p_ref(TDim);
+        std::vector<std::size_t> connectivities;
         for (typename MultiPatch<TDim>::PatchContainerType::iterator it = mpMultiPatch->begin();
                 it != mpMultiPatch->end(); ++it)
         {
@@ -124,13 +117,13 @@ public:
             Properties::Pointer pNewProperties = Properties::Pointer(new Properties(PropertiesCounter++));
             r_model_part.AddProperties(pNewProperties);
 
+            typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find(it->Id());
+            if (it_num == mNumDivision.end())
+                KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", it->Id())
+
+            // create new nodes
             if (TDim == 2)
             {
-                // create new nodes
-                typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find(it->Id());
-                if (it_num == mNumDivision.end())
-                    KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", it->Id())
-
                 std::size_t NumDivision1 = it_num->second[0];
                 std::size_t NumDivision2 = it_num->second[1];
                 #ifdef DEBUG_MESH_GENERATION
@@ -153,52 +146,9 @@ public:
                         ++NodeCounter;
                     }
                 }
-
-                // create and add element
-                Element::NodesArrayType temp_element_nodes;
-                for (std::size_t i = 0; i < NumDivision1; ++i)
-                {
-                    for (std::size_t j = 0; j < NumDivision2; ++j)
-                    {
-                        std::size_t Node1 = NodeCounter_old + i * (NumDivision2 + 1) + j;
-                        std::size_t Node2 = NodeCounter_old + i * (NumDivision2 + 1) + j + 1;
-                        std::size_t Node3 = NodeCounter_old + (i + 1) * (NumDivision2 + 1) + j;
-                        std::size_t Node4 = NodeCounter_old + (i + 1) * (NumDivision2 + 1) + j + 1;
-
-                        // TODO: check if jacobian checking is necessary
-                        temp_element_nodes.clear();
-                        temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node1, NodeKey).base()));
-                        temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node2, NodeKey).base()));
-                        temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node4, NodeKey).base()));
-                        temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node3, NodeKey).base()));
-
-                        Element::Pointer pNewElement = rCloneElement.Create(ElementCounter++, temp_element_nodes, pNewProperties);
-                        r_model_part.AddElement(pNewElement);
-                        #ifdef DEBUG_MESH_GENERATION
-                        std::cout << "Element " << pNewElement->Id() << " is created with connectivity:";
-                        for (std::size_t n = 0; n < pNewElement->GetGeometry().size(); ++n)
-                            std::cout << " " << pNewElement->GetGeometry()[n].Id();
-                        std::cout << std::endl;
-                        #endif
-                    }
-                }
-
-                // create and add conditions on the boundary
-                // TODO
-
-                // update the node counter
-                NodeCounter_old = NodeCounter;
-
-                // just to make sure everything is organized properly
-                r_model_part.Elements().Unique();
             }
             else if (TDim == 3)
             {
-                // create new nodes
-                typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find(it->Id());
-                if (it_num == mNumDivision.end())
-                    KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", it->Id())
-
                 std::size_t NumDivision1 = it_num->second[0];
                 std::size_t NumDivision2 = it_num->second[1];
                 std::size_t NumDivision3 = it_num->second[2];
@@ -223,57 +173,172 @@ public:
                         }
                     }
                 }
+            }
+
+            // create and add element
+            ComputeElementConnectivities(it_num->second, connectivities);
+            Element::NodesArrayType temp_element_nodes;
+            for (std::size_t c = 0; c < connectivities.size(); c += msNumberOfNodesPerElement)
+            {
+                // TODO: check if jacobian checking is necessary
+                temp_element_nodes.clear();
+                for (std::size_t n = 0; n < msNumberOfNodesPerElement; ++n)
+                    temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), NodeCounter_old + connectivities[c + n], NodeKey).base()));
+
+                Element::Pointer pNewElement = rCloneElement.Create(ElementCounter++, temp_element_nodes, pNewProperties);
+                r_model_part.AddElement(pNewElement);
+                #ifdef DEBUG_MESH_GENERATION
+                std::cout << "Element " << pNewElement->Id() << " is created with connectivity:";
+                for (std::size_t n = 0; n < pNewElement->GetGeometry().size(); ++n)
+                    std::cout << " " << pNewElement->GetGeometry()[n].Id();
+                std::cout << std::endl;
+                #endif
+            }
+
+            // create and add conditions on the boundary
+            // TODO
+
+            // update the node counter
+            NodeCounter_old = NodeCounter;
+
+            // just to make sure everything is organized properly
+            r_model_part.Elements().Unique();
+        }
+    }
+
+    /// Append to model_part, the quad/hex element from patches. This generates the same nodes and elements as WriteModelPart, but:
+    /// + the sample grid of a B-Splines/NURBS patch is evaluated at once by tensor-product basis tables (BSplinesPatchSampler)
+    /// + the nodes and elements are built into pre-sized vectors, the element connectivities are taken by index arithmetic
+    /// + the patches are processed in parallel, and the nodes and elements are inserted to the model_part at once
+    void WriteModelPartBulk(ModelPart& r_model_part) const
+    {
+        IsogeometricProfiler::ScopedTimer timer("NonConformingMultipatchLagrangeMesh::WriteModelPartBulk");
+
+        // get the sample element
+        Element const& rCloneElement = this->GetCloneElement();
+
+        // compute the node and element offsets of each patch, and create the properties
+        std::vector<typename Patch<TDim>::Pointer> patches;
+        std::vector<boost::array<std::size_t, TDim> > divisions;
+        std::vector<std::size_t> node_offsets(1, 0), element_offsets(1, 0);
+        std::vector<Properties::Pointer> properties;
+        std::size_t PropertiesCounter = mLastPropId;
+        for (typename MultiPatch<TDim>::PatchContainerType::ptr_iterator it = mpMultiPatch->Patches().ptr_begin();
+                it != mpMultiPatch->Patches().ptr_end(); ++it)
+        {
+            typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find((*it)->Id());
+            if (it_num == mNumDivision.end())
+                KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", (*it)->Id())
+
+            std::size_t number_of_nodes = 1, number_of_elements = 1;
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+            {
+                number_of_nodes *= it_num->second[dim] + 1;
+                number_of_elements *= it_num->second[dim];
+            }
 
-                // create and add element
-                Element::NodesArrayType temp_element_nodes;
-                for (std::size_t i = 0; i < NumDivision1; ++i)
+            patches.push_back(*it);
+            divisions.push_back(it_num->second);
+            node_offsets.push_back(node_offsets.back() + number_of_nodes);
+            element_offsets.push_back(element_offsets.back() + number_of_elements);
+
+            Properties::Pointer pNewProperties = Properties::Pointer(new Properties(PropertiesCounter++));
+            r_model_part.AddProperties(pNewProperties);
+            properties.push_back(pNewProperties);
+        }
+
+        std::vector<typename NodeType::Pointer> new_nodes(node_offsets.back());
+        std::vector<Element::Pointer> new_elements(element_offsets.back());
+
+        VariablesList* pVariablesList = &r_model_part.GetNodalSolutionStepVariablesList();
+        const std::size_t BufferSize = r_model_part.GetBufferSize();
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int ip = 0; ip < static_cast<int>(patches.size()); ++ip)
+        {
+            const Patch<TDim>& rPatch = *patches[ip];
+            const boost::array<std::size_t, TDim>& div = divisions[ip];
+
+            // the sample coordinates in each direction
+            std::vector<std::vector<double> > xi(TDim);
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+            {
+                xi[dim].resize(div[dim] + 1);
+                for (std::size_t i = 0; i <= div[dim]; ++i)
+                    xi[dim][i] = ((double) i) / div[dim];
+            }
+
+            typename BSplinesFESpace<TDim>::ConstPointer pBSplinesFESpace = boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >(rPatch.pFESpace());
+            boost::shared_ptr<BSplinesPatchSampler<TDim> > pSampler;
+            if (pBSplinesFESpace != NULL)
+                pSampler = boost::shared_ptr<BSplinesPatchSampler<TDim> >(new BSplinesPatchSampler<TDim>(pBSplinesFESpace, xi));
+
+            // the mapping from the sample point (first direction running fastest) to the node (last direction running fastest)
+            const std::size_t number_of_nodes = node_offsets[ip+1] - node_offsets[ip];
+            std::vector<std::size_t> node_index(number_of_nodes);
+            for (std::size_t s = 0; s < number_of_nodes; ++s)
+            {
+                std::size_t tmp = s, index = 0;
+                std::size_t loc[TDim];
+                for (std::size_t dim = 0; dim < TDim; ++dim)
                 {
-                    for (std::size_t j = 0; j < NumDivision2; ++j)
-                    {
-                        for (std::size_t k = 0; k < NumDivision3; ++k)
-                        {
-                            std::size_t Node1 = NodeCounter_old + (i * (NumDivision2 + 1) + j) * (NumDivision3 + 1) + k;
-                            std::size_t Node2 = NodeCounter_old + (i * (NumDivision2 + 1) + j + 1) * (NumDivision3 + 1) + k;
-                            std::size_t Node3 = NodeCounter_old + ((i + 1) * (NumDivision2 + 1) + j) * (NumDivision3 + 1) + k;
-                            std::size_t Node4 = NodeCounter_old + ((i + 1) * (NumDivision2 + 1) + j + 1) * (NumDivision3 + 1) + k;
-                            std::size_t Node5 = Node1 + 1;
-                            std::size_t Node6 = Node2 + 1;
-                            std::size_t Node7 = Node3 + 1;
-                            std::size_t Node8 = Node4 + 1;
-
-                            // TODO: check if jacobian checking is necessary
-                            temp_element_nodes.clear();
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node1, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node2, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node4, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node3, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node5, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node6, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node8, NodeKey).base()));
-                            temp_element_nodes.push_back(*(MultiPatchUtility::FindKey(r_model_part.Nodes(), Node7, NodeKey).base()));
-
-                            Element::Pointer pNewElement = rCloneElement.Create(ElementCounter++, temp_element_nodes, pNewProperties);
-                            r_model_part.AddElement(pNewElement);
-                            #ifdef DEBUG_MESH_GENERATION
-                            std::cout << "Element " << pNewElement->Id() << " is created with connectivity:";
-                            for (std::size_t n = 0; n < pNewElement->GetGeometry().size(); ++n)
-                                std::cout << " " << pNewElement->GetGeometry()[n].Id();
-                            std::cout << std::endl;
-                            #endif
-                        }
-                    }
+                    loc[dim] = tmp % (div[dim] + 1);
+                    tmp /= (div[dim] + 1);
                 }
+                for (std::size_t dim = 0; dim < TDim; ++dim)
+                    index = index * (div[dim] + 1) + loc[dim];
+                node_index[s] = index;
+            }
 
-                // create and add conditions on the boundary
-                // TODO
+            // create the nodes
+            std::vector<typename Patch<TDim>::ControlPointType> points;
+            this->SampleGridFunction(*rPatch.pControlPointGridFunction(), pSampler, xi, points);
+            for (std::size_t s = 0; s < number_of_nodes; ++s)
+            {
+                const std::size_t i = node_offsets[ip] + node_index[s];
+                typename NodeType::Pointer pNewNode = typename NodeType::Pointer(new NodeType(mLastNodeId + i, points[s].X(), points[s].Y(), points[s].Z()));
+                pNewNode->SetSolutionStepVariablesList(pVariablesList);
+                pNewNode->SetBufferSize(BufferSize);
+                new_nodes[i] = pNewNode;
+            }
 
-                // update the node counter
-                NodeCounter_old = NodeCounter;
+            // transfer the control values
+            this->TransferGridFunctions<double>(rPatch.DoubleGridFunctions(), pSampler, xi, new_nodes, node_offsets[ip], node_index);
+            this->TransferGridFunctions<array_1d<double, 3> >(rPatch.Array1DGridFunctions(), pSampler, xi, new_nodes, node_offsets[ip], node_index);
+            this->TransferGridFunctions<Vector>(rPatch.VectorGridFunctions(), pSampler, xi, new_nodes, node_offsets[ip], node_index);
+
+            // create the elements, with the same connectivities as WriteModelPart
+            typename NodeType::Pointer const* pNodes = &new_nodes[node_offsets[ip]];
+            std::vector<std::size_t> connectivities;
+            ComputeElementConnectivities(div, connectivities);
+            std::size_t e = element_offsets[ip];
+            Element::NodesArrayType temp_element_nodes;
+            for (std::size_t c = 0; c < connectivities.size(); c += msNumberOfNodesPerElement)
+            {
+                temp_element_nodes.clear();
+                for (std::size_t n = 0; n < msNumberOfNodesPerElement; ++n)
+                    temp_element_nodes.push_back(pNodes[connectivities[c + n]]);
 
-                // just to make sure everything is organized properly
-                r_model_part.Elements().Unique();
+                new_elements[e] = rCloneElement.Create(mLastElemId + e, temp_element_nodes, properties[ip]);
+                ++e;
             }
         }
+
+        // insert the nodes and elements at once
+        ModelPart::NodesContainerType& rNodes = r_model_part.Nodes();
+        rNodes.reserve(rNodes.size() + new_nodes.size());
+        for (std::size_t i = 0; i < new_nodes.size(); ++i)
+            rNodes.push_back(new_nodes[i]);
+        rNodes.Unique();
+
+        ModelPart::ElementsContainerType& rElements = r_model_part.Elements();
+        rElements.reserve(rElements.size() + new_elements.size());
+        for (std::size_t i = 0; i < new_elements.size(); ++i)
+            rElements.push_back(new_elements[i]);
+        rElements.Unique();
+
+        IsogeometricProfiler::AddCount("NonConformingMultipatchLagrangeMesh::WriteModelPartBulk::Nodes", new_nodes.size());
+        IsogeometricProfiler::AddCount("NonConformingMultipatchLagrangeMesh::WriteModelPartBulk::Elements", new_elements.size());
     }
 
     /// Information
@@ -297,6 +362,140 @@ private:
     std::size_t mLastElemId;
     std::size_t mLastPropId;
 
+    /// Number of nodes of the quad/hex element
+    static const std::size_t msNumberOfNodesPerElement = (TDim == 2) ? 4 : 8;
+
+    /// Get the sample element, i.e. the base element name appended by 2D4N/3D8N
+    Element const& GetCloneElement() const
+    {
+        std::string element_name = mBaseElementName;
+        if (TDim == 2)
+            element_name = element_name + "2D4N";
+        else if (TDim == 3)
+            element_name = element_name + "3D8N";
+
+        if(!KratosComponents<Element>::Has(element_name))
+        {
+            std::stringstream buffer;
+            buffer << "Element " << element_name << " is not registered in Kratos.";
+            buffer << " Please check the spelling of the element name and see if the application which containing it, is registered corectly.";
+            KRATOS_THROW_ERROR(std::runtime_error, buffer.str(), "");
+        }
+
+        return KratosComponents<Element>::Get(element_name);
+    }
+
+    /// Compute the connectivities of the quad/hex elements of a patch with the given divisions, in the order of creation.
+    /// The indices are local to the patch, whose nodes are ordered with the last direction running fastest.
+    static void ComputeElementConnectivities(const boost::array<std::size_t, TDim>& div, std::vector<std::size_t>& rConnectivities)
+    {
+        rConnectivities.clear();
+        if (TDim == 2)
+        {
+            rConnectivities.reserve(4 * div[0] * div[1]);
+            for (std::size_t i = 0; i < div[0]; ++i)
+            {
+                for (std::size_t j = 0; j < div[1]; ++j)
+                {
+                    std::size_t Node1 = i * (div[1] + 1) + j;
+                    std::size_t Node2 = Node1 + 1;
+                    std::size_t Node3 = Node1 + div[1] + 1;
+                    std::size_t Node4 = Node3 + 1;
+
+                    rConnectivities.push_back(Node1);
+                    rConnectivities.push_back(Node2);
+                    rConnectivities.push_back(Node4);
+                    rConnectivities.push_back(Node3);
+                }
+            }
+        }
+        else if (TDim == 3)
+        {
+            const std::size_t stride = div[TDim-1] + 1;
+            rConnectivities.reserve(8 * div[0] * div[1] * div[TDim-1]);
+            for (std::size_t i = 0; i < div[0]; ++i)
+            {
+                for (std::size_t j = 0; j < div[1]; ++j)
+                {
+                    for (std::size_t k = 0; k < div[TDim-1]; ++k)
+                    {
+                        std::size_t Node1 = (i * (div[1] + 1) + j) * stride + k;
+                        std::size_t Node2 = (i * (div[1] + 1) + j + 1) * stride + k;
+                        std::size_t Node3 = ((i + 1) * (div[1] + 1) + j) * stride + k;
+                        std::size_t Node4 = ((i + 1) * (div[1] + 1) + j + 1) * stride + k;
+
+                        rConnectivities.push_back(Node1);
+                        rConnectivities.push_back(Node2);
+                        rConnectivities.push_back(Node4);
+                        rConnectivities.push_back(Node3);
+                        rConnectivities.push_back(Node1 + 1);
+                        rConnectivities.push_back(Node2 + 1);
+                        rConnectivities.push_back(Node4 + 1);
+                        rConnectivities.push_back(Node3 + 1);
+                    }
+                }
+            }
+        }
+    }
+
+    /// Evaluate a grid function at the sample grid; the sample points are ordered with the first direction running fastest.
+    /// The tensor-product basis tables are used for B-Splines/NURBS patches, otherwise the grid function is evaluated point by point.
+    template<typename TDataType>
+    static void SampleGridFunction(const GridFunction<TDim, TDataType>& rGridFunction, boost::shared_ptr<BSplinesPatchSampler<TDim> > pSampler,
+            const std::vector<std::vector<double> >& xi, std::vector<TDataType>& rValues)
+    {
+        if (pSampler != NULL)
+        {
+            // the rational grid functions are defined on the WeightedFESpace
+            typename WeightedFESpace<TDim>::ConstPointer pWeightedFESpace = boost::dynamic_pointer_cast<const WeightedFESpace<TDim> >(rGridFunction.pFESpace());
+            if (pWeightedFESpace != NULL)
+                pSampler->Sample(rValues, *rGridFunction.pControlGrid(), pWeightedFESpace->Weights());
+            else
+                pSampler->Sample(rValues, *rGridFunction.pControlGrid(), std::vector<double>());
+            return;
+        }
+
+        std::size_t npoints = 1;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            npoints *= xi[dim].size();
+
+        rValues.resize(npoints);
+        std::vector<double> p_ref(TDim);
+        for (std::size_t s = 0; s < npoints; ++s)
+        {
+            std::size_t tmp = s;
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+            {
+                p_ref[dim] = xi[dim][tmp % xi[dim].size()];
+                tmp /= xi[dim].size();
+            }
+            rValues[s] = rGridFunction.GetValue(p_ref);
+        }
+    }
+
+    /// Transfer the values of the grid functions to the nodes of a patch
+    template<typename TDataType, class TGridFunctionContainerType>
+    static void TransferGridFunctions(const TGridFunctionContainerType& rGridFunctions, boost::shared_ptr<BSplinesPatchSampler<TDim> > pSampler,
+            const std::vector<std::vector<double> >& xi, std::vector<typename NodeType::Pointer>& rNodes,
+            const std::size_t& offset, const std::vector<std::size_t>& node_index)
+    {
+        typedef Variable<TDataType> VariableType;
+
+        std::vector<TDataType> values;
+        for (typename TGridFunctionContainerType::const_iterator it_gf = rGridFunctions.begin();
+                it_gf != rGridFunctions.end(); ++it_gf)
+        {
+            const std::string& var_name = (*it_gf)->pControlGrid()->Name();
+            if (!KratosComponents<VariableData>::Has(var_name))
+                continue;
+
+            VariableType* pVariable = dynamic_cast<VariableType*>(&KratosComponents<VariableData>::Get(var_name));
+            SampleGridFunction(**it_gf, pSampler, xi, values);
+            for (std::size_t s = 0; s < values.size(); ++s)
+                rNodes[offset + node_index[s]]->GetSolutionStepValue(*pVariable) = values[s];
+        }
+    }
+
     /// Helper function to create new node from patch and add to the model_part. The control values will be carried.
     void CreateNode(const std::vector<double>& p_ref, const Patch<TDim>& rPatch, ModelPart& r_model_part, const std::size_t& NodeCounter) const
     {
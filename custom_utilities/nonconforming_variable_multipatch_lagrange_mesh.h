@@ -11,6 +11,7 @@
 
 // System includes
 #include <vector>
+#include <map>
 
 // External includes
 
@@ -20,6 +21,9 @@
 #include "custom_utilities/control_point.h"
 #include "custom_utilities/grid_function.h"
 #include "custom_utilities/fespace.h"
+#include "custom_utilities/weighted_fespace.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/nurbs/bsplines_patch_sampler.h"
 #include "custom_utilities/patch.h"
 #include "custom_utilities/multipatch_utility.h"
 
@@ -114,6 +118,9 @@ public:
 
         Element const& rCloneElement = KratosComponents<Element>::Get(element_name);
 
+        // the nodes are regenerated, hence the transfer operators are recomputed at the next transfer
+        mTransferOperators.clear();
+
         // generate nodes and elements for each patch
         std::size_t NodeCounter = mLastNodeId;
         std::size_t NodeCounter_old = NodeCounter;
@@ -290,9 +297,14 @@ public:
 
     /// Transfer the variable from the multipatch to the model_part
     /// This function allows to input a different multipatch than the one used to generate the model_part. User must keep track with the compatibility.
+    /// The sparse evaluation operator from the control values to the nodes of each patch is computed at the first call and reused
+    /// as long as the FESpace and the weights of the patch are unchanged. The patches are transferred in parallel.
     template<typename TVariableType>
     void TransferVariables(const TVariableType& rVariable, typename MultiPatch<TDim>::Pointer pMultiPatch) const
     {
+        typedef typename TVariableType::Type DataType;
+        typedef typename GridFunction<TDim, DataType>::Pointer GridFunctionPointerType;
+
         if (pMultiPatch != mpMultiPatch)
         {
             std::cout << "WARNING: the input multipatch is the same as the underlying multipatch in NonConformingVariableMultipatchLagrangeMesh."
@@ -300,83 +312,72 @@ public:
                       << std::endl;
         }
 
-        std::string NodeKey = std::string("Node");
-
-        // get nodes sequentially, with the same sequence as when creating it
+        // collect the grid functions and the first node of each patch, with the same sequence as when creating the nodes
+        std::vector<GridFunctionPointerType> grid_functions;
+        std::vector<TransferOperator*> operators;
         std::size_t NodeCounter = mLastNodeId;
-        std::vector<double> p_ref(TDim);
         for (typename MultiPatch<TDim>::PatchContainerType::iterator it = pMultiPatch->begin();
                 it != pMultiPatch->end(); ++it)
         {
-            typename GridFunction<TDim, typename TVariableType::Type>::Pointer pGridFunction = it->pGetGridFunction(rVariable);
+            typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find(it->Id());
+            if (it_num == mNumDivision.end())
+                KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", it->Id())
 
-            if (TDim == 2)
+            grid_functions.push_back(it->pGetGridFunction(rVariable));
+
+            TransferOperator& rOperator = mTransferOperators[it->Id()];
+            if (rOperator.Divisions != it_num->second)
             {
-                // get nodes nodes
-                typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find(it->Id());
-                if (it_num == mNumDivision.end())
-                    KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", it->Id())
+                rOperator.Divisions = it_num->second;
+                rOperator.pFESpace = typename FESpace<TDim>::ConstPointer();
+            }
+            operators.push_back(&rOperator);
 
-                std::size_t NumDivision1 = it_num->second[0];
-                std::size_t NumDivision2 = it_num->second[1];
-                #ifdef DEBUG_MESH_GENERATION
-                KRATOS_WATCH(NumDivision1)
-                KRATOS_WATCH(NumDivision2)
-                #endif
+            std::size_t nnodes = 1;
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+                nnodes *= (it_num->second[dim] + 1);
 
-                for (std::size_t i = 0; i <= NumDivision1; ++i)
-                {
-                    p_ref[0] = ((double) i) / NumDivision1;
-                    for (std::size_t j = 0; j <= NumDivision2; ++j)
-                    {
-                        p_ref[1] = ((double) j) / NumDivision2;
+            // get the nodes once; the lookup is not done in the parallel region since it may sort the node container
+            if (rOperator.Nodes.size() != nnodes || (nnodes != 0 && rOperator.Nodes[0]->Id() != NodeCounter))
+            {
+                rOperator.Nodes.resize(nnodes);
+                for (std::size_t n = 0; n < nnodes; ++n)
+                    rOperator.Nodes[n] = mpModelPart->pGetNode(NodeCounter + n);
+            }
 
-                        #ifdef DEBUG_MESH_GENERATION
-                        std::cout << "p_ref: " << p_ref[0] << " " << p_ref[1] << std::endl;
-                        #endif
+            NodeCounter += nnodes;
+        }
 
-                        NodeType::Pointer pNode = mpModelPart->pGetNode(NodeCounter);
-                        typename TVariableType::Type value = pGridFunction->GetValue(p_ref);
-                        pNode->GetSolutionStepValue(rVariable) = value;
-                        ++NodeCounter;
-                    }
+        std::string error_message;
+        #pragma omp parallel for schedule(dynamic)
+        for (int ip = 0; ip < static_cast<int>(grid_functions.size()); ++ip)
+        {
+            try
+            {
+                TransferOperator& rOperator = *operators[ip];
+                this->UpdateTransferOperator(rOperator, grid_functions[ip]->pFESpace());
+
+                const ControlGrid<DataType>& r_control_grid = *(grid_functions[ip]->pControlGrid());
+                for (std::size_t n = 0; n < rOperator.Nodes.size(); ++n)
+                {
+                    std::size_t s = rOperator.RowPtr[n];
+                    DataType value = rOperator.Values[s] * r_control_grid.GetData(rOperator.Columns[s]);
+                    for (++s; s < rOperator.RowPtr[n+1]; ++s)
+                        value += rOperator.Values[s] * r_control_grid.GetData(rOperator.Columns[s]);
+                    rOperator.Nodes[n]->GetSolutionStepValue(rVariable) = value;
                 }
             }
-            else if (TDim == 3)
+            catch (std::exception& e)
             {
-                // create new nodes
-                typename std::map<std::size_t, boost::array<std::size_t, TDim> >::const_iterator it_num = mNumDivision.find(it->Id());
-                if (it_num == mNumDivision.end())
-                    KRATOS_THROW_ERROR(std::logic_error, "NumDivision is not set for patch", it->Id())
-
-                std::size_t NumDivision1 = it_num->second[0];
-                std::size_t NumDivision2 = it_num->second[1];
-                std::size_t NumDivision3 = it_num->second[2];
-                #ifdef DEBUG_MESH_GENERATION
-                KRATOS_WATCH(NumDivision1)
-                KRATOS_WATCH(NumDivision2)
-                KRATOS_WATCH(NumDivision3)
-                #endif
-
-                for (std::size_t i = 0; i <= NumDivision1; ++i)
+                #pragma omp critical
                 {
-                    p_ref[0] = ((double) i) / NumDivision1;
-                    for (std::size_t j = 0; j <= NumDivision2; ++j)
-                    {
-                        p_ref[1] = ((double) j) / NumDivision2;
-                        for (std::size_t k = 0; k <= NumDivision3; ++k)
-                        {
-                            p_ref[2] = ((double) k) / NumDivision3;
-
-                            NodeType::Pointer pNode = mpModelPart->pGetNode(NodeCounter);
-                            typename TVariableType::Type value = pGridFunction->GetValue(p_ref);
-                            pNode->GetSolutionStepValue(rVariable) = value;
-                            ++NodeCounter;
-                        }
-                    }
+                    if (error_message.empty())
+                        error_message = e.what();
                 }
             }
         }
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::logic_error, "Error transferring the variable", error_message)
     }
 
 
@@ -403,6 +404,113 @@ private:
     std::size_t mLastElemId;
     std::size_t mLastPropId;
 
+    /// Sparse evaluation operator from the control values of a patch to its nodes, stored row-wise, and the nodes of the patch
+    struct TransferOperator
+    {
+        boost::array<std::size_t, TDim> Divisions;
+        typename FESpace<TDim>::ConstPointer pFESpace; // the unweighted FESpace the operator was computed for
+        std::size_t NumberOfFunctions; // the number of basis functions of the FESpace, which changes if it is refined in place (e.g. HB-Splines)
+        std::vector<double> Weights;
+        std::vector<std::size_t> RowPtr;
+        std::vector<std::size_t> Columns;
+        std::vector<double> Values;
+        std::vector<NodeType::Pointer> Nodes;
+    };
+
+    mutable std::map<std::size_t, TransferOperator> mTransferOperators;
+
+    /// Compute the evaluation operator of the grid functions defined on pFESpace, if it is not yet computed or the FESpace has changed,
+    /// i.e. it is another FESpace, it has other weights or it has been refined in place.
+    /// For B-Splines, the basis functions are tabulated in each direction by BSplinesPatchSampler. Otherwise, the basis functions
+    /// are evaluated at each node and the zero values are discarded.
+    void UpdateTransferOperator(TransferOperator& rOperator, typename FESpace<TDim>::ConstPointer pFESpace) const
+    {
+        typename FESpace<TDim>::ConstPointer pBaseFESpace = pFESpace;
+        std::vector<double> weights;
+        if (pFESpace->Type() == WeightedFESpace<TDim>::StaticType())
+        {
+            typename WeightedFESpace<TDim>::ConstPointer pWeightedFESpace = boost::dynamic_pointer_cast<const WeightedFESpace<TDim> >(pFESpace);
+            pBaseFESpace = pWeightedFESpace->pFESpace();
+            weights = pWeightedFESpace->Weights();
+        }
+
+        std::size_t nnodes = 1;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            nnodes *= (rOperator.Divisions[dim] + 1);
+
+        if (rOperator.pFESpace == pBaseFESpace && rOperator.NumberOfFunctions == pBaseFESpace->TotalNumber()
+                && rOperator.Weights == weights && rOperator.RowPtr.size() == nnodes + 1)
+            return;
+
+        rOperator.pFESpace = pBaseFESpace;
+        rOperator.NumberOfFunctions = pBaseFESpace->TotalNumber();
+        rOperator.Weights = weights;
+        rOperator.RowPtr.resize(nnodes + 1);
+        rOperator.Columns.clear();
+        rOperator.Values.clear();
+
+        std::vector<std::vector<double> > coordinates(TDim);
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            coordinates[dim].resize(rOperator.Divisions[dim] + 1);
+            for (std::size_t i = 0; i <= rOperator.Divisions[dim]; ++i)
+                coordinates[dim][i] = ((double) i) / rOperator.Divisions[dim];
+        }
+
+        boost::shared_ptr<BSplinesPatchSampler<TDim> > pSampler;
+        if (pBaseFESpace->Type() == BSplinesFESpace<TDim>::StaticType())
+            pSampler = boost::shared_ptr<BSplinesPatchSampler<TDim> >(new BSplinesPatchSampler<TDim>(
+                    boost::dynamic_pointer_cast<const BSplinesFESpace<TDim> >(pBaseFESpace), coordinates));
+
+        std::vector<std::size_t> indices;
+        std::vector<double> values, p_ref(TDim);
+        std::size_t loc[TDim];
+        rOperator.RowPtr[0] = 0;
+        for (std::size_t n = 0; n < nnodes; ++n)
+        {
+            // the nodes are numbered with the last parametric direction running fastest
+            std::size_t tmp = n;
+            for (int dim = TDim-1; dim >= 0; --dim)
+            {
+                loc[dim] = tmp % (rOperator.Divisions[dim] + 1);
+                tmp /= (rOperator.Divisions[dim] + 1);
+            }
+
+            if (pSampler != NULL)
+            {
+                // the sample points are numbered with the first parametric direction running fastest
+                std::size_t point = 0;
+                for (int dim = TDim-1; dim >= 0; --dim)
+                    point = point * (rOperator.Divisions[dim] + 1) + loc[dim];
+                pSampler->GetSupport(point, indices, values, weights);
+                rOperator.Columns.insert(rOperator.Columns.end(), indices.begin(), indices.end());
+                rOperator.Values.insert(rOperator.Values.end(), values.begin(), values.end());
+            }
+            else
+            {
+                for (std::size_t dim = 0; dim < TDim; ++dim)
+                    p_ref[dim] = coordinates[dim][loc[dim]];
+                values = pFESpace->GetValue(p_ref);
+                for (std::size_t i = 0; i < values.size(); ++i)
+                {
+                    if (values[i] != 0.0)
+                    {
+                        rOperator.Columns.push_back(i);
+                        rOperator.Values.push_back(values[i]);
+                    }
+                }
+                if (rOperator.Columns.size() == rOperator.RowPtr[n])
+                {
+                    // keep at least one entry per row
+                    rOperator.Columns.push_back(0);
+                    rOperator.Values.push_back(0.0);
+                }
+            }
+
+            rOperator.RowPtr[n+1] = rOperator.Columns.size();
+        }
+    }
+
     /// Helper function to create new node from patch and add to the model_part. The control values will be carried.
     void CreateNode(const std::vector<double>& p_ref,
         const Patch<TDim>& rPatch,
@@ -0,0 +1,246 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_BSPLINES_PATCH_SAMPLER_H_INCLUDED)
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_BSPLINES_PATCH_SAMPLER_H_INCLUDED
+
+// System includes
+#include <vector>
+
+// External includes
+#include <omp.h>
+
+// Project includes
+#include "includes/define.h"
+#include "custom_utilities/bspline_utils.h"
+#include "custom_utilities/control_grid.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+
+namespace Kratos
+{
+
+/**
+Evaluate the control values of a B-Splines/NURBS patch on a uniform grid of parametric points.
+The non-zero basis functions in each direction are tabulated once per sample coordinate, hence the evaluation
+of one point only touches the (p1+1)x(p2+1)x(p3+1) supported control values, instead of the full basis vector
+as in GridFunction::GetValue. The sample points are ordered with the first parametric direction running fastest.
+ */
+template<int TDim>
+class BSplinesPatchSampler
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(BSplinesPatchSampler);
+
+    /// Type definition
+    typedef BSplinesFESpace<TDim> BSplinesFESpaceType;
+
+    /// Constructor with the number of divisions in each direction. The number of divisions must be positive.
+    BSplinesPatchSampler(typename BSplinesFESpaceType::ConstPointer pFESpace, const std::vector<std::size_t>& divisions)
+    {
+        if (divisions.size() < TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The number of divisions must be given for each dimension", "")
+
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            if (divisions[dim] == 0)
+                KRATOS_THROW_ERROR(std::logic_error, "The number of divisions must be positive, dimension", dim)
+
+            std::vector<double> xi(divisions[dim] + 1);
+            const double a = pFESpace->KnotVector(dim)[pFESpace->Order(dim)];
+            const double b = pFESpace->KnotVector(dim)[pFESpace->Number(dim)];
+            for (std::size_t k = 0; k < divisions[dim]; ++k)
+                xi[k] = a + (b - a) * static_cast<double>(k) / divisions[dim];
+            xi[divisions[dim]] = b; // avoid the round-off beyond the end of the knot vector
+            this->Initialize(dim, pFESpace, xi);
+        }
+    }
+
+    /// Constructor with the sample coordinates in each direction. The coordinates must lie in [U[p], U[n]].
+    BSplinesPatchSampler(typename BSplinesFESpaceType::ConstPointer pFESpace, const std::vector<std::vector<double> >& coordinates)
+    {
+        if (coordinates.size() < TDim)
+            KRATOS_THROW_ERROR(std::logic_error, "The sample coordinates must be given for each dimension", "")
+
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            this->Initialize(dim, pFESpace, coordinates[dim]);
+    }
+
+    /// Destructor
+    virtual ~BSplinesPatchSampler() {}
+
+    /// Get the number of sample points in direction dim
+    std::size_t NumberOfPoints(const std::size_t& dim) const {return mCoordinates[dim].size();}
+
+    /// Get the total number of sample points
+    std::size_t NumberOfPoints() const
+    {
+        std::size_t n = 1;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            n *= mCoordinates[dim].size();
+        return n;
+    }
+
+    /// Get the sample coordinates in direction dim
+    const std::vector<double>& Coordinates(const std::size_t& dim) const {return mCoordinates[dim];}
+
+    /// Get the local coordinates of the sample point
+    void LocalCoordinates(const std::size_t& point, std::vector<double>& xi) const
+    {
+        std::size_t loc[TDim];
+        this->Decode(point, loc);
+        xi.resize(TDim);
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            xi[dim] = mCoordinates[dim][loc[dim]];
+    }
+
+    /// Get the non-zero basis functions at a sample point. The indices are the local indices in the control grid.
+    /// If the weights are provided, the rational basis functions are computed.
+    void GetSupport(const std::size_t& point, std::vector<std::size_t>& rIndices, std::vector<double>& rValues,
+            const std::vector<double>& rWeights) const
+    {
+        std::size_t loc[TDim];
+        this->Decode(point, loc);
+
+        std::size_t nsupport = 1;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+            nsupport *= (mOrders[dim] + 1);
+
+        rIndices.resize(nsupport);
+        rValues.resize(nsupport);
+
+        std::size_t a[TDim];
+        for (std::size_t s = 0; s < nsupport; ++s)
+        {
+            std::size_t tmp = s;
+            std::size_t index = 0, stride = 1;
+            double N = 1.0;
+            for (std::size_t dim = 0; dim < TDim; ++dim)
+            {
+                a[dim] = tmp % (mOrders[dim] + 1);
+                tmp /= (mOrders[dim] + 1);
+                index += (mSpans[dim][loc[dim]] - mOrders[dim] + a[dim]) * stride;
+                stride *= mNumbers[dim];
+                N *= mValues[dim][loc[dim] * (mOrders[dim] + 1) + a[dim]];
+            }
+            rIndices[s] = index;
+            rValues[s] = N;
+        }
+
+        if (rWeights.size() != 0)
+        {
+            double W = 0.0;
+            for (std::size_t s = 0; s < nsupport; ++s)
+            {
+                rValues[s] *= rWeights[rIndices[s]];
+                W += rValues[s];
+            }
+            for (std::size_t s = 0; s < nsupport; ++s)
+                rValues[s] /= W;
+        }
+    }
+
+    /// Evaluate the control grid at all sample points. If the weights are provided, the rational basis functions are used.
+    /// For the control points, the weights shall not be provided, since the control points are stored in homogeneous coordinates.
+    template<typename TDataType>
+    void Sample(std::vector<TDataType>& rResults, const ControlGrid<TDataType>& rControlGrid, const std::vector<double>& rWeights) const
+    {
+        const std::size_t npoints = this->NumberOfPoints();
+        rResults.resize(npoints);
+
+        #pragma omp parallel
+        {
+            std::vector<std::size_t> indices;
+            std::vector<double> values;
+
+            #pragma omp for
+            for (int i = 0; i < static_cast<int>(npoints); ++i)
+            {
+                this->GetSupport(i, indices, values, rWeights);
+                TDataType v = values[0] * rControlGrid.GetData(indices[0]);
+                for (std::size_t s = 1; s < indices.size(); ++s)
+                    v += values[s] * rControlGrid.GetData(indices[s]);
+                rResults[i] = v;
+            }
+        }
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "BSplinesPatchSampler" << TDim << "D, number of points = " << NumberOfPoints();
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+    }
+
+private:
+
+    std::size_t mOrders[TDim];
+    std::size_t mNumbers[TDim];
+    std::vector<double> mCoordinates[TDim];
+    std::vector<int> mSpans[TDim];
+    std::vector<double> mValues[TDim]; // (p+1) values per sample coordinate
+
+    /// Tabulate the spans and non-zero basis functions in one direction
+    void Initialize(const std::size_t& dim, typename BSplinesFESpaceType::ConstPointer pFESpace, const std::vector<double>& xi)
+    {
+        mOrders[dim] = pFESpace->Order(dim);
+        mNumbers[dim] = pFESpace->Number(dim);
+        mCoordinates[dim] = xi;
+
+        // copy out the knot values to avoid the indirection through knot pointers
+        std::vector<double> knots(pFESpace->KnotVector(dim).size());
+        for (std::size_t i = 0; i < knots.size(); ++i)
+            knots[i] = pFESpace->KnotVector(dim)[i];
+
+        const std::size_t p = mOrders[dim];
+        const double a = knots[p];
+        const double b = knots[mNumbers[dim]];
+        for (std::size_t k = 0; k < xi.size(); ++k)
+            if (xi[k] < a || xi[k] > b)
+                KRATOS_THROW_ERROR(std::logic_error, "The sample coordinate is out of the parametric domain of the patch:", xi[k])
+
+        mSpans[dim].resize(xi.size());
+        mValues[dim].resize(xi.size() * (p + 1));
+        std::vector<double> N(p + 1);
+        for (std::size_t k = 0; k < xi.size(); ++k)
+        {
+            mSpans[dim][k] = BSplineUtils::FindSpan(mNumbers[dim], p, xi[k], knots);
+            BSplineUtils::BasisFuns(N, mSpans[dim][k], xi[k], p, knots);
+            std::copy(N.begin(), N.end(), mValues[dim].begin() + k * (p + 1));
+        }
+    }
+
+    /// Compute the multi-index of the sample point
+    void Decode(const std::size_t& point, std::size_t* loc) const
+    {
+        std::size_t tmp = point;
+        for (std::size_t dim = 0; dim < TDim; ++dim)
+        {
+            loc[dim] = tmp % mCoordinates[dim].size();
+            tmp /= mCoordinates[dim].size();
+        }
+    }
+
+};
+
+/// output stream function
+template<int TDim>
+inline std::ostream& operator <<(std::ostream& rOStream, const BSplinesPatchSampler<TDim>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << std::endl;
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+} // namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_BSPLINES_PATCH_SAMPLER_H_INCLUDED defined
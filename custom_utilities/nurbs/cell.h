@@ -15,7 +15,7 @@
 #include <iostream>
 
 // External includes
-#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
 
 // Project includes
 #include "includes/define.h"
@@ -46,22 +46,21 @@ public:
     /// Type definitions
     typedef Knot<double> KnotType;
     typedef KnotType::Pointer knot_t;
-    typedef boost::numeric::ublas::mapped_vector<double> SparseVectorType;
-    // typedef boost::numeric::ublas::vector<double> SparseVectorType;
+    typedef unsigned int IndexType;
 
     /// Constructor with knots
     Cell(const std::size_t& Id, knot_t pLeft, knot_t pRight)
-    : mId(Id), mpLeft(pLeft), mpRight(pRight), mpUp(new KnotType(0.0)), mpDown(new KnotType(0.0)), mpAbove(new KnotType(0.0)), mpBelow(new KnotType(0.0))
+    : mId(Id), mpLeft(pLeft), mpRight(pRight), mpUp(new KnotType(0.0)), mpDown(new KnotType(0.0)), mpAbove(new KnotType(0.0)), mpBelow(new KnotType(0.0)), mNumberOfColumns(0)
     {}
 
     /// Constructor with knots
     Cell(const std::size_t& Id, knot_t pLeft, knot_t pRight, knot_t pDown, knot_t pUp)
-    : mId(Id), mpLeft(pLeft), mpRight(pRight), mpUp(pUp), mpDown(pDown), mpAbove(new KnotType(0.0)), mpBelow(new KnotType(0.0))
+    : mId(Id), mpLeft(pLeft), mpRight(pRight), mpUp(pUp), mpDown(pDown), mpAbove(new KnotType(0.0)), mpBelow(new KnotType(0.0)), mNumberOfColumns(0)
     {}
 
     /// Constructor with knots
     Cell(const std::size_t& Id, knot_t pLeft, knot_t pRight, knot_t pDown, knot_t pUp, knot_t pBelow, knot_t pAbove)
-    : mId(Id), mpLeft(pLeft), mpRight(pRight), mpUp(pUp), mpDown(pDown), mpAbove(pAbove), mpBelow(pBelow)
+    : mId(Id), mpLeft(pLeft), mpRight(pRight), mpUp(pUp), mpDown(pDown), mpAbove(pAbove), mpBelow(pBelow), mNumberOfColumns(0)
     {}
 
     /// Destructor
@@ -197,24 +196,56 @@ public:
     {
         mSupportedAnchors.clear();
         mAnchorWeights.clear();
-        mCrows.clear();
+        mCrowPtr.clear();
+        mCcolInd.clear();
+        mCvalues.clear();
+        mNumberOfColumns = 0;
+    }
+
+    /// Reserve the internal storage for a number of anchors and total number of non-zeros of the extraction operator.
+    /// It is optional, but it avoids the reallocation when the sizes are known in advance.
+    void Reserve(const std::size_t& NumberOfAnchors, const std::size_t& NumberOfNonZeros)
+    {
+        mSupportedAnchors.reserve(NumberOfAnchors);
+        mAnchorWeights.reserve(NumberOfAnchors);
+        mCrowPtr.reserve(NumberOfAnchors + 1);
+        mCcolInd.reserve(NumberOfNonZeros);
+        mCvalues.reserve(NumberOfNonZeros);
     }
 
     /// Add supported anchor and the respective extraction operator of this cell to the anchor
-    void AddAnchor(const unsigned int& Id, const double& W, const Vector& Crow)
+    /// The non-zeros of the extraction operator row are appended to the CSR block of the cell.
+    template<class TVectorType>
+    void AddAnchor(const unsigned int& Id, const double& W, const TVectorType& Crow)
     {
+        if (mCrowPtr.empty())
+        {
+            mNumberOfColumns = Crow.size();
+            mCrowPtr.push_back(0);
+        }
+        else if (Crow.size() != mNumberOfColumns)
+            KRATOS_THROW_ERROR(std::logic_error, "The size of the extraction operator row is incompatible:", Crow.size())
+
         mSupportedAnchors.push_back(Id);
         mAnchorWeights.push_back(W);
 
-        std::vector<std::size_t> inz;
-        inz.reserve(Crow.size());
         for (std::size_t i = 0; i < Crow.size(); ++i)
-            if (Crow[i] != 0.0)
-                inz.push_back(i);
-        SparseVectorType Crow_sparse(Crow.size(), inz.size());
-        for (std::size_t i = 0; i < inz.size(); ++i)
-            Crow_sparse[inz[i]] = Crow[inz[i]];
-        mCrows.push_back(Crow_sparse);
+        {
+            const double v = Crow[i];
+            if (v != 0.0)
+            {
+                mCcolInd.push_back(static_cast<IndexType>(i));
+                mCvalues.push_back(v);
+            }
+        }
+        mCrowPtr.push_back(static_cast<IndexType>(mCvalues.size()));
+    }
+
+    /// Change the id and weight of the i-th supported anchor, keeping its row of the extraction operator
+    void SetAnchor(const std::size_t& i, const unsigned int& Id, const double& W)
+    {
+        mSupportedAnchors[i] = Id;
+        mAnchorWeights[i] = W;
     }
 
     /// Get the number of supported anchors of this cell. In the other language, it is the number of basis functions that the support domain includes this cell.
@@ -232,46 +263,83 @@ public:
         std::copy(mAnchorWeights.begin(), mAnchorWeights.end(), rWeights.begin());
     }
 
+    /// Get the number of columns of the extraction operator, i.e. the number of Bernstein basis functions on the cell
+    std::size_t NumberOfExtractionColumns() const {return mNumberOfColumns;}
+
+    /// Get the number of non-zeros of the extraction operator
+    std::size_t NumberOfExtractionNonZeros() const {return mCvalues.size();}
+
+    /// Get the row pointers of the extraction operator in CSR format (size NumberOfAnchors() + 1, or empty if there is no anchor)
+    const std::vector<IndexType>& ExtractionRowPointers() const {return mCrowPtr;}
+
+    /// Get the column indices of the extraction operator in CSR format
+    const std::vector<IndexType>& ExtractionColumnIndices() const {return mCcolInd;}
+
+    /// Get the non-zero values of the extraction operator in CSR format
+    const std::vector<double>& ExtractionValues() const {return mCvalues;}
+
     /// Get the extraction operator matrix
     Matrix GetExtractionOperator() const
     {
         Matrix M;
-        M.resize(mCrows.size(), mCrows[0].size());
-        for(std::size_t i = 0; i < mCrows.size(); ++i)
-            noalias(row(M, i)) = mCrows[i];
+        GetExtractionOperator(M);
         return M;
     }
 
+    /// Get the extraction operator matrix. The matrix is only resized if needed, hence it can be reused between cells.
+    void GetExtractionOperator(Matrix& rM) const
+    {
+        const std::size_t nrows = NumberOfAnchors();
+        if (rM.size1() != nrows || rM.size2() != mNumberOfColumns)
+            rM.resize(nrows, mNumberOfColumns, false);
+        noalias(rM) = ZeroMatrix(nrows, mNumberOfColumns);
+        for (std::size_t i = 0; i < nrows; ++i)
+            for (IndexType k = mCrowPtr[i]; k < mCrowPtr[i+1]; ++k)
+                rM(i, mCcolInd[k]) = mCvalues[k];
+    }
+
     /// Get the extraction as compressed matrix
     CompressedMatrix GetCompressedExtractionOperator() const
     {
-        CompressedMatrix M;
-        M.resize(mCrows.size(), mCrows[0].size());
-        // here we just naively copy the data. However we shall initialize the compressed matrix properly as in the kernel (TODO)
-        for(std::size_t i = 0; i < mCrows.size(); ++i)
-            noalias(row(M, i)) = mCrows[i];
+        const std::size_t nrows = NumberOfAnchors();
+        CompressedMatrix M(nrows, mNumberOfColumns, mCvalues.size());
+        // the non-zeros are stored row by row with increasing column index, hence they can be pushed back directly
+        for (std::size_t i = 0; i < nrows; ++i)
+            for (IndexType k = mCrowPtr[i]; k < mCrowPtr[i+1]; ++k)
+                M.push_back(i, mCcolInd[k], mCvalues[k]);
         M.complete_index1_data();
         return M;
     }
 
-    /// Get the extraction operator as CSR triplet
+    /// Get the extraction operator as CSR triplet. The output vectors are overwritten, i.e. rowPtr starts at 0.
     void GetExtractionOperator(std::vector<int>& rowPtr, std::vector<int>& colInd, std::vector<double>& values) const
     {
-        int cnt = 0;
-        rowPtr.push_back(cnt);
-        for(std::size_t i = 0; i < mCrows.size(); ++i)
-        {
-            for(std::size_t j = 0; j < mCrows[i].size(); ++j)
-            {
-                if(mCrows[i](j) != 0)
-                {
-                    colInd.push_back(j);
-                    values.push_back(mCrows[i](j));
-                    ++cnt;
-                }
-            }
-            rowPtr.push_back(cnt);
-        }
+        const std::size_t nrows = NumberOfAnchors();
+        rowPtr.assign(nrows + 1, 0);
+        for (std::size_t i = 0; i < nrows; ++i)
+            rowPtr[i+1] = static_cast<int>(mCrowPtr[i+1]);
+        colInd.assign(mCcolInd.begin(), mCcolInd.end());
+        values.assign(mCvalues.begin(), mCvalues.end());
+    }
+
+    /// Get the memory (in bytes) used by the cell, including the anchors and the extraction operator
+    std::size_t MemoryUsage() const
+    {
+        return sizeof(*this)
+             + mSupportedAnchors.capacity() * sizeof(std::size_t)
+             + mAnchorWeights.capacity() * sizeof(double)
+             + (mCrowPtr.capacity() + mCcolInd.capacity()) * sizeof(IndexType)
+             + mCvalues.capacity() * sizeof(double);
+    }
+
+    /// Release the unused capacity of the internal storage
+    void ShrinkToFit()
+    {
+        std::vector<std::size_t>(mSupportedAnchors).swap(mSupportedAnchors);
+        std::vector<double>(mAnchorWeights).swap(mAnchorWeights);
+        std::vector<IndexType>(mCrowPtr).swap(mCrowPtr);
+        std::vector<IndexType>(mCcolInd).swap(mCcolInd);
+        std::vector<double>(mCvalues).swap(mCvalues);
     }
 
     /// Implement relational operator for automatic arrangement in container
@@ -312,7 +380,10 @@ private:
     knot_t mpBelow;
     std::vector<std::size_t> mSupportedAnchors;
     std::vector<double> mAnchorWeights; // weight of the anchor
-    std::vector<SparseVectorType> mCrows; // bezier extraction operator row to each anchor
+    std::size_t mNumberOfColumns; // number of columns of the extraction operator
+    std::vector<IndexType> mCrowPtr; // row pointers of the bezier extraction operator, one row for each anchor
+    std::vector<IndexType> mCcolInd; // column indices of the non-zeros of the bezier extraction operator
+    std::vector<double> mCvalues; // non-zeros of the bezier extraction operator
 };
 
 template<>
@@ -54,7 +54,7 @@ public:
     typedef typename cell_container_t::const_iterator const_iterator;
 
     /// Default constructor
-    CellManager() : mTol(1.0e-10), mLastId(0)
+    CellManager() : cell_map_is_created(false), mLastId(0), mTol(1.0e-10)
     {}
 
     /// Destructor
@@ -88,6 +88,15 @@ public:
     /// Get the number of cells of this manager
     std::size_t size() const {return mpCells.size();}
 
+    /// Get the memory (in bytes) used by the cells of this manager, including the extraction operators
+    std::size_t MemoryUsage() const
+    {
+        std::size_t mem = 0;
+        for(const_iterator it = mpCells.begin(); it != mpCells.end(); ++it)
+            mem += (*it)->MemoryUsage();
+        return mem;
+    }
+
     /// Remove a cell by its Id from the set
     virtual void erase(cell_t p_cell)
     {
@@ -95,7 +104,7 @@ public:
     }
 
     /// Get a cell based on its Id
-    cell_t get(const std::size_t& Id)
+    const cell_t& get(const std::size_t& Id)
     {
         // create the index map if it's not created yet
         if(!cell_map_is_created)
@@ -109,6 +118,21 @@ public:
             KRATOS_THROW_ERROR(std::runtime_error, "Access index is not found:", Id)
     }
 
+    /// Create the map from cell Id to cell if it is outdated. The map is otherwise created at the first call to get(),
+    /// hence this shall be called before accessing the cells by Id from several threads.
+    void UpdateCellsMap()
+    {
+        if(!cell_map_is_created)
+            CreateCellsMap();
+    }
+
+    /// Find a cell containing the point xi in knot space. If the point lies on the boundary between cells, any of them can be returned.
+    /// A null pointer is returned if no cell contains the point.
+    virtual cell_t FindCell(const std::vector<double>& xi)
+    {
+        KRATOS_THROW_ERROR(std::logic_error, "Calling the virtual function", __FUNCTION__)
+    }
+
     /// Overload operator[]
     cell_t operator[](const std::size_t& Id)
     {
@@ -169,10 +193,24 @@ public:
 protected:
 
     cell_container_t mpCells;
-    mutable map_t mCellsMap; // map from cell id to the basis function. It's mainly used to search for the cell quickly. But it needs to be re-initialized whenever new cell is added to the set
+    mutable map_t mCellsMap; // map from cell id to the cell. It's mainly used to search for the cell quickly. It is kept up-to-date when the cells are added or removed
     bool cell_map_is_created;
     std::size_t mLastId;
 
+    /// Add the cell to the Id map. If the map is not created yet, it will contain the cell when it is created at the first access.
+    void AddToCellsMap(const cell_t& p_cell)
+    {
+        if(cell_map_is_created)
+            mCellsMap[p_cell->Id()] = p_cell;
+    }
+
+    /// Remove the cell from the Id map
+    void RemoveFromCellsMap(const cell_t& p_cell)
+    {
+        if(cell_map_is_created)
+            mCellsMap.erase(p_cell->Id());
+    }
+
 private:
     double mTol;
 
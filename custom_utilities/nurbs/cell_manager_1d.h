@@ -79,7 +79,7 @@ public:
         // otherwise create new cell
         cell_t p_cell = cell_t(new TCellType(++BaseType::mLastId, pKnots[0], pKnots[1]));
         BaseType::mpCells.insert(p_cell);
-        BaseType::cell_map_is_created = false;
+        BaseType::AddToCellsMap(p_cell);
 
         #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
         // update the r-tree
@@ -96,15 +96,12 @@ public:
     /// Insert a cell to the container. If the cell is existed in the container, the iterator of the existed one will be returned.
     virtual iterator insert(cell_t p_cell)
     {
-        // search in the list of cell if any cell has the same knot span
-        // Currently I use the brute-force approach. I know it is not efficient. I will improve it in the future. TODO
-        for(iterator it = BaseType::mpCells.begin(); it != BaseType::mpCells.end(); ++it)
-            if(*it == p_cell)
-                return it;
-
-        // otherwise insert new cell
-        iterator it = BaseType::mpCells.insert(p_cell).first;
-        BaseType::cell_map_is_created = false;
+        // the cells are ordered by Id, hence the existing cell is found by the set
+        std::pair<iterator, bool> result = BaseType::mpCells.insert(p_cell);
+        if(!result.second)
+            return result.first;
+        iterator it = result.first;
+        BaseType::AddToCellsMap(p_cell);
 
         #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
         // update the r-tree
@@ -119,21 +116,18 @@ public:
     /// Remove a cell by its Id from the set
     virtual void erase(cell_t p_cell)
     {
-        for(iterator it = BaseType::mpCells.begin(); it != BaseType::mpCells.end(); ++it)
+        iterator it = BaseType::mpCells.find(p_cell);
+        if(it != BaseType::mpCells.end() && *it == p_cell)
         {
-            if(*it == p_cell)
-            {
-                BaseType::mpCells.erase(it);
-
-                #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
-                // update the r-tree
-                double cmin[] = {p_cell->LeftValue()};
-                double cmax[] = {p_cell->RightValue()};
-                rtree_cells.Remove(cmin, cmax, p_cell->Id());
-                #endif
-
-                break;
-            }
+            BaseType::mpCells.erase(it);
+            BaseType::RemoveFromCellsMap(p_cell);
+
+            #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
+            // update the r-tree
+            double cmin[] = {p_cell->LeftValue()};
+            double cmax[] = {p_cell->RightValue()};
+            rtree_cells.Remove(cmin, cmax, p_cell->Id());
+            #endif
         }
     }
 
@@ -161,7 +155,7 @@ public:
         // check within overlapping cells the one covered in p_cell
         for(std::size_t i = 0; i < OverlappingCells.size(); ++i)
         {
-            cell_t pthis_cell = this->get(OverlappingCells[i]);
+            const cell_t& pthis_cell = this->get(OverlappingCells[i]);
             if(pthis_cell != p_cell)
                 if(pthis_cell->template IsCovered<1>(p_cell))
                     p_cells.push_back(pthis_cell);
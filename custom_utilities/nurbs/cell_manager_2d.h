@@ -68,7 +68,7 @@ public:
         assert(pKnots.size() == 4);
 
         // search in the list of cell if any cell has the same knot span
-        // Currently I use the brute-force approach. I know it is not efficient. I will improve it in the future.
+        #ifdef USE_BRUTE_FORCE_TO_SEARCH_FOR_CELLS
         for(iterator it = BaseType::mpCells.begin(); it != BaseType::mpCells.end(); ++it)
         {
             if( (*it)->Left()  == pKnots[0] // left
@@ -77,11 +77,31 @@ public:
              && (*it)->Up()    == pKnots[3] ) // up
                 return *it;
         }
+        #endif
+
+        #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
+        // the cell with the same knot span overlaps the new one, hence only the overlapping cells are checked.
+        // The search box is enlarged by the tolerance since the r-tree does not report the touching boxes.
+        const double tol = BaseType::GetTolerance();
+        std::vector<std::size_t> OverlappingCells;
+        double smin[] = {pKnots[0]->Value() - tol, pKnots[2]->Value() - tol};
+        double smax[] = {pKnots[1]->Value() + tol, pKnots[3]->Value() + tol};
+        rtree_cells.Search(smin, smax, CellManager_RtreeSearchCallback, (void*)(&OverlappingCells));
+        for(std::size_t i = 0; i < OverlappingCells.size(); ++i)
+        {
+            const cell_t& p_cell = this->get(OverlappingCells[i]);
+            if( p_cell->Left()  == pKnots[0] // left
+             && p_cell->Right() == pKnots[1] // right
+             && p_cell->Down()  == pKnots[2] // down
+             && p_cell->Up()    == pKnots[3] ) // up
+                return p_cell;
+        }
+        #endif
 
         // otherwise create new cell
         cell_t p_cell = cell_t(new TCellType(++BaseType::mLastId, pKnots[0], pKnots[1], pKnots[2], pKnots[3]));
         BaseType::mpCells.insert(p_cell);
-        BaseType::cell_map_is_created = false;
+        BaseType::AddToCellsMap(p_cell);
 
         #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
         // update the r-tree
@@ -98,15 +118,12 @@ public:
     /// Insert a cell to the container. If the cell is existed in the container, the iterator of the existed one will be returned.
     virtual iterator insert(cell_t p_cell)
     {
-        // search in the list of cell if any cell has the same knot span
-        // Currently I use the brute-force approach. I know it is not efficient. I will improve it in the future. TODO
-        for(iterator it = BaseType::mpCells.begin(); it != BaseType::mpCells.end(); ++it)
-            if(*it == p_cell)
-                return it;
-
-        // otherwise insert new cell
-        iterator it = BaseType::mpCells.insert(p_cell).first;
-        BaseType::cell_map_is_created = false;
+        // the cells are ordered by Id, hence the existing cell is found by the set
+        std::pair<iterator, bool> result = BaseType::mpCells.insert(p_cell);
+        if(!result.second)
+            return result.first;
+        iterator it = result.first;
+        BaseType::AddToCellsMap(p_cell);
 
         #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
         // update the r-tree
@@ -121,21 +138,18 @@ public:
     /// Remove a cell by its Id from the set
     virtual void erase(cell_t p_cell)
     {
-        for(iterator it = BaseType::mpCells.begin(); it != BaseType::mpCells.end(); ++it)
+        iterator it = BaseType::mpCells.find(p_cell);
+        if(it != BaseType::mpCells.end() && *it == p_cell)
         {
-            if(*it == p_cell)
-            {
-                BaseType::mpCells.erase(it);
-
-                #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
-                // update the r-tree
-                double cmin[] = {p_cell->LeftValue(), p_cell->DownValue(), p_cell->BelowValue()};
-                double cmax[] = {p_cell->RightValue(), p_cell->UpValue(), p_cell->AboveValue()};
-                rtree_cells.Remove(cmin, cmax, p_cell->Id());
-                #endif
-
-                break;
-            }
+            BaseType::mpCells.erase(it);
+            BaseType::RemoveFromCellsMap(p_cell);
+
+            #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
+            // update the r-tree
+            double cmin[] = {p_cell->LeftValue(), p_cell->DownValue(), p_cell->BelowValue()};
+            double cmax[] = {p_cell->RightValue(), p_cell->UpValue(), p_cell->AboveValue()};
+            rtree_cells.Remove(cmin, cmax, p_cell->Id());
+            #endif
         }
     }
 
@@ -163,7 +177,7 @@ public:
         // check within overlapping cells the one covered in p_cell
         for(std::size_t i = 0; i < OverlappingCells.size(); ++i)
         {
-            cell_t pthis_cell = this->get(OverlappingCells[i]);
+            const cell_t& pthis_cell = this->get(OverlappingCells[i]);
             if(pthis_cell != p_cell)
                 if(pthis_cell->template IsCovered<2>(p_cell))
                     p_cells.push_back(pthis_cell);
@@ -173,6 +187,34 @@ public:
         return p_cells;
     }
 
+    /// Find a cell containing the point xi in knot space
+    virtual cell_t FindCell(const std::vector<double>& xi)
+    {
+        #ifdef USE_BRUTE_FORCE_TO_SEARCH_FOR_CELLS
+        for(iterator it = BaseType::mpCells.begin(); it != BaseType::mpCells.end(); ++it)
+            if((*it)->IsCoverage(xi[0], xi[1]))
+                return *it;
+        #endif
+
+        #ifdef USE_R_TREE_TO_SEARCH_FOR_CELLS
+        // the r-tree only reports the strict overlaps, hence the point is searched as a small box to hit the cells touching it
+        std::vector<std::size_t> OverlappingCells;
+        const double tol = BaseType::GetTolerance();
+        double cmin[] = {xi[0] - tol, xi[1] - tol};
+        double cmax[] = {xi[0] + tol, xi[1] + tol};
+        rtree_cells.Search(cmin, cmax, CellManager_RtreeSearchCallback, (void*)(&OverlappingCells));
+
+        for(std::size_t i = 0; i < OverlappingCells.size(); ++i)
+        {
+            const cell_t& p_cell = this->get(OverlappingCells[i]);
+            if(p_cell->IsCoverage(xi[0], xi[1]))
+                return p_cell;
+        }
+        #endif
+
+        return cell_t();
+    }
+
     /// Information
     virtual void PrintInfo(std::ostream& rOStream) const
     {
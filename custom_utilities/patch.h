@@ -26,6 +26,7 @@
 #include "custom_utilities/grid_function.h"
 #include "custom_utilities/weighted_fespace.h"
 #include "custom_utilities/control_grid_utility.h"
+#include "custom_utilities/trans/batched_transformation.h"
 #include "isogeometric_application/isogeometric_application.h"
 
 // #define DEBUG_DESTROY
@@ -60,6 +61,7 @@ public:
     /// Type definition
     typedef ControlPoint<double> ControlPointType;
     typedef Transformation<double> TransformationType;
+    typedef BatchedTransformation<double> BatchedTransformationType;
 
     typedef GridFunction<TDim, double> DoubleGridFunctionType;
     typedef std::vector<typename DoubleGridFunctionType::Pointer> DoubleGridFunctionContainerType;
@@ -130,14 +132,14 @@ public:
     /// Get the number of basis functions defined over the patch
     virtual const std::size_t TotalNumber() const
     {
-        assert(mFESpace == NULL);
+        assert(mFESpace != NULL);
         return mFESpace->TotalNumber();
     }
 
     /// Get the order of the patch in specific direction
     virtual const std::size_t Order(const std::size_t& i) const
     {
-        assert(mFESpace == NULL);
+        assert(mFESpace != NULL);
         if (i >= TDim) return 0;
         else return mFESpace->Order(i);
     }
@@ -184,19 +186,33 @@ public:
     std::vector<double> GetControlWeights() const
     {
         typename ControlGrid<ControlPointType>::ConstPointer pControlPointGrid = pControlPointGridFunction()->pControlGrid();
-        std::vector<double> Weights(pControlPointGrid->size());
-        for (std::size_t i = 0; i < pControlPointGrid->size(); ++i)
-            Weights[i] = (*pControlPointGrid)[i].W();
+        std::vector<double> Weights;
+        ControlGridUtility::GetWeights(*pControlPointGrid, Weights);
         return Weights;
     }
 
     /// Apply the homogeneous transformation to the patch by applying the homogeneous transformation to the control points grid. For DISPLACEMENT, access the grid function for DISPLACEMENT directly and transform it.
     void ApplyTransformation(const TransformationType& trans)
+    {
+        this->ApplyTransformation(BatchedTransformationType(trans));
+    }
+
+    /// Apply the composed homogeneous transformation to the control points grid
+    void ApplyTransformation(const BatchedTransformationType& trans)
     {
         typename ControlGrid<ControlPointType>::Pointer pControlPointGrid = pControlPointGridFunction()->pControlGrid();
         ControlGridUtility::ApplyTransformation(*pControlPointGrid, trans);
     }
 
+    /// Apply the composed homogeneous transformation to the array_1d or Vector grid function representing the geometry, e.g. the coordinates of the points.
+    /// The control values are treated as points, i.e. the translation is applied.
+    template<class TVariableType>
+    void ApplyTransformation(const BatchedTransformationType& trans, const TVariableType& rVariable)
+    {
+        typename ControlGrid<typename TVariableType::Type>::Pointer pControlGrid = this->pGetGridFunction(rVariable)->pControlGrid();
+        ControlGridUtility::ApplyTransformation(*pControlGrid, trans);
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /// Create and add the grid function. This function will create the new FESpace based on the original FESpace of the control grid and the weights, and then assign to the new grid function.
@@ -422,7 +438,7 @@ public:
                 it != DoubleGridFunctions_.end(); ++it)
         {
             typename ControlGrid<double>::Pointer pBoundaryDoubleControlGrid = ControlGridUtility::ExtractSubGrid<double>((*it)->pControlGrid(), local_ids);
-            pBPatch->CreateGridFunction<double>(pBoundaryDoubleControlGrid);
+            pBPatch->template CreateGridFunction<double>(pBoundaryDoubleControlGrid);
         }
 
         Array1DGridFunctionContainerType Array1DGridFunctions_ = this->Array1DGridFunctions();
@@ -430,7 +446,7 @@ public:
                 it != Array1DGridFunctions_.end(); ++it)
         {
             typename ControlGrid<array_1d<double, 3> >::Pointer pBoundaryArray1DControlGrid = ControlGridUtility::ExtractSubGrid<array_1d<double, 3> >((*it)->pControlGrid(), local_ids);
-            pBPatch->CreateGridFunction<array_1d<double, 3> >(pBoundaryArray1DControlGrid);
+            pBPatch->template CreateGridFunction<array_1d<double, 3> >(pBoundaryArray1DControlGrid);
         }
 
         VectorGridFunctionContainerType VectorGridFunctions_ = this->VectorGridFunctions();
@@ -438,7 +454,7 @@ public:
                 it != VectorGridFunctions_.end(); ++it)
         {
             typename ControlGrid<Vector>::Pointer pBoundaryVectorControlGrid = ControlGridUtility::ExtractSubGrid<Vector>((*it)->pControlGrid(), local_ids);
-            pBPatch->CreateGridFunction<Vector>(pBoundaryVectorControlGrid);
+            pBPatch->template CreateGridFunction<Vector>(pBoundaryVectorControlGrid);
         }
 
         return pBPatch;
@@ -1297,6 +1313,30 @@ public:
         return start + mEquationSystemSize;
     }
 
+    /// Apply the homogeneous transformation to the control points of all the patches
+    void ApplyTransformation(const typename PatchType::TransformationType& trans)
+    {
+        this->ApplyTransformation(typename PatchType::BatchedTransformationType(trans));
+    }
+
+    /// Apply the composed homogeneous transformation to the control points of all the patches
+    void ApplyTransformation(const typename PatchType::BatchedTransformationType& trans)
+    {
+        std::vector<typename PatchType::Pointer> patches(mpPatches.ptr_begin(), mpPatches.ptr_end());
+        this->ApplyTransformationToPatches(patches, trans, static_cast<const Variable<ControlPoint<double> >*>(NULL));
+    }
+
+    /// Apply the composed homogeneous transformation to the array_1d or Vector grid function representing the geometry, in all the patches having it
+    template<class TVariableType>
+    void ApplyTransformation(const typename PatchType::BatchedTransformationType& trans, const TVariableType& rVariable)
+    {
+        std::vector<typename PatchType::Pointer> patches;
+        for (typename PatchContainerType::ptr_iterator it = Patches().ptr_begin(); it != Patches().ptr_end(); ++it)
+            if ((*it)->HasGridFunction(rVariable))
+                patches.push_back(*it);
+        this->ApplyTransformationToPatches(patches, trans, &rVariable);
+    }
+
     /// Make the two patches neighbor. This requires that two patches are conformed at the interface.
     static void MakeNeighbor(typename Patch<TDim>::Pointer pPatch1, const BoundarySide& side1,
             typename Patch<TDim>::Pointer pPatch2, const BoundarySide& side2)
@@ -1334,6 +1374,40 @@ public:
 
 private:
 
+    /// Apply the transformation to the grid function of the variable, or to the control points if pVariable is NULL, of the patches.
+    /// The patches are transformed concurrently when there are enough of them to occupy the threads; otherwise they are
+    /// transformed one after another, each grid being split over the threads.
+    template<class TVariableType>
+    static void ApplyTransformationToPatches(std::vector<typename PatchType::Pointer>& patches,
+            const typename PatchType::BatchedTransformationType& trans, const TVariableType* pVariable)
+    {
+        const int npatches = static_cast<int>(patches.size());
+
+        std::string error_message;
+        #pragma omp parallel for schedule(dynamic) if(npatches >= omp_get_max_threads())
+        for (int i = 0; i < npatches; ++i)
+        {
+            try
+            {
+                if (pVariable == NULL)
+                    patches[i]->ApplyTransformation(trans);
+                else
+                    patches[i]->ApplyTransformation(trans, *pVariable);
+            }
+            catch (std::exception& e)
+            {
+                #pragma omp critical
+                {
+                    if (error_message.empty())
+                        error_message = e.what();
+                }
+            }
+        }
+
+        if (!error_message.empty())
+            KRATOS_THROW_ERROR(std::runtime_error, error_message, "")
+    }
+
     PatchContainerType mpPatches; // container for all the patches
     bool mIsEnumerated;
     std::size_t mEquationSystemSize; // this is the number of equation id in this multipatch
@@ -0,0 +1,168 @@
+//
+//   Project Name:        Kratos
+//   Last Modified by:    $Author: hbui $
+//   Date:                $Date: 19 Oct 2026 $
+//   Revision:            $Revision: 1.0 $
+//
+//
+
+#if !defined(KRATOS_ISOGEOMETRIC_APPLICATION_BATCHED_TRANSFORMATION_H_INCLUDED )
+#define  KRATOS_ISOGEOMETRIC_APPLICATION_BATCHED_TRANSFORMATION_H_INCLUDED
+
+// System includes
+#include <string>
+#include <iostream>
+
+// External includes
+#include <omp.h>
+
+// Project includes
+#include "includes/define.h"
+#include "custom_utilities/trans/transformation.h"
+
+namespace Kratos
+{
+
+/**
+Homogeneous transformation applied to large sets of points at once. The chain of transformations is composed once in a fixed
+4x4 matrix, which is then applied to the arrays of points by vectorised loops, split over the threads for the large arrays.
+The points are given either as arrays of control points in homogeneous coordinates or as arrays of physical coordinates
+(array_1d, Vector), for which only the affine part is applied.
+ */
+template<typename TDataType>
+class BatchedTransformation
+{
+public:
+    /// Pointer definition
+    KRATOS_CLASS_POINTER_DEFINITION(BatchedTransformation);
+
+    /// Default constructor, which gives the identity
+    BatchedTransformation()
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                mMat[i][j] = (i == j) ? 1.0 : 0.0;
+    }
+
+    /// Constructor with a transformation
+    BatchedTransformation(const Transformation<TDataType>& trans)
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                mMat[i][j] = trans(i, j);
+    }
+
+    /// Destructor
+    virtual ~BatchedTransformation() {}
+
+    /// Append the transformation to the chain, i.e. it is applied after the current transformations
+    void Append(const Transformation<TDataType>& trans)
+    {
+        TDataType temp[4][4];
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                temp[i][j] = trans(i, 0)*mMat[0][j] + trans(i, 1)*mMat[1][j] + trans(i, 2)*mMat[2][j] + trans(i, 3)*mMat[3][j];
+
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                mMat[i][j] = temp[i][j];
+    }
+
+    /// Get the composed transformation
+    Transformation<TDataType> GetTransformation() const
+    {
+        Transformation<TDataType> trans;
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                trans(i, j) = mMat[i][j];
+        return trans;
+    }
+
+    /// overload operator ()
+    const TDataType& operator() (const int& i, const int& j) const
+    {
+        return mMat[i][j];
+    }
+
+    /// Apply the transformation to an array of control points. The control point type shall provide WX(), WY(), WZ() and W().
+    template<class TControlPointType>
+    void ApplyHomogeneous(TControlPointType* points, const std::size_t& n) const
+    {
+        const TDataType T00 = mMat[0][0], T01 = mMat[0][1], T02 = mMat[0][2], T03 = mMat[0][3];
+        const TDataType T10 = mMat[1][0], T11 = mMat[1][1], T12 = mMat[1][2], T13 = mMat[1][3];
+        const TDataType T20 = mMat[2][0], T21 = mMat[2][1], T22 = mMat[2][2], T23 = mMat[2][3];
+        const TDataType T30 = mMat[3][0], T31 = mMat[3][1], T32 = mMat[3][2], T33 = mMat[3][3];
+
+        const int size = static_cast<int>(n);
+        #pragma omp parallel for schedule(static) if(size > msMinParallelSize)
+        for (int i = 0; i < size; ++i)
+        {
+            TControlPointType& point = points[i];
+            const TDataType wx = point.WX(), wy = point.WY(), wz = point.WZ(), w = point.W();
+            point.WX() = T00*wx + T01*wy + T02*wz + T03*w;
+            point.WY() = T10*wx + T11*wy + T12*wz + T13*w;
+            point.WZ() = T20*wx + T21*wy + T22*wz + T23*w;
+            point.W()  = T30*wx + T31*wy + T32*wz + T33*w;
+        }
+    }
+
+    /// Apply the affine part of the transformation to an array of points in physical coordinates.
+    /// The point type shall provide operator[] for the first three components (array_1d<double, 3>, Vector).
+    template<class TPointType>
+    void ApplyAffine(TPointType* points, const std::size_t& n) const
+    {
+        const TDataType T00 = mMat[0][0], T01 = mMat[0][1], T02 = mMat[0][2], T03 = mMat[0][3];
+        const TDataType T10 = mMat[1][0], T11 = mMat[1][1], T12 = mMat[1][2], T13 = mMat[1][3];
+        const TDataType T20 = mMat[2][0], T21 = mMat[2][1], T22 = mMat[2][2], T23 = mMat[2][3];
+
+        const int size = static_cast<int>(n);
+        #pragma omp parallel for schedule(static) if(size > msMinParallelSize)
+        for (int i = 0; i < size; ++i)
+        {
+            TPointType& point = points[i];
+            const TDataType x = point[0], y = point[1], z = point[2];
+            point[0] = T00*x + T01*y + T02*z + T03;
+            point[1] = T10*x + T11*y + T12*z + T13;
+            point[2] = T20*x + T21*y + T22*z + T23;
+        }
+    }
+
+    /// Information
+    virtual void PrintInfo(std::ostream& rOStream) const
+    {
+        rOStream << "Batched Homogeneous Transformation";
+    }
+
+    virtual void PrintData(std::ostream& rOStream) const
+    {
+        rOStream << "[4,4](";
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            rOStream << (i == 0 ? "(" : ",(");
+            for (std::size_t j = 0; j < 4; ++j)
+                rOStream << (j == 0 ? "" : ",") << mMat[i][j];
+            rOStream << ")";
+        }
+        rOStream << ")";
+    }
+
+private:
+
+    static const int msMinParallelSize = 10000; // the arrays smaller than this size are transformed by one thread
+
+    TDataType mMat[4][4];
+};
+
+/// output stream function
+template<class TDataType>
+inline std::ostream& operator <<(std::ostream& rOStream, const BatchedTransformation<TDataType>& rThis)
+{
+    rThis.PrintInfo(rOStream);
+    rOStream << ": ";
+    rThis.PrintData(rOStream);
+    return rOStream;
+}
+
+}// namespace Kratos.
+
+#endif // KRATOS_ISOGEOMETRIC_APPLICATION_BATCHED_TRANSFORMATION_H_INCLUDED
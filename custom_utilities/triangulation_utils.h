@@ -8,6 +8,9 @@
 #include <cmath>
 #include <ctime>
 #include <cstring>
+#include <vector>
+#include <limits>
+#include <algorithm>
 
 #include "includes/define.h"
 
@@ -17,7 +20,11 @@ namespace Kratos
 {
 
 /**
-A handful utility to construct a simple triangle mesh from list of points. The performance of this code is not expected.
+A handful utility to construct a simple triangle mesh from list of points.
+The Delaunay triangulation is computed by a sweep-hull algorithm: the points are sorted by the distance to the circumcentre of a seed
+triangle, hence each point lies outside the convex hull of the previous ones and is connected to the visible part of the hull, which is
+located by an angular hash of the hull vertices; the new edges are then legalised by flipping. The complexity is O(n log n).
+The original routine r8tris2 (lexicographic insertion and edge swaps, without spatial search) is kept as the fallback for degenerate input.
 REF: this code makes use of code from John Burkardt webpage
 http://people.sc.fsu.edu/~jburkardt/cpp_src/triangulation/triangulation.html
  */
@@ -26,9 +33,52 @@ class TriangulationUtils
 public:
     TriangulationUtils() {}
     virtual ~TriangulationUtils() {}
-    
+
+    /// Compute the Delaunay triangulation of the points given by their coordinates (x0, y0, x1, y1, ...). The triangles are
+    /// appended to the connectivities, with 0-based node indices.
     void ComputeDelaunayTriangulation(std::vector<double>& XYlist,
                                       std::vector<std::vector<unsigned int> >& Connectivities)
+    {
+        std::vector<unsigned int> triangles;
+        ComputeDelaunayTriangulation(XYlist, triangles);
+
+        // write the output data
+        for(std::size_t i = 0; i < triangles.size() / 3; ++i)
+        {
+            std::vector<unsigned int> tri(3);
+            tri[0] = triangles[3*i];
+            tri[1] = triangles[3*i + 1];
+            tri[2] = triangles[3*i + 2];
+            Connectivities.push_back(tri);
+        }
+    }
+
+    /// Compute the Delaunay triangulation of the points given by their coordinates (x0, y0, x1, y1, ...) by the sweep-hull algorithm.
+    /// The connectivities are written in a flat array, three 0-based node indices per triangle in counter-clockwise order.
+    /// The coincident points are not connected. If the sweep-hull fails on degenerate input, r8tris2 is used, except if the points
+    /// are collinear or contain coincident points, which r8tris2 cannot handle either; an error is thrown then.
+    void ComputeDelaunayTriangulation(const std::vector<double>& XYlist,
+                                      std::vector<unsigned int>& Connectivities)
+    {
+        SweepHullTriangulation sweep_hull(XYlist);
+        if(sweep_hull.Triangulate(Connectivities))
+            return;
+
+        if(sweep_hull.IsCollinear())
+            KRATOS_THROW_ERROR(std::logic_error, "The points are collinear, no triangle can be generated. Number of points =", XYlist.size() / 2)
+
+        if(sweep_hull.HasCoincidentPoints())
+            KRATOS_THROW_ERROR(std::logic_error, "The triangulation failed on input containing coincident points. Number of points =", XYlist.size() / 2)
+
+        std::vector<double> points = XYlist;
+        ComputeDelaunayTriangulationR8Tris2(points, Connectivities);
+    }
+
+    /// Compute the Delaunay triangulation of the points given by their coordinates (x0, y0, x1, y1, ...) by r8tris2.
+    /// The connectivities are written in a flat array, three 0-based node indices per triangle.
+    /// The points are sorted in place during the computation and restored afterwards.
+    void ComputeDelaunayTriangulationR8Tris2(std::vector<double>& XYlist,
+                                             std::vector<unsigned int>& Connectivities)
     {
         // generate the triangulation
         int node_num = XYlist.size() / 2;
@@ -42,20 +92,14 @@ public:
         int error = r8tris2(node_num, &XYlist[0], &triangle_num, triangle_node, triangle_neighbor);
 
         if(error != 0)
+        {
+            free(triangle_node);
+            free(triangle_neighbor);
             KRATOS_THROW_ERROR(std::logic_error, "Error calling r8tris2, error code =", error)
-
-        // report the triangulation quality
-        // TODO
+        }
 
         // write the output data
-        for(int i = 0; i < triangle_num; ++i)
-        {
-            std::vector<unsigned int> tri(3);
-            tri[0] = triangle_node[3*i];
-            tri[1] = triangle_node[3*i + 1];
-            tri[2] = triangle_node[3*i + 2];
-            Connectivities.push_back(tri);
-        }
+        Connectivities.assign(triangle_node, triangle_node + 3*triangle_num);
 
         // free up the memory
         free(triangle_node);
@@ -65,6 +109,444 @@ public:
 
 private:
 
+    /// Working data of the sweep-hull triangulation. The triangles are stored by half-edges: the half-edge e belongs to the
+    /// triangle e/3 and goes from the node mTriangles[e] to the next node of that triangle; mHalfedges[e] is the opposite
+    /// half-edge in the neighbouring triangle, or -1 on the convex hull. The hull is a circular list of nodes in counter-clockwise
+    /// order, mHullTri[i] being the half-edge from the node i to the next one.
+    class SweepHullTriangulation
+    {
+    public:
+
+        SweepHullTriangulation(const std::vector<double>& XYlist) : mXY(XYlist), mTol(0.0), mIsCollinear(false), mCx(0.0), mCy(0.0), mHashSize(0), mHullStart(0), mTrianglesLen(0)
+        {}
+
+        /// Compute the triangulation. Return false if it fails, i.e. if all the points are collinear or a point cannot be inserted.
+        bool Triangulate(std::vector<unsigned int>& Connectivities)
+        {
+            const int n = static_cast<int>(mXY.size() / 2);
+            Connectivities.clear();
+            mIsCollinear = false;
+            if(n < 3)
+            {
+                mIsCollinear = true;
+                return false;
+            }
+
+            // tolerance to detect the coincident points
+            double min_x = mXY[0], max_x = mXY[0], min_y = mXY[1], max_y = mXY[1];
+            for(int i = 1; i < n; ++i)
+            {
+                min_x = std::min(min_x, mXY[2*i]);
+                max_x = std::max(max_x, mXY[2*i]);
+                min_y = std::min(min_y, mXY[2*i + 1]);
+                max_y = std::max(max_y, mXY[2*i + 1]);
+            }
+            mTol = 1.0e-14 * std::max(max_x - min_x, max_y - min_y);
+            const double& tol = mTol;
+
+            // the seed triangle is the point closest to the centre of the bounding box, its closest point and the point
+            // giving the smallest circumcircle with them
+            const double bx = 0.5 * (min_x + max_x);
+            const double by = 0.5 * (min_y + max_y);
+            int i0 = 0, i1 = -1, i2 = -1;
+            double min_dist = std::numeric_limits<double>::max();
+            for(int i = 0; i < n; ++i)
+            {
+                const double d = SquaredDistance(bx, by, mXY[2*i], mXY[2*i + 1]);
+                if(d < min_dist)
+                {
+                    i0 = i;
+                    min_dist = d;
+                }
+            }
+
+            min_dist = std::numeric_limits<double>::max();
+            for(int i = 0; i < n; ++i)
+            {
+                if(i == i0) continue;
+                const double d = SquaredDistance(mXY[2*i0], mXY[2*i0 + 1], mXY[2*i], mXY[2*i + 1]);
+                if(d < min_dist && d > 0.0)
+                {
+                    i1 = i;
+                    min_dist = d;
+                }
+            }
+            if(i1 == -1)
+            {
+                mIsCollinear = true;
+                return false;
+            }
+
+            double min_radius = std::numeric_limits<double>::max();
+            for(int i = 0; i < n; ++i)
+            {
+                if(i == i0 || i == i1) continue;
+                if(Orient(i0, i1, i) == 0.0) continue;
+                const double r = SquaredCircumradius(i0, i1, i);
+                if(r < min_radius)
+                {
+                    i2 = i;
+                    min_radius = r;
+                }
+            }
+            if(i2 == -1)
+            {
+                mIsCollinear = true;
+                return false;
+            }
+
+            if(Orient(i0, i1, i2) < 0.0)
+                std::swap(i1, i2);
+
+            Circumcenter(i0, i1, i2, mCx, mCy);
+
+            // sort the points by the distance to the circumcentre, so that each point is outside the hull of the previous ones
+            std::vector<double> dists(n);
+            std::vector<unsigned int> ids(n);
+            for(int i = 0; i < n; ++i)
+            {
+                ids[i] = i;
+                dists[i] = SquaredDistance(mCx, mCy, mXY[2*i], mXY[2*i + 1]);
+            }
+            std::sort(ids.begin(), ids.end(), DistanceLess(dists, mXY));
+
+            // initialise the hull with the seed triangle
+            mHashSize = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+            mHullHash.assign(mHashSize, -1);
+            mHullPrev.resize(n);
+            mHullNext.resize(n);
+            mHullTri.resize(n);
+
+            mHullStart = i0;
+            mHullNext[i0] = mHullPrev[i2] = i1;
+            mHullNext[i1] = mHullPrev[i0] = i2;
+            mHullNext[i2] = mHullPrev[i1] = i0;
+            mHullTri[i0] = 0;
+            mHullTri[i1] = 1;
+            mHullTri[i2] = 2;
+            mHullHash[HashKey(mXY[2*i0], mXY[2*i0 + 1])] = i0;
+            mHullHash[HashKey(mXY[2*i1], mXY[2*i1 + 1])] = i1;
+            mHullHash[HashKey(mXY[2*i2], mXY[2*i2 + 1])] = i2;
+
+            const std::size_t max_triangles = 2*n - 5;
+            mTriangles.resize(3*max_triangles);
+            mHalfedges.resize(3*max_triangles);
+            mTrianglesLen = 0;
+            AddTriangle(i0, i1, i2, -1, -1, -1);
+
+            double xp = 0.0, yp = 0.0;
+            for(int k = 0; k < n; ++k)
+            {
+                const int i = ids[k];
+                const double x = mXY[2*i];
+                const double y = mXY[2*i + 1];
+
+                // skip the coincident points
+                if(k > 0 && std::abs(x - xp) <= tol && std::abs(y - yp) <= tol) continue;
+                xp = x;
+                yp = y;
+
+                if(i == i0 || i == i1 || i == i2) continue;
+
+                // skip the points coincident with the seed triangle, which are not necessarily next to it in the distance order
+                if(IsCoincident(i, i0) || IsCoincident(i, i1) || IsCoincident(i, i2)) continue;
+
+                // find a visible edge on the hull, starting from the hull vertex of the closest angle
+                int start = 0;
+                const std::size_t key = HashKey(x, y);
+                for(std::size_t j = 0; j < mHashSize; ++j)
+                {
+                    start = mHullHash[(key + j) % mHashSize];
+                    if(start != -1 && start != mHullNext[start]) break;
+                }
+
+                start = mHullPrev[start];
+                int e = start, q;
+                while(q = mHullNext[e], !Visible(x, y, e, q))
+                {
+                    e = q;
+                    if(e == start)
+                    {
+                        e = -1;
+                        break;
+                    }
+                }
+                if(e == -1)
+                    return false; // the point is not outside the hull, which happens only on degenerate input
+
+                // add the first triangle from the point
+                int t = AddTriangle(e, i, mHullNext[e], -1, -1, mHullTri[e]);
+                mHullTri[i] = Legalize(t + 2);
+                mHullTri[e] = t;
+
+                // walk forward through the hull, adding more triangles and flipping recursively
+                int m = mHullNext[e];
+                while(q = mHullNext[m], Visible(x, y, m, q))
+                {
+                    t = AddTriangle(m, i, q, mHullTri[i], -1, mHullTri[m]);
+                    mHullTri[i] = Legalize(t + 2);
+                    mHullNext[m] = m; // mark as removed
+                    m = q;
+                }
+
+                // walk backward from the other side, adding more triangles and flipping
+                if(e == start)
+                {
+                    while(q = mHullPrev[e], Visible(x, y, q, e))
+                    {
+                        t = AddTriangle(q, i, e, -1, mHullTri[e], mHullTri[q]);
+                        Legalize(t + 2);
+                        mHullTri[q] = t;
+                        mHullNext[e] = e; // mark as removed
+                        e = q;
+                    }
+                }
+
+                // update the hull
+                mHullStart = mHullPrev[i] = e;
+                mHullNext[e] = mHullPrev[m] = i;
+                mHullNext[i] = m;
+
+                mHullHash[HashKey(x, y)] = i;
+                mHullHash[HashKey(mXY[2*e], mXY[2*e + 1])] = e;
+            }
+
+            Connectivities.assign(mTriangles.begin(), mTriangles.begin() + mTrianglesLen);
+            return true;
+        }
+
+        /// Check if the last call to Triangulate failed because all the points are collinear, or there are less than three points
+        const bool& IsCollinear() const {return mIsCollinear;}
+
+        /// Check if the input contains coincident points, using the tolerance of the last call to Triangulate
+        bool HasCoincidentPoints() const
+        {
+            const std::size_t n = mXY.size() / 2;
+            std::vector<unsigned int> ids(n);
+            for(std::size_t i = 0; i < n; ++i)
+                ids[i] = i;
+            std::sort(ids.begin(), ids.end(), CoordinatesLess(mXY));
+
+            for(std::size_t k = 1; k < n; ++k)
+                if(IsCoincident(ids[k-1], ids[k]))
+                    return true;
+            return false;
+        }
+
+    private:
+
+        /// Comparator of the point indices by their coordinates (x, y), then by their indices
+        struct CoordinatesLess
+        {
+            CoordinatesLess(const std::vector<double>& rXY) : mrXY(rXY) {}
+            bool operator()(const unsigned int& a, const unsigned int& b) const
+            {
+                if(mrXY[2*a] != mrXY[2*b]) return mrXY[2*a] < mrXY[2*b];
+                if(mrXY[2*a + 1] != mrXY[2*b + 1]) return mrXY[2*a + 1] < mrXY[2*b + 1];
+                return a < b;
+            }
+            const std::vector<double>& mrXY;
+        };
+
+        /// Comparator of the point indices by their distances. The ties are broken by the coordinates, so that the exactly
+        /// coincident points are next to each other.
+        struct DistanceLess
+        {
+            DistanceLess(const std::vector<double>& rDists, const std::vector<double>& rXY) : mrDists(rDists), mCoordinatesLess(rXY) {}
+            bool operator()(const unsigned int& a, const unsigned int& b) const
+            {
+                return (mrDists[a] < mrDists[b]) || (mrDists[a] == mrDists[b] && mCoordinatesLess(a, b));
+            }
+            const std::vector<double>& mrDists;
+            CoordinatesLess mCoordinatesLess;
+        };
+
+        const std::vector<double>& mXY;
+        double mTol; // tolerance to detect the coincident points
+        bool mIsCollinear;
+        double mCx, mCy; // circumcentre of the seed triangle
+        std::size_t mHashSize;
+        std::vector<int> mHullHash;
+        std::vector<int> mHullPrev;
+        std::vector<int> mHullNext;
+        std::vector<int> mHullTri;
+        int mHullStart;
+        std::vector<unsigned int> mTriangles;
+        std::vector<int> mHalfedges;
+        std::size_t mTrianglesLen;
+        std::vector<int> mEdgeStack;
+
+        bool IsCoincident(const int& a, const int& b) const
+        {
+            return std::abs(mXY[2*a] - mXY[2*b]) <= mTol && std::abs(mXY[2*a + 1] - mXY[2*b + 1]) <= mTol;
+        }
+
+        static double SquaredDistance(const double& ax, const double& ay, const double& bx, const double& by)
+        {
+            const double dx = ax - bx;
+            const double dy = ay - by;
+            return dx*dx + dy*dy;
+        }
+
+        /// Orientation of the points a, b, c: positive if counter-clockwise, negative if clockwise and zero if collinear
+        /// within the round-off
+        double Orient(const int& a, const int& b, const int& c) const
+        {
+            const double l = (mXY[2*b] - mXY[2*a]) * (mXY[2*c + 1] - mXY[2*a + 1]);
+            const double r = (mXY[2*b + 1] - mXY[2*a + 1]) * (mXY[2*c] - mXY[2*a]);
+            const double det = l - r;
+            if(std::abs(det) <= 1.0e-13 * (std::abs(l) + std::abs(r)))
+                return 0.0;
+            return det;
+        }
+
+        /// Check if the hull edge a-b is visible from the point (x, y), i.e. the point is strictly on its right
+        bool Visible(const double& x, const double& y, const int& a, const int& b) const
+        {
+            const double l = (mXY[2*b] - mXY[2*a]) * (y - mXY[2*a + 1]);
+            const double r = (mXY[2*b + 1] - mXY[2*a + 1]) * (x - mXY[2*a]);
+            return l - r < -1.0e-13 * (std::abs(l) + std::abs(r));
+        }
+
+        /// Check if the point p is strictly inside the circumcircle of the counter-clockwise triangle a, b, c
+        bool InCircle(const int& a, const int& b, const int& c, const int& p) const
+        {
+            const double dx = mXY[2*a] - mXY[2*p], dy = mXY[2*a + 1] - mXY[2*p + 1];
+            const double ex = mXY[2*b] - mXY[2*p], ey = mXY[2*b + 1] - mXY[2*p + 1];
+            const double fx = mXY[2*c] - mXY[2*p], fy = mXY[2*c + 1] - mXY[2*p + 1];
+            const double ap = dx*dx + dy*dy;
+            const double bp = ex*ex + ey*ey;
+            const double cp = fx*fx + fy*fy;
+            const double det = dx*(ey*cp - bp*fy) - dy*(ex*cp - bp*fx) + ap*(ex*fy - ey*fx);
+            const double perm = std::abs(dx)*(std::abs(ey)*cp + bp*std::abs(fy)) + std::abs(dy)*(std::abs(ex)*cp + bp*std::abs(fx))
+                              + ap*(std::abs(ex*fy) + std::abs(ey*fx));
+            return det > 1.0e-12 * perm;
+        }
+
+        double SquaredCircumradius(const int& a, const int& b, const int& c) const
+        {
+            double x, y;
+            Circumcenter(a, b, c, x, y);
+            return SquaredDistance(x, y, mXY[2*a], mXY[2*a + 1]);
+        }
+
+        void Circumcenter(const int& a, const int& b, const int& c, double& x, double& y) const
+        {
+            const double dx = mXY[2*b] - mXY[2*a], dy = mXY[2*b + 1] - mXY[2*a + 1];
+            const double ex = mXY[2*c] - mXY[2*a], ey = mXY[2*c + 1] - mXY[2*a + 1];
+            const double bl = dx*dx + dy*dy;
+            const double cl = ex*ex + ey*ey;
+            const double d = 0.5 / (dx*ey - dy*ex);
+            x = mXY[2*a] + (ey*bl - dy*cl) * d;
+            y = mXY[2*a + 1] + (dx*cl - ex*bl) * d;
+        }
+
+        /// Pseudo-angle of the point around the circumcentre of the seed triangle, discretised in the hash size
+        std::size_t HashKey(const double& x, const double& y) const
+        {
+            const double dx = x - mCx;
+            const double dy = y - mCy;
+            const double s = std::abs(dx) + std::abs(dy);
+            if(s == 0.0)
+                return 0;
+            const double p = dx / s;
+            const double angle = (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0; // in [0, 1)
+            return static_cast<std::size_t>(std::floor(angle * mHashSize)) % mHashSize;
+        }
+
+        void Link(const int& a, const int& b)
+        {
+            mHalfedges[a] = b;
+            if(b != -1)
+                mHalfedges[b] = a;
+        }
+
+        int AddTriangle(const int& i0, const int& i1, const int& i2, const int& a, const int& b, const int& c)
+        {
+            const int t = static_cast<int>(mTrianglesLen);
+            mTriangles[t] = i0;
+            mTriangles[t + 1] = i1;
+            mTriangles[t + 2] = i2;
+            Link(t, a);
+            Link(t + 1, b);
+            Link(t + 2, c);
+            mTrianglesLen += 3;
+            return t;
+        }
+
+        /// Flip the half-edge a and the following edges recursively until the Delaunay condition is satisfied.
+        /// Return the half-edge which replaces the edge after a in its triangle.
+        int Legalize(int a)
+        {
+            int ar = 0;
+            mEdgeStack.clear();
+            while(true)
+            {
+                const int b = mHalfedges[a];
+
+                // if the pair of triangles p0-pr-pl and pr-p1-pl does not satisfy the Delaunay condition (p1 is inside
+                // the circumcircle of p0-pr-pl), flip the edge pr-pl to p0-p1 and check the new pairs of triangles
+                const int a0 = a - a % 3;
+                ar = a0 + (a + 2) % 3;
+
+                if(b == -1) // hull edge
+                {
+                    if(mEdgeStack.empty()) break;
+                    a = mEdgeStack.back();
+                    mEdgeStack.pop_back();
+                    continue;
+                }
+
+                const int b0 = b - b % 3;
+                const int al = a0 + (a + 1) % 3;
+                const int bl = b0 + (b + 2) % 3;
+
+                const int p0 = mTriangles[ar];
+                const int pr = mTriangles[a];
+                const int pl = mTriangles[al];
+                const int p1 = mTriangles[bl];
+
+                if(InCircle(p0, pr, pl, p1))
+                {
+                    mTriangles[a] = p1;
+                    mTriangles[b] = p0;
+
+                    const int hbl = mHalfedges[bl];
+
+                    // the edge is swapped on the other side of the hull (rare), fix the half-edge reference
+                    if(hbl == -1)
+                    {
+                        int e = mHullStart;
+                        do
+                        {
+                            if(mHullTri[e] == bl)
+                            {
+                                mHullTri[e] = a;
+                                break;
+                            }
+                            e = mHullPrev[e];
+                        }
+                        while(e != mHullStart);
+                    }
+
+                    Link(a, hbl);
+                    Link(b, mHalfedges[ar]);
+                    Link(ar, bl);
+
+                    mEdgeStack.push_back(b0 + (b + 1) % 3);
+                }
+                else
+                {
+                    if(mEdgeStack.empty()) break;
+                    a = mEdgeStack.back();
+                    mEdgeStack.pop_back();
+                }
+            }
+
+            return ar;
+        }
+    };
+
 //****************************************************************************80
 
 void alpha_measure ( int n, double z[], int triangle_order, int triangle_num,
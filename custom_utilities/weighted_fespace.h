@@ -71,6 +71,9 @@ public:
     /// Get the weight vector
     const std::vector<double>& Weights() const {return mWeights;}
 
+    /// Get the underlying (unweighted) FESpace
+    typename BaseType::ConstPointer pFESpace() const {return mpFESpace;}
+
     /// Get the string representing the type of the WeightedFESpace
     virtual std::string Type() const
     {
@@ -110,6 +113,27 @@ public:
         return new_values;
     }
 
+    /// Get the local indices and the values of the non-zero basis functions at point xi.
+    /// The rational functions share the support of the underlying FESpace, hence only its non-zero values are weighted.
+    virtual void GetNonZeroValues(const std::vector<double>& xi, std::vector<std::size_t>& rIndices, std::vector<double>& rValues) const
+    {
+        mpFESpace->GetNonZeroValues(xi, rIndices, rValues);
+        double sum_value = 0.0;
+        for (std::size_t i = 0; i < rValues.size(); ++i)
+        {
+            rValues[i] *= mWeights[rIndices[i]];
+            sum_value += rValues[i];
+        }
+        for (std::size_t i = 0; i < rValues.size(); ++i)
+            rValues[i] /= sum_value;
+    }
+
+    /// Create the search structures of the underlying FESpace
+    virtual void UpdateSearchMaps() const
+    {
+        mpFESpace->UpdateSearchMaps();
+    }
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////
 
     /// Enumerate the dofs of each grid function. The enumeration algorithm is pretty straightforward.
@@ -0,0 +1,442 @@
+#include <cstdlib>
+#include <cmath>
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+#include "custom_utilities/control_point.h"
+#include "custom_utilities/nurbs/structured_control_grid.h"
+#include "custom_utilities/bspline_utils.h"
+
+using namespace Kratos;
+
+typedef ControlPoint<double> ControlPointType;
+
+/// The original bspdegelev-based routine of BSplineUtils, before it was replaced by DegreeElevationEngine.
+/// It is kept here verbatim as the reference of the speed-up and of the equivalence of the results.
+namespace reference
+{
+
+/* Compute logarithm of the gamma function */
+/* Algorithm from 'Numerical Recipes in C, 2nd Edition' pg214. */
+double gammaln(const double& xx)
+{
+    double x,y,tmp,ser;
+    static double cof[6] = {76.18009172947146,-86.50532032291677,
+                            24.01409824083091,-1.231739572450155,
+                            0.12086650973866179e-2, -0.5395239384953e-5};
+    int j;
+    y = x = xx;
+    tmp = x + 5.5;
+    tmp -= (x+0.5) * log(tmp);
+    ser = 1.000000000190015;
+    for (j=0; j<=5; j++) ser += cof[j]/++y;
+    return -tmp+log(2.5066282746310005*ser/x);
+}
+
+/* computes ln(n!) */
+/* Numerical Recipes in C */
+/* Algorithm from 'Numerical Recipes in C, 2nd Edition' pg215. */
+double factln(const int& n)
+{
+    static int ntop = 0;
+    static double a[101];
+
+    if (n <= 1) return 0.0;
+    while (n > ntop)
+    {
+        ++ntop;
+        a[ntop] = gammaln(ntop+1.0);
+    }
+    return a[n];
+}
+
+/* Algorithm from 'Numerical Recipes in C, 2nd Edition' pg215. */
+double bincoeff(const int& n, const int& k)
+{
+    return floor(0.5+exp(factln(n)-factln(k)-factln(n-k)));
+}
+
+/* "Adapted" modified version of Algorithm A5.9 from 'The NURBS BOOK' pg206. */
+/// @param d    degree of the B-Splines
+/// @param c    value container of the control points. Control points are the matrix [mc x nc]
+/// @param mc   dimension of the control point
+/// @param nc   number of control points
+/// @param k    value container of the knot vector
+/// @param nk   number of knots
+/// @param t    the order increment
+/// @param nh   number of resulted control points (maybe)
+/// @param ic   new control points
+/// @param ik   new knots
+/// REF: int bspdegelev(int d, double *c, int mc, int nc, double *k, int nk,
+///                          int t, int *nh, double *ic, double *ik)
+/// REMARKS: This function can also be used to elevate the degree of NURBS
+template<typename TDataType, class ValuesContainerType, class ValuesContainerType1, class ValuesContainerType2>
+int ComputeBsplinesDegreeElevation1D(const int& d, // order of B-Splines
+        const ValuesContainerType& ctrl, // control values
+        const ValuesContainerType1& k, // knot vector
+        const int& t, // order increment
+        ValuesContainerType& ictrl, // new control values
+        ValuesContainerType2& ik, // new knot vector
+        const TDataType& zero) // a sample zero control value to avoid explicit declaring TDataType
+{
+  int nc = ctrl.size();
+  int nk = k.size();
+  int row, col;
+
+  int ierr = 0;
+  int i, j, q, s, m, ph, ph2, mpi, mh, nh, r, a, b, cind, oldr, mul;
+  int n, lbz, rbz, save, tr, kj, first, kind, last, bet, ii;
+  int nic, nik;
+  double inv, ua, ub, numer, den, alf, gam;
+  double **bezalfs, *alfs;
+
+  /* allocate work space t times larger than original number */
+  /* of control points and knots */
+  ik.resize(nk*(t+1));
+  ictrl.resize(nc*(t+1));
+
+  n = nc - 1;
+
+  // bezalfs = matrix(d+1,d+t+1);
+  // bezalfs = (double**) calloc(d+1, sizeof(double*));
+  // for (int i = 0; i < d+1; ++i)
+  //   bezalfs[i] = (double*) calloc(d+t+1, sizeof(double));
+  bezalfs = (double**) calloc(d+t+1, sizeof(double*));
+  for (int i = 0; i < d+t+1; ++i)
+    bezalfs[i] = (double*) calloc(d+1, sizeof(double));
+
+  ValuesContainerType bpts(d+1);
+  ValuesContainerType ebpts(d+t+1);
+  ValuesContainerType Nextbpts(d+1);
+  alfs = (double *) calloc(d, sizeof(double));
+
+  m = n + d + 1;
+  ph = d + t;
+  ph2 = ph / 2;
+
+  /* compute bezier degree elevation coefficients   */
+  bezalfs[0][0] = bezalfs[ph][d] = 1.0;
+
+  for (i = 1; i <= ph2; i++)
+  {
+    inv = 1.0 / bincoeff(ph,i);
+    mpi = std::min(d,i);
+
+    for (j = std::max(0,i-t); j <= mpi; j++)
+      bezalfs[i][j] = inv * bincoeff(d,j) * bincoeff(t,i-j);
+  }
+
+  for (i = ph2+1; i <= ph-1; i++)
+  {
+    mpi = std::min(d, i);
+    for (j = std::max(0,i-t); j <= mpi; j++)
+      bezalfs[i][j] = bezalfs[ph-i][d-j];
+  }
+
+  mh = ph;
+  kind = ph+1;
+  r = -1;
+  a = d;
+  b = d+1;
+  cind = 1;
+  ua = k[0];
+
+  ictrl[0] = ctrl[0];
+
+  for (i = 0; i <= ph; i++)
+    ik[i] = ua;
+
+  /* initialise first bezier seg */
+  for (i = 0; i <= d; i++)
+      bpts[i] = ctrl[i];
+
+  /* big loop thru knot vector */
+  while (b < m)
+  {
+    i = b;
+    while (b < m && k[b] == k[b+1])
+      b++;
+
+    mul = b - i + 1;
+    mh += mul + t;
+    ub = k[b];
+    oldr = r;
+    r = d - mul;
+
+    /* insert knot u(b) r times */
+    if (oldr > 0)
+      lbz = (oldr+2) / 2;
+    else
+      lbz = 1;
+
+    if (r > 0)
+      rbz = ph - (r+1)/2;
+    else
+      rbz = ph;
+
+    if (r > 0)
+    {
+      /* insert knot to get bezier segment */
+      numer = ub - ua;
+      for (q = d; q > mul; q--)
+        alfs[q-mul-1] = numer / (k[a+q]-ua);
+      for (j = 1; j <= r; j++)
+      {
+        save = r - j;
+        s = mul + j;
+
+        for (q = d; q >= s; q--)
+            bpts[q] = alfs[q-s]*bpts[q]+(1.0-alfs[q-s])*bpts[q-1];
+
+        Nextbpts[save] = bpts[d];
+      }
+    }
+    /* end of insert knot */
+
+    /* degree elevate bezier */
+    for (i = lbz; i <= ph; i++)
+    {
+      ebpts[i] = zero;
+      mpi = std::min(d, i);
+      for (j = std::max(0,i-t); j <= mpi; j++)
+        ebpts[i] = ebpts[i] + bezalfs[i][j]*bpts[j];
+    }
+    /* end of degree elevating bezier */
+
+    if (oldr > 1)
+    {
+      /* must remove knot u=k[a] oldr times */
+      first = kind - 2;
+      last = kind;
+      den = ub - ua;
+      bet = (ub-ik[kind-1]) / den;
+
+      /* knot removal loop */
+      for (tr = 1; tr < oldr; tr++)
+      {
+        i = first;
+        j = last;
+        kj = j - kind + 1;
+        while (j - i > tr)
+        {
+          /* loop and compute the new control points */
+         /* for one removal step    */
+          if (i < cind)
+          {
+            alf = (ub-ik[i])/(ua-ik[i]);
+            ictrl[i] = alf * ictrl[i] + (1.0-alf) * ictrl[i-1];
+          }
+          if (j >= lbz)
+          {
+            if (j-tr <= kind-ph+oldr)
+            {
+              gam = (ub-ik[j-tr]) / den;
+              ebpts[kj] = gam*ebpts[kj] + (1.0-gam)*ebpts[kj+1];
+            }
+            else
+            {
+              ebpts[kj] = bet*ebpts[kj] + (1.0-bet)*ebpts[kj+1];
+            }
+          }
+          i++;
+          j--;
+          kj--;
+        }
+
+        first--;
+        last++;
+      }
+    }
+    /* end of removing knot n=k[a] */
+
+    /* load the knot ua  */
+    if (a != d)
+      for (i = 0; i < ph-oldr; i++)
+      {
+        ik[kind] = ua;
+        kind++;
+      }
+
+    /* load ctrl pts into ic  */
+    for (j = lbz; j <= rbz; j++)
+    {
+      ictrl[cind] = ebpts[j];
+      cind++;
+    }
+
+    if (b < m)
+    {
+      /* setup for next pass thru loop  */
+      for (j = 0; j < r; j++)
+        bpts[j] = Nextbpts[j];
+      for (j = r; j <= d; j++)
+        bpts[j] = ctrl[b-d+j];
+      a = b;
+      b++;
+      ua = ub;
+    }
+    else
+      /* end knot  */
+      for (i = 0; i <= ph; i++)
+        ik[kind+i] = ub;
+  }
+  /* end while loop  */
+
+  nh = mh - ph - 1;
+  nic = nh + 1;
+  nik = nic + d + t + 1;
+
+  // resize to the new size
+  ictrl.resize(nic);
+  ik.resize(nik);
+
+  free(alfs);
+  // for (int i = 0; i < d+1; ++i)
+  for (int i = 0; i < d+t+1; ++i)
+    free(bezalfs[i]);
+  free(bezalfs);
+
+  return(ierr);
+}
+
+} // namespace reference
+
+/// Elevate the degree along one dimension line by line with the reference ComputeBsplinesDegreeElevation1D,
+/// i.e. the coefficients are recomputed and the work arrays are allocated for every line.
+template<typename TDataType>
+void ElevateLineByLine(std::vector<TDataType>& rValues, std::vector<std::size_t>& sizes, const std::size_t& dim,
+        const int& p, const std::vector<double>& knots, const int& t, std::vector<double>& new_knots)
+{
+    std::size_t stride = 1, nouter = 1;
+    for (std::size_t d = 0; d < dim; ++d) stride *= sizes[d];
+    for (std::size_t d = dim+1; d < sizes.size(); ++d) nouter *= sizes[d];
+    const std::size_t n = sizes[dim];
+    std::size_t new_n = 0;
+    std::vector<TDataType> new_values;
+
+    for (std::size_t a = 0; a < nouter; ++a)
+    {
+        for (std::size_t b = 0; b < stride; ++b)
+        {
+            std::vector<TDataType> line(n), new_line;
+            for (std::size_t i = 0; i < n; ++i)
+                line[i] = rValues[b + stride*(i + n*a)];
+
+            reference::ComputeBsplinesDegreeElevation1D(p, line, knots, t, new_line, new_knots, TDataType(0.0));
+
+            if (new_values.size() == 0)
+            {
+                new_n = new_line.size();
+                new_values.resize(stride*new_n*nouter);
+            }
+
+            for (std::size_t i = 0; i < new_n; ++i)
+                new_values[b + stride*(i + new_n*a)] = new_line[i];
+        }
+    }
+
+    rValues.swap(new_values);
+    sizes[dim] = new_n;
+}
+
+/// Benchmark the degree elevation of a 3D B-Splines patch with n x n x n control points of order p.
+/// Usage: benchmark_degree_elevation [n] [order] [order increment] [repeats]
+/// Each line of output is: method,type,n,p,t,new control points,seconds,max difference to the reference
+int main(int argc, char** argv)
+{
+    int n = (argc > 1) ? std::atoi(argv[1]) : 40;
+    int p = (argc > 2) ? std::atoi(argv[2]) : 2;
+    int t = (argc > 3) ? std::atoi(argv[3]) : 1;
+    int nrepeats = (argc > 4) ? std::atoi(argv[4]) : 3;
+
+    // open knot vector with every third interior knot repeated, to exercise the knot removal
+    std::vector<int> interior;
+    for (int i = 1; (int) interior.size() < n - p - 1; ++i)
+    {
+        interior.push_back(i);
+        if (i % 3 == 0 && p > 1 && (int) interior.size() < n - p - 1)
+            interior.push_back(i);
+    }
+    std::vector<double> knots(p+1, 0.0);
+    for (std::size_t i = 0; i < interior.size(); ++i)
+        knots.push_back((double) interior[i] / (interior.back() + 1));
+    for (int i = 0; i <= p; ++i)
+        knots.push_back(1.0);
+
+    StructuredControlGrid<3, double> values(n, n, n);
+    StructuredControlGrid<3, ControlPointType> points(n, n, n);
+    for (int k = 0; k < n; ++k)
+        for (int j = 0; j < n; ++j)
+            for (int i = 0; i < n; ++i)
+            {
+                double w = 1.0 + 0.1*std::sin((double) (i + 2*j + 3*k));
+                values(i, j, k) = std::cos(0.1*i) * std::sin(0.2*j) + 0.01*k;
+                points(i, j, k) = ControlPointType(w*i, w*j, w*k, w);
+            }
+
+    // values
+    {
+        double elapsed_old = 0.0, elapsed_new = 0.0;
+        std::vector<double> ref;
+        StructuredControlGrid<3, double> new_values(1, 1, 1);
+        for (int r = 0; r < nrepeats; ++r)
+        {
+            double start = OpenMPUtils::GetCurrentTime();
+            ref.assign(values.Data().begin(), values.Data().end());
+            std::vector<std::size_t> sizes(3, n);
+            std::vector<double> new_knots;
+            ElevateLineByLine(ref, sizes, 2, p, knots, t, new_knots);
+            ElevateLineByLine(ref, sizes, 1, p, knots, t, new_knots);
+            ElevateLineByLine(ref, sizes, 0, p, knots, t, new_knots);
+            elapsed_old += OpenMPUtils::GetCurrentTime() - start;
+
+            start = OpenMPUtils::GetCurrentTime();
+            std::vector<double> ik1, ik2, ik3;
+            BSplineUtils::ComputeBsplinesDegreeElevation3D(p, p, p, values, knots, knots, knots, t, t, t, new_values, ik1, ik2, ik3, 0.0);
+            elapsed_new += OpenMPUtils::GetCurrentTime() - start;
+        }
+
+        double diff = 0.0;
+        for (std::size_t i = 0; i < ref.size(); ++i)
+            diff = std::max(diff, std::abs(ref[i] - new_values[i]));
+
+        std::cout << "reference,double," << n << "," << p << "," << t << "," << ref.size() << "," << elapsed_old / nrepeats << ",0" << std::endl;
+        std::cout << "engine,double," << n << "," << p << "," << t << "," << new_values.Size() << "," << elapsed_new / nrepeats << "," << diff << std::endl;
+    }
+
+    // homogeneous control points
+    {
+        double elapsed_old = 0.0, elapsed_new = 0.0;
+        std::vector<ControlPointType> ref;
+        StructuredControlGrid<3, ControlPointType> new_points(1, 1, 1);
+        for (int r = 0; r < nrepeats; ++r)
+        {
+            double start = OpenMPUtils::GetCurrentTime();
+            ref.assign(points.Data().begin(), points.Data().end());
+            std::vector<std::size_t> sizes(3, n);
+            std::vector<double> new_knots;
+            ElevateLineByLine(ref, sizes, 2, p, knots, t, new_knots);
+            ElevateLineByLine(ref, sizes, 1, p, knots, t, new_knots);
+            ElevateLineByLine(ref, sizes, 0, p, knots, t, new_knots);
+            elapsed_old += OpenMPUtils::GetCurrentTime() - start;
+
+            start = OpenMPUtils::GetCurrentTime();
+            std::vector<double> ik1, ik2, ik3;
+            BSplineUtils::ComputeBsplinesDegreeElevation3D(p, p, p, points, knots, knots, knots, t, t, t, new_points, ik1, ik2, ik3, ControlPointType(0.0));
+            elapsed_new += OpenMPUtils::GetCurrentTime() - start;
+        }
+
+        double diff = 0.0;
+        for (std::size_t i = 0; i < ref.size(); ++i)
+        {
+            diff = std::max(diff, std::abs(ref[i].WX() - new_points[i].WX()));
+            diff = std::max(diff, std::abs(ref[i].WY() - new_points[i].WY()));
+            diff = std::max(diff, std::abs(ref[i].WZ() - new_points[i].WZ()));
+            diff = std::max(diff, std::abs(ref[i].W() - new_points[i].W()));
+        }
+
+        std::cout << "reference,control point," << n << "," << p << "," << t << "," << ref.size() << "," << elapsed_old / nrepeats << ",0" << std::endl;
+        std::cout << "engine,control point," << n << "," << p << "," << t << "," << new_points.Size() << "," << elapsed_new / nrepeats << "," << diff << std::endl;
+    }
+
+    return 0;
+}
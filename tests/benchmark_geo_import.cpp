@@ -0,0 +1,130 @@
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <boost/algorithm/string.hpp>
+#include "includes/define.h"
+#include "utilities/openmp_utils.h"
+#include "custom_utilities/import_export/multi_nurbs_patch_geo_importer.h"
+
+using namespace Kratos;
+
+/// Write a geo file (v.2.1) with npatches 3D patches of n x n x n control points of order p, with the given number of significant digits
+void WriteGeoFile(const std::string& filename, const std::size_t& npatches, const std::size_t& n, const std::size_t& p, const int& digits)
+{
+    std::ofstream outfile(filename.c_str());
+    outfile << std::setprecision(digits);
+    outfile << "# nurbs mesh v.2.1\n";
+    outfile << "# benchmark\n";
+    outfile << "3 3 " << npatches << " 0 0\n";
+
+    const std::size_t total = n*n*n;
+    for (std::size_t ip = 0; ip < npatches; ++ip)
+    {
+        outfile << "PATCH " << ip+1 << "\n";
+        outfile << p << " " << p << " " << p << "\n";
+        outfile << n << " " << n << " " << n << "\n";
+        for (std::size_t dim = 0; dim < 3; ++dim)
+        {
+            for (std::size_t i = 0; i <= p; ++i)
+                outfile << " " << 0.0;
+            for (std::size_t i = 1; i < n - p; ++i)
+                outfile << " " << (double) i / (n - p);
+            for (std::size_t i = 0; i <= p; ++i)
+                outfile << " " << 1.0;
+            outfile << "\n";
+        }
+        for (std::size_t dim = 0; dim < 3; ++dim)
+        {
+            for (std::size_t i = 0; i < total; ++i)
+                outfile << " " << (ip + 1.0) * std::sin(0.001*i + dim);
+            outfile << "\n";
+        }
+        for (std::size_t i = 0; i < total; ++i)
+            outfile << " " << 1.0 + 0.1*std::cos(0.01*i);
+        outfile << "\n";
+    }
+}
+
+/// Parse all the numbers of a geo file line by line as the previous importer did (std::getline, boost::split, atof)
+std::size_t ReadGeoFileLineByLine(const std::string& filename)
+{
+    std::ifstream infile(filename.c_str());
+    std::string line;
+    std::vector<std::string> words;
+    std::vector<double> values;
+    while(!infile.eof())
+    {
+        std::getline(infile, line);
+        boost::trim_if(line, boost::is_any_of("\t "));
+        boost::split(words, line, boost::is_any_of(" \t"), boost::token_compress_on);
+        if (words.size() == 0 || words[0].size() == 0 || words[0][0] == '#' || words[0] == "PATCH")
+            continue;
+        for (std::size_t i = 0; i < words.size(); ++i)
+            values.push_back(atof(words[i].c_str()));
+    }
+    return values.size();
+}
+
+/// Benchmark the import of NURBS patches from geo file.
+/// Usage: benchmark_geo_import [n] [number of patches] [order] [repeats] [significant digits]
+/// Each line of output is: method,patches,n,MB,seconds,MB/s
+int main(int argc, char** argv)
+{
+    std::size_t n = (argc > 1) ? std::atoi(argv[1]) : 40;
+    std::size_t npatches = (argc > 2) ? std::atoi(argv[2]) : 8;
+    std::size_t p = (argc > 3) ? std::atoi(argv[3]) : 2;
+    int nrepeats = (argc > 4) ? std::atoi(argv[4]) : 3;
+    int digits = (argc > 5) ? std::atoi(argv[5]) : 15;
+
+    WriteGeoFile("benchmark_geo_import_single.geo", 1, n, p, digits);
+    WriteGeoFile("benchmark_geo_import_multi.geo", npatches, n, p, digits);
+
+    std::ifstream single_file("benchmark_geo_import_single.geo", std::ios::binary | std::ios::ate);
+    std::ifstream multi_file("benchmark_geo_import_multi.geo", std::ios::binary | std::ios::ate);
+    const double single_megabytes = (double) single_file.tellg() / 1.0e6;
+    const double multi_megabytes = (double) multi_file.tellg() / 1.0e6;
+
+    MultiNURBSPatchGeoImporter<3> importer;
+
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        ReadGeoFileLineByLine("benchmark_geo_import_single.geo");
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    elapsed /= nrepeats;
+    std::cout << "line-by-line," << 1 << "," << n << "," << single_megabytes << "," << elapsed << "," << single_megabytes / elapsed << std::endl;
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        Patch<3>::Pointer pPatch = importer.ImportSingle("benchmark_geo_import_single.geo");
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    elapsed /= nrepeats;
+    std::cout << "ImportSingle," << 1 << "," << n << "," << single_megabytes << "," << elapsed << "," << single_megabytes / elapsed << std::endl;
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        ReadGeoFileLineByLine("benchmark_geo_import_multi.geo");
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    elapsed /= nrepeats;
+    std::cout << "line-by-line," << npatches << "," << n << "," << multi_megabytes << "," << elapsed << "," << multi_megabytes / elapsed << std::endl;
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        MultiPatch<3>::Pointer pMultiPatch = importer.Import("benchmark_geo_import_multi.geo");
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    elapsed /= nrepeats;
+    std::cout << "Import," << npatches << "," << n << "," << multi_megabytes << "," << elapsed << "," << multi_megabytes / elapsed << std::endl;
+
+    return 0;
+}
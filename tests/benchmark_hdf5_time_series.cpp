@@ -0,0 +1,70 @@
+#include <cstdlib>
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/variables.h"
+#include "utilities/openmp_utils.h"
+#include "custom_utilities/hdf5_post_utility.h"
+#include "custom_utilities/hdf5_time_series_post_utility.h"
+
+using namespace Kratos;
+
+/// Benchmark the write bandwidth of the HDF5 post-processing for a structured 3D grid of n^3 nodes.
+/// Usage: benchmark_hdf5_time_series [n] [number of steps] [compression level] [shuffle]
+/// Each line of output is: method,n,nodes,steps,compression,shuffle,seconds,MB/s
+int main(int argc, char** argv)
+{
+    std::size_t n = (argc > 1) ? std::atoi(argv[1]) : 100;
+    std::size_t nsteps = (argc > 2) ? std::atoi(argv[2]) : 10;
+    int level = (argc > 3) ? std::atoi(argv[3]) : 0;
+    bool shuffle = (argc > 4) ? (std::atoi(argv[4]) != 0) : false;
+
+    ModelPart::Pointer pModelPart = ModelPart::Pointer(new ModelPart("benchmark"));
+    pModelPart->AddNodalSolutionStepVariable(DISPLACEMENT);
+    pModelPart->AddNodalSolutionStepVariable(TEMPERATURE);
+
+    std::size_t cnt = 0;
+    for (std::size_t k = 0; k < n; ++k)
+        for (std::size_t j = 0; j < n; ++j)
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                ModelPart::NodeType::Pointer pNode = pModelPart->CreateNewNode(++cnt, (double) i, (double) j, (double) k);
+                array_1d<double, 3>& d = pNode->GetSolutionStepValue(DISPLACEMENT);
+                d[0] = 1.0e-3*i; d[1] = 1.0e-3*j; d[2] = 1.0e-3*k;
+                pNode->GetSolutionStepValue(TEMPERATURE) = (double) (i + j + k);
+            }
+
+    const double megabytes = (double) (nsteps * cnt * 4 * sizeof(double)) / 1.0e6;
+
+    // one file per step, as in the original HDF5PostUtility
+    double start = OpenMPUtils::GetCurrentTime();
+    for (std::size_t step = 0; step < nsteps; ++step)
+    {
+        std::stringstream ss;
+        ss << "benchmark_hdf5_" << step << ".h5";
+        HDF5PostUtility post(ss.str());
+        post.WriteNodes(pModelPart);
+        post.WriteNodalResults(DISPLACEMENT, pModelPart);
+        post.WriteNodalResults(TEMPERATURE, pModelPart);
+    }
+    double elapsed = OpenMPUtils::GetCurrentTime() - start;
+    std::cout << "HDF5PostUtility," << n << "," << cnt << "," << nsteps << ",0,0,"
+              << elapsed << "," << megabytes / elapsed << std::endl;
+
+    // time series in one file
+    start = OpenMPUtils::GetCurrentTime();
+    HDF5TimeSeriesPostUtility series("benchmark_hdf5_time_series.h5");
+    series.SetCompressionLevel(level);
+    series.SetShuffle(shuffle);
+    series.WriteMesh(pModelPart);
+    for (std::size_t step = 0; step < nsteps; ++step)
+    {
+        series.BeginStep((double) step);
+        series.WriteNodalResults(DISPLACEMENT, pModelPart);
+        series.WriteNodalResults(TEMPERATURE, pModelPart);
+    }
+    elapsed = OpenMPUtils::GetCurrentTime() - start;
+    std::cout << "HDF5TimeSeriesPostUtility," << n << "," << cnt << "," << nsteps << "," << level << "," << shuffle << ","
+              << elapsed << "," << megabytes / elapsed << std::endl;
+
+    return 0;
+}
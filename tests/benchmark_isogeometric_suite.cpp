@@ -0,0 +1,711 @@
+#include <cstdlib>
+#include <cmath>
+#include <sstream>
+#include <fstream>
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/element.h"
+#include "includes/variables.h"
+#include "includes/kratos_components.h"
+#include "geometries/quadrilateral_2d_4.h"
+#include "geometries/hexahedra_3d_8.h"
+#include "spaces/ublas_space.h"
+#include "linear_solvers/cg_solver.h"
+#include "utilities/openmp_utils.h"
+#include "custom_geometries/geo_1d_bezier.h"
+#include "custom_geometries/geo_2d_bezier.h"
+#include "custom_geometries/geo_2d_bezier_3.h"
+#include "custom_geometries/geo_3d_bezier.h"
+#include "custom_utilities/bezier_utils.h"
+#include "custom_utilities/bezier_kernel.h"
+#include "custom_utilities/control_point.h"
+#include "custom_utilities/control_grid_library.h"
+#include "custom_utilities/trans/rotation.h"
+#include "custom_utilities/patch.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/nurbs/bsplines_fespace_library.h"
+#include "custom_utilities/hbsplines/hbsplines_patch_utility.h"
+#include "custom_utilities/hbsplines/hbsplines_refinement_utility.h"
+#include "custom_utilities/hbsplines/hbsplines_point_evaluator.h"
+#include "custom_utilities/hbsplines/deprecated_hb_mesh.h"
+#include "custom_utilities/nonconforming_variable_multipatch_lagrange_mesh.h"
+#include "custom_utilities/bezier_classical_post_utility.h"
+#include "custom_utilities/triangulation_utils.h"
+
+using namespace Kratos;
+
+typedef ControlPoint<double> ControlPointType;
+typedef Element::GeometryType GeometryType;
+typedef UblasSpace<double, CompressedMatrix, Vector> SparseSpaceType;
+typedef UblasSpace<double, Matrix, Vector> LocalSpaceType;
+
+/// Element giving a smooth field at its integration points, used as the source of the L2 projection
+class BenchmarkElement : public Element
+{
+public:
+    KRATOS_CLASS_POINTER_DEFINITION(BenchmarkElement);
+
+    BenchmarkElement(IndexType NewId, GeometryType::Pointer pGeometry, PropertiesType::Pointer pProperties)
+    : Element(NewId, pGeometry, pProperties)
+    {}
+
+    virtual ~BenchmarkElement() {}
+
+    virtual void GetValueOnIntegrationPoints(const Variable<double>& rVariable, std::vector<double>& rValues, const ProcessInfo& rCurrentProcessInfo)
+    {
+        for (std::size_t i = 0; i < rValues.size(); ++i)
+            rValues[i] = std::sin(0.01*this->Id() + 0.1*i);
+    }
+};
+
+/// Redirect std::cout to nowhere in the scope, to keep the output of the benchmark machine-readable
+struct ScopedSilence
+{
+    ScopedSilence() : mpOldBuffer(std::cout.rdbuf(mNull.rdbuf())) {}
+    ~ScopedSilence() {std::cout.rdbuf(mpOldBuffer);}
+    std::stringstream mNull;
+    std::streambuf* mpOldBuffer;
+};
+
+/// Output one line of result
+void PrintResult(const std::string& name, const int& dim, const int& p, const std::size_t& ne, const double& elapsed, const double& checksum)
+{
+    std::cout << name << "," << dim << "," << p << "," << ne << "," << elapsed << "," << elapsed / ne << "," << checksum << std::endl;
+}
+
+/// Open uniform knot vector of ne elements of order p
+std::vector<double> UniformKnots(const std::size_t& ne, const int& p)
+{
+    std::vector<double> knots(p+1, 0.0);
+    for (std::size_t i = 1; i < ne; ++i)
+        knots.push_back((double) i / ne);
+    for (int i = 0; i <= p; ++i)
+        knots.push_back(1.0);
+    return knots;
+}
+
+/// Create a B-Splines patch on the unit square/cube of n elements of order p in each direction, with the control point grid
+template<int TDim>
+typename Patch<TDim>::Pointer CreatePatch(const std::size_t& n, const int& p)
+{
+    typename BSplinesFESpace<TDim>::Pointer pFESpace = BSplinesFESpace<TDim>::Create();
+    for (int dim = 0; dim < TDim; ++dim)
+    {
+        pFESpace->SetKnotVector(dim, UniformKnots(n, p));
+        pFESpace->SetInfo(dim, n+p, p);
+    }
+    pFESpace->ResetFunctionIndices();
+    std::size_t start = 0;
+    pFESpace->Enumerate(start);
+
+    typename Patch<TDim>::Pointer pPatch = Patch<TDim>::Create(1, pFESpace);
+
+    std::vector<double> corner_start(3, 0.0), corner_end(3, 0.0);
+    std::vector<std::size_t> ngrid(TDim, n+p);
+    for (int dim = 0; dim < TDim; ++dim)
+        corner_end[dim] = 1.0;
+    pPatch->CreateControlPointGridFunction(ControlGridLibrary::CreateStructuredControlPointGrid<TDim>(corner_start, ngrid, corner_end));
+
+    return pPatch;
+}
+
+/// Time the Bezier extraction on the whole patch
+template<int TDim>
+void BenchmarkBezierExtraction(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    std::vector<double> U = UniformKnots(n, p);
+    std::vector<Matrix> C;
+    int nb1, nb2, nb3;
+
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        if (TDim == 1)
+            BezierUtils::bezier_extraction_1d(C, nb1, U, p);
+        else if (TDim == 2)
+            BezierUtils::bezier_extraction_2d(C, nb1, nb2, U, U, p, p);
+        else if (TDim == 3)
+            BezierUtils::bezier_extraction_3d(C, nb1, nb2, nb3, U, U, U, p, p, p);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+
+    double checksum = 0.0;
+    for (std::size_t i = 0; i < C.size(); ++i)
+        for (std::size_t j = 0; j < C[i].size1(); ++j)
+            for (std::size_t k = 0; k < C[i].size2(); ++k)
+                checksum += C[i](j, k);
+
+    std::stringstream name;
+    name << "bezier_extraction_" << TDim << "d";
+    PrintResult(name.str(), TDim, p, C.size(), elapsed / nrepeats, checksum);
+}
+
+/// Time CalculateShapeFunctionsIntegrationPointsValuesAndLocalGradients on all the Bezier geometries of the patch
+template<int TDim, class TGeometryType>
+void BenchmarkShapeFunctions(const std::string& name, const std::size_t& n, const int& p, const int& nrepeats)
+{
+    typename Patch<TDim>::Pointer pPatch = CreatePatch<TDim>(n, p);
+    typename ControlGrid<ControlPointType>::ConstPointer pControlGrid = pPatch->pControlPointGridFunction()->pControlGrid();
+
+    std::vector<Node<3>::Pointer> nodes(pControlGrid->size());
+    for (std::size_t i = 0; i < pControlGrid->size(); ++i)
+    {
+        const ControlPointType& point = pControlGrid->GetData(i);
+        nodes[i] = Node<3>::Pointer(new Node<3>(i+1, point.X(), point.Y(), (TDim == 2) ? 0.1*std::sin(point.X() + point.Y()) : point.Z()));
+    }
+
+    typename FESpace<TDim>::cell_container_t::Pointer pCellManager = pPatch->pFESpace()->ConstructCellManager();
+    std::vector<typename TGeometryType::Pointer> geometries;
+    Vector dummy;
+    for (typename FESpace<TDim>::cell_container_t::iterator it_cell = pCellManager->begin(); it_cell != pCellManager->end(); ++it_cell)
+    {
+        const std::vector<std::size_t>& anchors = (*it_cell)->GetSupportedAnchors();
+        GeometryType::PointsArrayType points;
+        Vector weights(anchors.size());
+        for (std::size_t i = 0; i < anchors.size(); ++i)
+        {
+            points.push_back(nodes[anchors[i]]);
+            weights[i] = pControlGrid->GetData(anchors[i]).W();
+        }
+
+        typename TGeometryType::Pointer pGeometry = typename TGeometryType::Pointer(new TGeometryType(points));
+        pGeometry->AssignGeometryData(dummy, dummy, dummy, weights, (*it_cell)->GetExtractionOperator(), p, p, p, 1);
+        geometries.push_back(pGeometry);
+    }
+
+    Matrix Ncontainer;
+    GeometryType::ShapeFunctionsGradientsType DN_De;
+    double checksum = 0.0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        checksum = 0.0;
+        double start = OpenMPUtils::GetCurrentTime();
+        for (std::size_t i = 0; i < geometries.size(); ++i)
+        {
+            geometries[i]->CalculateShapeFunctionsIntegrationPointsValuesAndLocalGradients(Ncontainer, DN_De, geometries[i]->GetDefaultIntegrationMethod());
+            checksum += Ncontainer(0, 0) + DN_De[0](0, 0);
+        }
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+
+    PrintResult(name, TDim, p, geometries.size(), elapsed / nrepeats, checksum);
+}
+
+/// Time the construction of the cell manager of the B-Splines FESpace
+template<int TDim>
+void BenchmarkCellManager(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    typename Patch<TDim>::Pointer pPatch = CreatePatch<TDim>(n, p);
+
+    std::size_t ncells = 0;
+    double checksum = 0.0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        typename FESpace<TDim>::cell_container_t::Pointer pCellManager = pPatch->pFESpace()->ConstructCellManager();
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+
+        ncells = pCellManager->size();
+        checksum = 0.0;
+        for (typename FESpace<TDim>::cell_container_t::iterator it_cell = pCellManager->begin(); it_cell != pCellManager->end(); ++it_cell)
+            checksum += (*it_cell)->GetSupportedAnchors().size();
+    }
+
+    PrintResult("construct_cell_manager", TDim, p, ncells, elapsed / nrepeats, checksum);
+}
+
+/// Time GridFunction::GetValue of the control point grid function on npoints scattered points.
+/// The time per element column is the time per evaluation.
+template<int TDim>
+void BenchmarkGridFunction(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    typename Patch<TDim>::Pointer pPatch = CreatePatch<TDim>(n, p);
+    typename GridFunction<TDim, ControlPointType>::Pointer pGridFunc = pPatch->pControlPointGridFunction();
+
+    const std::size_t npoints = 1000;
+    std::vector<std::vector<double> > xi(npoints, std::vector<double>(TDim));
+    for (std::size_t i = 0; i < npoints; ++i)
+        for (int dim = 0; dim < TDim; ++dim)
+            xi[i][dim] = 0.5 + 0.49*std::sin(1.3*i + 0.7*dim);
+
+    double checksum = 0.0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        checksum = 0.0;
+        double start = OpenMPUtils::GetCurrentTime();
+        for (std::size_t i = 0; i < npoints; ++i)
+            checksum += pGridFunc->GetValue(xi[i]).X();
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+
+    std::cout << "grid_function_get_value," << TDim << "," << p << "," << (std::size_t) std::pow(n, TDim) << "," << elapsed / nrepeats
+              << "," << elapsed / nrepeats / npoints << "," << checksum << std::endl;
+}
+
+/// Time the extraction of the control weights and the homogeneous transformation of the control point grid, point by point
+/// through GetData/SetData and in bulk on the contiguous storage by ControlGridUtility
+template<int TDim>
+void BenchmarkControlPoints(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    typename Patch<TDim>::Pointer pPatch = CreatePatch<TDim>(n, p);
+    typename ControlGrid<ControlPointType>::Pointer pControlPointGrid = pPatch->pControlPointGridFunction()->pControlGrid();
+    const std::size_t npoints = pControlPointGrid->size();
+    const Rotation<2, double> trans(1.0e-3);
+
+    double checksum = 0.0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        std::vector<double> weights(npoints);
+        for (std::size_t i = 0; i < npoints; ++i)
+            weights[i] = pControlPointGrid->GetData(i).W();
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+        checksum = weights[npoints / 2];
+    }
+    PrintResult("control_weights_pointwise", TDim, p, npoints, elapsed / nrepeats, checksum);
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        std::vector<double> weights = pPatch->GetControlWeights();
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+        checksum = weights[npoints / 2];
+    }
+    PrintResult("control_weights_bulk", TDim, p, npoints, elapsed / nrepeats, checksum);
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        for (std::size_t i = 0; i < npoints; ++i)
+        {
+            ControlPointType point = pControlPointGrid->GetData(i);
+            point.ApplyTransformation(trans);
+            pControlPointGrid->SetData(i, point);
+        }
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    checksum = pControlPointGrid->GetData(npoints / 2).X();
+    PrintResult("control_points_transform_pointwise", TDim, p, npoints, elapsed / nrepeats, checksum);
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        pPatch->ApplyTransformation(trans);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    checksum = pControlPointGrid->GetData(npoints / 2).X();
+    PrintResult("control_points_transform_bulk", TDim, p, npoints, elapsed / nrepeats, checksum);
+}
+
+/// Time the refinement of all the level-1 hierarchical B-Splines basis functions supported in the corner [0, 0.5]^d
+template<int TDim>
+void BenchmarkHBRefinement(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    std::vector<std::vector<double> > window(TDim, std::vector<double>{0.0, 0.5});
+
+    std::size_t nfunctions = 0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        typename Patch<TDim>::Pointer pPatch = HBSplinesPatchUtility::CreatePatchFromBSplines<TDim>(CreatePatch<TDim>(n, p));
+
+        ScopedSilence silence;
+        double start = OpenMPUtils::GetCurrentTime();
+        HBSplinesRefinementUtility::RefineWindow<TDim>(pPatch, window, 0);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+
+        nfunctions = pPatch->pFESpace()->TotalNumber();
+    }
+
+    PrintResult("hb_refinement", TDim, p, (std::size_t) std::pow(n, TDim), elapsed / nrepeats, nfunctions);
+}
+
+/// Time the evaluation of the control point grid function of a hierarchical B-Splines patch, refined in the corner [0, 0.5]^d, on npoints
+/// scattered points, by GridFunction::GetValue point by point and by HBSplinesPointEvaluator in batch (including its construction).
+/// The time per element column is the time per evaluation.
+template<int TDim>
+void BenchmarkHBGridFunction(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    std::vector<std::vector<double> > window(TDim, std::vector<double>{0.0, 0.5});
+    typename Patch<TDim>::Pointer pPatch = HBSplinesPatchUtility::CreatePatchFromBSplines<TDim>(CreatePatch<TDim>(n, p));
+    {
+        ScopedSilence silence;
+        HBSplinesRefinementUtility::RefineWindow<TDim>(pPatch, window, 0);
+    }
+    typename HBSplinesFESpace<TDim>::Pointer pFESpace = boost::dynamic_pointer_cast<HBSplinesFESpace<TDim> >(pPatch->pFESpace());
+    typename GridFunction<TDim, ControlPointType>::Pointer pGridFunc = pPatch->pControlPointGridFunction();
+    pFESpace->ConstructCellManager(); // as after the analysis, the extraction operators are up-to-date
+
+    const std::size_t npoints = 1000;
+    std::vector<std::vector<double> > xi(npoints, std::vector<double>(TDim));
+    for (std::size_t i = 0; i < npoints; ++i)
+        for (int dim = 0; dim < TDim; ++dim)
+            xi[i][dim] = 0.5 + 0.49*std::sin(1.3*i + 0.7*dim);
+
+    double checksum = 0.0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        checksum = 0.0;
+        double start = OpenMPUtils::GetCurrentTime();
+        for (std::size_t i = 0; i < npoints; ++i)
+            checksum += pGridFunc->GetValue(xi[i]).X();
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+
+    std::cout << "hb_grid_function_get_value," << TDim << "," << p << "," << (std::size_t) std::pow(n, TDim) << "," << elapsed / nrepeats
+              << "," << elapsed / nrepeats / npoints << "," << checksum << std::endl;
+
+    elapsed = 0.0;
+    std::vector<ControlPointType> results;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        checksum = 0.0;
+        double start = OpenMPUtils::GetCurrentTime();
+        HBSplinesPointEvaluator<TDim> evaluator(pFESpace, xi);
+        evaluator.Sample(results, *(pGridFunc->pControlGrid()), std::vector<double>());
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+        for (std::size_t i = 0; i < npoints; ++i)
+            checksum += results[i].X();
+    }
+
+    std::cout << "hb_point_evaluator," << TDim << "," << p << "," << (std::size_t) std::pow(n, TDim) << "," << elapsed / nrepeats
+              << "," << elapsed / nrepeats / npoints << "," << checksum << std::endl;
+}
+
+/// Time the generation of the post mesh by NonConformingVariableMultipatchLagrangeMesh, and the transfer of a variable to it.
+/// The patch is sampled with n divisions in each direction.
+template<int TDim>
+void BenchmarkPostMesh(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    typename Patch<TDim>::Pointer pPatch = CreatePatch<TDim>(n, p);
+    typename ControlGrid<double>::Pointer pTemperatureGrid = ControlGridLibrary::CreateStructuredZeroControlGrid<TDim>(TEMPERATURE, std::vector<std::size_t>(TDim, n+p));
+    for (std::size_t i = 0; i < pTemperatureGrid->size(); ++i)
+        pTemperatureGrid->SetData(i, std::sin(0.01*i));
+    pPatch->CreateGridFunction(TEMPERATURE, pTemperatureGrid);
+
+    typename MultiPatch<TDim>::Pointer pMultiPatch = typename MultiPatch<TDim>::Pointer(new MultiPatch<TDim>());
+    pMultiPatch->AddPatch(pPatch);
+
+    double elapsed_mesh = 0.0, elapsed_transfer = 0.0;
+    double checksum = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        ModelPart::Pointer pModelPartPost = ModelPart::Pointer(new ModelPart("benchmark_post"));
+        pModelPartPost->AddNodalSolutionStepVariable(TEMPERATURE);
+
+        NonConformingVariableMultipatchLagrangeMesh<TDim> post_mesh(pMultiPatch, pModelPartPost);
+        post_mesh.SetBaseElementName("BenchmarkElement");
+        post_mesh.SetUniformDivision(n);
+
+        ScopedSilence silence;
+        double start = OpenMPUtils::GetCurrentTime();
+        post_mesh.WriteModelPart();
+        elapsed_mesh += OpenMPUtils::GetCurrentTime() - start;
+
+        start = OpenMPUtils::GetCurrentTime();
+        post_mesh.TransferVariables(TEMPERATURE, pMultiPatch);
+        elapsed_transfer += OpenMPUtils::GetCurrentTime() - start;
+
+        checksum = 0.0;
+        for (ModelPart::NodeIterator it = pModelPartPost->NodesBegin(); it != pModelPartPost->NodesEnd(); ++it)
+            checksum += it->GetSolutionStepValue(TEMPERATURE);
+    }
+
+    const std::size_t ne = (std::size_t) std::pow(n, TDim);
+    PrintResult("post_mesh", TDim, p, ne, elapsed_mesh / nrepeats, ne);
+    PrintResult("post_transfer", TDim, p, ne, elapsed_transfer / nrepeats, checksum);
+}
+
+/// Time the L2 projection of the values at the integration points to the control points by BezierClassicalPostUtility
+template<int TDim, class TGeometryType>
+void BenchmarkL2Projection(const std::size_t& n, const int& p, const int& nrepeats)
+{
+    typename Patch<TDim>::Pointer pPatch = CreatePatch<TDim>(n, p);
+    typename ControlGrid<ControlPointType>::ConstPointer pControlGrid = pPatch->pControlPointGridFunction()->pControlGrid();
+
+    ModelPart::Pointer pModelPart = ModelPart::Pointer(new ModelPart("benchmark_l2"));
+    pModelPart->AddNodalSolutionStepVariable(TEMPERATURE);
+    for (std::size_t i = 0; i < pControlGrid->size(); ++i)
+    {
+        const ControlPointType& point = pControlGrid->GetData(i);
+        pModelPart->CreateNewNode(i+1, point.X(), point.Y(), point.Z());
+    }
+
+    Properties::Pointer pProperties = Properties::Pointer(new Properties(0));
+    pModelPart->AddProperties(pProperties);
+
+    typename FESpace<TDim>::cell_container_t::Pointer pCellManager = pPatch->pFESpace()->ConstructCellManager();
+    std::size_t ElementCounter = 0;
+    Vector dummy;
+    for (typename FESpace<TDim>::cell_container_t::iterator it_cell = pCellManager->begin(); it_cell != pCellManager->end(); ++it_cell)
+    {
+        const std::vector<std::size_t>& anchors = (*it_cell)->GetSupportedAnchors();
+        GeometryType::PointsArrayType points;
+        Vector weights(anchors.size());
+        for (std::size_t i = 0; i < anchors.size(); ++i)
+        {
+            points.push_back(pModelPart->pGetNode(anchors[i]+1));
+            weights[i] = pControlGrid->GetData(anchors[i]).W();
+        }
+
+        typename TGeometryType::Pointer pGeometry = typename TGeometryType::Pointer(new TGeometryType(points));
+        pGeometry->AssignGeometryData(dummy, dummy, dummy, weights, (*it_cell)->GetExtractionOperator(), p, p, p, 1);
+        pModelPart->AddElement(Element::Pointer(new BenchmarkElement(++ElementCounter, pGeometry, pProperties)));
+    }
+
+    BezierClassicalPostUtility::LinearSolverType::Pointer pSolver
+        = BezierClassicalPostUtility::LinearSolverType::Pointer(new CGSolver<SparseSpaceType, LocalSpaceType>(1.0e-10, 5000));
+    BezierClassicalPostUtility post_utility(pModelPart);
+
+    double checksum = 0.0;
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        ScopedSilence silence;
+        double start = OpenMPUtils::GetCurrentTime();
+        post_utility.TransferVariablesToNodes(TEMPERATURE, pModelPart, pSolver);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+
+        checksum = 0.0;
+        for (ModelPart::NodeIterator it = pModelPart->NodesBegin(); it != pModelPart->NodesEnd(); ++it)
+            checksum += it->GetSolutionStepValue(TEMPERATURE);
+    }
+
+    PrintResult("l2_projection", TDim, p, ElementCounter, elapsed / nrepeats, checksum);
+}
+
+/// Time the Delaunay triangulation of npoints quasi-random points in the unit square, by the sweep-hull algorithm and by r8tris2.
+/// r8tris2 is skipped above 10^5 points, since its time grows almost quadratically. The checksum is the number of triangles.
+void BenchmarkTriangulation(const std::size_t& npoints, const int& nrepeats)
+{
+    std::vector<double> XYlist(2*npoints);
+    for (std::size_t i = 0; i < npoints; ++i)
+    {
+        XYlist[2*i] = std::fmod(0.7548776662466927 * (i+1), 1.0);
+        XYlist[2*i+1] = std::fmod(0.5698402909980532 * (i+1), 1.0);
+    }
+
+    TriangulationUtils util;
+    std::vector<unsigned int> connectivities;
+
+    double elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        double start = OpenMPUtils::GetCurrentTime();
+        util.ComputeDelaunayTriangulation(XYlist, connectivities);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    PrintResult("triangulation_sweep_hull", 2, 1, npoints, elapsed / nrepeats, connectivities.size() / 3);
+
+    if (npoints > 100000)
+        return;
+
+    elapsed = 0.0;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        ScopedSilence silence;
+        double start = OpenMPUtils::GetCurrentTime();
+        util.ComputeDelaunayTriangulationR8Tris2(XYlist, connectivities);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+    }
+    PrintResult("triangulation_r8tris2", 2, 1, npoints, elapsed / nrepeats, connectivities.size() / 3);
+}
+
+/// Time the generation of the cell geology of the deprecated hierarchical B-Splines mesh (vertices and tetrahedralization of
+/// each cell), exported to a binary file, with 1, 2, 4 and 8 threads. The mesh of 3x3x3 quadratic elements is refined at the
+/// basis functions with Id from 1 to nrefines. The dimension column of the output is the number of threads and the checksum
+/// is the size of the binary file, which does not depend on the number of threads.
+void BenchmarkCellGeology(const std::size_t& nrefines, const int& nrepeats)
+{
+    const std::string geo_file = "benchmark_cell_geology.txt";
+    const std::string out_file = "benchmark_cell_geology.bin";
+    const int n = 5; // number of basis functions in each direction
+    const std::vector<double> knots = UniformKnots(n-2, 2);
+
+    std::ofstream geo(geo_file.c_str());
+    geo << "# dim npatches\n3 1\n# order\n2 2 2\n# number\n" << n << " " << n << " " << n << "\n# knots\n";
+    for (int dim = 0; dim < 3; ++dim)
+    {
+        for (std::size_t i = 0; i < knots.size(); ++i)
+            geo << knots[i] << " ";
+        geo << "\n";
+    }
+    geo << "# coordinates\n";
+    for (int dim = 0; dim < 3; ++dim)
+    {
+        for (int k = 0; k < n; ++k)
+            for (int j = 0; j < n; ++j)
+                for (int i = 0; i < n; ++i)
+                    geo << (double) ((dim == 0) ? i : ((dim == 1) ? j : k)) / (n-1) << " ";
+        geo << "\n";
+    }
+    geo << "# weights\n";
+    for (int i = 0; i < n*n*n; ++i)
+        geo << "1 ";
+    geo << "\n";
+    geo.close();
+
+    DeprecatedHBMesh<3> mesh(1, "benchmark_cell_geology");
+    {
+        ScopedSilence silence;
+        mesh.ReadMesh(geo_file);
+        for (std::size_t id = 1; id <= nrefines; ++id)
+            mesh.Refine(id);
+        mesh.BuildMesh();
+    }
+
+    const int max_threads = OpenMPUtils::GetNumThreads();
+    for (int nthreads = 1; nthreads <= 8; nthreads *= 2)
+    {
+        OpenMPUtils::SetNumThreads(nthreads);
+
+        double elapsed = 0.0;
+        for (int r = 0; r < nrepeats; ++r)
+        {
+            ScopedSilence silence;
+            double start = OpenMPUtils::GetCurrentTime();
+            mesh.ExportCellGeologyAsBinary(out_file);
+            elapsed += OpenMPUtils::GetCurrentTime() - start;
+        }
+
+        std::ifstream out(out_file.c_str(), std::ios::binary | std::ios::ate);
+        PrintResult("cell_geology", nthreads, 2, nrefines, elapsed / nrepeats, out.tellg());
+    }
+    OpenMPUtils::SetNumThreads(max_threads);
+}
+
+/// Benchmark suite of the computational kernels of the application, for tracking the performance regressions.
+/// Usage: benchmark_isogeometric_suite [max elements] [max degree] [case] [repeats]
+/// The number of elements goes from 10^2 to max elements by a factor of 10 (n = round(elements^(1/d)) in each direction),
+/// the degree from 1 to max degree. case is all (default), bezier_extraction, shape_functions, shape_functions_generic (without the
+/// kernels of fixed degrees), cell_manager, grid_function, control_points, hb_refinement, hb_grid_function, post_mesh, l2_projection,
+/// triangulation (elements is then the number of points, run for the degree 1 only) or cell_geology (elements/10 refinements, run
+/// for the degree 1 only, see BenchmarkCellGeology). The configurations storing more than 2GB of extraction operators are skipped.
+/// Each line of output is: case,dim,degree,elements,seconds,seconds per element,checksum
+int main(int argc, char** argv)
+{
+    std::size_t max_elements = (argc > 1) ? std::atoi(argv[1]) : 10000;
+    int max_degree = (argc > 2) ? std::atoi(argv[2]) : 5;
+    std::string which = (argc > 3) ? std::string(argv[3]) : std::string("all");
+    int nrepeats = (argc > 4) ? std::atoi(argv[4]) : 1;
+
+    // sample elements for the post mesh
+    static const Element sample_element_2d(0, GeometryType::Pointer(new Quadrilateral2D4<Node<3> >(GeometryType::PointsArrayType(4, Node<3>()))));
+    static const Element sample_element_3d(0, GeometryType::Pointer(new Hexahedra3D8<Node<3> >(GeometryType::PointsArrayType(8, Node<3>()))));
+    KratosComponents<Element>::Add("BenchmarkElement2D4N", sample_element_2d);
+    KratosComponents<Element>::Add("BenchmarkElement3D8N", sample_element_3d);
+
+    std::cout << "case,dim,degree,elements,seconds,seconds_per_element,checksum" << std::endl;
+
+    for (std::size_t elements = 100; elements <= max_elements; elements *= 10)
+    {
+        const std::size_t n1 = elements;
+        const std::size_t n2 = (std::size_t) std::floor(std::sqrt((double) elements) + 0.5);
+        const std::size_t n3 = (std::size_t) std::floor(std::pow((double) elements, 1.0/3) + 0.5);
+
+        for (int p = 1; p <= max_degree; ++p)
+        {
+            const double b = p + 1;
+            const double limit = 2.0e9 / sizeof(double);
+            const bool fit1 = n1*b*b <= limit;
+            const bool fit2 = n2*n2*std::pow(b, 4) <= limit;
+            const bool fit3 = n3*n3*n3*std::pow(b, 6) <= limit;
+
+            if (which == "all" || which == "bezier_extraction")
+            {
+                if (fit1) BenchmarkBezierExtraction<1>(n1, p, nrepeats);
+                if (fit2) BenchmarkBezierExtraction<2>(n2, p, nrepeats);
+                if (fit3) BenchmarkBezierExtraction<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "shape_functions")
+            {
+                if (fit1) BenchmarkShapeFunctions<1, Geo1dBezier<Node<3> > >("shape_functions_geo_1d_bezier", n1, p, nrepeats);
+                if (fit2) BenchmarkShapeFunctions<2, Geo2dBezier<Node<3> > >("shape_functions_geo_2d_bezier", n2, p, nrepeats);
+                if (fit2) BenchmarkShapeFunctions<2, Geo2dBezier3<Node<3> > >("shape_functions_geo_2d_bezier_3", n2, p, nrepeats);
+                if (fit3) BenchmarkShapeFunctions<3, Geo3dBezier<Node<3> > >("shape_functions_geo_3d_bezier", n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "shape_functions_generic")
+            {
+                // same as shape_functions, without the kernels of fixed degrees
+                BezierKernel<1>::SetEnabled(false);
+                BezierKernel<2>::SetEnabled(false);
+                BezierKernel<3>::SetEnabled(false);
+                if (fit1) BenchmarkShapeFunctions<1, Geo1dBezier<Node<3> > >("shape_functions_generic_geo_1d_bezier", n1, p, nrepeats);
+                if (fit2) BenchmarkShapeFunctions<2, Geo2dBezier<Node<3> > >("shape_functions_generic_geo_2d_bezier", n2, p, nrepeats);
+                if (fit2) BenchmarkShapeFunctions<2, Geo2dBezier3<Node<3> > >("shape_functions_generic_geo_2d_bezier_3", n2, p, nrepeats);
+                if (fit3) BenchmarkShapeFunctions<3, Geo3dBezier<Node<3> > >("shape_functions_generic_geo_3d_bezier", n3, p, nrepeats);
+                BezierKernel<1>::SetEnabled(true);
+                BezierKernel<2>::SetEnabled(true);
+                BezierKernel<3>::SetEnabled(true);
+            }
+
+            if (which == "all" || which == "cell_manager")
+            {
+                if (fit1) BenchmarkCellManager<1>(n1, p, nrepeats);
+                if (fit2) BenchmarkCellManager<2>(n2, p, nrepeats);
+                if (fit3) BenchmarkCellManager<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "grid_function")
+            {
+                BenchmarkGridFunction<1>(n1, p, nrepeats);
+                BenchmarkGridFunction<2>(n2, p, nrepeats);
+                BenchmarkGridFunction<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "control_points")
+            {
+                BenchmarkControlPoints<1>(n1, p, nrepeats);
+                BenchmarkControlPoints<2>(n2, p, nrepeats);
+                BenchmarkControlPoints<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "hb_refinement")
+            {
+                BenchmarkHBRefinement<2>(n2, p, nrepeats);
+                BenchmarkHBRefinement<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "hb_grid_function")
+            {
+                BenchmarkHBGridFunction<2>(n2, p, nrepeats);
+                BenchmarkHBGridFunction<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "post_mesh")
+            {
+                BenchmarkPostMesh<2>(n2, p, nrepeats);
+                BenchmarkPostMesh<3>(n3, p, nrepeats);
+            }
+
+            if (which == "all" || which == "l2_projection")
+            {
+                if (fit2) BenchmarkL2Projection<2, Geo2dBezier<Node<3> > >(n2, p, nrepeats);
+                if (fit3) BenchmarkL2Projection<3, Geo3dBezier<Node<3> > >(n3, p, nrepeats);
+            }
+
+            if ((which == "all" || which == "triangulation") && p == 1)
+            {
+                BenchmarkTriangulation(n1, nrepeats);
+            }
+
+            if ((which == "all" || which == "cell_geology") && p == 1)
+            {
+                BenchmarkCellGeology(elements / 10, nrepeats);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <cstdlib>
+#include <cmath>
+#include <sstream>
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/element.h"
+#include "includes/condition.h"
+#include "includes/kratos_components.h"
+#include "geometries/hexahedra_3d_8.h"
+#include "geometries/quadrilateral_3d_4.h"
+#include "utilities/openmp_utils.h"
+#include "custom_utilities/isogeometric_merge_utility.h"
+
+using namespace Kratos;
+
+typedef Element::GeometryType GeometryType;
+
+/// Create a partition of n x n x n hexahedra covering [offset, offset+1] x [0, 1] x [0, 1], with the quadrilateral conditions on the face x = offset.
+/// The nodes on the faces x = offset and x = offset+1 are perturbed by much less than the merge tolerance.
+ModelPart::Pointer CreatePartition(const std::size_t& offset, const std::size_t& n, Element const& rCloneElement, Condition const& rCloneCondition)
+{
+    std::stringstream name;
+    name << "partition_" << offset;
+    ModelPart::Pointer pModelPart = ModelPart::Pointer(new ModelPart(name.str()));
+    pModelPart->AddProperties(Properties::Pointer(new Properties(1)));
+    Properties::Pointer pProperties = pModelPart->pGetProperties(1);
+
+    std::vector<Node<3>::Pointer> nodes;
+    for (std::size_t k = 0; k <= n; ++k)
+        for (std::size_t j = 0; j <= n; ++j)
+            for (std::size_t i = 0; i <= n; ++i)
+            {
+                const double eps = (i == 0 || i == n) ? 1.0e-9 * std::sin((double) (i + j + k + offset)) : 0.0;
+                nodes.push_back(pModelPart->CreateNewNode(nodes.size()+1, offset + (double) i / n + eps, (double) j / n, (double) k / n));
+            }
+
+    const std::size_t nx = n + 1, nxy = (n + 1) * (n + 1);
+    std::size_t element_id = 0;
+    for (std::size_t k = 0; k < n; ++k)
+        for (std::size_t j = 0; j < n; ++j)
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const std::size_t b = k*nxy + j*nx + i;
+                Element::NodesArrayType element_nodes;
+                element_nodes.push_back(nodes[b]);
+                element_nodes.push_back(nodes[b + 1]);
+                element_nodes.push_back(nodes[b + nx + 1]);
+                element_nodes.push_back(nodes[b + nx]);
+                element_nodes.push_back(nodes[b + nxy]);
+                element_nodes.push_back(nodes[b + nxy + 1]);
+                element_nodes.push_back(nodes[b + nxy + nx + 1]);
+                element_nodes.push_back(nodes[b + nxy + nx]);
+                pModelPart->AddElement(rCloneElement.Create(++element_id, element_nodes, pProperties));
+            }
+
+    std::size_t condition_id = 0;
+    for (std::size_t k = 0; k < n; ++k)
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const std::size_t b = k*nxy + j*nx;
+            Condition::NodesArrayType condition_nodes;
+            condition_nodes.push_back(nodes[b]);
+            condition_nodes.push_back(nodes[b + nx]);
+            condition_nodes.push_back(nodes[b + nxy + nx]);
+            condition_nodes.push_back(nodes[b + nxy]);
+            pModelPart->AddCondition(rCloneCondition.Create(++condition_id, condition_nodes, pProperties));
+        }
+
+    return pModelPart;
+}
+
+/// Benchmark the merging of the partition outputs by IsogeometricMergeUtility.
+/// Usage: benchmark_merge_utility [number of partitions] [n] [repeats]
+/// Each line of output is: partitions,source nodes,merged nodes,expected nodes,elements,conditions,seconds
+int main(int argc, char** argv)
+{
+    std::size_t npartitions = (argc > 1) ? std::atoi(argv[1]) : 50;
+    std::size_t n = (argc > 2) ? std::atoi(argv[2]) : 20;
+    int nrepeats = (argc > 3) ? std::atoi(argv[3]) : 3;
+
+    static const Element sample_element(0, GeometryType::Pointer(new Hexahedra3D8<Node<3> >(GeometryType::PointsArrayType(8, Node<3>()))));
+    static const Condition sample_condition(0, GeometryType::Pointer(new Quadrilateral3D4<Node<3> >(GeometryType::PointsArrayType(4, Node<3>()))));
+    KratosComponents<Element>::Add("BenchmarkMergeElement3D8N", sample_element);
+    KratosComponents<Condition>::Add("BenchmarkMergeCondition3D4N", sample_condition);
+
+    IsogeometricMergeUtility merge_utility;
+    std::size_t source_nodes = 0;
+    for (std::size_t i = 0; i < npartitions; ++i)
+    {
+        ModelPart::Pointer pPartition = CreatePartition(i, n, sample_element, sample_condition);
+        source_nodes += pPartition->Nodes().size();
+        merge_utility.Add(pPartition);
+    }
+
+    const std::size_t expected_nodes = (npartitions*n + 1) * (n + 1) * (n + 1);
+
+    double elapsed = 0.0;
+    ModelPart::Pointer pMergedModelPart;
+    for (int r = 0; r < nrepeats; ++r)
+    {
+        pMergedModelPart = ModelPart::Pointer(new ModelPart("merged"));
+
+        std::stringstream null_stream;
+        std::streambuf* old_buffer = std::cout.rdbuf(null_stream.rdbuf());
+        double start = OpenMPUtils::GetCurrentTime();
+        merge_utility.Export(pMergedModelPart);
+        elapsed += OpenMPUtils::GetCurrentTime() - start;
+        std::cout.rdbuf(old_buffer);
+    }
+
+    std::cout << npartitions << "," << source_nodes << "," << pMergedModelPart->Nodes().size() << "," << expected_nodes << ","
+              << pMergedModelPart->Elements().size() << "," << pMergedModelPart->Conditions().size() << "," << elapsed / nrepeats << std::endl;
+
+    return 0;
+}
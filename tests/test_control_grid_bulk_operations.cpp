@@ -0,0 +1,105 @@
+#include <cmath>
+#include "includes/define.h"
+#include "custom_utilities/control_point.h"
+#include "custom_utilities/control_grid_utility.h"
+#include "custom_utilities/unstructured_control_grid.h"
+#include "custom_utilities/nurbs/structured_control_grid.h"
+#include "custom_utilities/trans/translation.h"
+#include "custom_utilities/trans/rotation.h"
+#include "custom_utilities/trans/batched_transformation.h"
+
+using namespace Kratos;
+
+typedef ControlPoint<double> ControlPointType;
+
+/// Fill the grid with distinct control points with non-unit weights
+void FillControlGrid(ControlGrid<ControlPointType>& rGrid)
+{
+    for (std::size_t i = 0; i < rGrid.size(); ++i)
+    {
+        double w = 1.0 + 0.1 * (i % 7);
+        rGrid.SetData(i, ControlPointType(w * std::sin(0.3*i), w * std::cos(0.7*i), w * 0.01 * i, w));
+    }
+}
+
+/// Check that the bulk operations of ControlGridUtility give the same results as the point-by-point operations, including
+/// the changes made through the references and SetData before the bulk operations
+void CheckBulkOperations(ControlGrid<ControlPointType>& rGrid)
+{
+    FillControlGrid(rGrid);
+
+    // modify some entries through the reference and by SetData, keeping a reference across the bulk operations
+    ControlPointType& rPoint = rGrid[3];
+    rPoint = ControlPointType(2.0, 4.0, 6.0, 2.0);
+    rGrid.SetData(5, ControlPointType(1.5, 3.0, 4.5, 1.5));
+
+    std::vector<ControlPointType> reference(rGrid.size());
+    for (std::size_t i = 0; i < rGrid.size(); ++i)
+        reference[i] = rGrid.GetData(i);
+
+    // weights
+    std::vector<double> weights;
+    ControlGridUtility::GetWeights(rGrid, weights);
+    if (weights.size() != rGrid.size())
+        KRATOS_THROW_ERROR(std::logic_error, "Wrong number of weights:", weights.size())
+    for (std::size_t i = 0; i < rGrid.size(); ++i)
+        if (weights[i] != reference[i].W())
+            KRATOS_THROW_ERROR(std::logic_error, "Wrong weight at", i)
+
+    // transformation, composed of a rotation and a translation
+    Rotation<2, double> rot(0.3);
+    Translation<double> trans(1.0, -2.0, 0.5);
+    for (std::size_t i = 0; i < reference.size(); ++i)
+    {
+        reference[i].ApplyTransformation(rot);
+        reference[i].ApplyTransformation(trans);
+    }
+
+    BatchedTransformation<double> batched(rot);
+    batched.Append(trans);
+    ControlGridUtility::ApplyTransformation(rGrid, batched);
+
+    for (std::size_t i = 0; i < rGrid.size(); ++i)
+    {
+        const ControlPointType& p = rGrid.GetData(i);
+        double diff = std::abs(p.WX() - reference[i].WX()) + std::abs(p.WY() - reference[i].WY())
+                    + std::abs(p.WZ() - reference[i].WZ()) + std::abs(p.W() - reference[i].W());
+        if (diff > 1.0e-12)
+            KRATOS_THROW_ERROR(std::logic_error, "Wrong transformed control point at", i)
+    }
+
+    // the reference taken before the bulk operations still refers to the transformed entry
+    if (std::abs(rPoint.WX() - reference[3].WX()) > 1.0e-12 || &rPoint != &rGrid[3])
+        KRATOS_THROW_ERROR(std::logic_error, "The reference is not valid after the transformation", "")
+
+    // a single transformation gives the same results
+    for (std::size_t i = 0; i < reference.size(); ++i)
+        reference[i].ApplyTransformation(trans);
+    ControlGridUtility::ApplyTransformation(rGrid, trans);
+    for (std::size_t i = 0; i < rGrid.size(); ++i)
+        if (std::abs(rGrid.GetData(i).WX() - reference[i].WX()) > 1.0e-12)
+            KRATOS_THROW_ERROR(std::logic_error, "Wrong translated control point at", i)
+}
+
+int main(int argc, char** argv)
+{
+    StructuredControlGrid<1, ControlPointType> grid1(17);
+    CheckBulkOperations(grid1);
+    std::cout << "structured grid 1D: passed" << std::endl;
+
+    StructuredControlGrid<2, ControlPointType> grid2(5, 7);
+    CheckBulkOperations(grid2);
+    std::cout << "structured grid 2D: passed" << std::endl;
+
+    StructuredControlGrid<3, ControlPointType> grid3(20, 30, 40);
+    CheckBulkOperations(grid3);
+    std::cout << "structured grid 3D: passed" << std::endl;
+
+    UnstructuredControlGrid<ControlPointType> grid4(11);
+    CheckBulkOperations(grid4);
+    std::cout << "unstructured grid: passed" << std::endl;
+
+    std::cout << "test_control_grid_bulk_operations passed" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include <mpi.h>
+#include <climits>
+#include <sstream>
+#include "includes/define.h"
+#include "includes/model_part.h"
+#include "includes/element.h"
+#include "includes/condition.h"
+#include "includes/variables.h"
+#include "includes/kratos_components.h"
+#include "geometries/hexahedra_3d_8.h"
+#include "geometries/quadrilateral_3d_4.h"
+#include "custom_io/isogeometric_model_part_io.h"
+#include "custom_processes/isogeometric_distributed_partitioning_process.h"
+
+using namespace Kratos;
+
+/// Read test_distributed_partitioning.mdpa (4x4x4 hexahedra, 16 quadrilateral conditions on the bottom face and one node
+/// without element) by IsogeometricDistributedPartitioningProcess and check the partitions.
+/// Usage: mpirun -np 8 test_distributed_partitioning [path to test_distributed_partitioning, without .mdpa]
+int main(int argc, char** argv)
+{
+    MPI_Init(&argc, &argv);
+
+    int rank, number_of_processes;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &number_of_processes);
+
+    const int number_of_nodes = 126;
+    const int number_of_elements = 64;
+    const int number_of_conditions = 16;
+
+    static const Element sample_element(0, Element::GeometryType::Pointer(new Hexahedra3D8<Node<3> >(Element::GeometryType::PointsArrayType(8, Node<3>()))));
+    static const Condition sample_condition(0, Condition::GeometryType::Pointer(new Quadrilateral3D4<Node<3> >(Condition::GeometryType::PointsArrayType(4, Node<3>()))));
+    KratosComponents<Element>::Add("TestElement3D8N", sample_element);
+    KratosComponents<Condition>::Add("TestCondition3D4N", sample_condition);
+
+    std::string input = (argc > 1) ? std::string(argv[1]) : std::string("test_distributed_partitioning");
+    std::stringstream output;
+    output << input << "_" << rank << "_out";
+
+    ModelPart model_part("test_distributed_partitioning");
+    model_part.AddNodalSolutionStepVariable(PARTITION_INDEX);
+
+    IsogeometricModelPartIO model_part_io(input, output.str());
+    IsogeometricDistributedPartitioningProcess(model_part, model_part_io).Execute();
+
+    Communicator& r_communicator = model_part.GetCommunicator();
+
+    // the lowest rank having an element containing the node
+    std::vector<int> lowest_rank(number_of_nodes, INT_MAX);
+    for (ModelPart::ElementIterator it = model_part.ElementsBegin(); it != model_part.ElementsEnd(); ++it)
+        for (std::size_t i = 0; i < it->GetGeometry().size(); ++i)
+            lowest_rank[it->GetGeometry()[i].Id() - 1] = rank;
+    MPI_Allreduce(MPI_IN_PLACE, &lowest_rank[0], number_of_nodes, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+    // each node is owned by one rank, which is the lowest rank among the ranks of its elements
+    std::vector<int> owners(number_of_nodes, 0);
+    for (ModelPart::NodeIterator it = model_part.NodesBegin(); it != model_part.NodesEnd(); ++it)
+    {
+        int owner = it->GetSolutionStepValue(PARTITION_INDEX);
+        if (lowest_rank[it->Id() - 1] != INT_MAX && owner != lowest_rank[it->Id() - 1])
+            KRATOS_THROW_ERROR(std::logic_error, "The node is not owned by the lowest partition of its elements:", it->Id())
+        bool is_local = (r_communicator.LocalMesh().Nodes().find(it->Id()) != r_communicator.LocalMesh().Nodes().end());
+        if (is_local != (owner == rank))
+            KRATOS_THROW_ERROR(std::logic_error, "The local mesh does not contain exactly the owned nodes. Wrong node", it->Id())
+        if (owner == rank)
+            owners[it->Id() - 1] = 1;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &owners[0], number_of_nodes, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    for (int i = 0; i < number_of_nodes; ++i)
+        if (owners[i] != 1)
+            KRATOS_THROW_ERROR(std::logic_error, "The node is not owned by exactly one rank:", i+1)
+
+    // the elements and conditions are distributed without duplicate
+    int numbers[3] = {(int) r_communicator.LocalMesh().NumberOfNodes(), (int) model_part.NumberOfElements(), (int) model_part.NumberOfConditions()};
+    std::cout << "rank " << rank << ": " << model_part.NumberOfNodes() << " nodes (" << numbers[0] << " local), "
+              << numbers[1] << " elements, " << numbers[2] << " conditions" << std::endl;
+    MPI_Allreduce(MPI_IN_PLACE, numbers, 3, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (numbers[0] != number_of_nodes || numbers[1] != number_of_elements || numbers[2] != number_of_conditions)
+        KRATOS_THROW_ERROR(std::logic_error, "Wrong total number of local nodes, elements or conditions", "")
+
+    std::vector<int> element_counts(number_of_elements, 0);
+    for (ModelPart::ElementIterator it = model_part.ElementsBegin(); it != model_part.ElementsEnd(); ++it)
+        ++element_counts[it->Id() - 1];
+    MPI_Allreduce(MPI_IN_PLACE, &element_counts[0], number_of_elements, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    for (int i = 0; i < number_of_elements; ++i)
+        if (element_counts[i] != 1)
+            KRATOS_THROW_ERROR(std::logic_error, "The element is not in exactly one partition:", i+1)
+
+    std::vector<int> condition_counts(number_of_conditions, 0);
+    for (ModelPart::ConditionIterator it = model_part.ConditionsBegin(); it != model_part.ConditionsEnd(); ++it)
+        ++condition_counts[it->Id() - 1];
+    MPI_Allreduce(MPI_IN_PLACE, &condition_counts[0], number_of_conditions, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    for (int i = 0; i < number_of_conditions; ++i)
+        if (condition_counts[i] != 1)
+            KRATOS_THROW_ERROR(std::logic_error, "The condition is not in exactly one partition:", i+1)
+
+    if (rank == 0)
+        std::cout << "test_distributed_partitioning passed on " << number_of_processes << " processes" << std::endl;
+
+    MPI_Finalize();
+    return 0;
+}
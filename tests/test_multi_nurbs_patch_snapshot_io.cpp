@@ -0,0 +1,143 @@
+#include <cmath>
+#include <cstdio>
+#include "includes/define.h"
+#include "custom_utilities/control_grid_library.h"
+#include "custom_utilities/patch.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/import_export/multi_nurbs_patch_snapshot_io.h"
+
+using namespace Kratos;
+
+/// Create a quadratic patch on [x0, x0+1] x [0, 1] with n x n control points, and the TEMPERATURE and DISPLACEMENT grid functions
+Patch<2>::Pointer CreatePatch(const std::size_t& Id, const double& x0, const std::size_t& n)
+{
+    BSplinesFESpace<2>::Pointer pFESpace = BSplinesFESpace<2>::Create();
+    std::vector<double> knots(3, 0.0);
+    for (std::size_t i = 1; i < n - 2; ++i)
+        knots.push_back(static_cast<double>(i) / (n - 2));
+    for (std::size_t i = 0; i < 3; ++i)
+        knots.push_back(1.0);
+    for (int dim = 0; dim < 2; ++dim)
+    {
+        pFESpace->SetKnotVector(dim, knots);
+        pFESpace->SetInfo(dim, n, 2);
+    }
+    pFESpace->ResetFunctionIndices();
+
+    Patch<2>::Pointer pPatch = Patch<2>::Create(Id, pFESpace);
+
+    std::vector<double> start = {x0, 0.0, 0.0};
+    std::vector<double> end = {x0 + 1.0, 1.0, 0.0};
+    std::vector<std::size_t> ngrid = {n, n};
+    ControlGrid<ControlPoint<double> >::Pointer pControlPointGrid = ControlGridLibrary::CreateStructuredControlPointGrid<2>(start, ngrid, end);
+    for (std::size_t i = 0; i < pControlPointGrid->size(); ++i)
+    {
+        ControlPoint<double> point = pControlPointGrid->GetData(i);
+        point.SetCoordinates(point.X() + 1.0e-3 * std::sin(0.1*i), point.Y(), 0.01 * std::cos(0.3*i), 1.0 + 0.1 * std::sin(0.7*i));
+        pControlPointGrid->SetData(i, point);
+    }
+    pPatch->CreateControlPointGridFunction(pControlPointGrid);
+
+    ControlGrid<double>::Pointer pTemperatureGrid = ControlGridLibrary::CreateStructuredZeroControlGrid<2>(TEMPERATURE, ngrid);
+    ControlGrid<array_1d<double, 3> >::Pointer pDisplacementGrid = ControlGridLibrary::CreateStructuredZeroControlGrid<2>(DISPLACEMENT, ngrid);
+    for (std::size_t i = 0; i < pTemperatureGrid->size(); ++i)
+    {
+        pTemperatureGrid->SetData(i, 300.0 + std::sin(0.01*i) / 3.0);
+        array_1d<double, 3> u;
+        u[0] = std::exp(-1.0e-4*i);
+        u[1] = -1.0 / (i + 1.0);
+        u[2] = std::sqrt(static_cast<double>(i));
+        pDisplacementGrid->SetData(i, u);
+    }
+    pPatch->CreateGridFunction(TEMPERATURE, pTemperatureGrid);
+    pPatch->CreateGridFunction(DISPLACEMENT, pDisplacementGrid);
+
+    return pPatch;
+}
+
+/// Check that the restored patch is bit-exactly the same as the original patch
+void CheckPatch(Patch<2>::Pointer pPatch, Patch<2>::Pointer pNewPatch)
+{
+    if (pNewPatch->Id() != pPatch->Id())
+        KRATOS_THROW_ERROR(std::logic_error, "Wrong patch id:", pNewPatch->Id())
+
+    const BSplinesFESpace<2>& rFESpace = dynamic_cast<const BSplinesFESpace<2>&>(*(pPatch->pFESpace()));
+    const BSplinesFESpace<2>& rNewFESpace = dynamic_cast<const BSplinesFESpace<2>&>(*(pNewPatch->pFESpace()));
+    for (std::size_t dim = 0; dim < 2; ++dim)
+    {
+        if (rNewFESpace.Order(dim) != rFESpace.Order(dim) || rNewFESpace.Number(dim) != rFESpace.Number(dim))
+            KRATOS_THROW_ERROR(std::logic_error, "Wrong order or number of functions of patch", pPatch->Id())
+        for (std::size_t i = 0; i < rFESpace.KnotVector(dim).size(); ++i)
+            if (rNewFESpace.KnotVector(dim)[i] != rFESpace.KnotVector(dim)[i])
+                KRATOS_THROW_ERROR(std::logic_error, "Wrong knot vector of patch", pPatch->Id())
+    }
+
+    ControlGrid<ControlPoint<double> >::ConstPointer pPoints = pPatch->pControlPointGridFunction()->pControlGrid();
+    ControlGrid<ControlPoint<double> >::ConstPointer pNewPoints = pNewPatch->pControlPointGridFunction()->pControlGrid();
+    ControlGrid<double>::ConstPointer pTemperature = pPatch->pGetGridFunction(TEMPERATURE)->pControlGrid();
+    ControlGrid<double>::ConstPointer pNewTemperature = pNewPatch->pGetGridFunction(TEMPERATURE)->pControlGrid();
+    ControlGrid<array_1d<double, 3> >::ConstPointer pDisplacement = pPatch->pGetGridFunction(DISPLACEMENT)->pControlGrid();
+    ControlGrid<array_1d<double, 3> >::ConstPointer pNewDisplacement = pNewPatch->pGetGridFunction(DISPLACEMENT)->pControlGrid();
+    if (pNewPoints->size() != pPoints->size() || pNewTemperature->size() != pTemperature->size() || pNewDisplacement->size() != pDisplacement->size())
+        KRATOS_THROW_ERROR(std::logic_error, "Wrong number of control values of patch", pPatch->Id())
+
+    for (std::size_t i = 0; i < pPoints->size(); ++i)
+    {
+        const ControlPoint<double>& p = pPoints->GetData(i);
+        const ControlPoint<double>& q = pNewPoints->GetData(i);
+        if (q.WX() != p.WX() || q.WY() != p.WY() || q.WZ() != p.WZ() || q.W() != p.W())
+            KRATOS_THROW_ERROR(std::logic_error, "Wrong control point at", i)
+        if (pNewTemperature->GetData(i) != pTemperature->GetData(i))
+            KRATOS_THROW_ERROR(std::logic_error, "Wrong temperature at", i)
+        for (std::size_t j = 0; j < 3; ++j)
+            if (pNewDisplacement->GetData(i)[j] != pDisplacement->GetData(i)[j])
+                KRATOS_THROW_ERROR(std::logic_error, "Wrong displacement at", i)
+    }
+}
+
+/// Write the multipatch and the single patch to snapshots, read them back and compare
+void CheckRoundTrip(MultiPatch<2>::Pointer pMultiPatch, const int& CompressionLevel, const bool& Shuffle)
+{
+    const std::string filename = "test_multi_nurbs_patch_snapshot_io.bin";
+
+    MultiNURBSPatchSnapshotWriter<2> writer;
+    writer.SetCompressionLevel(CompressionLevel);
+    writer.SetShuffle(Shuffle);
+    MultiNURBSPatchSnapshotReader<2> reader;
+
+    writer.Export(pMultiPatch, filename);
+    MultiPatch<2>::Pointer pNewMultiPatch = reader.Import(filename);
+    for (std::size_t id = 1; id <= 2; ++id)
+        CheckPatch(pMultiPatch->pGetPatch(id), pNewMultiPatch->pGetPatch(id));
+    if (pNewMultiPatch->pGetPatch(1)->pNeighbor(_RIGHT_) == NULL || pNewMultiPatch->pGetPatch(1)->pNeighbor(_RIGHT_)->Id() != 2
+        || pNewMultiPatch->pGetPatch(2)->pNeighbor(_LEFT_) == NULL || pNewMultiPatch->pGetPatch(2)->pNeighbor(_LEFT_)->Id() != 1)
+        KRATOS_THROW_ERROR(std::logic_error, "The topology is not restored", "")
+
+    writer.Export(pMultiPatch->pGetPatch(2), filename);
+    CheckPatch(pMultiPatch->pGetPatch(2), reader.ImportSingle(filename));
+
+    std::remove(filename.c_str());
+
+    std::cout << "compression level " << CompressionLevel << ", shuffle " << Shuffle << ": passed" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    // the payload of the first patch spans several blocks
+    MultiPatch<2>::Pointer pMultiPatch = MultiPatch<2>::Pointer(new MultiPatch<2>());
+    pMultiPatch->AddPatch(CreatePatch(1, 0.0, 400));
+    pMultiPatch->AddPatch(CreatePatch(2, 1.0, 5));
+    pMultiPatch->pGetPatch(1)->pSetNeighbor(_RIGHT_, pMultiPatch->pGetPatch(2));
+    pMultiPatch->pGetPatch(2)->pSetNeighbor(_LEFT_, pMultiPatch->pGetPatch(1));
+
+    CheckRoundTrip(pMultiPatch, 0, false);
+    CheckRoundTrip(pMultiPatch, 0, true);
+    #ifdef ISOGEOMETRIC_USE_ZLIB
+    CheckRoundTrip(pMultiPatch, 1, false);
+    CheckRoundTrip(pMultiPatch, 6, true);
+    #endif
+
+    std::cout << "test_multi_nurbs_patch_snapshot_io passed" << std::endl;
+
+    return 0;
+}
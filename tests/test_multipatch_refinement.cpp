@@ -0,0 +1,122 @@
+#include <cmath>
+#include "includes/define.h"
+#include "custom_utilities/control_grid_library.h"
+#include "custom_utilities/patch.h"
+#include "custom_utilities/nurbs/bsplines_fespace.h"
+#include "custom_utilities/multipatch_refinement_utility.h"
+
+using namespace Kratos;
+
+/// Create a quadratic patch on [x0, x0+1] x [0, 1] with two elements in each direction
+Patch<2>::Pointer CreatePatch(const std::size_t& Id, const double& x0)
+{
+    BSplinesFESpace<2>::Pointer pFESpace = BSplinesFESpace<2>::Create();
+    std::vector<double> knots = {0.0, 0.0, 0.0, 0.5, 1.0, 1.0, 1.0};
+    for (int dim = 0; dim < 2; ++dim)
+    {
+        pFESpace->SetKnotVector(dim, knots);
+        pFESpace->SetInfo(dim, 4, 2);
+    }
+    pFESpace->ResetFunctionIndices();
+
+    Patch<2>::Pointer pPatch = Patch<2>::Create(Id, pFESpace);
+
+    std::vector<double> start = {x0, 0.0, 0.0};
+    std::vector<double> end = {x0 + 1.0, 1.0, 0.0};
+    std::vector<std::size_t> ngrid = {4, 4};
+    pPatch->CreateControlPointGridFunction(ControlGridLibrary::CreateStructuredControlPointGrid<2>(start, ngrid, end));
+
+    return pPatch;
+}
+
+/// Get the order, the distinct knots and their multiplicities on the side of the patch
+void GetInterfaceKnots(Patch<2>::Pointer pPatch, const BoundarySide& side, std::size_t& order,
+        std::vector<double>& knots, std::vector<std::size_t>& multiplicities)
+{
+    BSplinesFESpace<1>::Pointer pBFESpace = boost::dynamic_pointer_cast<BSplinesFESpace<1> >(pPatch->pFESpace()->ConstructBoundaryFESpace(side));
+    if (pBFESpace == NULL)
+        KRATOS_THROW_ERROR(std::logic_error, "The boundary FESpace is not B-Splines on side", side)
+
+    order = pBFESpace->Order(0);
+    knots.clear();
+    multiplicities.clear();
+    const BSplinesFESpace<1>::knot_container_t& knot_vector = pBFESpace->KnotVector(0);
+    for (std::size_t i = 0; i < knot_vector.size(); ++i)
+    {
+        double k = knot_vector[i];
+        if (knots.size() != 0 && std::abs(k - knots.back()) < 1.0e-10)
+            ++multiplicities.back();
+        else
+        {
+            knots.push_back(k);
+            multiplicities.push_back(1);
+        }
+    }
+}
+
+/// Check that the knots and multiplicities of the interface between the two patches are the same on both sides, and as expected
+void CheckInterface(MultiPatch<2>& rMultiPatch, const std::size_t& expected_order,
+        const std::vector<double>& expected_knots, const std::vector<std::size_t>& expected_multiplicities)
+{
+    std::size_t order1, order2;
+    std::vector<double> knots1, knots2;
+    std::vector<std::size_t> multiplicities1, multiplicities2;
+    GetInterfaceKnots(rMultiPatch.pGetPatch(1), _RIGHT_, order1, knots1, multiplicities1);
+    GetInterfaceKnots(rMultiPatch.pGetPatch(2), _LEFT_, order2, knots2, multiplicities2);
+
+    for (std::size_t i = 0; i < knots1.size(); ++i)
+        std::cout << " " << knots1[i] << "(" << multiplicities1[i] << ")";
+    std::cout << ", order " << order1 << std::endl;
+
+    if (order1 != order2 || order1 != expected_order)
+        KRATOS_THROW_ERROR(std::logic_error, "The orders of the interface do not match, patch 2 has", order2)
+
+    if (knots1.size() != knots2.size() || knots1.size() != expected_knots.size())
+        KRATOS_THROW_ERROR(std::logic_error, "The numbers of distinct knots of the interface do not match, patch 2 has", knots2.size())
+
+    for (std::size_t i = 0; i < knots1.size(); ++i)
+    {
+        if (std::abs(knots1[i] - knots2[i]) > 1.0e-10 || std::abs(knots1[i] - expected_knots[i]) > 1.0e-10)
+            KRATOS_THROW_ERROR(std::logic_error, "The knots of the interface do not match, patch 2 has", knots2[i])
+        if (multiplicities1[i] != multiplicities2[i] || multiplicities1[i] != expected_multiplicities[i])
+            KRATOS_THROW_ERROR(std::logic_error, "The multiplicities of the interface do not match, patch 2 has", multiplicities2[i])
+    }
+}
+
+int main(int argc, char** argv)
+{
+    // two patches sharing the right side of patch 1 and the left side of patch 2
+    MultiPatch<2>::Pointer pMultiPatch = MultiPatch<2>::Pointer(new MultiPatch<2>());
+    pMultiPatch->AddPatch(CreatePatch(1, 0.0));
+    pMultiPatch->AddPatch(CreatePatch(2, 1.0));
+    pMultiPatch->pGetPatch(1)->pSetNeighbor(_RIGHT_, pMultiPatch->pGetPatch(2));
+    pMultiPatch->pGetPatch(2)->pSetNeighbor(_LEFT_, pMultiPatch->pGetPatch(1));
+
+    MultiPatchRefinementUtility refinement_util;
+
+    // refine patch 1; the knots along the interface are inserted in patch 2
+    std::cout << "interface after knot insertion:";
+    Patch<2>::Pointer pPatch1 = pMultiPatch->pGetPatch(1);
+    std::vector<std::vector<double> > ins_knots = {{0.25}, {0.3, 0.3, 0.75}};
+    refinement_util.InsertKnots<2>(pPatch1, ins_knots);
+    pMultiPatch->Enumerate();
+    CheckInterface(*pMultiPatch, 2, {0.0, 0.3, 0.5, 0.75, 1.0}, {3, 2, 1, 1, 3});
+
+    // elevate patch 2; patch 1 is elevated along the interface
+    std::cout << "interface after degree elevation:";
+    Patch<2>::Pointer pPatch2 = pMultiPatch->pGetPatch(2);
+    std::vector<std::size_t> order_increment = {1, 1};
+    refinement_util.DegreeElevate<2>(pPatch2, order_increment);
+    pMultiPatch->Enumerate();
+    CheckInterface(*pMultiPatch, 3, {0.0, 0.3, 0.5, 0.75, 1.0}, {4, 3, 2, 2, 4});
+
+    // the knot inserted across the interface does not leak to patch 2
+    const BSplinesFESpace<2>& rFESpace2 = dynamic_cast<const BSplinesFESpace<2>&>(*(pMultiPatch->pGetPatch(2)->pFESpace()));
+    for (std::size_t i = 0; i < rFESpace2.KnotVector(0).size(); ++i)
+        if (std::abs(rFESpace2.KnotVector(0)[i] - 0.25) < 1.0e-10)
+            KRATOS_THROW_ERROR(std::logic_error, "The knot inserted across the interface is found in patch 2", "")
+
+    std::cout << "test_multipatch_refinement passed" << std::endl;
+
+    return 0;
+}
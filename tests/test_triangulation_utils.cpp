@@ -0,0 +1,118 @@
+#include <cmath>
+#include "includes/define.h"
+#include "custom_utilities/triangulation_utils.h"
+
+using namespace Kratos;
+
+/// Check that the triangles are counter-clockwise, cover the expected area and satisfy the empty-circumcircle property
+void CheckTriangulation(const std::vector<double>& XYlist, const std::vector<unsigned int>& Connectivities,
+        const std::size_t& expected_number_of_triangles, const double& expected_area)
+{
+    const std::size_t ntri = Connectivities.size() / 3;
+    std::cout << "  " << XYlist.size() / 2 << " points, " << ntri << " triangles" << std::endl;
+    if (ntri != expected_number_of_triangles)
+        KRATOS_THROW_ERROR(std::logic_error, "Wrong number of triangles:", ntri)
+
+    double area = 0.0;
+    for (std::size_t t = 0; t < ntri; ++t)
+    {
+        const double ax = XYlist[2*Connectivities[3*t]], ay = XYlist[2*Connectivities[3*t] + 1];
+        const double bx = XYlist[2*Connectivities[3*t + 1]], by = XYlist[2*Connectivities[3*t + 1] + 1];
+        const double cx = XYlist[2*Connectivities[3*t + 2]], cy = XYlist[2*Connectivities[3*t + 2] + 1];
+        const double a = 0.5 * ((bx - ax) * (cy - ay) - (by - ay) * (cx - ax));
+        if (a <= 0.0)
+            KRATOS_THROW_ERROR(std::logic_error, "The triangle is not counter-clockwise or is degenerated:", t)
+        area += a;
+
+        // no point lies strictly inside the circumcircle
+        for (std::size_t i = 0; i < XYlist.size() / 2; ++i)
+        {
+            const double dx = ax - XYlist[2*i], dy = ay - XYlist[2*i + 1];
+            const double ex = bx - XYlist[2*i], ey = by - XYlist[2*i + 1];
+            const double fx = cx - XYlist[2*i], fy = cy - XYlist[2*i + 1];
+            const double incircle = (dx*dx + dy*dy) * (ex*fy - fx*ey) - (ex*ex + ey*ey) * (dx*fy - fx*dy) + (fx*fx + fy*fy) * (dx*ey - ex*dy);
+            if (incircle > 1.0e-10)
+                KRATOS_THROW_ERROR(std::logic_error, "The triangle is not Delaunay, the circumcircle contains the point", i)
+        }
+    }
+
+    if (std::abs(area - expected_area) > 1.0e-10 * expected_area)
+        KRATOS_THROW_ERROR(std::logic_error, "Wrong area covered by the triangles:", area)
+}
+
+/// Check that the triangulation throws an error
+void CheckThrow(const std::vector<double>& XYlist)
+{
+    TriangulationUtils util;
+    std::vector<unsigned int> Connectivities;
+    try
+    {
+        util.ComputeDelaunayTriangulation(XYlist, Connectivities);
+    }
+    catch (std::exception& e)
+    {
+        std::cout << "  error thrown as expected" << std::endl;
+        return;
+    }
+    KRATOS_THROW_ERROR(std::logic_error, "The triangulation does not throw on degenerate input, number of triangles =", Connectivities.size() / 3)
+}
+
+int main(int argc, char** argv)
+{
+    TriangulationUtils util;
+    std::vector<unsigned int> Connectivities;
+
+    // regular grid of 21x21 points, all the cells have cocircular points
+    const std::size_t n = 21;
+    std::vector<double> grid;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            grid.push_back(static_cast<double>(j));
+            grid.push_back(static_cast<double>(i));
+        }
+    }
+    std::cout << "grid:" << std::endl;
+    util.ComputeDelaunayTriangulation(grid, Connectivities);
+    CheckTriangulation(grid, Connectivities, 2*(n-1)*(n-1), (n-1)*(n-1));
+
+    // the same grid with every third node repeated, once after the grid and once in reverse order
+    std::vector<double> grid_with_duplicates = grid;
+    for (std::size_t i = 0; i < n*n; i += 3)
+    {
+        grid_with_duplicates.push_back(grid[2*i]);
+        grid_with_duplicates.push_back(grid[2*i + 1]);
+    }
+    for (std::size_t i = n*n; i > 0; i -= 3)
+    {
+        grid_with_duplicates.push_back(grid[2*(i-1)]);
+        grid_with_duplicates.push_back(grid[2*(i-1) + 1]);
+    }
+    std::cout << "grid with repeated nodes:" << std::endl;
+    util.ComputeDelaunayTriangulation(grid_with_duplicates, Connectivities);
+    CheckTriangulation(grid_with_duplicates, Connectivities, 2*(n-1)*(n-1), (n-1)*(n-1));
+
+    // triangle with one repeated vertex
+    std::vector<double> triangle = {0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 1.0, 0.0};
+    std::cout << "triangle with a repeated vertex:" << std::endl;
+    util.ComputeDelaunayTriangulation(triangle, Connectivities);
+    CheckTriangulation(triangle, Connectivities, 1, 0.5);
+
+    // collinear points, with and without repeated points
+    std::vector<double> collinear = {0.0, 0.0, 1.0, 1.0, 2.0, 2.0, 3.0, 3.0};
+    std::cout << "collinear points:" << std::endl;
+    CheckThrow(collinear);
+
+    std::vector<double> collinear_with_duplicates = {0.0, 0.0, 1.0, 1.0, 2.0, 2.0, 1.0, 1.0, 3.0, 3.0};
+    std::cout << "collinear points with a repeated point:" << std::endl;
+    CheckThrow(collinear_with_duplicates);
+
+    std::vector<double> coincident = {1.0, 1.0, 1.0, 1.0, 1.0, 1.0};
+    std::cout << "coincident points:" << std::endl;
+    CheckThrow(coincident);
+
+    std::cout << "test_triangulation_utils passed" << std::endl;
+
+    return 0;
+}